@@ -0,0 +1,177 @@
+/*
+
+Copyright (C) 2009, 2010  Gaetan Guidet
+
+This file is part of lwc.
+
+lwc is free software; you can redistribute it and/or modify it
+under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 2.1 of the License, or (at
+your option) any later version.
+
+lwc is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+USA.
+
+*/
+
+#ifndef __lwc_actor_h__
+#define __lwc_actor_h__
+
+#include <lwc/object.h>
+#include <lwc/atomic.h>
+#include <gcore/threads.h>
+#ifndef _WIN32
+# include <pthread.h>
+#endif
+
+namespace lwc {
+  
+  struct MailboxStats {
+    unsigned long sent;       // calls queued by waiting callers
+    unsigned long posted;     // fire and forget calls queued
+    unsigned long processed;  // calls run by the owner thread
+    unsigned long failed;     // posted calls that failed (sent ones report to their caller)
+    unsigned long depth;      // calls currently queued
+    unsigned long maxDepth;   // highest depth seen by the owner thread
+    unsigned long stalls;     // times a caller waited for room in a full mailbox
+  };
+  
+  // Actor mode (see Object::setMailbox, Registry::setLoaderMailbox): calls
+  // made on an object from any other thread than its mailbox owner are
+  // queued and run by the owner thread, so that objects bound to a single
+  // interpreter can be used from a multithreaded host.
+  // Callers push to a lock-free multi-producer/single-consumer queue, they
+  // only take a lock to wake up a sleeping owner thread or to wait.
+  class LWC_API Mailbox {
+    public:
+      
+      // Owner thread work other than method calls (see execute)
+      typedef void (*Func)(void *data);
+      
+      // capacity: number of queued calls above which callers wait for room
+      //   (approximate with concurrent callers), 0 for unbounded
+      // ownThread: the mailbox starts its own owner thread, otherwise the
+      //   creating thread owns it and must call process regularly
+      Mailbox(size_t capacity=0, bool ownThread=true);
+      // Remaining calls are run first, by the destroying thread when the
+      // mailbox has no thread of its own (destroy it from the owner thread)
+      ~Mailbox();
+      
+      bool isOwnerThread() const;
+      
+      inline bool hasOwnThread() const {
+        return (mThread != 0);
+      }
+      
+      // Run queued calls (at most maxCalls, 0 for all), owner thread only.
+      // Returns the number of calls run
+      size_t process(size_t maxCalls=0);
+      
+      // Queue a call and wait for its completion
+      void send(Object *o, const char *name, MethodParams &params, Status &status);
+      
+      // Queue a copy of params and return (input arguments only)
+      // o must not be destroyed before the call is processed
+      void post(Object *o, const char *name, const MethodParams &params) throw(std::runtime_error);
+      
+      // Run func(data) on the owner thread and wait for it (object creation,
+      // destruction and property access). Exceptions are thrown back to the
+      // caller as std::runtime_error
+      void execute(Func func, void *data) throw(std::runtime_error);
+      
+      inline size_t depth() const {
+        return size_t(atomic::Load(&mDepth));
+      }
+      
+      void getStats(MailboxStats &stats) const;
+      
+    private:
+      
+      Mailbox(const Mailbox&);
+      Mailbox& operator=(const Mailbox&);
+      
+      // intrusive queue node
+      struct Node {
+        void * volatile next;
+      };
+      
+      struct Message : public Node {
+        Object *object;
+        const char *name;
+        MethodParams *params;
+        // 0 for posted calls (see PostedMessage)
+        Status *status;
+        // executed function instead of a method call
+        Func func;
+        void *data;
+        volatile long done;
+      };
+      
+      // heap allocated, owns its method name, parameters and input strings
+      struct PostedMessage : public Message {
+        std::string ownedName;
+        std::vector<std::string> strings;
+      };
+      
+#ifdef _WIN32
+      typedef unsigned long ThreadID;
+#else
+      typedef pthread_t ThreadID;
+#endif
+      
+      static ThreadID CurrentThread();
+      
+      void push(Message *msg);
+      Message* pop();
+      void run(Message *msg);
+      void complete(Message *msg);
+      size_t drain(size_t maxCalls);
+      // push and wait for run to complete msg
+      void wait(Message *msg);
+      
+      int ownerMain(void *data);
+      
+    private:
+      
+      // producers side
+      void * volatile mHead;
+      // consumer side
+      Node *mTail;
+      Node mStub;
+      
+      size_t mCapacity;
+      volatile long mDepth;
+      volatile long mWaitingProducers;
+      volatile long mSleeping;
+      volatile long mStop;
+      
+      gcore::Thread *mThread;
+      ThreadID mOwner;
+      volatile long mOwnerSet;
+      
+      // owner thread wake up, room in the mailbox, completed sent calls
+      gcore::Mutex mWakeMutex;
+      gcore::Condition mWake;
+      gcore::Mutex mRoomMutex;
+      gcore::Condition mRoom;
+      gcore::Mutex mDoneMutex;
+      gcore::Condition mDone;
+      
+      volatile long mSent;
+      volatile long mPosted;
+      volatile long mProcessed;
+      volatile long mFailed;
+      volatile long mMaxDepth;
+      volatile long mStalls;
+  };
+  
+}
+
+#endif
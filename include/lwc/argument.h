@@ -30,6 +30,8 @@ USA.
 
 #define LWC_MAX_POSITIONAL_ARGS 16
 #define LWC_MAX_ARGS 32
+// signal payloads are stored inline in the delivery queues
+#define LWC_MAX_SIGNAL_ARGS 8
 #define LWC_DEFVAL(v) true, {(void*)(v)}
 #define LWC_DEFVAL2(v) true, {*reinterpret_cast<void**>(&v)}
 #define LWC_NODEF     false, {0}
@@ -42,7 +44,10 @@ namespace lwc {
   enum Direction {
     AD_IN = 0,
     AD_OUT,
-    AD_INOUT
+    AD_INOUT,
+    // last argument only: the value is stored in the parameters slot itself
+    // (no pointer indirection), see MethodParams::setReturn
+    AD_RETURN
   };
   
   typedef union {
@@ -168,459 +173,143 @@ namespace lwc {
   
   // ---
   
+  // Argument value conversion failures (see details::GetSet). Messages are only
+  // built when a conversion fails, through ConversionErrorString.
+  enum ConversionError {
+    CE_NONE = 0,
+    CE_INDIRECTION,   // level of indirection mismatch
+    CE_TYPE,          // no conversion between argument type and C++ type
+    CE_EMPTY          // Empty is not a valid argument type
+  };
+  
+  LWC_API const char* ConversionErrorString(ConversionError err);
+  
   namespace details {
     
+    // Convertion lookup resolved at compile time: Do is never instantiated for
+    // pairs the Convertion table does not allow
+    template <typename From, typename To, int Allowed=Convertion<From, To>::Allowed>
+    struct Convert {
+      static inline ConversionError Do(const From &src, To &dst) {
+        Convertion<From, To>::Do(src, dst);
+        return CE_NONE;
+      }
+    };
+    template <typename From, typename To> struct Convert<From, To, 0> {
+      static inline ConversionError Do(const From &, To &) {
+        return CE_TYPE;
+      }
+    };
+    
+    inline ConversionError Check(const BaseArgument &arg, int indirection, int type) {
+      if (arg.indirectionLevel() != indirection) {
+        return CE_INDIRECTION;
+      }
+      if (int(arg.getType()) != type) {
+        return CE_TYPE;
+      }
+      return CE_NONE;
+    }
+    
     // general case (plain types)
     template <typename T> struct GetSet {
-      static bool Get(const BaseArgument &arg, const ArgumentValue &src, T &dst, std::string &err) {
-        err = "";
+      typedef typename gcore::NoRefOrConst<T>::Type TT;
+      static ConversionError Get(const BaseArgument &arg, const ArgumentValue &src, T &dst) {
         if (arg.indirectionLevel() != 0) {
-          err ="Expected 0 level of indirection";
-          return false;
+          return CE_INDIRECTION;
         }
         switch (arg.getType()) {
-          case AT_BOOL: {
-            if (!Convertion<bool, typename gcore::NoRefOrConst<T>::Type>::Possible()) {
-              err = "Invalid argument type (excepted ";
-              err += typeid(bool).name();
-              err += " got ";
-              err += typeid(typename gcore::NoRefOrConst<T>::Type).name();
-              err += ")";
-              return false;
-            }
-            Convertion<bool, typename gcore::NoRefOrConst<T>::Type>::Do(src.boolean, dst);
-            return true;
-          }
-          case AT_INT: {
-            if (!Convertion<Integer, typename gcore::NoRefOrConst<T>::Type>::Possible()) {
-              err = "Invalid argument type (excepted ";
-              err += typeid(Integer).name();
-              err += " got ";
-              err += typeid(typename gcore::NoRefOrConst<T>::Type).name();
-              err += ")";
-              return false;
-            }
-            Convertion<Integer, typename gcore::NoRefOrConst<T>::Type>::Do(src.integer, dst);
-            return true;
-          }
-          case AT_REAL: {
-            if (!Convertion<Real, typename gcore::NoRefOrConst<T>::Type>::Possible()) {
-              err = "Invalid argument type (excepted ";
-              err += typeid(Real).name();
-              err += " got ";
-              err += typeid(typename gcore::NoRefOrConst<T>::Type).name();
-              err += ")";
-              return false;
-            }
-            Convertion<Real, typename gcore::NoRefOrConst<T>::Type>::Do(src.real, dst);
-            return true;
-          }
+          case AT_BOOL:
+            return Convert<bool, TT>::Do(src.boolean, dst);
+          case AT_INT:
+            return Convert<Integer, TT>::Do(src.integer, dst);
+          case AT_REAL:
+            return Convert<Real, TT>::Do(src.real, dst);
           case AT_STRING: {
-            if (!Convertion<char*, typename gcore::NoRefOrConst<T>::Type>::Possible()) {
-              err = "Invalid argument type (excepted ";
-              err += typeid(char*).name();
-              err += " got ";
-              err += typeid(typename gcore::NoRefOrConst<T>::Type).name();
-              err += ")";
-              return false;
-            }
             char *val = (char*) src.ptr;
-            Convertion<char*, typename gcore::NoRefOrConst<T>::Type>::Do(val, dst);
-            return true;
+            return Convert<char*, TT>::Do(val, dst);
           }
           case AT_OBJECT: {
-            if (!Convertion<Object*, typename gcore::NoRefOrConst<T>::Type>::Possible()) {
-              err = "Invalid argument type (excepted ";
-              err += typeid(Object*).name();
-              err += " got ";
-              err += typeid(typename gcore::NoRefOrConst<T>::Type).name();
-              err += ")";
-              return false;
-            }
             lwc::Object *val = (lwc::Object*) src.ptr;
-            Convertion<Object*, typename gcore::NoRefOrConst<T>::Type>::Do(val, dst);
-            return true;
+            return Convert<Object*, TT>::Do(val, dst);
           }
           default:
-            err = "Invalid argument type";
-            return false;
+            return CE_TYPE;
         }
       }
-      static bool Set(const BaseArgument &arg, T src, ArgumentValue &dst, std::string &err) {
-        err = "";
+      static ConversionError Set(const BaseArgument &arg, T src, ArgumentValue &dst) {
         if (arg.indirectionLevel() != 0) {
-          err ="Expected 0 level of indirection";
-          return false;
+          return CE_INDIRECTION;
         }
         switch (arg.getType()) {
-          case AT_BOOL: {
-            if (!Convertion<typename gcore::NoRefOrConst<T>::Type, bool>::Possible()) {
-              err = "Invalid argument type (excepted ";
-              err += typeid(bool).name();
-              err += " got ";
-              err += typeid(typename gcore::NoRefOrConst<T>::Type).name();
-              err += ")";
-              return false;
-            }
-            Convertion<typename gcore::NoRefOrConst<T>::Type, bool>::Do(src, dst.boolean);
-            return true;
-          }
-          case AT_INT: {
-            if (!Convertion<typename gcore::NoRefOrConst<T>::Type, Integer>::Possible()) {
-              err = "Invalid argument type (excepted ";
-              err += typeid(Integer).name();
-              err += " got ";
-              err += typeid(typename gcore::NoRefOrConst<T>::Type).name();
-              err += ")";
-              return false;
-            }
-            Convertion<typename gcore::NoRefOrConst<T>::Type, Integer>::Do(src, dst.integer);
-            return true;
-          }
-          case AT_REAL: {
-            if (!Convertion<typename gcore::NoRefOrConst<T>::Type, Real>::Possible()) {
-              err = "Invalid argument type (excepted ";
-              err += typeid(Real).name();
-              err += " got ";
-              err += typeid(typename gcore::NoRefOrConst<T>::Type).name();
-              err += ")";
-              return false;
-            }
-            Convertion<typename gcore::NoRefOrConst<T>::Type, Real>::Do(src, dst.real);
-            return true;
-          }
+          case AT_BOOL:
+            return Convert<TT, bool>::Do(src, dst.boolean);
+          case AT_INT:
+            return Convert<TT, Integer>::Do(src, dst.integer);
+          case AT_REAL:
+            return Convert<TT, Real>::Do(src, dst.real);
           case AT_STRING: {
-            if (!Convertion<typename gcore::NoRefOrConst<T>::Type, char*>::Possible()) {
-              err = "Invalid argument type (excepted ";
-              err += typeid(char*).name();
-              err += " got ";
-              err += typeid(typename gcore::NoRefOrConst<T>::Type).name();
-              err += ")";
-              return false;
-            }
             char *val = 0;
-            Convertion<typename gcore::NoRefOrConst<T>::Type, char*>::Do(src, val);
-            dst.ptr = (void*) val;
-            return true;
+            ConversionError rv = Convert<TT, char*>::Do(src, val);
+            if (rv == CE_NONE) {
+              dst.ptr = (void*) val;
+            }
+            return rv;
           }
           case AT_OBJECT: {
-            if (!Convertion<typename gcore::NoRefOrConst<T>::Type, Object*>::Possible()) {
-              err = "Invalid argument type (excepted ";
-              err += typeid(Object*).name();
-              err += " got ";
-              err += typeid(typename gcore::NoRefOrConst<T>::Type).name();
-              err += ")";
-              return false;
-            }
             lwc::Object *val = 0;
-            Convertion<typename gcore::NoRefOrConst<T>::Type, Object*>::Do(src, val);
-            dst.ptr = (void*) val;
-            return true;
+            ConversionError rv = Convert<TT, Object*>::Do(src, val);
+            if (rv == CE_NONE) {
+              dst.ptr = (void*) val;
+            }
+            return rv;
           }
           default:
-            err = "Invalid argument type";
-            return false;
-        }
-      }
-    };
-    template <typename T> struct GetSet<T*> {
-      static bool Get(const BaseArgument &arg, const ArgumentValue &src, T* &dst, std::string &err) {
-        err = "";
-        // use typetraits?
-        if (arg.indirectionLevel() != 1) {
-          err ="Expected 1 level of indirection";
-          return false;
-        }
-        if (Type2Enum<T>::Enum != int(arg.getType())) {
-          err = "Invalid type";
-          return false;
-        }
-        // check constness?
-        dst = (T*) src.ptr;
-        return true;
-      }
-      static bool Set(const BaseArgument &arg, const T* src, ArgumentValue &dst, std::string &err) {
-        err = "";
-        // use typetraits?
-        if (arg.indirectionLevel() != 1) {
-          err ="Expected 1 level of indirection";
-          return false;
+            return CE_TYPE;
         }
-        if (Type2Enum<T>::Enum != int(arg.getType())) {
-          err = "Invalid type";
-          return false;
-        }
-        // check constness ?
-        dst.ptr = (void*) src;
-        return true;
-      }
-      static bool Set(const BaseArgument &arg, T* src, ArgumentValue &dst, std::string &err) {
-        return Set(arg, (const T*)src, dst, err);
       }
     };
-    template <typename T> struct GetSet<T**> {
-      static bool Get(const BaseArgument &arg, const ArgumentValue &src, T** &dst, std::string &err) {
-        err = "";
-        // use typetraits?
-        if (arg.indirectionLevel() != 2) {
-          err = "Expected 2 level of indirection";
-          return false;
-        }
-        if (Type2Enum<T>::Enum != int(arg.getType())) {
-          err = "Invalid type";
-          return false;
+    
+    // pointer types: value is passed through, only type and indirection are checked
+    template <typename T, int Indirection, int ArgType> struct GetSetPtr {
+      static ConversionError Get(const BaseArgument &arg, const ArgumentValue &src, T &dst) {
+        ConversionError rv = Check(arg, Indirection, ArgType);
+        if (rv == CE_NONE) {
+          // check constness?
+          dst = (T) src.ptr;
         }
-        // check constness?
-        dst = (T**) src.ptr;
-        return true;
+        return rv;
       }
-      static bool Set(const BaseArgument &arg, const T** src, ArgumentValue &dst, std::string &err) {
-        err = "";
-        // use typetraits?
-        if (arg.indirectionLevel() != 2) {
-          err = "Expected 2 level of indirection";
-          return false;
-        }
-        if (Type2Enum<T>::Enum != int(arg.getType())) {
-          err = "Invalid type";
-          return false;
+      static ConversionError Set(const BaseArgument &arg, const void *src, ArgumentValue &dst) {
+        ConversionError rv = Check(arg, Indirection, ArgType);
+        if (rv == CE_NONE) {
+          // check constness?
+          dst.ptr = (void*) src;
         }
-        // check constness?
-        dst.ptr = (void*) src;
-        return true;
-      }
-      static bool Set(const BaseArgument &arg, T** src, ArgumentValue &dst, std::string &err) {
-        return Set(arg, (const T**)src, dst, err);
+        return rv;
       }
     };
     
+    template <typename T> struct GetSet<T*> : public GetSetPtr<T*, 1, Type2Enum<T>::Enum> {};
+    template <typename T> struct GetSet<T**> : public GetSetPtr<T**, 2, Type2Enum<T>::Enum> {};
+    
     // string special case
-    template <> struct GetSet<char*> {
-      static bool Get(const BaseArgument &arg, const ArgumentValue &src, char* &dst, std::string &err) {
-        err = "";
-        // use typetraits?
-        if (arg.indirectionLevel() != 0) {
-          err = "Expected 0 level of indirection";
-          return false;
-        }
-        if (arg.getType () != AT_STRING) {
-          err = "Invalid type";
-          return false;
-        }
-        // check constness?
-        dst = (char*) src.ptr;
-        return true;
-      }
-      static bool Set(const BaseArgument &arg, const char* src, ArgumentValue &dst, std::string &err) {
-        err = "";
-        // use typetraits?
-        if (arg.indirectionLevel() != 0) {
-          err = "Expected 0 level of indirection";
-          return false;
-        }
-        if (arg.getType() != AT_STRING) {
-          err = "Invalid type";
-          return false;
-        }
-        // check constness?
-        dst.ptr = (void*) src;
-        return true;
-      }
-      static bool Set(const BaseArgument &arg, char* src, ArgumentValue &dst, std::string &err) {
-        return Set(arg, (const char*)src, dst, err);
-      }
-    };
-    template <> struct GetSet<char**> {
-      static bool Get(const BaseArgument &arg, const ArgumentValue &src, char** &dst, std::string &err) {
-        err = "";
-        // use typetraits?
-        if (arg.indirectionLevel() != 1) {
-          err = "Expected 1 level of indirection";
-          return false;
-        }
-        if (arg.getType () != AT_STRING) {
-          err = "Invalid type";
-          return false;
-        }
-        // check constness?
-        dst = (char**) src.ptr;
-        return true;
-      }
-      static bool Set(const BaseArgument &arg, const char** src, ArgumentValue &dst, std::string &err) {
-        err = "";
-        // use typetraits?
-        if (arg.indirectionLevel() != 1) {
-          err = "Expected 1 level of indirection";
-          return false;
-        }
-        if (arg.getType() != AT_STRING) {
-          err = "Invalid type";
-          return false;
-        }
-        // check constness?
-        dst.ptr = (void*) src;
-        return true;
-      }
-      static bool Set(const BaseArgument &arg, char** src, ArgumentValue &dst, std::string &err) {
-        return Set(arg, (const char**)src, dst, err);
-      }
-    };
-    template <> struct GetSet<char***> {
-      static bool Get(const BaseArgument &arg, const ArgumentValue &src, char*** &dst, std::string &err) {
-        err = "";
-        // use typetraits?
-        if (arg.indirectionLevel() != 2) {
-          err = "Expected 2 level of indirection";
-          return false;
-        }
-        if (arg.getType () != AT_STRING) {
-          err = "Invalid type";
-          return false;
-        }
-        // check constness?
-        dst = (char***) src.ptr;
-        return true;
-      }
-      static bool Set(const BaseArgument &arg, const char*** src, ArgumentValue &dst, std::string &err) {
-        err = "";
-        // use typetraits?
-        if (arg.indirectionLevel() != 2) {
-          err = "Expected 2 level of indirection";
-          return false;
-        }
-        if (arg.getType() != AT_STRING) {
-          err = "Invalid type";
-          return false;
-        }
-        // check constness?
-        dst.ptr = (void*) src;
-        return true;
-      }
-      static bool Set(const BaseArgument &arg, char*** src, ArgumentValue &dst, std::string &err) {
-        return Set(arg, (const char***)src, dst, err);
-      }
-    };
+    template <> struct GetSet<char*> : public GetSetPtr<char*, 0, AT_STRING> {};
+    template <> struct GetSet<char**> : public GetSetPtr<char**, 1, AT_STRING> {};
+    template <> struct GetSet<char***> : public GetSetPtr<char***, 2, AT_STRING> {};
     
     // object special case
-    template <> struct GetSet<Object*> {
-      static bool Get(const BaseArgument &arg, const ArgumentValue &src, Object* &dst, std::string &err) {
-        err = "";
-        // use typetraits?
-        if (arg.indirectionLevel() != 0) {
-          err = "Expected 0 level of indirection";
-          return false;
-        }
-        if (arg.getType() != AT_OBJECT) {
-          err = "Invalid type";
-          return false;
-        }
-        // check constness?
-        dst = (Object*) src.ptr;
-        return true;
-      }
-      static bool Set(const BaseArgument &arg, const Object* src, ArgumentValue &dst, std::string &err) {
-        err = "";
-        // use typetraits?
-        if (arg.indirectionLevel() != 0) {
-          err = "Expected 0 level of indirection";
-          return false;
-        }
-        if (arg.getType() != AT_OBJECT) {
-          err = "Invalid type";
-          return false;
-        }
-        // check constness?
-        dst.ptr = (void*) src;
-        return true;
-      }
-      static bool Set(const BaseArgument &arg, Object* src, ArgumentValue &dst, std::string &err) {
-        return Set(arg, (const Object*)src, dst, err);
-      }
-    };
-    template <> struct GetSet<Object**> {
-      static bool Get(const BaseArgument &arg, const ArgumentValue &src, Object** &dst, std::string &err) {
-        err = "";
-        // use typetraits?
-        if (arg.indirectionLevel() != 1) {
-          err = "Expected 1 level of indirection";
-          return false;
-        }
-        if (arg.getType() != AT_OBJECT) {
-          err = "Invalid type";
-          return false;
-        }
-        // check constness?
-        dst = (Object**) src.ptr;
-        return true;
-      }
-      static bool Set(const BaseArgument &arg, const Object** src, ArgumentValue &dst, std::string &err) {
-        err = "";
-        // use typetraits?
-        if (arg.indirectionLevel() != 1) {
-          err = "Expected 1 level of indirection";
-          return false;
-        }
-        if (arg.getType() != AT_OBJECT) {
-          err = "Invalid type";
-          return false;
-        }
-        // check constness?
-        dst.ptr = (void*) src;
-        return true;
-      }
-      static bool Set(const BaseArgument &arg, Object** src, ArgumentValue &dst, std::string &err) {
-        return Set(arg, (const Object**)src, dst, err);
-      }
-    };
-    template <> struct GetSet<Object***> {
-      static bool Get(const BaseArgument &arg, const ArgumentValue &src, Object*** &dst, std::string &err) {
-        err = "";
-        // use typetraits?
-        if (arg.indirectionLevel() != 2) {
-          err = "Expected 2 level of indirection";
-          return false;
-        }
-        if (arg.getType() != AT_OBJECT) {
-          err = "Invalid type";
-          return false;
-        }
-        // check constness?
-        dst = (Object***) src.ptr;
-        return true;
-      }
-      static bool Set(const BaseArgument &arg, const Object*** src, ArgumentValue &dst, std::string &err) {
-        err = "";
-        // use typetraits?
-        if (arg.indirectionLevel() != 2) {
-          err = "Expected 2 level of indirection";
-          return false;
-        }
-        if (arg.getType() != AT_OBJECT) {
-          err = "Invalid type";
-          return false;
-        }
-        // check constness?
-        dst.ptr = (void*) src;
-        return true;
-      }
-      static bool Set(const BaseArgument &arg, Object*** src, ArgumentValue &dst, std::string &err) {
-        return Set(arg, (const Object***)src, dst, err);
-      }
-    };
+    template <> struct GetSet<Object*> : public GetSetPtr<Object*, 0, AT_OBJECT> {};
+    template <> struct GetSet<Object**> : public GetSetPtr<Object**, 1, AT_OBJECT> {};
+    template <> struct GetSet<Object***> : public GetSetPtr<Object***, 2, AT_OBJECT> {};
     
     // empty special case
     template <> struct GetSet<Empty> {
-      static bool Get(const BaseArgument &, const ArgumentValue &, Empty &, std::string &err) {
-        err = "Empty is not a valid argument type";
-        return false;
-      }
-      static bool Set(const BaseArgument &, const Empty &, ArgumentValue &, std::string &err) {
-        err = "Empty is not a valid argument type";
-        return false;
+      static ConversionError Get(const BaseArgument &, const ArgumentValue &, Empty &) {
+        return CE_EMPTY;
       }
-      static bool Set(const BaseArgument &, Empty &, ArgumentValue &, std::string &err) {
-        err = "Empty is not a valid argument type";
-        return false;
+      static ConversionError Set(const BaseArgument &, const Empty &, ArgumentValue &) {
+        return CE_EMPTY;
       }
     };
     
@@ -683,6 +372,8 @@ namespace lwc {
       using Super::end;
       using Super::find;
       using Super::clear;
+      using Super::empty;
+      using Super::size;
       
       KeywordArgs() {
       }
@@ -777,10 +468,10 @@ namespace lwc {
   
   template <typename T>
   BaseArgument& BaseArgument::setValue(T val) throw(std::runtime_error) {
-    std::string err;
-    if (!details::GetSet<typename gcore::NoRefOrConst<T>::Type>::Set(*this, val, mValue, err)) {
+    ConversionError err = details::GetSet<typename gcore::NoRefOrConst<T>::Type>::Set(*this, val, mValue);
+    if (err != CE_NONE) {
       std::ostringstream oss;
-      oss << "BaseArgument::setValue: " << err;
+      oss << "BaseArgument::setValue: " << ConversionErrorString(err);
       throw std::runtime_error(oss.str());
     }
     return *this;
@@ -788,10 +479,10 @@ namespace lwc {
   
   template <typename T>
   void BaseArgument::getValue(T &val) const throw(std::runtime_error)  {
-    std::string err;
-    if (!details::GetSet<typename gcore::NoRefOrConst<T>::Type>::Get(*this, mValue, val, err)) {
+    ConversionError err = details::GetSet<typename gcore::NoRefOrConst<T>::Type>::Get(*this, mValue, val);
+    if (err != CE_NONE) {
       std::ostringstream oss;
-      oss << "BaseArgument::getValue: " << err;
+      oss << "BaseArgument::getValue: " << ConversionErrorString(err);
       throw std::runtime_error(oss.str());
     }
   }
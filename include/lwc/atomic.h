@@ -0,0 +1,178 @@
+/*
+
+Copyright (C) 2009, 2010  Gaetan Guidet
+
+This file is part of lwc.
+
+lwc is free software; you can redistribute it and/or modify it
+under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 2.1 of the License, or (at
+your option) any later version.
+
+lwc is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+USA.
+
+*/
+
+#ifndef __lwc_atomic_h__
+#define __lwc_atomic_h__
+
+#include <lwc/config.h>
+#ifdef _MSC_VER
+# include <intrin.h>
+#endif
+
+namespace lwc {
+  
+  // Minimal atomic operations on longs and pointers: read-modify-write
+  // operations are full barriers, loads have acquire and stores release
+  // semantics. LoadSeqCst is ordered with the preceding read-modify-write
+  // operations (sleep/wake up handshakes)
+  namespace atomic {
+    
+#if defined(_MSC_VER)
+    
+    inline long Increment(volatile long *v) {
+      return _InterlockedIncrement(v);
+    }
+    
+    inline long Decrement(volatile long *v) {
+      return _InterlockedDecrement(v);
+    }
+    
+    inline bool CompareExchange(volatile long *v, long expected, long desired) {
+      return (_InterlockedCompareExchange(v, desired, expected) == expected);
+    }
+    
+    inline long Load(const volatile long *v) {
+      long rv = *v;
+      _ReadWriteBarrier();
+      return rv;
+    }
+    
+    inline long LoadSeqCst(const volatile long *v) {
+      return _InterlockedOr(const_cast<volatile long*>(v), 0);
+    }
+    
+    inline void Store(volatile long *v, long value) {
+      _ReadWriteBarrier();
+      *v = value;
+    }
+    
+    inline void* ExchangePointer(void * volatile *p, void *value) {
+      return _InterlockedExchangePointer(p, value);
+    }
+    
+    inline void* LoadPointer(void * const volatile *p) {
+      void *rv = *p;
+      _ReadWriteBarrier();
+      return rv;
+    }
+    
+    inline void StorePointer(void * volatile *p, void *value) {
+      _ReadWriteBarrier();
+      *p = value;
+    }
+    
+#elif defined(__ATOMIC_SEQ_CST)
+    
+    inline long Increment(volatile long *v) {
+      return __atomic_add_fetch(v, 1, __ATOMIC_SEQ_CST);
+    }
+    
+    inline long Decrement(volatile long *v) {
+      return __atomic_sub_fetch(v, 1, __ATOMIC_SEQ_CST);
+    }
+    
+    inline bool CompareExchange(volatile long *v, long expected, long desired) {
+      return __atomic_compare_exchange_n(v, &expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+    }
+    
+    inline long Load(const volatile long *v) {
+      return __atomic_load_n(v, __ATOMIC_ACQUIRE);
+    }
+    
+    inline long LoadSeqCst(const volatile long *v) {
+      return __atomic_load_n(v, __ATOMIC_SEQ_CST);
+    }
+    
+    inline void Store(volatile long *v, long value) {
+      __atomic_store_n(v, value, __ATOMIC_RELEASE);
+    }
+    
+    inline void* ExchangePointer(void * volatile *p, void *value) {
+      return __atomic_exchange_n(p, value, __ATOMIC_SEQ_CST);
+    }
+    
+    inline void* LoadPointer(void * const volatile *p) {
+      return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+    }
+    
+    inline void StorePointer(void * volatile *p, void *value) {
+      __atomic_store_n(p, value, __ATOMIC_RELEASE);
+    }
+    
+#else
+    
+    // older gcc: __sync builtins
+    
+    inline long Increment(volatile long *v) {
+      return __sync_add_and_fetch(v, 1);
+    }
+    
+    inline long Decrement(volatile long *v) {
+      return __sync_sub_and_fetch(v, 1);
+    }
+    
+    inline bool CompareExchange(volatile long *v, long expected, long desired) {
+      return __sync_bool_compare_and_swap(v, expected, desired);
+    }
+    
+    inline long Load(const volatile long *v) {
+      long rv = *v;
+      __sync_synchronize();
+      return rv;
+    }
+    
+    inline long LoadSeqCst(const volatile long *v) {
+      __sync_synchronize();
+      long rv = *v;
+      __sync_synchronize();
+      return rv;
+    }
+    
+    inline void Store(volatile long *v, long value) {
+      __sync_synchronize();
+      *v = value;
+    }
+    
+    inline void* ExchangePointer(void * volatile *p, void *value) {
+      __sync_synchronize();
+      return __sync_lock_test_and_set(p, value);
+    }
+    
+    inline void* LoadPointer(void * const volatile *p) {
+      void *rv = *p;
+      __sync_synchronize();
+      return rv;
+    }
+    
+    inline void StorePointer(void * volatile *p, void *value) {
+      __sync_synchronize();
+      *p = value;
+    }
+    
+#endif
+    
+  }
+  
+}
+
+#endif
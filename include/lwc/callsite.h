@@ -0,0 +1,158 @@
+/*
+
+Copyright (C) 2009, 2010  Gaetan Guidet
+
+This file is part of lwc.
+
+lwc is free software; you can redistribute it and/or modify it
+under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 2.1 of the License, or (at
+your option) any later version.
+
+lwc is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+USA.
+
+*/
+
+#ifndef __lwc_callsite_h__
+#define __lwc_callsite_h__
+
+#include <lwc/method.h>
+
+namespace lwc {
+  
+  // Method call binding precompiled for a given call shape: number of positional
+  // values and names of the keyword arguments. Keyword slots, arguments to fill
+  // with their default value and keyword value conversions are computed once so
+  // that calls with the same shape only copy values into the parameter slots.
+  class LWC_API CallSite {
+    public:
+      
+      enum Binding {
+        // positional values map to method arguments in order (C++ calls)
+        CSB_NATIVE = 0,
+        // output and array size arguments are not passed by the caller
+        // (language bridges)
+        CSB_SCRIPT
+      };
+      
+      CallSite();
+      // Native call site for the given number of positional arguments and keyword
+      // arguments (only the keyword names and value types matter)
+      CallSite(const MethodHandle &handle, size_t nargs, const KeywordArgs &kwargs=NoKeywordArgs) throw(std::runtime_error);
+      CallSite(const CallSite &rhs);
+      ~CallSite();
+      
+      CallSite& operator=(const CallSite &rhs);
+      
+      // keywords must be sorted (strcmp order, as in KeywordArgs)
+      bool compile(const MethodHandle &handle, size_t nargs, const char **keywords, size_t nkeywords,
+                   Binding binding, Status &status);
+      
+      bool compile(const MethodHandle &handle, size_t nargs, const KeywordArgs &kwargs, Status &status);
+      
+      bool matches(const MethodsTable *table, const char *name, size_t nargs,
+                   const char **keywords, size_t nkeywords, Binding binding) const;
+      
+      // Set keyword and default values for a native call with this site shape
+      bool bind(MethodParams &params, size_t nargs, const KeywordArgs &kwargs, Status &status) const;
+      
+      inline bool isValid() const {
+        return mHandle.isValid();
+      }
+      
+      inline const MethodHandle& getHandle() const {
+        return mHandle;
+      }
+      
+      inline const char* getName() const {
+        return mHandle.getName();
+      }
+      
+      inline Binding getBinding() const {
+        return mBinding;
+      }
+      
+      inline size_t numArgs() const {
+        return mNumArgs;
+      }
+      
+      inline size_t numKeywords() const {
+        return mKeywords.size();
+      }
+      
+      inline const char* getKeyword(size_t k) const {
+        return mKeywords[k].c_str();
+      }
+      
+      // method argument index set by keyword k
+      inline size_t getKeywordSlot(size_t k) const {
+        return mKeywordSlots[k];
+      }
+      
+      // bit i set if argument i takes its default value
+      inline unsigned long defaultArgsMask() const {
+        return mDefaults;
+      }
+      
+      // Arguments the language bridges fill by themselves (outputs, return
+      // value and array sizes)
+      static unsigned long ImplicitArgs(const Method &m);
+      
+    protected:
+      
+      enum Conversion {
+        CONV_NONE = 0,
+        CONV_INT_TO_REAL,
+        CONV_REAL_TO_INT
+      };
+      
+      MethodHandle mHandle;
+      Binding mBinding;
+      size_t mNumArgs;
+      unsigned long mDefaults;
+      std::vector<std::string> mKeywords;
+      size_t mKeywordSlots[LWC_MAX_ARGS];
+      // keyword value types (native call sites built from KeywordArgs only)
+      bool mTyped;
+      Type mKeywordTypes[LWC_MAX_ARGS];
+      int mKeywordIndirections[LWC_MAX_ARGS];
+      Conversion mKeywordConversions[LWC_MAX_ARGS];
+  };
+  
+  // Small most recently compiled call sites cache for the language bridges
+  class LWC_API CallSiteCache {
+    public:
+      
+      CallSiteCache(size_t capacity=8);
+      ~CallSiteCache();
+      
+      const CallSite* get(const MethodsTable *table, const char *name, size_t nargs,
+                          const char **keywords, size_t nkeywords,
+                          CallSite::Binding binding, Status &status);
+      
+      void clear();
+      
+    private:
+      
+      CallSiteCache(const CallSiteCache&);
+      CallSiteCache& operator=(const CallSiteCache&);
+      
+    private:
+      
+      std::vector<CallSite> mSites;
+      size_t mCapacity;
+      size_t mNext;
+  };
+  
+}
+
+#endif
+
@@ -0,0 +1,123 @@
+/*
+
+Copyright (C) 2009, 2010  Gaetan Guidet
+
+This file is part of lwc.
+
+lwc is free software; you can redistribute it and/or modify it
+under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 2.1 of the License, or (at
+your option) any later version.
+
+lwc is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+USA.
+
+*/
+
+#ifndef __lwc_capi_h__
+#define __lwc_capi_h__
+
+/* Flat C interface to the registry for FFI hosts (LuaJIT ffi, ctypes, cffi).
+ * No function raises an exception: failures are reported by the returned
+ * error code (lwc::ErrorCode values) or a null pointer, and the message of
+ * the last failure is available through lwc_last_error.
+ * This header is valid C and C++ and does not include any other lwc header.
+ */
+
+#include <stddef.h>
+
+#ifdef _WIN32
+# ifdef LWC_EXPORTS
+#   define LWC_CAPI __declspec(dllexport)
+# else
+#   define LWC_CAPI __declspec(dllimport)
+# endif
+#else
+# define LWC_CAPI
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* same definition as lwc::Integer */
+#if defined(__LP64__) || defined(_LP64) || (_MIPS_SZLONG == 64) || (__WORDSIZE == 64)
+typedef long lwc_integer;
+#elif defined(_MSC_VER) || (defined(__BCPLUSPLUS__) && __BORLANDC__ > 0x500) || defined(__WATCOM_INT64__)
+typedef __int64 lwc_integer;
+#else
+typedef long long lwc_integer;
+#endif
+
+/* Layout of lwc::ArgumentValue: one value per method argument, in the order
+ * of the declaration. Arguments follow the MethodParams conventions:
+ *   in      value (strings and objects as pointers)
+ *   out     pointer to the variable receiving the value
+ *   inout   pointer to the variable holding the value
+ *   return  slot receiving the value itself once lwc_call succeeded
+ * The slots are used as is, without any conversion: the caller guarantees
+ * that each slot holds the member matching the argument type (see
+ * lwc_method_arg_type). lwc_call only rejects null out/inout pointers and
+ * in booleans other than 0 or 1 (EC_ARGUMENT_TYPE)
+ */
+typedef union {
+  void *ptr;
+  double real;
+  lwc_integer integer;
+  unsigned char boolean;
+} lwc_value;
+
+typedef struct lwc_registry lwc_registry;
+typedef struct lwc_object lwc_object;
+typedef struct lwc_method lwc_method;
+
+/* Registry */
+
+LWC_CAPI lwc_registry* lwc_registry_create(void);
+LWC_CAPI void lwc_registry_destroy(lwc_registry *reg);
+LWC_CAPI int lwc_registry_add_loader_path(lwc_registry *reg, const char *path);
+LWC_CAPI int lwc_registry_add_module_path(lwc_registry *reg, const char *path);
+LWC_CAPI int lwc_registry_has_type(lwc_registry *reg, const char *type);
+
+/* Objects */
+
+LWC_CAPI lwc_object* lwc_object_create(lwc_registry *reg, const char *type);
+LWC_CAPI void lwc_object_destroy(lwc_registry *reg, lwc_object *obj);
+LWC_CAPI const char* lwc_object_type(const lwc_object *obj);
+
+/* Methods: handles are resolved once per type and method name, and are
+ * valid for any object of that type until lwc_method_release */
+
+LWC_CAPI lwc_method* lwc_method_lookup(lwc_registry *reg, const char *type, const char *name);
+LWC_CAPI void lwc_method_release(lwc_method *method);
+LWC_CAPI size_t lwc_method_num_args(const lwc_method *method);
+/* lwc::Type value of the argument, -1 if out of range */
+LWC_CAPI int lwc_method_arg_type(const lwc_method *method, size_t i);
+/* lwc::Direction value of the argument, -1 if out of range */
+LWC_CAPI int lwc_method_arg_dir(const lwc_method *method, size_t i);
+
+/* Calls: nargs must be the method number of arguments, no default value
+ * is applied. Returns 0 on success, the lwc::ErrorCode of the failure
+ * otherwise */
+
+LWC_CAPI int lwc_call(lwc_object *obj, const lwc_method *method, lwc_value *args, size_t nargs);
+
+/* Errors: copy the message of the last failure of any function above in
+ * the calling thread to buf, truncated to size-1 characters.
+ * Messages are kept per thread and limited to 1023 characters.
+ * Returns the length of the stored message */
+
+LWC_CAPI size_t lwc_last_error(char *buf, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
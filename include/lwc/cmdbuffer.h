@@ -0,0 +1,286 @@
+/*
+
+Copyright (C) 2009, 2010  Gaetan Guidet
+
+This file is part of lwc.
+
+lwc is free software; you can redistribute it and/or modify it
+under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 2.1 of the License, or (at
+your option) any later version.
+
+lwc is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+USA.
+
+*/
+
+#ifndef __lwc_cmdbuffer_h__
+#define __lwc_cmdbuffer_h__
+
+#include <lwc/object.h>
+#include <lwc/memory.h>
+
+namespace lwc {
+  
+  // Recorded sequence of calls replayed in one go (see submit). Each command
+  // owns its parameters, a copy of its input strings and the storage of its
+  // output values so that a buffer can be submitted again, with the same or
+  // updated inputs. Only the input and in/out argument values are set, in
+  // declaration order, missing ones take their default value. In/out values
+  // are updated by each submit (the next one starts from the last output).
+  // Array and in/out string arguments are not supported.
+  // Output strings returned by the calls are owned by the buffer and released
+  // by the next submit or clear. The recorded objects must outlive the buffer.
+  class LWC_API CommandBuffer {
+    public:
+      
+      CommandBuffer();
+      ~CommandBuffer();
+      
+      inline size_t size() const {
+        return mCommands.size();
+      }
+      
+      // number of commands that completed during the last submit
+      inline size_t numCompleted() const {
+        return mCompleted;
+      }
+      
+      // index of the command that failed the last submit (size() if none)
+      inline size_t failedCommand() const {
+        return mFailed;
+      }
+      
+      void clear();
+      
+      // Append a call of target on o and return the command index
+      size_t record(Object *o, const CallTarget &target) throw(std::runtime_error);
+      
+      bool tryRecord(Object *o, const CallTarget &target, size_t &index, Status &status);
+      
+      // Remove the last recorded command (releases the outputs)
+      void pop();
+      
+      Object* getObject(size_t cmd) const throw(std::runtime_error);
+      
+      const char* getName(size_t cmd) const throw(std::runtime_error);
+      
+      const Method& getMethod(size_t cmd) const throw(std::runtime_error);
+      
+      // Set input k (k-th in or in/out argument) of command cmd
+      template <typename T>
+      bool trySetInput(size_t cmd, size_t k, T value, Status &status) {
+        Command *c = command(cmd, status);
+        size_t i = 0;
+        if (!c || !inputArg(*c, k, i, status)) {
+          return false;
+        }
+        const Argument &arg = c->params.getMethod()[i];
+        if (arg.getDir() == AD_IN) {
+          if (!c->params.trySet(i, value, status, false)) {
+            status.setMethodName(c->name);
+            return false;
+          }
+        } else {
+          BaseArgument va(AD_IN, arg.getType());
+          if (details::GetSet<typename gcore::NoRefOrConst<T>::Type>::Set(va, value, mValues[c->values+i]) != CE_NONE) {
+            status.set(EC_ARGUMENT_TYPE, c->name, long(i));
+            return false;
+          }
+        }
+        c->inputs |= (1UL << k);
+        return true;
+      }
+      
+      // strings are copied
+      bool trySetInput(size_t cmd, size_t k, const char *value, Status &status);
+      
+      inline bool trySetInput(size_t cmd, size_t k, char *value, Status &status) {
+        return trySetInput(cmd, k, (const char*)value, status);
+      }
+      
+      template <typename T>
+      void setInput(size_t cmd, size_t k, T value) throw(std::runtime_error) {
+        Status status;
+        if (!trySetInput(cmd, k, value, status)) {
+          throw std::runtime_error(status.getMessage());
+        }
+      }
+      
+      // Call the commands in record order. Nothing is called if a command has
+      // a missing input, the sequence stops at the first failed call
+      Status trySubmit();
+      
+      void submit() throw(std::runtime_error);
+      
+      // Read an output, in/out or return argument value of a completed command
+      template <typename T>
+      T get(size_t cmd, size_t i) const throw(std::runtime_error) {
+        BaseArgument arg;
+        const ArgumentValue &value = output(cmd, i, arg);
+        T rv;
+        ConversionError err = details::GetSet<typename gcore::NoRefOrConst<T>::Type>::Get(arg, value, rv);
+        if (err != CE_NONE) {
+          std::ostringstream oss;
+          oss << "CommandBuffer::get: Command " << cmd << ", method argument " << i << ": " << ConversionErrorString(err);
+          throw std::runtime_error(oss.str());
+        }
+        return rv;
+      }
+      
+      template <typename T>
+      T getReturn(size_t cmd) const throw(std::runtime_error) {
+        if (!getMethod(cmd).hasReturn()) {
+          throw std::runtime_error("CommandBuffer::getReturn: Method has no return argument");
+        }
+        return get<T>(cmd, size_t(getMethod(cmd).returnArg()));
+      }
+      
+    private:
+      
+      CommandBuffer(const CommandBuffer&);
+      CommandBuffer& operator=(const CommandBuffer&);
+      
+      struct Command {
+        Object *object;
+        // owned by the object methods table
+        const char *name;
+        MethodParams params;
+        // index of the first argument value in mValues
+        size_t values;
+        // mask of the inputs set
+        unsigned long inputs;
+        
+        Command(Object *o, const char *n, const Method &m, size_t v);
+      };
+      
+      Command* command(size_t cmd, Status &status);
+      
+      const Command& command(size_t cmd) const throw(std::runtime_error);
+      
+      bool inputArg(const Command &c, size_t k, size_t &i, Status &status) const;
+      
+      // Check for missing inputs and point the parameters to the command
+      // strings and output values (mValues may have been reallocated)
+      bool bind(Command &c, Status &status);
+      
+      const ArgumentValue& output(size_t cmd, size_t i, BaseArgument &arg) const throw(std::runtime_error);
+      
+      // free the output strings of the completed commands
+      void releaseOutputs();
+      
+    private:
+      
+      std::vector<Command> mCommands;
+      // output and in/out values of all commands
+      std::vector<ArgumentValue> mValues;
+      // input string copies, parallel to mValues
+      std::vector<std::string> mStrings;
+      size_t mCompleted;
+      size_t mFailed;
+  };
+  
+  // Language bridge side of the command buffers, B describes the bridge values
+  // as for Marshal (Get also has to handle Object*, Value char* and Object*)
+  template <class B>
+  struct CommandBridge {
+    
+    typedef typename B::Args Args;
+    typedef typename B::Result Result;
+    
+    // Record a call of name on o, the inputs are the bridge values from first
+    // to Count(args)
+    static bool Record(CommandBuffer &buffer, Object *o, const char *name, Args args, size_t first,
+                       size_t &index, Status &status) {
+      if (!buffer.tryRecord(o, name, index, status)) {
+        return false;
+      }
+      size_t n = B::Count(args);
+      const Method &meth = buffer.getMethod(index);
+      size_t k = 0;
+      for (size_t i=0; i<meth.numArgs(); ++i) {
+        const Argument &arg = meth[i];
+        if (arg.getDir() != AD_IN && arg.getDir() != AD_INOUT) {
+          continue;
+        }
+        if (first + k < n) {
+          bool ok = false;
+          switch (arg.getType()) {
+            case AT_BOOL:
+              ok = SetInput<bool>(buffer, index, k, args, first+k, status);
+              break;
+            case AT_INT:
+              ok = SetInput<Integer>(buffer, index, k, args, first+k, status);
+              break;
+            case AT_REAL:
+              ok = SetInput<Real>(buffer, index, k, args, first+k, status);
+              break;
+            case AT_STRING:
+              ok = SetInput<char*>(buffer, index, k, args, first+k, status);
+              break;
+            default:
+              ok = SetInput<Object*>(buffer, index, k, args, first+k, status);
+          }
+          if (!ok) {
+            if (status.succeeded()) {
+              status.set(EC_ARGUMENT_TYPE, buffer.getName(index), long(i));
+            }
+            buffer.pop();
+            return false;
+          }
+        }
+        ++k;
+      }
+      if (first + k < n) {
+        status.set(EC_ARGUMENT_COUNT, buffer.getName(index), -1, 0, long(k));
+        buffer.pop();
+        return false;
+      }
+      return true;
+    }
+    
+    // Bridge value of argument i of a completed command
+    static Result Output(const CommandBuffer &buffer, size_t cmd, size_t i, Args args) {
+      switch (buffer.getMethod(cmd)[i].getType()) {
+        case AT_BOOL:
+          return B::Value(args, buffer.get<bool>(cmd, i));
+        case AT_INT:
+          return B::Value(args, buffer.get<Integer>(cmd, i));
+        case AT_REAL:
+          return B::Value(args, buffer.get<Real>(cmd, i));
+        case AT_STRING:
+          return B::Value(args, buffer.get<char*>(cmd, i));
+        default:
+          return B::Value(args, buffer.get<Object*>(cmd, i));
+      }
+    }
+    
+  private:
+    
+    template <typename T>
+    static bool SetInput(CommandBuffer &buffer, size_t cmd, size_t k, Args args, size_t j, Status &status) {
+      T val;
+      if (!B::Get(args, j, val)) {
+        return false;
+      }
+      bool rv = buffer.trySetInput(cmd, k, val, status);
+      Release(val);
+      return rv;
+    }
+    
+    // strings are copied by Get (see Marshal)
+    template <typename T>
+    static inline void Release(T &) {}
+    static inline void Release(char* &val) {if (val) memory::Free((void*)val);}
+  };
+  
+}
+
+#endif
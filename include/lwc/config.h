@@ -34,6 +34,13 @@ USA.
 # define LWC_API
 #endif
 
+// storage class for per thread POD variables
+#ifdef _MSC_VER
+# define LWC_THREAD_LOCAL __declspec(thread)
+#else
+# define LWC_THREAD_LOCAL __thread
+#endif
+
 #ifdef _MSC_VER
 // 4290: warning for exception specification (not supported by msvc)
 // 4251: warning for un-exported template typess
@@ -24,7 +24,7 @@ USA.
 #ifndef __lwc_factory_h__
 #define __lwc_factory_h__
 
-#include <lwc/object.h>
+#include <lwc/pool.h>
 
 namespace lwc {
   
@@ -40,6 +40,40 @@ namespace lwc {
       virtual bool isSingleton(const char *typeName) = 0;
       virtual const char* getDescription(const char *typeName) = 0;
       virtual std::string docString(const char *n, const std::string &indent="") = 0;
+      
+      // Instance pools: up to maxSize destroyed instances of typeName are kept
+      // for reuse by create (see Object::recycle), maxSize 0 removes the pool.
+      // warmUp instances (at least one, to check the type) are created upfront.
+      // Fails for unknown and singleton types and if recycle is refused, an
+      // existing pool is then left as it was. Loaders with a mailbox must be
+      // called on its thread (see Registry::setPool)
+      bool setPool(const char *typeName, size_t maxSize, size_t warmUp=0);
+      bool getPoolStats(const char *typeName, PoolStats &stats) const;
+      
+    protected:
+      
+      // For create and destroy implementations: pooled instance of typeName
+      // (0 if one must be allocated), and whether o was kept (delete it otherwise)
+      inline Object* acquire(const char *typeName) {
+        return (mPools.empty() ? 0 : acquirePooled(typeName));
+      }
+      
+      inline bool release(Object *o) {
+        return (!mPools.empty() && releasePooled(o));
+      }
+      
+    private:
+      
+      Factory(const Factory&);
+      Factory& operator=(const Factory&);
+      
+      Object* acquirePooled(const char *typeName);
+      bool releasePooled(Object *o);
+      
+    private:
+      
+      // type name -> pool, pooled instances are deleted with the factory
+      std::map<std::string, ObjectPool*> mPools;
   };
   
 }
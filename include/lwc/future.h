@@ -0,0 +1,271 @@
+/*
+
+Copyright (C) 2009, 2010  Gaetan Guidet
+
+This file is part of lwc.
+
+lwc is free software; you can redistribute it and/or modify it
+under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 2.1 of the License, or (at
+your option) any later version.
+
+lwc is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+USA.
+
+*/
+
+#ifndef __lwc_future_h__
+#define __lwc_future_h__
+
+#include <lwc/parallel.h>
+
+namespace lwc {
+  
+  // Pending asynchronous call (see Object::callAsync). The future owns the
+  // call parameters and the storage of the output, in/out and return values,
+  // input strings are copied. In/out strings and arrays are not supported.
+  // Objects allowing concurrent calls run on the registry thread pool, the
+  // other ones (script objects) are only called from their interpreter
+  // thread: a pool worker forwards the call when the object mailbox has its
+  // own thread (see Registry::setLoaderMailbox), otherwise the call completes
+  // in callAsync on the calling thread, as a synchronous call would.
+  // Concurrent calls on the same object are the caller responsibility.
+  // Deleting a future waits for the call.
+  class LWC_API Future {
+    public:
+      
+      // Argument pack of Object::callAsync (unused slots are Empty)
+      template <typename T0=Empty, typename T1=Empty, typename T2=Empty, typename T3=Empty,
+                typename T4=Empty, typename T5=Empty, typename T6=Empty, typename T7=Empty>
+      struct Call {
+        
+        enum {
+          Arity = details::CallArity<T0, T1, T2, T3, T4, T5, T6, T7,
+                                     Empty, Empty, Empty, Empty, Empty, Empty, Empty, Empty>::Value
+        };
+        
+        static Future* Start(Object *self, const CallTarget &target,
+                             T0 arg0=T0(), T1 arg1=T1(), T2 arg2=T2(), T3 arg3=T3(),
+                             T4 arg4=T4(), T5 arg5=T5(), T6 arg6=T6(), T7 arg7=T7()) throw(std::runtime_error) {
+          
+          Status status;
+          
+          const Method *meth = self->findMethod(target, status);
+          
+          if (!meth) {
+            throw std::runtime_error(status.getMessage());
+          }
+          
+          Future *future = new Future(self, target.getName(), *meth);
+          
+          if (!future->bind(size_t(Arity), status) ||
+              !future->setInput(0, arg0, status) ||
+              !future->setInput(1, arg1, status) ||
+              !future->setInput(2, arg2, status) ||
+              !future->setInput(3, arg3, status) ||
+              !future->setInput(4, arg4, status) ||
+              !future->setInput(5, arg5, status) ||
+              !future->setInput(6, arg6, status) ||
+              !future->setInput(7, arg7, status)) {
+            delete future;
+            status.setMethodName(target.getName());
+            throw std::runtime_error(status.getMessage());
+          }
+          
+          future->start();
+          
+          return future;
+        }
+      };
+      
+    public:
+      
+      ~Future();
+      
+      // false until the call completed
+      bool ready();
+      
+      // Block until the call completed, running queued pool tasks meanwhile
+      void wait();
+      
+      // wait and return the call status
+      const Status& getStatus();
+      
+      // wait and throw if the call failed
+      void check() throw(std::runtime_error);
+      
+      // wait and read an output, in/out or return argument value (throws if
+      // the call failed)
+      template <typename T>
+      T get(size_t i) throw(std::runtime_error) {
+        BaseArgument arg;
+        const ArgumentValue &value = output(i, arg);
+        T rv;
+        ConversionError err = details::GetSet<typename gcore::NoRefOrConst<T>::Type>::Get(arg, value, rv);
+        if (err != CE_NONE) {
+          std::ostringstream oss;
+          oss << "Future::get: Method argument " << i << ": " << ConversionErrorString(err);
+          throw std::runtime_error(oss.str());
+        }
+        return rv;
+      }
+      
+      template <typename T>
+      T getReturn() throw(std::runtime_error) {
+        if (!getMethod().hasReturn()) {
+          throw std::runtime_error("Future::getReturn: Method has no return argument");
+        }
+        return get<T>(size_t(getMethod().returnArg()));
+      }
+      
+      inline Object* getObject() const {
+        return mObject;
+      }
+      
+      inline const char* getName() const {
+        return mName.c_str();
+      }
+      
+      inline const Method& getMethod() const {
+        return mParams.getMethod();
+      }
+      
+    private:
+      
+      Future(Object *o, const char *name, const Method &m);
+      Future(const Future&);
+      Future& operator=(const Future&);
+      
+      // Check the number of inputs, set the defaults of the missing ones and
+      // point the output arguments to the owned storage
+      bool bind(size_t ninputs, Status &status);
+      
+      // Set input k (k-th in or in/out argument)
+      template <typename T>
+      bool setInput(size_t k, T value, Status &status) {
+        if (k >= mNumInputs) {
+          status.set(EC_ARGUMENT_COUNT, 0, -1, 0, long(mNumInputs));
+          return false;
+        }
+        size_t i = mInputs[k];
+        const Argument &arg = getMethod()[i];
+        if (arg.getDir() == AD_IN) {
+          return (mParams.trySet(i, value, status, false) && keepString(i));
+        }
+        BaseArgument va(AD_IN, arg.getType());
+        if (details::GetSet<typename gcore::NoRefOrConst<T>::Type>::Set(va, value, mValues[i]) != CE_NONE) {
+          status.set(EC_ARGUMENT_TYPE, 0, long(i));
+          return false;
+        }
+        return true;
+      }
+      
+      inline bool setInput(size_t, const Empty &, Status &) {
+        return true;
+      }
+      
+      // converted while value is alive (the generic conversion works on copies)
+      inline bool setInput(size_t k, const std::string &value, Status &status) {
+        return setInput(k, value.c_str(), status);
+      }
+      
+      // Point a string input to a copy owned by the future (always true)
+      bool keepString(size_t i);
+      
+      // Submit the call to the thread pool or run it
+      void start();
+      
+      void run();
+      
+      static void Run(void *data, size_t begin, size_t end);
+      
+      // wait, check the call status and the argument direction, set arg to
+      // describe the returned value
+      const ArgumentValue& output(size_t i, BaseArgument &arg) throw(std::runtime_error);
+      
+    private:
+      
+      Object *mObject;
+      std::string mName;
+      MethodParams mParams;
+      // output and in/out values (the parameters point to them)
+      ArgumentValue mValues[LWC_MAX_ARGS];
+      // input string copies, parallel to mValues
+      std::string mStrings[LWC_MAX_ARGS];
+      // argument index of each input
+      size_t mInputs[LWC_MAX_ARGS];
+      size_t mNumInputs;
+      Status mStatus;
+      // 0 for calls run by callAsync
+      parallel::Executor *mExecutor;
+      parallel::Executor::Group mGroup;
+      bool mStarted;
+      bool mDone;
+  };
+  
+  // ---
+  
+  template <typename T0>
+  Future* Object::callAsync(const CallTarget &target, T0 arg0) throw(std::runtime_error) {
+    return Future::Call<T0>::Start(this, target, arg0);
+  }
+  
+  template <typename T0, typename T1>
+  Future* Object::callAsync(const CallTarget &target, T0 arg0, T1 arg1) throw(std::runtime_error) {
+    return Future::Call<T0,T1>::Start(this, target, arg0, arg1);
+  }
+  
+  template <typename T0, typename T1, typename T2>
+  Future* Object::callAsync(const CallTarget &target, T0 arg0, T1 arg1, T2 arg2) throw(std::runtime_error) {
+    return Future::Call<T0,T1,T2>::Start(this, target, arg0, arg1, arg2);
+  }
+  
+  template <typename T0, typename T1, typename T2, typename T3>
+  Future* Object::callAsync(const CallTarget &target, T0 arg0, T1 arg1, T2 arg2, T3 arg3) throw(std::runtime_error) {
+    return Future::Call<T0,T1,T2,T3>::Start(this, target, arg0, arg1, arg2, arg3);
+  }
+  
+  template <typename T0, typename T1, typename T2, typename T3,
+            typename T4>
+  Future* Object::callAsync(const CallTarget &target,
+                            T0 arg0, T1 arg1, T2 arg2, T3 arg3,
+                            T4 arg4) throw(std::runtime_error) {
+    return Future::Call<T0,T1,T2,T3,T4>::Start(this, target, arg0, arg1, arg2, arg3, arg4);
+  }
+  
+  template <typename T0, typename T1, typename T2, typename T3,
+            typename T4, typename T5>
+  Future* Object::callAsync(const CallTarget &target,
+                            T0 arg0, T1 arg1, T2 arg2, T3 arg3,
+                            T4 arg4, T5 arg5) throw(std::runtime_error) {
+    return Future::Call<T0,T1,T2,T3,T4,T5>::Start(this, target, arg0, arg1, arg2, arg3, arg4, arg5);
+  }
+  
+  template <typename T0, typename T1, typename T2, typename T3,
+            typename T4, typename T5, typename T6>
+  Future* Object::callAsync(const CallTarget &target,
+                            T0 arg0, T1 arg1, T2 arg2, T3 arg3,
+                            T4 arg4, T5 arg5, T6 arg6) throw(std::runtime_error) {
+    return Future::Call<T0,T1,T2,T3,T4,T5,T6>::Start(this, target, arg0, arg1, arg2, arg3,
+                                                     arg4, arg5, arg6);
+  }
+  
+  template <typename T0, typename T1, typename T2, typename T3,
+            typename T4, typename T5, typename T6, typename T7>
+  Future* Object::callAsync(const CallTarget &target,
+                            T0 arg0, T1 arg1, T2 arg2, T3 arg3,
+                            T4 arg4, T5 arg5, T6 arg6, T7 arg7) throw(std::runtime_error) {
+    return Future::Call<T0,T1,T2,T3,T4,T5,T6,T7>::Start(this, target, arg0, arg1, arg2, arg3,
+                                                        arg4, arg5, arg6, arg7);
+  }
+  
+}
+
+#endif
@@ -0,0 +1,111 @@
+/*
+
+Copyright (C) 2009, 2010  Gaetan Guidet
+
+This file is part of lwc.
+
+lwc is free software; you can redistribute it and/or modify it
+under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 2.1 of the License, or (at
+your option) any later version.
+
+lwc is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+USA.
+
+*/
+
+
+#ifndef __lwc_interceptor_h__
+#define __lwc_interceptor_h__
+
+#include <lwc/method.h>
+#include <lwc/atomic.h>
+
+namespace lwc {
+  
+  // Hooks run around calls (timing, logging, access control, fault injection)
+  // see Registry::addInterceptor. Interceptors are not owned by the registry.
+  // Every method call path goes through them, property accesses do not.
+  // Exceptions thrown by before and after are reported as call failures.
+  class LWC_API Interceptor {
+    public:
+      
+      Interceptor();
+      virtual ~Interceptor();
+      
+      // Called with the input arguments set. Return false to skip the method
+      // (status is set to EC_INTERCEPTED unless the interceptor set it)
+      virtual bool before(Object *o, const char *name, MethodParams &params, Status &status);
+      
+      // Called once the method returned or failed, only if before accepted
+      // the call. status may be changed to report a failure
+      virtual void after(Object *o, const char *name, MethodParams &params, Status &status);
+  };
+  
+  // Interceptors installed for one type, run in installation order before
+  // the call and in reverse order after it.
+  // Chains must not be modified while calls are in progress
+  class LWC_API InterceptorChain {
+    public:
+      
+      // Checked by every call: interceptors cost a single test until the
+      // first one is installed
+      static inline bool Active() {
+        return (atomic::Load(&msNumInstalled) != 0);
+      }
+      
+      InterceptorChain();
+      ~InterceptorChain();
+      
+      // methodName 0 to intercept all the type methods
+      void add(Interceptor *i, const char *methodName=0);
+      
+      // Remove all entries for i, returns the number of removed entries
+      size_t remove(Interceptor *i);
+      
+      inline bool empty() const {
+        return mEntries.empty();
+      }
+      
+      inline size_t size() const {
+        return mEntries.size();
+      }
+      
+      // Returns the number of leading entries to pass to after (stops at the
+      // first interceptor rejecting the call)
+      size_t before(Object *o, const char *name, MethodParams &params, Status &status) const;
+      
+      void after(Object *o, const char *name, MethodParams &params, Status &status, size_t n) const;
+      
+    private:
+      
+      InterceptorChain(const InterceptorChain &);
+      InterceptorChain& operator=(const InterceptorChain &);
+      
+      inline bool matches(size_t i, const char *name) const {
+        return (mEntries[i].method.length() == 0 || mEntries[i].method == name);
+      }
+      
+    private:
+      
+      struct Entry {
+        Interceptor *interceptor;
+        std::string method;
+      };
+      
+      std::vector<Entry> mEntries;
+      
+      // entries over all chains (read by any calling thread)
+      static volatile long msNumInstalled;
+  };
+  
+}
+
+#endif
@@ -0,0 +1,133 @@
+/*
+
+Copyright (C) 2009, 2010  Gaetan Guidet
+
+This file is part of lwc.
+
+lwc is free software; you can redistribute it and/or modify it
+under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 2.1 of the License, or (at
+your option) any later version.
+
+lwc is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+USA.
+
+*/
+
+
+#ifndef __lwc_interface_h__
+#define __lwc_interface_h__
+
+#include <lwc/object.h>
+
+namespace lwc {
+  
+  // Protocol shared by types of any language: an ordered list of method
+  // signatures (slots). Signatures are declared as MethodDecl tables, method
+  // pointers are ignored. Argument names and default values are not part of
+  // the signature.
+  class LWC_API Interface {
+    public:
+      
+      Interface();
+      Interface(const char *name, const MethodDecl *decls, size_t n) throw(std::runtime_error);
+      Interface(const Interface &rhs);
+      ~Interface();
+      
+      Interface& operator=(const Interface &rhs);
+      
+      inline const char* getName() const {
+        return mName.c_str();
+      }
+      
+      inline size_t numSlots() const {
+        return mSlots.size();
+      }
+      
+      inline const char* getSlotName(size_t slot) const {
+        return mSlotNames[slot].c_str();
+      }
+      
+      inline const Method& getSlotMethod(size_t slot) const {
+        return mSlots[slot];
+      }
+      
+      bool findSlot(const char *name, size_t &slot) const;
+      
+      // Check method m against slot signature, on failure argIndex is the
+      // first mismatching argument (-1 for an arguments count mismatch)
+      bool matches(size_t slot, const Method &m, long &argIndex) const;
+      
+      std::string toString() const;
+      
+    private:
+      
+      std::string mName;
+      std::vector<std::string> mSlotNames;
+      std::vector<Method> mSlots;
+  };
+  
+  // Interface checked once against a type methods table: slot i maps to the
+  // handle of the type method implementing interface slot i so that callers
+  // go through the slot index rather than looking methods up by name
+  //   obj->call(binding[2], &width);
+  class LWC_API InterfaceBinding {
+    public:
+      
+      InterfaceBinding();
+      // Does not throw, see isValid and getStatus
+      InterfaceBinding(const Interface &iface, const MethodsTable *table);
+      InterfaceBinding(const InterfaceBinding &rhs);
+      ~InterfaceBinding();
+      
+      InterfaceBinding& operator=(const InterfaceBinding &rhs);
+      
+      // Whether the type implements the whole interface
+      inline bool isValid() const {
+        return (mInterface != 0 && mStatus.succeeded());
+      }
+      
+      // Reason the type does not implement the interface
+      inline const Status& getStatus() const {
+        return mStatus;
+      }
+      
+      inline const Interface* getInterface() const {
+        return mInterface;
+      }
+      
+      inline const MethodsTable* getMethodsTable() const {
+        return mTable;
+      }
+      
+      inline size_t numSlots() const {
+        return mSlots.size();
+      }
+      
+      inline const MethodHandle& operator[](size_t slot) const {
+        return mSlots[slot];
+      }
+      
+      // Whether o can be called through this binding
+      inline bool accepts(const Object *o) const {
+        return (isValid() && o != 0 && o->getMethods() == mTable);
+      }
+      
+    private:
+      
+      const Interface *mInterface;
+      const MethodsTable *mTable;
+      std::vector<MethodHandle> mSlots;
+      Status mStatus;
+  };
+  
+}
+
+#endif
@@ -53,6 +53,9 @@ namespace lwc {
       std::string docString(const char *name, const std::string &indent="");
       Object* create(const char *name);
       void destroy(Object *o);
+      // Instance pools (see Factory::setPool)
+      bool setPool(const char *name, size_t maxSize, size_t warmUp=0);
+      bool getPoolStats(const char *name, PoolStats &stats) const;
       
     protected:
       
@@ -39,6 +39,8 @@ USA.
 #include <lwc/memory.h>
 #include <lwc/object.h>
 #include <lwc/registry.h>
+#include <lwc/cmdbuffer.h>
+#include <lwc/signal.h>
 #include <lua.hpp>
 
 #endif
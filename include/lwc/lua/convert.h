@@ -242,6 +242,78 @@ namespace lua {
   };
   
   
+  // Push return argument value (AD_RETURN), read from the parameters slot itself
+  inline void PushReturn(lua_State *L, const lwc::MethodParams &params, size_t i) {
+    const lwc::ArgumentValue &v = params.rawget(i, false);
+    switch (params.getMethod()[i].getType()) {
+      case lwc::AT_BOOL:
+        C2Lua<lwc::AT_BOOL>::ToValue(v.boolean, L);
+        break;
+      case lwc::AT_INT:
+        C2Lua<lwc::AT_INT>::ToValue(v.integer, L);
+        break;
+      case lwc::AT_REAL:
+        C2Lua<lwc::AT_REAL>::ToValue(v.real, L);
+        break;
+      default: {
+        lwc::Object *o = (lwc::Object*) v.ptr;
+        C2Lua<lwc::AT_OBJECT>::ToValue(o, L);
+      }
+    }
+  }
+  
+  // Bridge values for lwc::Marshal stubs: positional arguments on the stack
+  struct MarshalArgs {
+    lua_State *L;
+    int first;
+    size_t count;
+  };
+  
+  struct MarshalTraits {
+    typedef MarshalArgs Args;
+    // number of values pushed, Error when the call failed: the message is
+    // pushed and raised by the caller, lua_error longjmps over C++ frames
+    typedef int Result;
+    
+    enum {
+      Error = -1
+    };
+    
+    static inline size_t Count(const MarshalArgs &args) {
+      return args.count;
+    }
+    template <typename T>
+    static inline bool Get(const MarshalArgs &args, size_t i, T &val) {
+      int idx = args.first + int(i);
+      if (!LuaType<T>::Check(args.L, idx)) {
+        return false;
+      }
+      LuaType<T>::ToC(args.L, idx, val);
+      return true;
+    }
+    // copied as the callee gets a mutable string (see Marshal::Release)
+    static inline bool Get(const MarshalArgs &args, size_t i, char* &val) {
+      int idx = args.first + int(i);
+      if (!lua_isnil(args.L, idx) && lua_type(args.L, idx) != LUA_TSTRING) {
+        return false;
+      }
+      LuaType<char*>::ToC(args.L, idx, val);
+      return true;
+    }
+    static inline int None(const MarshalArgs &) {
+      return 0;
+    }
+    template <typename T>
+    static inline int Value(const MarshalArgs &args, T val) {
+      CType<T>::ToLua(val, args.L);
+      return 1;
+    }
+    static inline int Failed(const MarshalArgs &args, const lwc::Status &status) {
+      lua_pushstring(args.L, status.getMessage().c_str());
+      return Error;
+    }
+  };
+  
   template <lwc::Type T> struct ParamConverter {
     
     typedef typename lwc::Enum2Type<T>::Type Type;
@@ -301,19 +373,8 @@ namespace lua {
       return false;
     }
     
-    static bool HasKey(lua_State *L, int arg, const std::string &name) {
-      if (!lua_istable(L, arg)) {
-        return false;
-      }
-      lua_pushstring(L, name.c_str());
-      lua_gettable(L, arg);
-      bool rv = !lua_isnil(L, -1);
-      lua_pop(L, 1);
-      return rv;
-    }
-    
     static bool PreCall(const lwc::Argument &desc, size_t /*idesc*/,
-                        lua_State *L, int firstArg, size_t nargs, int kwargs, size_t &iarg,
+                        lua_State *L, int firstArg, size_t nargs, int kwarg, size_t &iarg,
                         std::map<size_t,size_t> &arraySizes, Type &val,
                         std::string &err) {
       
@@ -327,18 +388,12 @@ namespace lua {
           if (iarg >= nargs) {
             bool failed = true;
             if (desc.isNamed()) {
-              if (kwargs != 0) {
-                lua_pushstring(L, desc.getName().c_str());
-                lua_gettable(L, kwargs);
-                if (!lua_isnil(L, -1)) {
-                  Lua2C<T>::ToValue(L, lua_gettop(L), val);
-                  failed = false;
-                }
-              }
-              if (failed) {
+              if (kwarg != 0) {
+                Lua2C<T>::ToValue(L, kwarg, val);
+                failed = false;
+              } else {
                 failed = !GetDefaultValue(desc, val);
               }
-              lua_pop(L, 1);
             }
             if (failed) {
               err = "Not enough arguments";
@@ -354,13 +409,13 @@ namespace lua {
     }
     
     static void PostCall(const lwc::Argument &desc, size_t /*idesc*/,
-                         lua_State *L, int /*firstArg*/, size_t nargs, int kwargs, size_t &iarg,
+                         lua_State *L, int /*firstArg*/, size_t nargs, int kwarg, size_t &iarg,
                          std::map<size_t,size_t> &arraySizes, Type &val, int rv,
                          bool callFailed) {
       
       bool dontDispose = false;
       if (iarg >= nargs && desc.isNamed() && 
-          (kwargs == 0 || HasKey(L, kwargs, desc.getName())) &&
+          kwarg == 0 &&
           desc.hasDefaultValue()) {
         dontDispose = true;
       }
@@ -403,7 +458,7 @@ namespace lua {
     }
     
     static bool PreCallArray(const lwc::Argument &desc, size_t idesc, const lwc::Argument &sdesc,
-                             lua_State *L, int firstArg, size_t nargs, int kwargs, size_t &iarg,
+                             lua_State *L, int firstArg, size_t nargs, int kwarg, size_t &iarg,
                              std::map<size_t,size_t> &arraySizes, Array &ary,
                              std::string &err) {
       if (desc.getDir() == lwc::AD_IN || desc.getDir() == lwc::AD_INOUT) {
@@ -411,16 +466,11 @@ namespace lua {
         if (iarg >= nargs) {
           bool failed = true;
           if (desc.isNamed()) {
-            if (kwargs != 0) {
-              lua_pushstring(L, desc.getName().c_str());
-              lua_gettable(L, kwargs);
-              if (!lua_isnil(L, -1)) {
-                Lua2C<T>::ToArray(L, lua_gettop(L), ary, length);
-                arraySizes[idesc] = length;
-                failed = false;
-              }
-            }
-            if (failed) {
+            if (kwarg != 0) {
+              Lua2C<T>::ToArray(L, kwarg, ary, length);
+              arraySizes[idesc] = length;
+              failed = false;
+            } else {
               failed = !GetDefaultValue(desc, ary);
               if (!failed) {
                 lwc::Integer tmp;
@@ -430,7 +480,6 @@ namespace lua {
                 }
               }
             }
-            lua_pop(L, 1);
           }
           if (failed) {
             err = "Not enough arguments";
@@ -446,13 +495,13 @@ namespace lua {
     }
     
     static void PostCallArray(const lwc::Argument &desc, size_t idesc, const lwc::Argument &,
-                              lua_State *L, int firstArg, size_t nargs, int kwargs, size_t &iarg,
+                              lua_State *L, int firstArg, size_t nargs, int kwarg, size_t &iarg,
                               std::map<size_t,size_t> &arraySizes, Array &ary, int rv,
                               bool callFailed) {
       
       bool dontDispose = false;
       if (iarg >= nargs && desc.isNamed() && 
-          (kwargs == 0 || HasKey(L, kwargs, desc.getName())) &&
+          kwarg == 0 &&
           desc.hasDefaultValue()) {
         dontDispose = true;
       }
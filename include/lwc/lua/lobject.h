@@ -37,10 +37,30 @@ namespace lua {
       // put self on stack
       int self();
       
-      virtual void call(const char *name, lwc::MethodParams &params) throw(std::runtime_error);
+      virtual bool allowsConcurrentCalls() const {
+        return false;
+      }
+      
+      // Calls the "recycle" method of the lua object if it has one, a false
+      // return value or an error refuse the recycling
+      virtual bool recycle();
     
     protected:
       
+      virtual void invoke(const char *name, lwc::MethodParams &params) throw(std::runtime_error);
+      
+      // One lua call for the whole batch when the object defines "<name>_batch"
+      virtual void invokeBatch(const char *name, const lwc::Method &meth, lwc::MethodParams **params, size_t n) throw(std::runtime_error);
+      
+      // Push the method inputs on the stack (inout arrays are also inserted at inoutPos)
+      void pushArgs(lwc::MethodParams &params, int &inoutPos,
+                    std::map<size_t, size_t> &inoutInSizes) throw(std::runtime_error);
+      
+      // Convert the noutputs values starting at stack index retPos to the method outputs
+      void getOutputs(lwc::MethodParams &params, int retPos, size_t noutputs,
+                      std::map<size_t, size_t> &inoutArgs,
+                      std::map<size_t, size_t> &inoutInSizes) throw(std::runtime_error);
+      
       lua_State *mState;
   };
 
@@ -31,10 +31,17 @@ USA.
 
 namespace lua {
 
+  // kwargs holds the stack index of the keyword value for each method argument (0 if none)
   LWCLUA_API int CallMethod(lwc::Object *o, const char *n,
                             lwc::MethodParams &params, int cArg,
-                            lua_State *L, int firstArg, size_t nargs, int kwargs, size_t luaArg, // firstArg, index of first arg on stack, luaArg relative to first arg
-                            std::map<size_t,size_t> &arraySizes) throw(std::runtime_error);
+                            lua_State *L, int firstArg, size_t nargs, const int *kwargs, size_t luaArg, // firstArg, index of first arg on stack, luaArg relative to first arg
+                            std::map<size_t,size_t> &arraySizes, lwc::Status &status);
+  
+  // Call method mn of o with the values from firstArg to the top of the stack
+  // (a last table with string keys only holds keyword arguments), methods is the
+  // table used to compile the call sites. Returns the number of values pushed.
+  LWCLUA_API int CallMethod(lwc::Object *o, const lwc::MethodsTable *methods, const char *mn,
+                            lwc::CallSiteCache &sites, lua_State *L, int firstArg);
 
 }
 
@@ -89,6 +89,8 @@ namespace lua {
     public:
     
       lwc::Object *obj;
+      // call sites compiled for this object methods
+      lwc::CallSiteCache sites;
     
       LuaObject();
       LuaObject(lwc::Object *o);
@@ -99,6 +101,37 @@ namespace lua {
       static int New(lua_State *L);
       static int Wrap(lua_State *L, lwc::Object *o);
       static lwc::Object* UnWrap(lua_State *L, int idx, bool upValue=false);
+      static LuaObject* UnWrapObject(lua_State *L, int idx, bool upValue=false);
+      static int Del(lua_State *L);
+  };
+  
+  class LWCLUA_API LuaCommandBuffer {
+    public:
+      
+      lwc::CommandBuffer buffer;
+      
+      LuaCommandBuffer();
+      ~LuaCommandBuffer();
+      
+      static size_t AllocSize();
+      static const char* RegistryKey();
+      static int New(lua_State *L);
+      static lwc::CommandBuffer& UnWrap(lua_State *L, int idx, bool upValue=false);
+      static int Del(lua_State *L);
+  };
+  
+  class LWCLUA_API LuaSignalQueue {
+    public:
+      
+      lwc::SignalQueue *queue;
+      
+      LuaSignalQueue(size_t capacity);
+      ~LuaSignalQueue();
+      
+      static size_t AllocSize();
+      static const char* RegistryKey();
+      static int New(lua_State *L);
+      static lwc::SignalQueue* UnWrap(lua_State *L, int idx, bool upValue=false);
       static int Del(lua_State *L);
   };
   
@@ -124,6 +157,8 @@ namespace lua {
   LWCLUA_API bool InitMethod(lua_State *L, int module);
   LWCLUA_API bool InitMethodsTable(lua_State *L, int module);
   LWCLUA_API bool InitObject(lua_State *L, int module);
+  LWCLUA_API bool InitCommandBuffer(lua_State *L, int module);
+  LWCLUA_API bool InitSignalQueue(lua_State *L, int module);
   LWCLUA_API bool InitRegistry(lua_State *L, int module);
   LWCLUA_API int CreateModule(lua_State *L);
 
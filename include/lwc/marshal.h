@@ -0,0 +1,167 @@
+/*
+
+Copyright (C) 2009, 2010  Gaetan Guidet
+
+This file is part of lwc.
+
+lwc is free software; you can redistribute it and/or modify it
+under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 2.1 of the License, or (at
+your option) any later version.
+
+lwc is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+USA.
+
+*/
+
+
+#ifndef __lwc_marshal_h__
+#define __lwc_marshal_h__
+
+#include <lwc/object.h>
+#include <lwc/memory.h>
+
+namespace lwc {
+  
+  // Marshaling stubs for the common signatures (see Method::signature) shared
+  // by the language bridges, B describes the bridge values:
+  //
+  //   typedef ... Args;    script call arguments
+  //   typedef ... Result;  script call result
+  //   static size_t Count(Args args);
+  //   static bool Get(Args args, size_t i, T &val);  bool, Integer, Real and char*
+  //   static Result None(Args args);
+  //   static Result Value(Args args, T val);         bool, Integer, Real
+  //   static Result Failed(Args args, const Status &status);
+  //
+  // Strings are copied by Get (memory::Alloc, as the generic conversion does)
+  // and freed once the method returned. Failed should not longjmp out of the
+  // stub: bridges raising that way return a marker and raise from the caller
+  //
+  // A stub returns false before calling the method when the arguments do not
+  // match exactly (count or types), the bridge then goes through its generic
+  // conversion (defaults, implicit conversions and error reporting)
+  template <class B>
+  class Marshal {
+    public:
+      
+      typedef typename B::Args Args;
+      typedef typename B::Result Result;
+      typedef bool (*Stub)(Object *o, const char *name, MethodParams &params, Args args,
+                           Status &status, Result &result);
+      
+      // 0 if the method signature has no stub
+      static inline Stub Find(const Method &m) {
+        static const Stub sStubs[SIG_COUNT] = {
+          0,
+          &Void,
+          &In1<bool>, &In1<Integer>, &In1<Real>, &In1<char*>,
+          &In2<Integer, Integer>, &In2<Real, Real>,
+          &Out1<bool>, &Out1<Integer>, &Out1<Real>,
+          &Return1<bool>, &Return1<Integer>, &Return1<Real>
+        };
+        return sStubs[m.signature()];
+      }
+      
+    private:
+      
+      static inline void Store(ArgumentValue &v, bool val) {v.boolean = val;}
+      static inline void Store(ArgumentValue &v, Integer val) {v.integer = val;}
+      static inline void Store(ArgumentValue &v, Real val) {v.real = val;}
+      static inline void Store(ArgumentValue &v, char *val) {v.ptr = (void*) val;}
+      
+      static inline void Load(const ArgumentValue &v, bool &val) {val = v.boolean;}
+      static inline void Load(const ArgumentValue &v, Integer &val) {val = v.integer;}
+      static inline void Load(const ArgumentValue &v, Real &val) {val = v.real;}
+      
+      template <typename T>
+      static inline void Release(T &) {}
+      static inline void Release(char* &val) {if (val) memory::Free((void*)val);}
+      
+      static bool Void(Object *o, const char *name, MethodParams &params, Args args,
+                       Status &status, Result &result) {
+        if (B::Count(args) != 0) {
+          return false;
+        }
+        status = o->tryCall(name, params);
+        result = (status.failed() ? B::Failed(args, status) : B::None(args));
+        return true;
+      }
+      
+      template <typename A0>
+      static bool In1(Object *o, const char *name, MethodParams &params, Args args,
+                      Status &status, Result &result) {
+        A0 a0;
+        if (B::Count(args) != 1 || !B::Get(args, 0, a0)) {
+          return false;
+        }
+        Store(params.rawvalues()[0], a0);
+        status = o->tryCall(name, params);
+        Release(a0);
+        result = (status.failed() ? B::Failed(args, status) : B::None(args));
+        return true;
+      }
+      
+      template <typename A0, typename A1>
+      static bool In2(Object *o, const char *name, MethodParams &params, Args args,
+                      Status &status, Result &result) {
+        A0 a0;
+        A1 a1;
+        if (B::Count(args) != 2 || !B::Get(args, 0, a0)) {
+          return false;
+        }
+        if (!B::Get(args, 1, a1)) {
+          Release(a0);
+          return false;
+        }
+        ArgumentValue *v = params.rawvalues();
+        Store(v[0], a0);
+        Store(v[1], a1);
+        status = o->tryCall(name, params);
+        Release(a0);
+        Release(a1);
+        result = (status.failed() ? B::Failed(args, status) : B::None(args));
+        return true;
+      }
+      
+      template <typename T>
+      static bool Out1(Object *o, const char *name, MethodParams &params, Args args,
+                       Status &status, Result &result) {
+        if (B::Count(args) != 0) {
+          return false;
+        }
+        T val = T();
+        params.rawvalues()[0].ptr = &val;
+        status = o->tryCall(name, params);
+        result = (status.failed() ? B::Failed(args, status) : B::Value(args, val));
+        return true;
+      }
+      
+      template <typename T>
+      static bool Return1(Object *o, const char *name, MethodParams &params, Args args,
+                          Status &status, Result &result) {
+        if (B::Count(args) != 0) {
+          return false;
+        }
+        status = o->tryCall(name, params);
+        if (status.failed()) {
+          result = B::Failed(args, status);
+        } else {
+          T val;
+          Load(params.rawvalues()[0], val);
+          result = B::Value(args, val);
+        }
+        return true;
+      }
+  };
+  
+}
+
+#endif
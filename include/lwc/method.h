@@ -25,51 +25,233 @@ USA.
 #define __lwc_method_h__
 
 #include <lwc/argument.h>
+#include <lwc/status.h>
 #include <map>
 
 namespace lwc {
   
   class LWC_API Object;
-  class LWC_API MethodPointer;
   class LWC_API MethodParams;
+  class LWC_API InterceptorChain;
+  
+  // Plain function called for a native method: self is the object the method
+  // is called on (its actual type is the one the method was declared for)
+  typedef void (*MethodPointer)(Object *self, MethodParams &params);
+  
+  enum MethodFlags {
+    MF_NONE = 0,
+    // results only depend on the input values and the object state: calls
+    // with bool, integer and real arguments are memoized per object (see
+    // Object::invalidateResults)
+    MF_PURE = 0x01
+  };
+  
+  // Argument lists the language bridges marshal with specialized stubs (see
+  // lwc::Marshal), any other method goes through the generic conversion
+  enum Signature {
+    SIG_GENERIC = 0,
+    SIG_VOID,         // ()
+    SIG_BOOL,         // (in bool)
+    SIG_INT,          // (in int)
+    SIG_REAL,         // (in real)
+    SIG_STRING,       // (in string)
+    SIG_INT_INT,      // (in int, in int)
+    SIG_REAL_REAL,    // (in real, in real)
+    SIG_OUT_BOOL,     // (out bool)
+    SIG_OUT_INT,      // (out int)
+    SIG_OUT_REAL,     // (out real)
+    SIG_RETURN_BOOL,  // (return bool)
+    SIG_RETURN_INT,   // (return int)
+    SIG_RETURN_REAL,  // (return real)
+    SIG_COUNT
+  };
   
   struct LWC_API MethodDecl {
     const char *name;
     Integer nargs;
     ArgumentDecl args[LWC_MAX_ARGS];
-    MethodPointer *ptr;
+    MethodPointer ptr;
     const char *desc;
+    // MethodFlags bit mask, may be omitted
+    unsigned long flags;
   };
   
 #define LWC_NUMMETHODS(Ary) (sizeof(Ary) / sizeof(lwc::MethodDecl))
-#define LWC_METHOD(Class, Name) new lwc::TMethodPointer<Class>(&Class::Name)
+#define LWC_METHOD(Class, Name) &lwc::MethodThunk<Class, &Class::Name>::Call
   
-  // Ugly work around to have things work on windows
-  //   if pointer type is (void (Object::*)()) we cannot assign (void (Box::*)()) to it
-  // Need a better scheme, this makes each objects do allocation for each of its method
-  // and code for setting up methods is butt-ugly
-  class LWC_API MethodPointer {
-    public:
-      MethodPointer();
-      virtual ~MethodPointer();
+  // Static thunk generated for each declared method: no allocation, the same
+  // pointer can be shared by any number of tables, and the call goes through a
+  // static_cast to the declaring class rather than a member pointer cast
+  // (methods inherited from a base class are declared with LWC_METHOD(Base, Name))
+  template <class T, void (T::*Ptr)(MethodParams &)>
+  struct MethodThunk {
+    static void Call(Object *self, MethodParams &params) {
+      (static_cast<T*>(self)->*Ptr)(params);
+    }
+  };
+  
+  // Properties are typed values (AT_BOOL, AT_INT or AT_REAL) read and written
+  // without building MethodParams, either straight from an object field or
+  // through plain accessor functions.
+  // They go through the object mailbox (see Object::readProperty) but not
+  // through interceptors, and are never memoized
+  typedef void (*PropertyGetter)(const Object *self, ArgumentValue &value);
+  typedef void (*PropertySetter)(Object *self, const ArgumentValue &value);
+  
+  struct LWC_API PropertyDecl {
+    const char *name;
+    Type type;
+    PropertyGetter get;
+    // 0 for a read only property
+    PropertySetter set;
+    const char *desc;
+  };
+  
+#define LWC_NUMPROPERTIES(Ary) (sizeof(Ary) / sizeof(lwc::PropertyDecl))
+#define LWC_FIELD(Class, Member) \
+  lwc::FieldType(&Class::Member), \
+  lwc::Field(&Class::Member).getter<&Class::Member>(), \
+  lwc::Field(&Class::Member).setter<&Class::Member>()
+#define LWC_ACCESSORS(Class, ValueType, Getter, Setter) \
+  lwc::Type(lwc::Type2Enum<ValueType>::Enum), \
+  &lwc::PropertyGetThunk<Class, ValueType, &Class::Getter>::Call, \
+  &lwc::PropertySetThunk<Class, ValueType, &Class::Setter>::Call
+#define LWC_GETTER(Class, ValueType, Getter) \
+  lwc::Type(lwc::Type2Enum<ValueType>::Enum), \
+  &lwc::PropertyGetThunk<Class, ValueType, &Class::Getter>::Call, 0
+  
+  template <typename T> struct PropertyValue {};
+  template <> struct PropertyValue<bool> {
+    static inline bool Get(const ArgumentValue &v) {return v.boolean;}
+    static inline void Set(ArgumentValue &v, bool val) {v.boolean = val;}
+  };
+  template <> struct PropertyValue<Integer> {
+    static inline Integer Get(const ArgumentValue &v) {return v.integer;}
+    static inline void Set(ArgumentValue &v, Integer val) {v.integer = val;}
+  };
+  template <> struct PropertyValue<Real> {
+    static inline Real Get(const ArgumentValue &v) {return v.real;}
+    static inline void Set(ArgumentValue &v, Real val) {v.real = val;}
+  };
+  
+  template <class T, typename V, V (T::*Get)() const>
+  struct PropertyGetThunk {
+    static void Call(const Object *self, ArgumentValue &value) {
+      PropertyValue<V>::Set(value, (static_cast<const T*>(self)->*Get)());
+    }
+  };
+  
+  template <class T, typename V, void (T::*Set)(V)>
+  struct PropertySetThunk {
+    static void Call(Object *self, const ArgumentValue &value) {
+      (static_cast<T*>(self)->*Set)(PropertyValue<V>::Get(value));
+    }
   };
   
-  template <class T> class TMethodPointer : public MethodPointer {
+  template <class T, typename V>
+  Type FieldType(V T::*) {
+    return Type(Type2Enum<V>::Enum);
+  }
+  
+  // Native interfaces are plain C++ abstract classes shared by a module and
+  // its C++ clients. Once obtained through Object::queryInterface, calls are
+  // plain virtual calls: no name lookup and no MethodParams.
+  // An interface identifies itself with LWC_INTERFACE(Name), names are used
+  // rather than RTTI as type_info cannot be compared reliably across modules
+  typedef void* (*InterfaceCast)(Object *self);
+  
+  struct LWC_API InterfaceDecl {
+    const char *name;
+    InterfaceCast cast;
+  };
+  
+#define LWC_INTERFACE(Name) static const char* InterfaceName() {return Name;}
+#define LWC_NUMINTERFACES(Ary) (sizeof(Ary) / sizeof(lwc::InterfaceDecl))
+#define LWC_IMPLEMENTS(Class, Interface) Interface::InterfaceName(), &lwc::InterfaceThunk<Class, Interface>::Cast
+  
+  template <class T, class I>
+  struct InterfaceThunk {
+    static void* Cast(Object *self) {
+      return static_cast<I*>(static_cast<T*>(self));
+    }
+  };
+  
+  class LWC_API Property {
     public:
-      TMethodPointer(void (T::*ptr)(MethodParams &))
-        : MethodPointer(), mPtr(ptr) {
-      }
-      virtual ~TMethodPointer() {
+      
+      Property();
+      Property(const PropertyDecl &decl) throw(std::runtime_error);
+      Property(const Property &rhs);
+      ~Property();
+      
+      Property& operator=(const Property &rhs);
+      
+      inline Type getType() const {return mType;}
+      inline bool isReadOnly() const {return (mSetter == 0);}
+      inline const char* getDescription() const {return mDesc.c_str();}
+      
+      inline void get(const Object *self, ArgumentValue &value) const {
+        mGetter(self, value);
       }
-      inline void call(T *self, MethodParams &params) {
-        (self->*mPtr)(params);
+      
+      // false for read only properties
+      // field writes drop the memoized results of self (accessors are left to
+      // call Object::invalidateResults themselves)
+      inline bool set(Object *self, const ArgumentValue &value) const {
+        if (mSetter) {
+          mSetter(self, value);
+          return true;
+        } else {
+          return false;
+        }
       }
-    protected:
-      void (T::*mPtr)(MethodParams &);
+      
+      std::string toString() const;
+      std::string docString(const std::string &indent="") const;
+      
+      // Object::invalidateResults for the field setters (object.h includes
+      // this header)
+      static void FieldWritten(Object *self);
+      
+    private:
+      
+      Type mType;
+      PropertyGetter mGetter;
+      PropertySetter mSetter;
+      std::string mDesc;
+  };
+  
+  // Field properties access the member through its pointer to member, the
+  // value type is deduced by Field so that LWC_FIELD only needs the member name
+  template <class T, typename V>
+  struct FieldAccess {
+    template <V T::*Member>
+    static void Get(const Object *self, ArgumentValue &value) {
+      PropertyValue<V>::Set(value, static_cast<const T*>(self)->*Member);
+    }
+    
+    template <V T::*Member>
+    static void Set(Object *self, const ArgumentValue &value) {
+      static_cast<T*>(self)->*Member = PropertyValue<V>::Get(value);
+      Property::FieldWritten(self);
+    }
+    
+    template <V T::*Member>
+    PropertyGetter getter() const {
+      return &Get<Member>;
+    }
+    
+    template <V T::*Member>
+    PropertySetter setter() const {
+      return &Set<Member>;
+    }
   };
   
-  // IMPORTANT NODE:
-  // Method DOES NOT OWN the MethodPointer object
+  template <class T, typename V>
+  FieldAccess<T, V> Field(V T::*) {
+    return FieldAccess<T, V>();
+  }
+  
   class LWC_API Method {
     
     public:
@@ -88,14 +270,37 @@ namespace lwc {
       void addArg(const Argument &arg) throw(std::runtime_error);
       inline size_t numArgs() const {return mArgs.size();}
       inline size_t numPositionalArgs() const {return mNumPArgs;}
+      // bit i set if argument i has no default value (computed by validateArgs)
+      inline unsigned long requiredArgsMask() const {return mRequiredArgs;}
+      // Default image: one value per argument (the default value when the
+      // argument has one, zero otherwise) so that MethodParams can fill all
+      // omitted arguments with a single block copy (computed by validateArgs)
+      inline const ArgumentValue* defaultValues() const {return (mDefaults.empty() ? 0 : &mDefaults[0]);}
+      inline unsigned long defaultArgsMask() const {return mDefaultArgs;}
       size_t namedArgIndex(const char *name) const throw(std::runtime_error);
+      bool findNamedArg(const char *name, size_t &idx) const;
       
-      inline void setPointer(MethodPointer *ptr) {mPtr = ptr;}
-      inline MethodPointer* getPointer() const {return mPtr;}
+      inline void setPointer(MethodPointer ptr) {mPtr = ptr;}
+      inline MethodPointer getPointer() const {return mPtr;}
       
       inline void setDescription(const char *desc) {mDesc = (desc == 0 ? "" : desc);}
       inline const char* getDescription() const {return mDesc.c_str();}
       
+      void setFlags(unsigned long flags);
+      inline unsigned long getFlags() const {return mFlags;}
+      inline bool isPure() const {return ((mFlags & MF_PURE) != 0);}
+      // pure method whose arguments are all plain bool, integer or real
+      // values, inputs or outputs (updated by validateArgs)
+      inline bool isMemoized() const {return mMemoized;}
+      
+      // index of the AD_RETURN argument (always the last one), -1 if none
+      // (updated by validateArgs)
+      inline long returnArg() const {return mReturnArg;}
+      inline bool hasReturn() const {return (mReturnArg >= 0);}
+      
+      // signature key of the argument list (updated by validateArgs)
+      inline Signature signature() const {return mSignature;}
+      
       inline const Argument& operator[](size_t idx) const {return mArgs[idx];}
       inline Argument& operator[](size_t idx) {return mArgs[idx];}
       
@@ -104,27 +309,53 @@ namespace lwc {
       
       void validateArgs() throw(std::runtime_error);
       
+    private:
+      
+      Signature computeSignature() const;
+      
     private:
       
       std::vector<Argument> mArgs;
-      MethodPointer *mPtr;
+      MethodPointer mPtr;
       std::string mDesc;
       size_t mNumPArgs;
       std::map<std::string, size_t> mNArgIndices;
+      unsigned long mRequiredArgs;
+      std::vector<ArgumentValue> mDefaults;
+      unsigned long mDefaultArgs;
+      unsigned long mFlags;
+      bool mMemoized;
+      long mReturnArg;
+      Signature mSignature;
   };
   
   class LWC_API MethodsTable {
     public:
       
       MethodsTable(const MethodsTable *parent=0);
+      MethodsTable(const MethodsTable &rhs);
       ~MethodsTable();
       
+      MethodsTable& operator=(const MethodsTable &rhs);
+      
+      // Lookups use a flattened view of all visible methods (overrides resolved)
+      // rebuilt whenever methods are added, derived tables are rebuilt with
+      // their parent. Declaration lists are inserted with a single rebuild
       inline const Method* findMethod(const char *name) const {
-        std::map<std::string, Method>::const_iterator it = mTable.find(name);
-        return (it == mTable.end() ? (mParent ? mParent->findMethod(name) : 0) : &(it->second));
+        const Entry *e = findEntry(name);
+        return (e ? e->method : 0);
       }
       
-      size_t numMethods() const;
+      // Method name as stored by the table (0 if not found), valid as long as
+      // the table
+      inline const char* findMethodName(const char *name) const {
+        const Entry *e = findEntry(name);
+        return (e ? e->name : 0);
+      }
+      
+      inline size_t numMethods() const {
+        return mEntries.size();
+      }
       
       std::string toString() const;
       std::string docString(const std::string &indent="") const;
@@ -135,15 +366,201 @@ namespace lwc {
       
       void fromDeclaration(const MethodDecl *decl, size_t n, bool override=false) throw(std::runtime_error);
       
+      // Properties share the methods namespace and are inherited the same way
+      inline const Property* findProperty(const char *name) const {
+        if (mPropEntries.size() == 0) {
+          return 0;
+        }
+        unsigned int h = Hash(name);
+        for (size_t i=0; i<mPropEntries.size(); ++i) {
+          const PropEntry &e = mPropEntries[i];
+          if (e.hash == h && !strcmp(e.name, name)) {
+            return e.property;
+          }
+        }
+        return 0;
+      }
+      
+      inline size_t numProperties() const {
+        return mPropEntries.size();
+      }
+      
+      size_t availableProperties(std::vector<std::string> &propertyNames) const;
+      
+      void addProperty(const char *name, const Property &p, bool override=false) throw(std::runtime_error);
+      
+      void fromDeclaration(const PropertyDecl *decl, size_t n, bool override=false) throw(std::runtime_error);
+      
+      // Native interfaces are inherited from the parent table
+      inline InterfaceCast findInterface(const char *name) const {
+        for (size_t i=0; i<mInterfaces.size(); ++i) {
+          if (mInterfaces[i].first == name) {
+            return mInterfaces[i].second;
+          }
+        }
+        return (mParent ? mParent->findInterface(name) : 0);
+      }
+      
+      inline size_t numInterfaces() const {
+        return mInterfaces.size();
+      }
+      
+      void addInterface(const char *name, InterfaceCast cast, bool override=false) throw(std::runtime_error);
+      
+      void fromDeclaration(const InterfaceDecl *decl, size_t n, bool override=false) throw(std::runtime_error);
+      
+      // Signals (see lwc/signal.h) are declared as MethodDecl tables, method
+      // pointers are ignored. Arguments are input only (no arrays), at most
+      // LWC_MAX_SIGNAL_ARGS. Signals are inherited from the parent table
+      inline const Method* findSignal(const char *name) const {
+        for (size_t i=0; i<mSignals.size(); ++i) {
+          if (!strcmp(mSignals[i].first.c_str(), name)) {
+            return &(mSignals[i].second);
+          }
+        }
+        return (mParent ? mParent->findSignal(name) : 0);
+      }
+      
+      // Signal name as stored by the table (0 if not found), valid as long as
+      // the table
+      inline const char* findSignalName(const char *name) const {
+        for (size_t i=0; i<mSignals.size(); ++i) {
+          if (!strcmp(mSignals[i].first.c_str(), name)) {
+            return mSignals[i].first.c_str();
+          }
+        }
+        return (mParent ? mParent->findSignalName(name) : 0);
+      }
+      
+      inline size_t numSignals() const {
+        return mSignals.size();
+      }
+      
+      size_t availableSignals(std::vector<std::string> &signalNames) const;
+      
+      void addSignal(const char *name, const Method &m, bool override=false) throw(std::runtime_error);
+      
+      void addSignals(const MethodDecl *decl, size_t n, bool override=false) throw(std::runtime_error);
+      
+      // Interceptors installed for this type (see Registry::addInterceptor)
+      inline const InterceptorChain* getInterceptors() const {
+        return mInterceptors;
+      }
+      
+    protected:
+      
+      static inline unsigned int Hash(const char *name) {
+        // FNV-1a
+        unsigned int h = 2166136261U;
+        while (*name != '\0') {
+          h = (h ^ (unsigned char)(*name++)) * 16777619U;
+        }
+        return h;
+      }
+      
+      void insertMethod(const char *name, const Method &m, bool override) throw(std::runtime_error);
+      void insertProperty(const char *name, const Property &p, bool override) throw(std::runtime_error);
+      void buildLookup();
+      void setParent(const MethodsTable *parent);
+      
     protected:
       
+      struct Entry {
+        const char *name;
+        unsigned int hash;
+        const Method *method;
+      };
+      
+      struct PropEntry {
+        const char *name;
+        unsigned int hash;
+        const Property *property;
+      };
+      
+      inline const Entry* findEntry(const char *name) const {
+        if (mIndex.size() == 0) {
+          return 0;
+        }
+        unsigned int h = Hash(name);
+        size_t i = h & mIndexMask;
+        while (mIndex[i] != 0) {
+          const Entry &e = mEntries[mIndex[i] - 1];
+          if (e.hash == h && !strcmp(e.name, name)) {
+            return &e;
+          }
+          i = (i + 1) & mIndexMask;
+        }
+        return 0;
+      }
+      
       std::map<std::string, Method> mTable;
+      std::map<std::string, Property> mProperties;
       const MethodsTable *mParent;
+      // tables whose parent is this one, their views include ours
+      mutable std::vector<MethodsTable*> mDerived;
+      // flattened view, sorted by name
+      std::vector<Entry> mEntries;
+      // open addressing index in mEntries (1 based, 0 for empty slots)
+      std::vector<size_t> mIndex;
+      size_t mIndexMask;
+      // flattened view of all visible properties (few per type, linear lookup)
+      std::vector<PropEntry> mPropEntries;
+      // own native interfaces (few per type, linear lookup)
+      std::vector<std::pair<std::string, InterfaceCast> > mInterfaces;
+      // own signals (few per type, linear lookup)
+      std::vector<std::pair<std::string, Method> > mSignals;
+      // owned by the registry, not copied
+      mutable InterceptorChain *mInterceptors;
+      
+      friend class Registry;
   };
   
+  // Method resolved once from a methods table so that repeated calls can skip
+  // the by-name lookup. A handle is only valid for objects using the methods
+  // table it was resolved from (see Object::getMethodHandle and
+  // Registry::getMethodHandle).
+  class LWC_API MethodHandle {
+    public:
+      
+      MethodHandle();
+      MethodHandle(const MethodsTable *table, const char *name) throw(std::runtime_error);
+      MethodHandle(const MethodHandle &rhs);
+      ~MethodHandle();
+      
+      MethodHandle& operator=(const MethodHandle &rhs);
+      
+      inline bool isValid() const {
+        return (mMethod != 0);
+      }
+      
+      inline const char* getName() const {
+        return mName.c_str();
+      }
+      
+      inline const Method& getMethod() const {
+        return *mMethod;
+      }
+      
+      inline const MethodsTable* getMethodsTable() const {
+        return mTable;
+      }
+      
+    private:
+      
+      const MethodsTable *mTable;
+      const Method *mMethod;
+      std::string mName;
+  };
+      
+  // Argument values storage is sized to the method: values are stored inline
+  // for methods with up to InlineArgs arguments, in a pooled buffer otherwise
   class LWC_API MethodParams {
     public:
       
+      enum {
+        InlineArgs = 4
+      };
+      
       MethodParams(const Method &m);
       MethodParams(const MethodParams &rhs);
       ~MethodParams();
@@ -174,6 +591,23 @@ namespace lwc {
         mParams[i] = v;
       }
       
+      // unchecked access to all the argument values (see AutoMethod)
+      inline ArgumentValue* rawvalues() {
+        return mParams;
+      }
+      
+      // Reset arguments [from, numArgs) from the method default image (this
+      // includes the return value pointer when the return argument is in range)
+      inline void setDefaults(size_t from=0) {
+        size_t n = mMethod.numArgs();
+        if (from < n) {
+          memcpy(mParams + from, mMethod.defaultValues() + from, (n - from) * sizeof(ArgumentValue));
+          if (mMethod.returnArg() >= long(from)) {
+            mReturnTarget.ptr = 0;
+          }
+        }
+      }
+      
       inline const ArgumentValue& rawgetn(const char *name) const throw(std::runtime_error) {
         return mParams[mMethod.namedArgIndex(name)];
       }
@@ -184,6 +618,25 @@ namespace lwc {
       
       // get/set positional arguments
       
+      // exception free set, see Object::tryCall
+      template <typename T>
+      inline bool trySet(size_t i, T value, Status &status, bool positionalOnly=true) {
+        if (( positionalOnly && i >= mMethod.numPositionalArgs()) ||
+            (!positionalOnly && i >= mMethod.numArgs())) {
+          status.set(EC_ARGUMENT_INDEX, 0, long(i));
+          return false;
+        }
+        ConversionError err = details::GetSet<typename gcore::NoRefOrConst<T>::Type>::Set(mMethod[i], value, mParams[i]);
+        if (long(i) == mMethod.returnArg()) {
+          err = setReturnValue(err, value);
+        }
+        if (err != CE_NONE) {
+          status.set(EC_ARGUMENT_TYPE, 0, long(i));
+          return false;
+        }
+        return true;
+      }
+      
       template <typename T>
       void set(size_t i, T value, bool positionalOnly=true) throw(std::runtime_error) {
         if (( positionalOnly && i >= mMethod.numPositionalArgs()) ||
@@ -219,6 +672,48 @@ namespace lwc {
         return value;
       }
       
+      // get/set the return argument (see AD_RETURN): the method sets the value,
+      // callers read it back once the method returned
+      
+      template <typename T>
+      void setReturn(T value) throw(std::runtime_error) {
+        if (!mMethod.hasReturn()) {
+          throw std::runtime_error("MethodParams::setReturn: Method has no return argument");
+        }
+        // the caller pointer, if any, is kept for storeReturn
+        size_t i = size_t(mMethod.returnArg());
+        ConversionError err = details::GetSet<typename gcore::NoRefOrConst<T>::Type>::Set(mMethod[i], value, mParams[i]);
+        if (err != CE_NONE) {
+          std::ostringstream oss;
+          oss << "MethodParams::setReturn: " << ConversionErrorString(err);
+          throw std::runtime_error(oss.str());
+        }
+      }
+      
+      template <typename T>
+      T getReturn() throw(std::runtime_error) {
+        if (!mMethod.hasReturn()) {
+          throw std::runtime_error("MethodParams::getReturn: Method has no return argument");
+        }
+        T value;
+        _get(size_t(mMethod.returnArg()), value);
+        return value;
+      }
+      
+      // Copy the return value to the pointer passed in place of the return
+      // argument by the caller, if any (called by Object after dispatch)
+      inline void storeReturn() {
+        if (mReturnTarget.ptr != 0) {
+          const ArgumentValue &v = mParams[mMethod.returnArg()];
+          switch (mMethod[mMethod.returnArg()].getType()) {
+            case AT_BOOL: *((bool*) mReturnTarget.ptr) = v.boolean; break;
+            case AT_INT: *((Integer*) mReturnTarget.ptr) = v.integer; break;
+            case AT_REAL: *((Real*) mReturnTarget.ptr) = v.real; break;
+            default: *((Object**) mReturnTarget.ptr) = (Object*) v.ptr;
+          }
+        }
+      }
+      
       // get/set named arguments
       
       template <typename T>
@@ -243,22 +738,42 @@ namespace lwc {
       MethodParams();
       MethodParams& operator=(const MethodParams&);
       
+      static ArgumentValue* AllocSpill();
+      static void FreeSpill(ArgumentValue *values);
+      
+      // pointer given for the return argument (same rules as an output argument),
+      // a plain value drops the previous pointer
+      template <typename T>
+      inline ConversionError setReturnValue(ConversionError err, T value) {
+        if (err == CE_INDIRECTION) {
+          BaseArgument target(AD_OUT, mMethod[mMethod.returnArg()].getType());
+          return details::GetSet<typename gcore::NoRefOrConst<T>::Type>::Set(target, value, mReturnTarget);
+        }
+        if (err == CE_NONE) {
+          mReturnTarget.ptr = 0;
+        }
+        return err;
+      }
+      
       template <typename T>
       void _set(size_t i, T value) throw(std::runtime_error) {
-        std::string err;
-        if (!details::GetSet<typename gcore::NoRefOrConst<T>::Type>::Set(mMethod[i], value, mParams[i], err)) {
+        ConversionError err = details::GetSet<typename gcore::NoRefOrConst<T>::Type>::Set(mMethod[i], value, mParams[i]);
+        if (long(i) == mMethod.returnArg()) {
+          err = setReturnValue(err, value);
+        }
+        if (err != CE_NONE) {
           std::ostringstream oss;
-          oss << "MethodParams::_set: Method argument " << i << ": " << err;
+          oss << "MethodParams::_set: Method argument " << i << ": " << ConversionErrorString(err);
           throw std::runtime_error(oss.str());
         }
       }
       
       template <typename T>
       void _get(size_t i, T &value) throw(std::runtime_error)  {
-        std::string err;
-        if (!details::GetSet<typename gcore::NoRefOrConst<T>::Type>::Get(mMethod[i], mParams[i], value, err)) {
+        ConversionError err = details::GetSet<typename gcore::NoRefOrConst<T>::Type>::Get(mMethod[i], mParams[i], value);
+        if (err != CE_NONE) {
           std::ostringstream oss;
-          oss << "MethodParams::_get: Method argument " << i << ": " << err;
+          oss << "MethodParams::_get: Method argument " << i << ": " << ConversionErrorString(err);
           throw std::runtime_error(oss.str());
         }
       }
@@ -273,7 +788,9 @@ namespace lwc {
     private:
       
       const Method &mMethod;
-      ArgumentValue mParams[LWC_MAX_ARGS];
+      ArgumentValue *mParams;
+      ArgumentValue mInline[InlineArgs];
+      ArgumentValue mReturnTarget;
   };
   
 }
@@ -5,39 +5,462 @@
 
 namespace lwc {
   
+  // Auto binding: methods declared from plain member functions
+  //
+  //   void move(lwc::Integer dx, lwc::Integer dy);
+  //   lwc::Integer area() const;
+  //
+  //   {"move", ...} is generated by LWC_AUTO_METHOD(Box, move, "Move box")
+  //
+  // Arguments map by type: bool, Integer, Real, Object* and const char* values
+  // (or const references) are inputs, pointers to bool, Integer, Real or
+  // Object* outputs and non const references in/out arguments. A non void
+  // result becomes an AD_RETURN argument. Arguments have no names or default
+  // values and array arguments are not supported (up to 8 arguments).
+  // The generated thunk reads the argument values directly: they were checked
+  // against the same signature when the call parameters were set.
+  
+  namespace details {
+    
+    template <typename T> struct AutoArg;
+    
+    template <> struct AutoArg<bool> {
+      enum {ArgDir = AD_IN, ArgType = AT_BOOL};
+      static inline bool Get(const ArgumentValue &v) {return v.boolean;}
+    };
+    template <> struct AutoArg<Integer> {
+      enum {ArgDir = AD_IN, ArgType = AT_INT};
+      static inline Integer Get(const ArgumentValue &v) {return v.integer;}
+    };
+    template <> struct AutoArg<Real> {
+      enum {ArgDir = AD_IN, ArgType = AT_REAL};
+      static inline Real Get(const ArgumentValue &v) {return v.real;}
+    };
+    template <> struct AutoArg<Object*> {
+      enum {ArgDir = AD_IN, ArgType = AT_OBJECT};
+      static inline Object* Get(const ArgumentValue &v) {return (Object*) v.ptr;}
+    };
+    template <> struct AutoArg<const char*> {
+      enum {ArgDir = AD_IN, ArgType = AT_STRING};
+      static inline const char* Get(const ArgumentValue &v) {return (const char*) v.ptr;}
+    };
+    template <typename T> struct AutoArg<const T&> : public AutoArg<T> {
+    };
+    template <typename T> struct AutoArg<T*> {
+      enum {ArgDir = AD_OUT, ArgType = Type2Enum<T>::Enum};
+      static inline T* Get(const ArgumentValue &v) {return (T*) v.ptr;}
+    };
+    template <typename T> struct AutoArg<T&> {
+      enum {ArgDir = AD_INOUT, ArgType = Type2Enum<T>::Enum};
+      static inline T& Get(const ArgumentValue &v) {return *((T*) v.ptr);}
+    };
+    
+    template <typename T>
+    inline void AutoDeclare(ArgumentDecl &decl) {
+      // unsupported argument types fail here
+      typedef char Supported[int(AutoArg<T>::ArgType) != int(AT_UNKNOWN) ? 1 : -1];
+      (void) sizeof(Supported);
+      decl.dir = Direction(AutoArg<T>::ArgDir);
+      decl.type = Type(AutoArg<T>::ArgType);
+      decl.arylen = -1;
+    }
+    
+    template <typename R> struct AutoReturn;
+    
+    template <> struct AutoReturn<bool> {
+      enum {ArgType = AT_BOOL};
+      static inline void Set(ArgumentValue &v, bool r) {v.boolean = r;}
+    };
+    template <> struct AutoReturn<Integer> {
+      enum {ArgType = AT_INT};
+      static inline void Set(ArgumentValue &v, Integer r) {v.integer = r;}
+    };
+    template <> struct AutoReturn<Real> {
+      enum {ArgType = AT_REAL};
+      static inline void Set(ArgumentValue &v, Real r) {v.real = r;}
+    };
+    template <> struct AutoReturn<Object*> {
+      enum {ArgType = AT_OBJECT};
+      static inline void Set(ArgumentValue &v, Object *r) {v.ptr = r;}
+    };
+    
+    // Member function signatures: argument declarations and the call with
+    // values read from the parameters
+    template <typename Sig> struct AutoSignature;
+    
+    template <class T, typename R>
+    struct AutoSignature<R (T::*)()> {
+      enum {NumArgs = 0};
+      typedef R Return;
+      static inline void Declare(ArgumentDecl *) {
+      }
+      static inline R Invoke(R (T::*ptr)(), Object *self, ArgumentValue *) {
+        return (static_cast<T*>(self)->*ptr)();
+      }
+    };
+    
+    template <class T, typename R>
+    struct AutoSignature<R (T::*)() const> {
+      enum {NumArgs = 0};
+      typedef R Return;
+      static inline void Declare(ArgumentDecl *) {
+      }
+      static inline R Invoke(R (T::*ptr)() const, Object *self, ArgumentValue *) {
+        return (static_cast<T*>(self)->*ptr)();
+      }
+    };
+    
+    template <class T, typename R, typename A0>
+    struct AutoSignature<R (T::*)(A0)> {
+      enum {NumArgs = 1};
+      typedef R Return;
+      static inline void Declare(ArgumentDecl *args) {
+        AutoDeclare<A0>(args[0]);
+      }
+      static inline R Invoke(R (T::*ptr)(A0), Object *self, ArgumentValue *v) {
+        return (static_cast<T*>(self)->*ptr)(AutoArg<A0>::Get(v[0]));
+      }
+    };
+    
+    template <class T, typename R, typename A0>
+    struct AutoSignature<R (T::*)(A0) const> {
+      enum {NumArgs = 1};
+      typedef R Return;
+      static inline void Declare(ArgumentDecl *args) {
+        AutoDeclare<A0>(args[0]);
+      }
+      static inline R Invoke(R (T::*ptr)(A0) const, Object *self, ArgumentValue *v) {
+        return (static_cast<T*>(self)->*ptr)(AutoArg<A0>::Get(v[0]));
+      }
+    };
+    
+    template <class T, typename R, typename A0, typename A1>
+    struct AutoSignature<R (T::*)(A0, A1)> {
+      enum {NumArgs = 2};
+      typedef R Return;
+      static inline void Declare(ArgumentDecl *args) {
+        AutoDeclare<A0>(args[0]);
+        AutoDeclare<A1>(args[1]);
+      }
+      static inline R Invoke(R (T::*ptr)(A0, A1), Object *self, ArgumentValue *v) {
+        return (static_cast<T*>(self)->*ptr)(AutoArg<A0>::Get(v[0]), AutoArg<A1>::Get(v[1]));
+      }
+    };
+    
+    template <class T, typename R, typename A0, typename A1>
+    struct AutoSignature<R (T::*)(A0, A1) const> {
+      enum {NumArgs = 2};
+      typedef R Return;
+      static inline void Declare(ArgumentDecl *args) {
+        AutoDeclare<A0>(args[0]);
+        AutoDeclare<A1>(args[1]);
+      }
+      static inline R Invoke(R (T::*ptr)(A0, A1) const, Object *self, ArgumentValue *v) {
+        return (static_cast<T*>(self)->*ptr)(AutoArg<A0>::Get(v[0]), AutoArg<A1>::Get(v[1]));
+      }
+    };
+    
+    template <class T, typename R, typename A0, typename A1, typename A2>
+    struct AutoSignature<R (T::*)(A0, A1, A2)> {
+      enum {NumArgs = 3};
+      typedef R Return;
+      static inline void Declare(ArgumentDecl *args) {
+        AutoDeclare<A0>(args[0]);
+        AutoDeclare<A1>(args[1]);
+        AutoDeclare<A2>(args[2]);
+      }
+      static inline R Invoke(R (T::*ptr)(A0, A1, A2), Object *self, ArgumentValue *v) {
+        return (static_cast<T*>(self)->*ptr)(AutoArg<A0>::Get(v[0]), AutoArg<A1>::Get(v[1]), AutoArg<A2>::Get(v[2]));
+      }
+    };
+    
+    template <class T, typename R, typename A0, typename A1, typename A2>
+    struct AutoSignature<R (T::*)(A0, A1, A2) const> {
+      enum {NumArgs = 3};
+      typedef R Return;
+      static inline void Declare(ArgumentDecl *args) {
+        AutoDeclare<A0>(args[0]);
+        AutoDeclare<A1>(args[1]);
+        AutoDeclare<A2>(args[2]);
+      }
+      static inline R Invoke(R (T::*ptr)(A0, A1, A2) const, Object *self, ArgumentValue *v) {
+        return (static_cast<T*>(self)->*ptr)(AutoArg<A0>::Get(v[0]), AutoArg<A1>::Get(v[1]), AutoArg<A2>::Get(v[2]));
+      }
+    };
+    
+    template <class T, typename R, typename A0, typename A1, typename A2, typename A3>
+    struct AutoSignature<R (T::*)(A0, A1, A2, A3)> {
+      enum {NumArgs = 4};
+      typedef R Return;
+      static inline void Declare(ArgumentDecl *args) {
+        AutoDeclare<A0>(args[0]);
+        AutoDeclare<A1>(args[1]);
+        AutoDeclare<A2>(args[2]);
+        AutoDeclare<A3>(args[3]);
+      }
+      static inline R Invoke(R (T::*ptr)(A0, A1, A2, A3), Object *self, ArgumentValue *v) {
+        return (static_cast<T*>(self)->*ptr)(AutoArg<A0>::Get(v[0]), AutoArg<A1>::Get(v[1]), AutoArg<A2>::Get(v[2]), AutoArg<A3>::Get(v[3]));
+      }
+    };
+    
+    template <class T, typename R, typename A0, typename A1, typename A2, typename A3>
+    struct AutoSignature<R (T::*)(A0, A1, A2, A3) const> {
+      enum {NumArgs = 4};
+      typedef R Return;
+      static inline void Declare(ArgumentDecl *args) {
+        AutoDeclare<A0>(args[0]);
+        AutoDeclare<A1>(args[1]);
+        AutoDeclare<A2>(args[2]);
+        AutoDeclare<A3>(args[3]);
+      }
+      static inline R Invoke(R (T::*ptr)(A0, A1, A2, A3) const, Object *self, ArgumentValue *v) {
+        return (static_cast<T*>(self)->*ptr)(AutoArg<A0>::Get(v[0]), AutoArg<A1>::Get(v[1]), AutoArg<A2>::Get(v[2]), AutoArg<A3>::Get(v[3]));
+      }
+    };
+    
+    template <class T, typename R, typename A0, typename A1, typename A2, typename A3, typename A4>
+    struct AutoSignature<R (T::*)(A0, A1, A2, A3, A4)> {
+      enum {NumArgs = 5};
+      typedef R Return;
+      static inline void Declare(ArgumentDecl *args) {
+        AutoDeclare<A0>(args[0]);
+        AutoDeclare<A1>(args[1]);
+        AutoDeclare<A2>(args[2]);
+        AutoDeclare<A3>(args[3]);
+        AutoDeclare<A4>(args[4]);
+      }
+      static inline R Invoke(R (T::*ptr)(A0, A1, A2, A3, A4), Object *self, ArgumentValue *v) {
+        return (static_cast<T*>(self)->*ptr)(AutoArg<A0>::Get(v[0]), AutoArg<A1>::Get(v[1]), AutoArg<A2>::Get(v[2]), AutoArg<A3>::Get(v[3]), AutoArg<A4>::Get(v[4]));
+      }
+    };
+    
+    template <class T, typename R, typename A0, typename A1, typename A2, typename A3, typename A4>
+    struct AutoSignature<R (T::*)(A0, A1, A2, A3, A4) const> {
+      enum {NumArgs = 5};
+      typedef R Return;
+      static inline void Declare(ArgumentDecl *args) {
+        AutoDeclare<A0>(args[0]);
+        AutoDeclare<A1>(args[1]);
+        AutoDeclare<A2>(args[2]);
+        AutoDeclare<A3>(args[3]);
+        AutoDeclare<A4>(args[4]);
+      }
+      static inline R Invoke(R (T::*ptr)(A0, A1, A2, A3, A4) const, Object *self, ArgumentValue *v) {
+        return (static_cast<T*>(self)->*ptr)(AutoArg<A0>::Get(v[0]), AutoArg<A1>::Get(v[1]), AutoArg<A2>::Get(v[2]), AutoArg<A3>::Get(v[3]), AutoArg<A4>::Get(v[4]));
+      }
+    };
+    
+    template <class T, typename R, typename A0, typename A1, typename A2, typename A3, typename A4, typename A5>
+    struct AutoSignature<R (T::*)(A0, A1, A2, A3, A4, A5)> {
+      enum {NumArgs = 6};
+      typedef R Return;
+      static inline void Declare(ArgumentDecl *args) {
+        AutoDeclare<A0>(args[0]);
+        AutoDeclare<A1>(args[1]);
+        AutoDeclare<A2>(args[2]);
+        AutoDeclare<A3>(args[3]);
+        AutoDeclare<A4>(args[4]);
+        AutoDeclare<A5>(args[5]);
+      }
+      static inline R Invoke(R (T::*ptr)(A0, A1, A2, A3, A4, A5), Object *self, ArgumentValue *v) {
+        return (static_cast<T*>(self)->*ptr)(AutoArg<A0>::Get(v[0]), AutoArg<A1>::Get(v[1]), AutoArg<A2>::Get(v[2]), AutoArg<A3>::Get(v[3]), AutoArg<A4>::Get(v[4]), AutoArg<A5>::Get(v[5]));
+      }
+    };
+    
+    template <class T, typename R, typename A0, typename A1, typename A2, typename A3, typename A4, typename A5>
+    struct AutoSignature<R (T::*)(A0, A1, A2, A3, A4, A5) const> {
+      enum {NumArgs = 6};
+      typedef R Return;
+      static inline void Declare(ArgumentDecl *args) {
+        AutoDeclare<A0>(args[0]);
+        AutoDeclare<A1>(args[1]);
+        AutoDeclare<A2>(args[2]);
+        AutoDeclare<A3>(args[3]);
+        AutoDeclare<A4>(args[4]);
+        AutoDeclare<A5>(args[5]);
+      }
+      static inline R Invoke(R (T::*ptr)(A0, A1, A2, A3, A4, A5) const, Object *self, ArgumentValue *v) {
+        return (static_cast<T*>(self)->*ptr)(AutoArg<A0>::Get(v[0]), AutoArg<A1>::Get(v[1]), AutoArg<A2>::Get(v[2]), AutoArg<A3>::Get(v[3]), AutoArg<A4>::Get(v[4]), AutoArg<A5>::Get(v[5]));
+      }
+    };
+    
+    template <class T, typename R, typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6>
+    struct AutoSignature<R (T::*)(A0, A1, A2, A3, A4, A5, A6)> {
+      enum {NumArgs = 7};
+      typedef R Return;
+      static inline void Declare(ArgumentDecl *args) {
+        AutoDeclare<A0>(args[0]);
+        AutoDeclare<A1>(args[1]);
+        AutoDeclare<A2>(args[2]);
+        AutoDeclare<A3>(args[3]);
+        AutoDeclare<A4>(args[4]);
+        AutoDeclare<A5>(args[5]);
+        AutoDeclare<A6>(args[6]);
+      }
+      static inline R Invoke(R (T::*ptr)(A0, A1, A2, A3, A4, A5, A6), Object *self, ArgumentValue *v) {
+        return (static_cast<T*>(self)->*ptr)(AutoArg<A0>::Get(v[0]), AutoArg<A1>::Get(v[1]), AutoArg<A2>::Get(v[2]), AutoArg<A3>::Get(v[3]), AutoArg<A4>::Get(v[4]), AutoArg<A5>::Get(v[5]), AutoArg<A6>::Get(v[6]));
+      }
+    };
+    
+    template <class T, typename R, typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6>
+    struct AutoSignature<R (T::*)(A0, A1, A2, A3, A4, A5, A6) const> {
+      enum {NumArgs = 7};
+      typedef R Return;
+      static inline void Declare(ArgumentDecl *args) {
+        AutoDeclare<A0>(args[0]);
+        AutoDeclare<A1>(args[1]);
+        AutoDeclare<A2>(args[2]);
+        AutoDeclare<A3>(args[3]);
+        AutoDeclare<A4>(args[4]);
+        AutoDeclare<A5>(args[5]);
+        AutoDeclare<A6>(args[6]);
+      }
+      static inline R Invoke(R (T::*ptr)(A0, A1, A2, A3, A4, A5, A6) const, Object *self, ArgumentValue *v) {
+        return (static_cast<T*>(self)->*ptr)(AutoArg<A0>::Get(v[0]), AutoArg<A1>::Get(v[1]), AutoArg<A2>::Get(v[2]), AutoArg<A3>::Get(v[3]), AutoArg<A4>::Get(v[4]), AutoArg<A5>::Get(v[5]), AutoArg<A6>::Get(v[6]));
+      }
+    };
+    
+    template <class T, typename R, typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7>
+    struct AutoSignature<R (T::*)(A0, A1, A2, A3, A4, A5, A6, A7)> {
+      enum {NumArgs = 8};
+      typedef R Return;
+      static inline void Declare(ArgumentDecl *args) {
+        AutoDeclare<A0>(args[0]);
+        AutoDeclare<A1>(args[1]);
+        AutoDeclare<A2>(args[2]);
+        AutoDeclare<A3>(args[3]);
+        AutoDeclare<A4>(args[4]);
+        AutoDeclare<A5>(args[5]);
+        AutoDeclare<A6>(args[6]);
+        AutoDeclare<A7>(args[7]);
+      }
+      static inline R Invoke(R (T::*ptr)(A0, A1, A2, A3, A4, A5, A6, A7), Object *self, ArgumentValue *v) {
+        return (static_cast<T*>(self)->*ptr)(AutoArg<A0>::Get(v[0]), AutoArg<A1>::Get(v[1]), AutoArg<A2>::Get(v[2]), AutoArg<A3>::Get(v[3]), AutoArg<A4>::Get(v[4]), AutoArg<A5>::Get(v[5]), AutoArg<A6>::Get(v[6]), AutoArg<A7>::Get(v[7]));
+      }
+    };
+    
+    template <class T, typename R, typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7>
+    struct AutoSignature<R (T::*)(A0, A1, A2, A3, A4, A5, A6, A7) const> {
+      enum {NumArgs = 8};
+      typedef R Return;
+      static inline void Declare(ArgumentDecl *args) {
+        AutoDeclare<A0>(args[0]);
+        AutoDeclare<A1>(args[1]);
+        AutoDeclare<A2>(args[2]);
+        AutoDeclare<A3>(args[3]);
+        AutoDeclare<A4>(args[4]);
+        AutoDeclare<A5>(args[5]);
+        AutoDeclare<A6>(args[6]);
+        AutoDeclare<A7>(args[7]);
+      }
+      static inline R Invoke(R (T::*ptr)(A0, A1, A2, A3, A4, A5, A6, A7) const, Object *self, ArgumentValue *v) {
+        return (static_cast<T*>(self)->*ptr)(AutoArg<A0>::Get(v[0]), AutoArg<A1>::Get(v[1]), AutoArg<A2>::Get(v[2]), AutoArg<A3>::Get(v[3]), AutoArg<A4>::Get(v[4]), AutoArg<A5>::Get(v[5]), AutoArg<A6>::Get(v[6]), AutoArg<A7>::Get(v[7]));
+      }
+    };
+    
+    template <typename Sig, Sig Ptr, typename R>
+    struct AutoThunk {
+      static void Call(Object *self, MethodParams &params) {
+        ArgumentValue *v = params.rawvalues();
+        AutoReturn<R>::Set(v[AutoSignature<Sig>::NumArgs], AutoSignature<Sig>::Invoke(Ptr, self, v));
+      }
+    };
+    
+    template <typename Sig, Sig Ptr>
+    struct AutoThunk<Sig, Ptr, void> {
+      static void Call(Object *self, MethodParams &params) {
+        AutoSignature<Sig>::Invoke(Ptr, self, params.rawvalues());
+      }
+    };
+    
+    template <typename R>
+    inline Integer AutoDeclareReturn(ArgumentDecl &decl) {
+      decl.dir = AD_RETURN;
+      decl.type = Type(AutoReturn<R>::ArgType);
+      decl.arylen = -1;
+      return 1;
+    }
+    
+    template <>
+    inline Integer AutoDeclareReturn<void>(ArgumentDecl &) {
+      return 0;
+    }
+  }
+  
+  template <typename Sig>
+  class AutoMethod {
+    public:
+      
+      typedef typename details::AutoSignature<Sig>::Return Return;
+      
+      template <Sig Ptr>
+      static MethodDecl Declare(const char *name, const char *desc, unsigned long flags=0) {
+        MethodDecl decl;
+        memset(&decl, 0, sizeof(MethodDecl));
+        decl.name = name;
+        details::AutoSignature<Sig>::Declare(decl.args);
+        decl.nargs = details::AutoSignature<Sig>::NumArgs;
+        decl.nargs += details::AutoDeclareReturn<Return>(decl.args[decl.nargs]);
+        decl.ptr = &details::AutoThunk<Sig, Ptr, Return>::Call;
+        decl.desc = desc;
+        decl.flags = flags;
+        return decl;
+      }
+  };
+  
+  // Signature deduction for LWC_AUTO_METHOD
+  template <typename Sig>
+  inline AutoMethod<Sig> AutoBind(Sig) {
+    return AutoMethod<Sig>();
+  }
+  
+#define LWC_AUTO_METHOD(Class, Name, Desc) lwc::AutoBind(&Class::Name).Declare<&Class::Name>(#Name, Desc)
+#define LWC_AUTO_METHOD_FLAGS(Class, Name, Desc, Flags) lwc::AutoBind(&Class::Name).Declare<&Class::Name>(#Name, Desc, Flags)
+  
   // Helper class to create a factory for a simple object type
   // "parent" attribute must also be a SimpleFactory
+  // Property declarations are optional (see LWC_FIELD and LWC_ACCESSORS)
   template <typename T>
   class SimpleFactory : public Factory {
     public:
       
-      SimpleFactory(MethodDecl *methods, size_t n, bool singleton=false, const char *desc=0, Factory *parent=0)
+      SimpleFactory(MethodDecl *methods, size_t n, bool singleton=false, const char *desc=0, Factory *parent=0,
+                    const PropertyDecl *properties=0, size_t nproperties=0)
         : Factory() {
         mMethodsDecl = methods;
         mNumMethods = n;
         mSingleton = singleton;
         mMethods = new MethodsTable(parent ? parent->getMethods(0) : 0);
         mMethods->fromDeclaration(methods, n);
+        if (properties) {
+          mMethods->fromDeclaration(properties, nproperties);
+        }
         mDesc = (desc == 0 ? "" : desc);
       }
       
       virtual ~SimpleFactory() {
-        for (size_t i=0; i<mNumMethods; ++i) {
-          delete mMethodsDecl[i].ptr;
-        }
         delete mMethods;
       }
       
+      void addInterfaces(const InterfaceDecl *interfaces, size_t n) throw(std::runtime_error) {
+        mMethods->fromDeclaration(interfaces, n);
+      }
+      
+      void addSignals(const MethodDecl *signals, size_t n) throw(std::runtime_error) {
+        mMethods->addSignals(signals, n);
+      }
+      
       virtual const MethodsTable* getMethods(const char *) {
         return mMethods;
       }
       
-      virtual Object* create(const char *) {
-        return new T();
+      virtual Object* create(const char *typeName) {
+        Object *o = acquire(typeName);
+        return (o ? o : new T());
       }
       
       virtual void destroy(Object *o) {
-        if (o) {
+        if (o && !release(o)) {
           delete o;
         }
       }
@@ -102,6 +525,46 @@ namespace lwc {
       std::cout << "cloader: Failed to register type \"" << Name << "\": " << e.what() << std::endl;\
     }
 
+#define LWC_MODULE_TYPE_WITH_PROPERTIES(Index, Name, Type, MethodsDecl, PropertiesDecl, Singleton, Description) \
+    gsTypeNames[Index] = Name;\
+    try {\
+      gsFactories[Index] = new lwc::SimpleFactory<Type>(MethodsDecl, LWC_NUMMETHODS(MethodsDecl), Singleton, Description, 0,\
+                                                        PropertiesDecl, LWC_NUMPROPERTIES(PropertiesDecl));\
+    } catch (std::exception &e) {\
+      gsFactories[Index] = 0;\
+      std::cout << "cloader: Failed to register type \"" << Name << "\": " << e.what() << std::endl;\
+    }
+
+#define LWC_MODULE_DERIVED_TYPE_WITH_PROPERTIES(Index, Name, Type, MethodsDecl, PropertiesDecl, Singleton, Description, ParentIndex) \
+    gsTypeNames[Index] = Name;\
+    try {\
+      gsFactories[Index] = new lwc::SimpleFactory<Type>(MethodsDecl, LWC_NUMMETHODS(MethodsDecl), Singleton, Description, gsFactories[ParentIndex],\
+                                                        PropertiesDecl, LWC_NUMPROPERTIES(PropertiesDecl));\
+    } catch (std::exception &e) {\
+      gsFactories[Index] = 0;\
+      std::cout << "cloader: Failed to register type \"" << Name << "\": " << e.what() << std::endl;\
+    }
+
+// Native interfaces of a type registered by one of the macros above
+#define LWC_MODULE_TYPE_INTERFACES(Index, Type, InterfacesDecl) \
+    if (gsFactories[Index] != 0) {\
+      try {\
+        static_cast<lwc::SimpleFactory<Type>*>(gsFactories[Index])->addInterfaces(InterfacesDecl, LWC_NUMINTERFACES(InterfacesDecl));\
+      } catch (std::exception &e) {\
+        std::cout << "cloader: Failed to register interfaces of type \"" << gsTypeNames[Index] << "\": " << e.what() << std::endl;\
+      }\
+    }
+
+// Signals of a type registered by one of the macros above (see lwc/signal.h)
+#define LWC_MODULE_TYPE_SIGNALS(Index, Type, SignalsDecl) \
+    if (gsFactories[Index] != 0) {\
+      try {\
+        static_cast<lwc::SimpleFactory<Type>*>(gsFactories[Index])->addSignals(SignalsDecl, LWC_NUMMETHODS(SignalsDecl));\
+      } catch (std::exception &e) {\
+        std::cout << "cloader: Failed to register signals of type \"" << gsTypeNames[Index] << "\": " << e.what() << std::endl;\
+      }\
+    }
+
 #define LWC_END_MODULE() \
   }\
   LWC_MODULE_EXPORT size_t LWC_ModuleGetTypeCount() {\
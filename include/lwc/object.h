@@ -25,159 +25,214 @@ USA.
 #define __lwc_object_h__
 
 #include <lwc/config.h>
-#include <lwc/method.h>
+#include <lwc/callsite.h>
+#include <lwc/interceptor.h>
 
 namespace lwc {
   
+  class LWC_API ResultCache;
+  class LWC_API Future;
+  class LWC_API Mailbox;
+  class LWC_API SignalQueue;
+  class LWC_API ObjectPool;
+  struct SignalConnections;
+  struct SignalSources;
+  
+  namespace details {
+    
+    template <typename T> struct IsEmpty {
+      enum {
+        Value = 0
+      };
+    };
+    
+    template <> struct IsEmpty<Empty> {
+      enum {
+        Value = 1
+      };
+    };
+    
+    // Number of actual arguments in a call argument pack (unused slots are Empty)
+    template <typename T0,  typename T1,  typename T2,  typename T3,
+              typename T4,  typename T5,  typename T6,  typename T7,
+              typename T8,  typename T9,  typename T10, typename T11,
+              typename T12, typename T13, typename T14, typename T15>
+    struct CallArity {
+      enum {
+        Value = 16 - (IsEmpty<T0>::Value  + IsEmpty<T1>::Value  + IsEmpty<T2>::Value  + IsEmpty<T3>::Value +
+                      IsEmpty<T4>::Value  + IsEmpty<T5>::Value  + IsEmpty<T6>::Value  + IsEmpty<T7>::Value +
+                      IsEmpty<T8>::Value  + IsEmpty<T9>::Value  + IsEmpty<T10>::Value + IsEmpty<T11>::Value +
+                      IsEmpty<T12>::Value + IsEmpty<T13>::Value + IsEmpty<T14>::Value + IsEmpty<T15>::Value)
+      };
+    };
+    
+    // Store positional argument N (no-op for unused slots)
+    template <size_t N, typename T> struct StoreArg {
+      static inline bool Do(MethodParams &params, T value, Status &status) {
+        return params.trySet(N, value, status, false);
+      }
+    };
+    
+    template <size_t N> struct StoreArg<N, Empty> {
+      static inline bool Do(MethodParams &, const Empty &, Status &) {
+        return true;
+      }
+    };
+  }
+  
+  // Either a method name, a pre-resolved MethodHandle or a CallSite
+  // Object::call overloads accept all, handles skip the method lookup and call
+  // sites also skip the keyword and default arguments resolution
+  class CallTarget {
+    public:
+      
+      CallTarget(const char *name)
+        : mName(name), mHandle(0), mSite(0) {
+      }
+      
+      CallTarget(const MethodHandle &handle)
+        : mName(handle.getName()), mHandle(&handle), mSite(0) {
+      }
+      
+      CallTarget(const CallSite &site)
+        : mName(site.getName()), mHandle(&(site.getHandle())), mSite(&site) {
+      }
+      
+      inline const char* getName() const {
+        return mName;
+      }
+      
+      inline const MethodHandle* getHandle() const {
+        return mHandle;
+      }
+      
+      inline const CallSite* getSite() const {
+        return mSite;
+      }
+      
+    private:
+      
+      const char *mName;
+      const MethodHandle *mHandle;
+      const CallSite *mSite;
+  };
+  
   class LWC_API Object {
     public:
       
+      // Call engine: the argument pack arity is a compile time constant, unused
+      // slots (Empty) compile to nothing and the arity is checked against the
+      // method required arguments mask computed when the method was registered
       template <typename T0=Empty,  typename T1=Empty,  typename T2=Empty,  typename T3=Empty,
                 typename T4=Empty,  typename T5=Empty,  typename T6=Empty,  typename T7=Empty,
                 typename T8=Empty,  typename T9=Empty,  typename T10=Empty, typename T11=Empty,
                 typename T12=Empty, typename T13=Empty, typename T14=Empty, typename T15=Empty>
       struct MethodCall {
-        static void Call(Object *self, const char *name, const KeywordArgs &kwargs,
-                         T0 arg0=T0(), T1 arg1=T1(), T2 arg2=T2(), T3 arg3=T3(),
-                         T4 arg4=T4(), T5 arg5=T5(), T6 arg6=T6(), T7 arg7=T7(),
-                         T8 arg8=T8(), T9 arg9=T9(), T10 arg10=T10(), T11 arg11=T11(),
-                         T12 arg12=T12(), T13 arg13=T13(), T14 arg14=T14(), T15 arg15=T15()) throw(std::runtime_error) {
+        
+        enum {
+          Arity = details::CallArity<T0, T1, T2,  T3,  T4,  T5,  T6,  T7,
+                                     T8, T9, T10, T11, T12, T13, T14, T15>::Value
+        };
+        
+        static bool Bind(const CallTarget &target, MethodParams &params, const KeywordArgs &kwargs, Status &status,
+                         T0 arg0, T1 arg1, T2 arg2, T3 arg3,
+                         T4 arg4, T5 arg5, T6 arg6, T7 arg7,
+                         T8 arg8, T9 arg9, T10 arg10, T11 arg11,
+                         T12 arg12, T13 arg13, T14 arg14, T15 arg15) {
           
-          if (!self->respondsTo(name)) {
-            std::ostringstream oss;
-            oss << "Object has not method \"" << name << "\"";
-            throw std::runtime_error(oss.str());
+          const Method &meth = params.getMethod();
+          const CallSite *site = target.getSite();
+          
+          if (site) {
+            if (!site->bind(params, size_t(Arity), kwargs, status)) {
+              return false;
+            }
+          } else if (size_t(Arity) != meth.numArgs() || !kwargs.empty()) {
+            if (!SetDefaultArgs(target.getName(), meth, params, size_t(Arity), (kwargs.empty() ? 0 : &kwargs), status)) {
+              return false;
+            }
           }
           
-          const Method &meth = self->getMethod(name);
+          if (details::StoreArg<0,  T0>::Do(params, arg0, status) &&
+              details::StoreArg<1,  T1>::Do(params, arg1, status) &&
+              details::StoreArg<2,  T2>::Do(params, arg2, status) &&
+              details::StoreArg<3,  T3>::Do(params, arg3, status) &&
+              details::StoreArg<4,  T4>::Do(params, arg4, status) &&
+              details::StoreArg<5,  T5>::Do(params, arg5, status) &&
+              details::StoreArg<6,  T6>::Do(params, arg6, status) &&
+              details::StoreArg<7,  T7>::Do(params, arg7, status) &&
+              details::StoreArg<8,  T8>::Do(params, arg8, status) &&
+              details::StoreArg<9,  T9>::Do(params, arg9, status) &&
+              details::StoreArg<10, T10>::Do(params, arg10, status) &&
+              details::StoreArg<11, T11>::Do(params, arg11, status) &&
+              details::StoreArg<12, T12>::Do(params, arg12, status) &&
+              details::StoreArg<13, T13>::Do(params, arg13, status) &&
+              details::StoreArg<14, T14>::Do(params, arg14, status) &&
+              details::StoreArg<15, T15>::Do(params, arg15, status)) {
+            return true;
+          }
           
-          static const std::type_info &emptytype = typeid(Empty);
+          status.setMethodName(target.getName());
+          return false;
+        }
+        
+        static void Call(Object *self, const CallTarget &target, const KeywordArgs &kwargs,
+                         T0 arg0=T0(), T1 arg1=T1(), T2 arg2=T2(), T3 arg3=T3(),
+                         T4 arg4=T4(), T5 arg5=T5(), T6 arg6=T6(), T7 arg7=T7(),
+                         T8 arg8=T8(), T9 arg9=T9(), T10 arg10=T10(), T11 arg11=T11(),
+                         T12 arg12=T12(), T13 arg13=T13(), T14 arg14=T14(), T15 arg15=T15()) throw(std::runtime_error) {
           
-          MethodParams params(meth);
+          Status status;
           
-          // Set keyworkds arguments
-          // -> must be set before as SETPARAMORCALL may return
+          const Method *meth = self->findMethod(target, status);
           
-          KeywordArgs::const_iterator it = kwargs.begin();
-          while (it != kwargs.end()) {
-            size_t idx = meth.namedArgIndex(it->first.c_str());
-            const Argument &ma = meth[idx];
-            if (!it->second.typeMatches(ma)) {
-              // at the time keyword arguments are set, we don't know yet which
-              // method they will be applied to, so don't know the exact target type
-              // for plain type, we should allow int to real and real to int conversions
-              // as allow in Argument::setValue, MethodParams::set/setn
-              if (ma.indirectionLevel() == 0 && // plain type
-                  it->second.indirectionLevel() == ma.indirectionLevel() &&
-                  ((it->second.getType() == AT_INT && // int -> real
-                    ma.getType() == AT_REAL) ||
-                   (it->second.getType() == AT_REAL && // real -> int
-                    ma.getType() == AT_INT))) {
-                ArgumentValue av;
-                if (ma.getType() == AT_REAL) {
-                  it->second.getValue(av.real);
-                } else {
-                  it->second.getValue(av.integer);
-                }
-                params.rawsetn(it->first.c_str(), av);
-              } else {
-                std::ostringstream oss;
-                oss << "In method \"" << name << "\": Keyword argument type mismatch";
-                throw std::runtime_error(oss.str());
-              }
-            } else {
-              params.rawsetn(it->first.c_str(), it->second.getRawValue());
-            }
-            ++it;
+          if (!meth) {
+            throw std::runtime_error(status.getMessage());
           }
           
-#define SETPARAMORCALL(n) \
-          if (typeid(T##n) == emptytype) {\
-            if (n < meth.numArgs()) {\
-              size_t nn = n;\
-              while (nn < meth.numArgs()) {\
-                const Argument &ma = meth[nn];\
-                bool ignoreKwarg = (ma.isNamed() && kwargs.find(ma.getName()) != kwargs.end());\
-                if (ma.hasDefaultValue()) {\
-                  if (!ignoreKwarg) {\
-                    try {\
-                      params.rawset(nn, ma.getRawDefaultValue(), false);\
-                    } catch (std::exception &e) {\
-                      std::ostringstream oss;\
-                      oss << "In method \"" << name << "\": " << e.what();\
-                      throw std::runtime_error(oss.str());\
-                    }\
-                  }\
-                  ++nn;\
-                } else {\
-                  if (ignoreKwarg) {\
-                    ++nn;\
-                    continue;\
-                  } else {\
-                    break;\
-                  }\
-                }\
-              }\
-              if (meth.numArgs() != nn) {\
-                std::ostringstream oss;\
-                oss << "Method \"" << name << "\" expects " << meth.numArgs() << " arguments";\
-                throw std::runtime_error(oss.str());\
-              }\
-            }\
-            self->call(name, params);\
-            return;\
-          } else {\
-            if (n >= meth.numPositionalArgs()) {\
-              if (kwargs.find(meth[n].getName()) != kwargs.end()) {\
-                std::ostringstream oss;\
-                oss << "Method \"" << name << "\" keyword argument \"" << meth[n].getName() << "\" is set twice";\
-                throw std::runtime_error(oss.str());\
-              }\
-            }\
-            try {\
-              params.set(size_t(n), arg##n, false);\
-            } catch (std::exception &e) {\
-              std::ostringstream oss;\
-              oss << "In method \"" << name << "\": " << e.what();\
-              throw std::runtime_error(oss.str());\
-            }\
+          MethodParams params(*meth);
+          
+          if (!Bind(target, params, kwargs, status,
+                    arg0, arg1, arg2, arg3, arg4, arg5, arg6, arg7,
+                    arg8, arg9, arg10, arg11, arg12, arg13, arg14, arg15)) {
+            throw std::runtime_error(status.getMessage());
           }
           
-          // Set positional arguments
+          self->dispatch(target.getName(), params);
+        }
+        
+        static Status TryCall(Object *self, const CallTarget &target, const KeywordArgs &kwargs,
+                              T0 arg0=T0(), T1 arg1=T1(), T2 arg2=T2(), T3 arg3=T3(),
+                              T4 arg4=T4(), T5 arg5=T5(), T6 arg6=T6(), T7 arg7=T7(),
+                              T8 arg8=T8(), T9 arg9=T9(), T10 arg10=T10(), T11 arg11=T11(),
+                              T12 arg12=T12(), T13 arg13=T13(), T14 arg14=T14(), T15 arg15=T15()) {
           
-          SETPARAMORCALL(0)
-          SETPARAMORCALL(1)
-          SETPARAMORCALL(2)
-          SETPARAMORCALL(3)
-          SETPARAMORCALL(4)
-          SETPARAMORCALL(5)
-          SETPARAMORCALL(6)
-          SETPARAMORCALL(7)
-          SETPARAMORCALL(8)
-          SETPARAMORCALL(9)
-          SETPARAMORCALL(10)
-          SETPARAMORCALL(11)
-          SETPARAMORCALL(12)
-          SETPARAMORCALL(13)
-          SETPARAMORCALL(14)
-          SETPARAMORCALL(15)
+          Status status;
           
-#undef SETPARAMORCALL
+          const Method *meth = self->findMethod(target, status);
           
-          if (meth.numPositionalArgs() != LWC_MAX_POSITIONAL_ARGS) {
-            std::ostringstream oss;
-            oss << "Method \"" << name << "\" expects " << meth.numArgs() << " arguments";
-            throw std::runtime_error(oss.str());
+          if (meth) {
+            MethodParams params(*meth);
+            if (Bind(target, params, kwargs, status,
+                     arg0, arg1, arg2, arg3, arg4, arg5, arg6, arg7,
+                     arg8, arg9, arg10, arg11, arg12, arg13, arg14, arg15)) {
+              self->tryDispatch(target.getName(), params, status);
+            }
           }
-          self->call(name, params);
+          
+          return status;
         }
       };
-          
+      
     public:
       
       Object();
+      Object(const Object &rhs);
       virtual ~Object();
       
+      // memoized results are not copied
+      Object& operator=(const Object &rhs);
+      
       
       inline const char* getLoaderName() const {
         return mLoaderName.c_str();
@@ -214,77 +269,359 @@ namespace lwc {
         return *m;
       }
       
-      virtual void call(const char *name, MethodParams &params) throw(std::runtime_error);
+      inline const Method& getMethod(const CallTarget &target) const throw(std::runtime_error) {
+        Status status;
+        const Method *m = findMethod(target, status);
+        if (!m) {
+          throw std::runtime_error(status.getMessage());
+        }
+        return *m;
+      }
+      
+      // exception free method lookup
+      inline const Method* findMethod(const CallTarget &target, Status &status) const {
+        const MethodHandle *handle = target.getHandle();
+        if (handle) {
+          if (handle->getMethodsTable() != mMethods || !handle->isValid()) {
+            status.set(EC_INVALID_HANDLE, handle->getName(), -1, mTypeName.c_str());
+            return 0;
+          }
+          return &(handle->getMethod());
+        }
+        const Method *m = (mMethods ? mMethods->findMethod(target.getName()) : 0);
+        if (!m) {
+          status.set(EC_NO_METHOD, target.getName());
+        }
+        return m;
+      }
+      
+      // Properties: values read and written without building MethodParams
       
-      void call(const char *name, const KeywordArgs &kwargs=NoKeywordArgs) throw(std::runtime_error) {
-        MethodCall<Empty>::Call(this, name, kwargs);
+      inline const Property* findProperty(const char *name) const {
+        return (mMethods ? mMethods->findProperty(name) : 0);
       }
       
+      inline size_t availableProperties(std::vector<std::string> &names) const {
+        names.clear();
+        if (mMethods) {
+          return mMethods->availableProperties(names);
+        } else {
+          return 0;
+        }
+      }
+      
+      // Read or write p on the mailbox owner thread if any (see setMailbox),
+      // writeProperty returns false for read only properties
+      void readProperty(const Property &p, ArgumentValue &value) const throw(std::runtime_error);
+      bool writeProperty(const Property &p, const ArgumentValue &value) throw(std::runtime_error);
+      
+      template <typename T>
+      T getProperty(const char *name) const throw(std::runtime_error) {
+        ArgumentValue value;
+        readProperty(findTypedProperty(name, Type(Type2Enum<T>::Enum)), value);
+        return PropertyValue<T>::Get(value);
+      }
+      
+      template <typename T>
+      void setProperty(const char *name, T val) throw(std::runtime_error) {
+        ArgumentValue value;
+        PropertyValue<T>::Set(value, val);
+        if (!writeProperty(findTypedProperty(name, Type(Type2Enum<T>::Enum)), value)) {
+          std::ostringstream oss;
+          oss << "Property \"" << name << "\" is read only";
+          throw std::runtime_error(oss.str());
+        }
+      }
+      
+      // Native interfaces (see LWC_INTERFACE): typed pointer for direct C++
+      // calls, 0 if the object does not implement it (script objects never do)
+      // in which case callers fall back to the reflective methods
+      
+      inline void* queryInterface(const char *name) {
+        InterfaceCast cast = (mMethods ? mMethods->findInterface(name) : 0);
+        return (cast ? cast(this) : 0);
+      }
+      
+      template <class I>
+      inline I* queryInterface() {
+        return static_cast<I*>(queryInterface(I::InterfaceName()));
+      }
+      
+      // Results of memoized methods (see MF_PURE) are cached per object, objects
+      // must call invalidateResults whenever a state change affects them.
+      // Every call path goes through the cache, except callBatch when the
+      // whole batch is handed to invokeBatch.
+      
+      void invalidateResults();
+      
+      // Cache lookups counters since the object creation
+      void getResultStats(unsigned long &hits, unsigned long &misses) const;
+      
+      // Actor mode (see lwc::Mailbox in lwc/actor.h): calls from other threads
+      // than the mailbox owner are queued and run by the owner thread.
+      // 0 to call the object directly again (no call may be in progress)
+      inline void setMailbox(Mailbox *mailbox) {
+        mMailbox = mailbox;
+      }
+      
+      inline Mailbox* getMailbox() const {
+        return mMailbox;
+      }
+      
+      // Fire and forget call (input arguments only): queued without waiting
+      // for actors, called directly otherwise (failures are then thrown)
+      void post(const CallTarget &target, const MethodParams &params) throw(std::runtime_error);
+      
+      // Signals (see lwc/signal.h, include it to use emit with typed arguments)
+      // The slot method of listener must take the signal arguments first (same
+      // types, inputs), any other argument must have a default value. Without
+      // queue the slot is called by the emitting thread, otherwise the event is
+      // queued and delivered by SignalQueue::process.
+      // Connections must not be changed while the object emits from another
+      // thread. Destroying a listener or a queue removes its connections,
+      // events already queued for a listener must be delivered first
+      
+      void connect(const char *signal, Object *listener, const char *slot, SignalQueue *queue=0) throw(std::runtime_error);
+      
+      // Remove connections of signal to listener (all its slots if slot is 0),
+      // returns the number of connections removed
+      size_t disconnect(const char *signal, Object *listener, const char *slot=0);
+      
+      // Remove all the connections of this object signals
+      void disconnectAll();
+      
+      size_t numConnections(const char *signal=0) const;
+      
+      // Number of connections to a slot of this object
+      size_t numIncomingConnections() const;
+      
+      inline bool hasConnections() const {
+        return (mConnections != 0);
+      }
+      
+      inline const Method* findSignal(const char *name) const {
+        return (mMethods ? mMethods->findSignal(name) : 0);
+      }
+      
+      // Emit signal with raw values (one per signal argument, as set by
+      // details::GetSet). Exception free, synchronous slot failures are
+      // reported by the returned status (first one), all slots are still called.
+      // Signals without connections return immediately
+      inline Status emitValues(const char *signal, const ArgumentValue *values, size_t n) {
+        Status status;
+        if (mConnections) {
+          emitSignal(signal, values, n, status);
+        }
+        return status;
+      }
+      
+      Status emit(const char *signal);
+      
       template <typename T0>
-      void call(const char *name, T0 arg0, const KeywordArgs &kwargs=NoKeywordArgs) throw(std::runtime_error) {
-        MethodCall<T0>::Call(this, name, kwargs, arg0);
+      Status emit(const char *signal, T0 arg0);
+      
+      template <typename T0, typename T1>
+      Status emit(const char *signal, T0 arg0, T1 arg1);
+      
+      template <typename T0, typename T1, typename T2>
+      Status emit(const char *signal, T0 arg0, T1 arg1, T2 arg2);
+      
+      template <typename T0, typename T1, typename T2, typename T3>
+      Status emit(const char *signal, T0 arg0, T1 arg1, T2 arg2, T3 arg3);
+      
+      template <typename T0, typename T1, typename T2, typename T3,
+                typename T4>
+      Status emit(const char *signal,
+                  T0 arg0, T1 arg1, T2 arg2, T3 arg3,
+                  T4 arg4);
+      
+      template <typename T0, typename T1, typename T2, typename T3,
+                typename T4, typename T5>
+      Status emit(const char *signal,
+                  T0 arg0, T1 arg1, T2 arg2, T3 arg3,
+                  T4 arg4, T5 arg5);
+      
+      template <typename T0, typename T1, typename T2, typename T3,
+                typename T4, typename T5, typename T6>
+      Status emit(const char *signal,
+                  T0 arg0, T1 arg1, T2 arg2, T3 arg3,
+                  T4 arg4, T5 arg5, T6 arg6);
+      
+      template <typename T0, typename T1, typename T2, typename T3,
+                typename T4, typename T5, typename T6, typename T7>
+      Status emit(const char *signal,
+                  T0 arg0, T1 arg1, T2 arg2, T3 arg3,
+                  T4 arg4, T5 arg5, T6 arg6, T7 arg7);
+      
+      // Whether different objects can be called from several threads at once
+      // (see parallel::Executor::broadcast), script objects return false as their
+      // interpreter cannot run concurrently
+      virtual bool allowsConcurrentCalls() const {
+        return true;
+      }
+      
+      // Instance pools (see Registry::setPool): restore the state of a newly
+      // created object before a destroyed instance is kept for reuse. Return
+      // false to have it deleted instead (the default, types must opt in)
+      virtual bool recycle();
+      
+      inline MethodHandle getMethodHandle(const char *name) const throw(std::runtime_error) {
+        return MethodHandle(mMethods, name);
       }
       
+      // Same path as the other call overloads (mailbox, interceptors, results
+      // cache and return value), params must have been created for name
+      void call(const char *name, MethodParams &params) throw(std::runtime_error);
+      
+      inline void call(const MethodHandle &handle, MethodParams &params) throw(std::runtime_error) {
+        if (&(getMethod(handle)) != &(params.getMethod())) {
+          std::ostringstream oss;
+          oss << "Method handle \"" << handle.getName() << "\" does not match parameters";
+          throw std::runtime_error(oss.str());
+        }
+        dispatch(handle.getName(), params);
+      }
+      
+      // Call one method over n parameter sets (all created for that method).
+      // The method is resolved once and the whole batch goes through a single
+      // invokeBatch dispatch so that script objects can process it with one
+      // transition to the interpreter
+      void callBatch(const CallTarget &target, MethodParams **params, size_t n) throw(std::runtime_error);
+      
+      // Asynchronous calls (defined in lwc/future.h, include it to use them)
+      // Only the input and in/out argument values are passed, in declaration
+      // order, missing ones take their default value. The returned future
+      // (deleted by the caller) owns the parameters and the output values.
+      // Invalid calls throw, failures of the call itself are reported by the
+      // future status
+      
+      Future* callAsync(const CallTarget &target) throw(std::runtime_error);
+      
+      template <typename T0>
+      Future* callAsync(const CallTarget &target, T0 arg0) throw(std::runtime_error);
+      
       template <typename T0, typename T1>
-      void call(const char *name, T0 arg0, T1 arg1, const KeywordArgs &kwargs=NoKeywordArgs) throw(std::runtime_error) {
-        MethodCall<T0,T1>::Call(this, name, kwargs, arg0, arg1);
+      Future* callAsync(const CallTarget &target, T0 arg0, T1 arg1) throw(std::runtime_error);
+      
+      template <typename T0, typename T1, typename T2>
+      Future* callAsync(const CallTarget &target, T0 arg0, T1 arg1, T2 arg2) throw(std::runtime_error);
+      
+      template <typename T0, typename T1, typename T2, typename T3>
+      Future* callAsync(const CallTarget &target, T0 arg0, T1 arg1, T2 arg2, T3 arg3) throw(std::runtime_error);
+      
+      template <typename T0, typename T1, typename T2, typename T3,
+                typename T4>
+      Future* callAsync(const CallTarget &target,
+                        T0 arg0, T1 arg1, T2 arg2, T3 arg3,
+                        T4 arg4) throw(std::runtime_error);
+      
+      template <typename T0, typename T1, typename T2, typename T3,
+                typename T4, typename T5>
+      Future* callAsync(const CallTarget &target,
+                        T0 arg0, T1 arg1, T2 arg2, T3 arg3,
+                        T4 arg4, T5 arg5) throw(std::runtime_error);
+      
+      template <typename T0, typename T1, typename T2, typename T3,
+                typename T4, typename T5, typename T6>
+      Future* callAsync(const CallTarget &target,
+                        T0 arg0, T1 arg1, T2 arg2, T3 arg3,
+                        T4 arg4, T5 arg5, T6 arg6) throw(std::runtime_error);
+      
+      template <typename T0, typename T1, typename T2, typename T3,
+                typename T4, typename T5, typename T6, typename T7>
+      Future* callAsync(const CallTarget &target,
+                        T0 arg0, T1 arg1, T2 arg2, T3 arg3,
+                        T4 arg4, T5 arg5, T6 arg6, T7 arg7) throw(std::runtime_error);
+      
+      // Exception free calls: errors are reported by the returned Status
+      // (exceptions raised by the method implementation are caught and
+      // reported as EC_FAILED)
+      
+      inline Status tryCall(const CallTarget &target, MethodParams &params) {
+        Status status;
+        const MethodHandle *handle = target.getHandle();
+        if (handle && (handle->getMethodsTable() != mMethods || !handle->isValid() ||
+                       &(handle->getMethod()) != &(params.getMethod()))) {
+          status.set(EC_INVALID_HANDLE, target.getName(), -1, mTypeName.c_str());
+        } else {
+          tryDispatch(target.getName(), params, status);
+        }
+        return status;
+      }
+      
+      Status tryCall(const CallTarget &target, const KeywordArgs &kwargs=NoKeywordArgs) {
+        return MethodCall<Empty>::TryCall(this, target, kwargs);
+      }
+      
+      void call(const CallTarget &target, const KeywordArgs &kwargs=NoKeywordArgs) throw(std::runtime_error) {
+        MethodCall<Empty>::Call(this, target, kwargs);
+      }
+      
+      template <typename T0>
+      void call(const CallTarget &target, T0 arg0, const KeywordArgs &kwargs=NoKeywordArgs) throw(std::runtime_error) {
+        MethodCall<T0>::Call(this, target, kwargs, arg0);
+      }
+      
+      template <typename T0, typename T1>
+      void call(const CallTarget &target, T0 arg0, T1 arg1, const KeywordArgs &kwargs=NoKeywordArgs) throw(std::runtime_error) {
+        MethodCall<T0,T1>::Call(this, target, kwargs, arg0, arg1);
       }
       
       template <typename T0, typename T1, typename T2>
-      void call(const char *name,
+      void call(const CallTarget &target,
                 T0 arg0, T1 arg1, T2 arg2, const KeywordArgs &kwargs=NoKeywordArgs) throw(std::runtime_error) {
-        MethodCall<T0,T1,T2>::Call(this, name, kwargs, arg0, arg1, arg2);
+        MethodCall<T0,T1,T2>::Call(this, target, kwargs, arg0, arg1, arg2);
       }
       
       template <typename T0, typename T1, typename T2, typename T3>
-      void call(const char *name,
+      void call(const CallTarget &target,
                 T0 arg0, T1 arg1, T2 arg2, T3 arg3, const KeywordArgs &kwargs=NoKeywordArgs) throw(std::runtime_error) {
-        MethodCall<T0,T1,T2,T3>::Call(this, name, kwargs, arg0, arg1, arg2, arg3);
+        MethodCall<T0,T1,T2,T3>::Call(this, target, kwargs, arg0, arg1, arg2, arg3);
       }
       
       template <typename T0, typename T1, typename T2, typename T3,
                 typename T4>
-      void call(const char *name,
+      void call(const CallTarget &target,
                 T0 arg0, T1 arg1, T2 arg2, T3 arg3,
                 T4 arg4, const KeywordArgs &kwargs=NoKeywordArgs) throw(std::runtime_error) {
-        MethodCall<T0,T1,T2,T3,T4>::Call(this, name, kwargs, arg0, arg1, arg2, arg3, arg4);
+        MethodCall<T0,T1,T2,T3,T4>::Call(this, target, kwargs, arg0, arg1, arg2, arg3, arg4);
       }
       
       template <typename T0, typename T1, typename T2, typename T3,
                 typename T4, typename T5>
-      void call(const char *name,
+      void call(const CallTarget &target,
                 T0 arg0, T1 arg1, T2 arg2, T3 arg3,
                 T4 arg4, T5 arg5, const KeywordArgs &kwargs=NoKeywordArgs) throw(std::runtime_error) {
-        MethodCall<T0,T1,T2,T3,T4,T5>::Call(this, name, kwargs, arg0, arg1, arg2, arg3,
+        MethodCall<T0,T1,T2,T3,T4,T5>::Call(this, target, kwargs, arg0, arg1, arg2, arg3,
                                             arg4, arg5);
       }
       
       template <typename T0, typename T1, typename T2, typename T3,
                 typename T4, typename T5, typename T6>
-      void call(const char *name,
+      void call(const CallTarget &target,
                 T0 arg0, T1 arg1, T2 arg2, T3 arg3,
                 T4 arg4, T5 arg5, T6 arg6, const KeywordArgs &kwargs=NoKeywordArgs) throw(std::runtime_error) {
-        MethodCall<T0,T1,T2,T3,T4,T5,T6>::Call(this, name, kwargs, arg0, arg1, arg2, arg3,
+        MethodCall<T0,T1,T2,T3,T4,T5,T6>::Call(this, target, kwargs, arg0, arg1, arg2, arg3,
                                                arg4, arg5, arg6);
       }
       
       template <typename T0, typename T1, typename T2, typename T3,
                 typename T4, typename T5, typename T6, typename T7>
-      void call(const char *name,
+      void call(const CallTarget &target,
                 T0 arg0, T1 arg1, T2 arg2, T3 arg3,
                 T4 arg4, T5 arg5, T6 arg6, T7 arg7, const KeywordArgs &kwargs=NoKeywordArgs) throw(std::runtime_error) {
-        MethodCall<T0,T1,T2,T3,T4,T5,T6,T7>::Call(this, name, kwargs, arg0, arg1, arg2,
+        MethodCall<T0,T1,T2,T3,T4,T5,T6,T7>::Call(this, target, kwargs, arg0, arg1, arg2,
                                                   arg3, arg4, arg5, arg6, arg7);
       }
       
       template <typename T0, typename T1, typename T2, typename T3,
                 typename T4, typename T5, typename T6, typename T7,
                 typename T8>
-      void call(const char *name,
+      void call(const CallTarget &target,
                 T0 arg0, T1 arg1, T2 arg2, T3 arg3,
                 T4 arg4, T5 arg5, T6 arg6, T7 arg7,
                 T8 arg8, const KeywordArgs &kwargs=NoKeywordArgs) throw(std::runtime_error) {
-        MethodCall<T0,T1,T2,T3,T4,T5,T6,T7,T8>::Call(this, name, kwargs, arg0, arg1, arg2,
+        MethodCall<T0,T1,T2,T3,T4,T5,T6,T7,T8>::Call(this, target, kwargs, arg0, arg1, arg2,
                                                      arg3, arg4, arg5, arg6, arg7,
                                                      arg8);
       }
@@ -292,11 +629,11 @@ namespace lwc {
       template <typename T0, typename T1, typename T2, typename T3,
                 typename T4, typename T5, typename T6, typename T7,
                 typename T8, typename T9>
-      void call(const char *name,
+      void call(const CallTarget &target,
                 T0 arg0, T1 arg1, T2 arg2, T3 arg3,
                 T4 arg4, T5 arg5, T6 arg6, T7 arg7,
                 T8 arg8, T9 arg9, const KeywordArgs &kwargs=NoKeywordArgs) throw(std::runtime_error) {
-        MethodCall<T0,T1,T2,T3,T4,T5,T6,T7,T8,T9>::Call(this, name, kwargs, arg0, arg1, arg2,
+        MethodCall<T0,T1,T2,T3,T4,T5,T6,T7,T8,T9>::Call(this, target, kwargs, arg0, arg1, arg2,
                                                         arg3, arg4, arg5, arg6, arg7,
                                                         arg8, arg9);
       }
@@ -304,11 +641,11 @@ namespace lwc {
       template <typename T0, typename T1, typename T2, typename T3,
                 typename T4, typename T5, typename T6, typename T7,
                 typename T8, typename T9, typename T10>
-      void call(const char *name,
+      void call(const CallTarget &target,
                 T0 arg0, T1 arg1, T2 arg2, T3 arg3,
                 T4 arg4, T5 arg5, T6 arg6, T7 arg7,
                 T8 arg8, T9 arg9, T10 arg10, const KeywordArgs &kwargs=NoKeywordArgs) throw(std::runtime_error) {
-        MethodCall<T0,T1,T2,T3,T4,T5,T6,T7,T8,T9,T10>::Call(this, name, kwargs, arg0, arg1, arg2,
+        MethodCall<T0,T1,T2,T3,T4,T5,T6,T7,T8,T9,T10>::Call(this, target, kwargs, arg0, arg1, arg2,
                                                             arg3, arg4, arg5, arg6, arg7,
                                                             arg8, arg9, arg10);
       }
@@ -316,11 +653,11 @@ namespace lwc {
       template <typename T0, typename T1, typename T2, typename T3,
                 typename T4, typename T5, typename T6, typename T7,
                 typename T8, typename T9, typename T10, typename T11>
-      void call(const char *name,
+      void call(const CallTarget &target,
                 T0 arg0, T1 arg1, T2 arg2, T3 arg3,
                 T4 arg4, T5 arg5, T6 arg6, T7 arg7,
                 T8 arg8, T9 arg9, T10 arg10, T11 arg11, const KeywordArgs &kwargs=NoKeywordArgs) throw(std::runtime_error) {
-        MethodCall<T0,T1,T2,T3,T4,T5,T6,T7,T8,T9,T10,T11>::Call(this, name, kwargs, arg0, arg1, arg2,
+        MethodCall<T0,T1,T2,T3,T4,T5,T6,T7,T8,T9,T10,T11>::Call(this, target, kwargs, arg0, arg1, arg2,
                                                                 arg3, arg4, arg5, arg6, arg7,
                                                                 arg8, arg9, arg10, arg11);
       }
@@ -329,12 +666,12 @@ namespace lwc {
                 typename T4, typename T5, typename T6, typename T7,
                 typename T8, typename T9, typename T10, typename T11,
                 typename T12>
-      void call(const char *name,
+      void call(const CallTarget &target,
                 T0 arg0, T1 arg1, T2 arg2, T3 arg3,
                 T4 arg4, T5 arg5, T6 arg6, T7 arg7,
                 T8 arg8, T9 arg9, T10 arg10, T11 arg11,
                 T12 arg12, const KeywordArgs &kwargs=NoKeywordArgs) throw(std::runtime_error) {
-        MethodCall<T0,T1,T2,T3,T4,T5,T6,T7,T8,T9,T10,T11,T12>::Call(this, name, kwargs, arg0, arg1, arg2,
+        MethodCall<T0,T1,T2,T3,T4,T5,T6,T7,T8,T9,T10,T11,T12>::Call(this, target, kwargs, arg0, arg1, arg2,
                                                                     arg3, arg4, arg5, arg6, arg7,
                                                                     arg8, arg9, arg10, arg11, arg12);
       }
@@ -343,12 +680,12 @@ namespace lwc {
                 typename T4, typename T5, typename T6, typename T7,
                 typename T8, typename T9, typename T10, typename T11,
                 typename T12, typename T13>
-      void call(const char *name,
+      void call(const CallTarget &target,
                 T0 arg0, T1 arg1, T2 arg2, T3 arg3,
                 T4 arg4, T5 arg5, T6 arg6, T7 arg7,
                 T8 arg8, T9 arg9, T10 arg10, T11 arg11,
                 T12 arg12, T13 arg13, const KeywordArgs &kwargs=NoKeywordArgs) throw(std::runtime_error) {
-        MethodCall<T0,T1,T2,T3,T4,T5,T6,T7,T8,T9,T10,T11,T12,T13>::Call(this, name, kwargs, arg0, arg1, arg2,
+        MethodCall<T0,T1,T2,T3,T4,T5,T6,T7,T8,T9,T10,T11,T12,T13>::Call(this, target, kwargs, arg0, arg1, arg2,
                                                                         arg3, arg4, arg5, arg6, arg7,
                                                                         arg8, arg9, arg10, arg11, arg12,
                                                                         arg13);
@@ -358,12 +695,12 @@ namespace lwc {
                 typename T4, typename T5, typename T6, typename T7,
                 typename T8, typename T9, typename T10, typename T11,
                 typename T12, typename T13, typename T14>
-      void call(const char *name,
+      void call(const CallTarget &target,
                 T0 arg0, T1 arg1, T2 arg2, T3 arg3,
                 T4 arg4, T5 arg5, T6 arg6, T7 arg7,
                 T8 arg8, T9 arg9, T10 arg10, T11 arg11,
                 T12 arg12, T13 arg13, T14 arg14, const KeywordArgs &kwargs=NoKeywordArgs) throw(std::runtime_error) {
-        MethodCall<T0,T1,T2,T3,T4,T5,T6,T7,T8,T9,T10,T11,T12,T13,T14>::Call(this, name, kwargs, arg0, arg1, arg2,
+        MethodCall<T0,T1,T2,T3,T4,T5,T6,T7,T8,T9,T10,T11,T12,T13,T14>::Call(this, target, kwargs, arg0, arg1, arg2,
                                                                             arg3, arg4, arg5, arg6, arg7,
                                                                             arg8, arg9, arg10, arg11, arg12,
                                                                             arg13, arg14);
@@ -373,21 +710,294 @@ namespace lwc {
                 typename T4, typename T5, typename T6, typename T7,
                 typename T8, typename T9, typename T10, typename T11,
                 typename T12, typename T13, typename T14, typename T15>
-      void call(const char *name,
+      void call(const CallTarget &target,
                 T0 arg0, T1 arg1, T2 arg2, T3 arg3,
                 T4 arg4, T5 arg5, T6 arg6, T7 arg7,
                 T8 arg8, T9 arg9, T10 arg10, T11 arg11,
                 T12 arg12, T13 arg13, T14 arg14, T15 arg15, const KeywordArgs &kwargs=NoKeywordArgs) throw(std::runtime_error) {
-        MethodCall<T0,T1,T2,T3,T4,T5,T6,T7,T8,T9,T10,T11,T12,T13,T14,T15>::Call(this, name, kwargs, arg0, arg1, arg2,
+        MethodCall<T0,T1,T2,T3,T4,T5,T6,T7,T8,T9,T10,T11,T12,T13,T14,T15>::Call(this, target, kwargs, arg0, arg1, arg2,
                                                                                 arg3, arg4, arg5, arg6, arg7,
                                                                                 arg8, arg9, arg10, arg11, arg12,
                                                                                 arg13, arg14, arg15);
       }
       
+      template <typename T0>
+      Status tryCall(const CallTarget &target, T0 arg0, const KeywordArgs &kwargs=NoKeywordArgs) {
+        return MethodCall<T0>::TryCall(this, target, kwargs, arg0);
+      }
+      
+      template <typename T0, typename T1>
+      Status tryCall(const CallTarget &target, T0 arg0, T1 arg1, const KeywordArgs &kwargs=NoKeywordArgs) {
+        return MethodCall<T0,T1>::TryCall(this, target, kwargs, arg0, arg1);
+      }
+      
+      template <typename T0, typename T1, typename T2>
+      Status tryCall(const CallTarget &target,
+                    T0 arg0, T1 arg1, T2 arg2, const KeywordArgs &kwargs=NoKeywordArgs) {
+        return MethodCall<T0,T1,T2>::TryCall(this, target, kwargs, arg0, arg1, arg2);
+      }
+      
+      template <typename T0, typename T1, typename T2, typename T3>
+      Status tryCall(const CallTarget &target,
+                    T0 arg0, T1 arg1, T2 arg2, T3 arg3, const KeywordArgs &kwargs=NoKeywordArgs) {
+        return MethodCall<T0,T1,T2,T3>::TryCall(this, target, kwargs, arg0, arg1, arg2, arg3);
+      }
+      
+      template <typename T0, typename T1, typename T2, typename T3,
+                typename T4>
+      Status tryCall(const CallTarget &target,
+                    T0 arg0, T1 arg1, T2 arg2, T3 arg3,
+                    T4 arg4, const KeywordArgs &kwargs=NoKeywordArgs) {
+        return MethodCall<T0,T1,T2,T3,T4>::TryCall(this, target, kwargs, arg0, arg1, arg2, arg3, arg4);
+      }
+      
+      template <typename T0, typename T1, typename T2, typename T3,
+                typename T4, typename T5>
+      Status tryCall(const CallTarget &target,
+                    T0 arg0, T1 arg1, T2 arg2, T3 arg3,
+                    T4 arg4, T5 arg5, const KeywordArgs &kwargs=NoKeywordArgs) {
+        return MethodCall<T0,T1,T2,T3,T4,T5>::TryCall(this, target, kwargs, arg0, arg1, arg2, arg3,
+                                                      arg4, arg5);
+      }
+      
+      template <typename T0, typename T1, typename T2, typename T3,
+                typename T4, typename T5, typename T6>
+      Status tryCall(const CallTarget &target,
+                    T0 arg0, T1 arg1, T2 arg2, T3 arg3,
+                    T4 arg4, T5 arg5, T6 arg6, const KeywordArgs &kwargs=NoKeywordArgs) {
+        return MethodCall<T0,T1,T2,T3,T4,T5,T6>::TryCall(this, target, kwargs, arg0, arg1, arg2, arg3,
+                                                         arg4, arg5, arg6);
+      }
+      
+      template <typename T0, typename T1, typename T2, typename T3,
+                typename T4, typename T5, typename T6, typename T7>
+      Status tryCall(const CallTarget &target,
+                    T0 arg0, T1 arg1, T2 arg2, T3 arg3,
+                    T4 arg4, T5 arg5, T6 arg6, T7 arg7, const KeywordArgs &kwargs=NoKeywordArgs) {
+        return MethodCall<T0,T1,T2,T3,T4,T5,T6,T7>::TryCall(this, target, kwargs, arg0, arg1, arg2,
+                                                            arg3, arg4, arg5, arg6, arg7);
+      }
+      
+      template <typename T0, typename T1, typename T2, typename T3,
+                typename T4, typename T5, typename T6, typename T7,
+                typename T8>
+      Status tryCall(const CallTarget &target,
+                    T0 arg0, T1 arg1, T2 arg2, T3 arg3,
+                    T4 arg4, T5 arg5, T6 arg6, T7 arg7,
+                    T8 arg8, const KeywordArgs &kwargs=NoKeywordArgs) {
+        return MethodCall<T0,T1,T2,T3,T4,T5,T6,T7,T8>::TryCall(this, target, kwargs, arg0, arg1, arg2,
+                                                               arg3, arg4, arg5, arg6, arg7,
+                                                               arg8);
+      }
+      
+      template <typename T0, typename T1, typename T2, typename T3,
+                typename T4, typename T5, typename T6, typename T7,
+                typename T8, typename T9>
+      Status tryCall(const CallTarget &target,
+                    T0 arg0, T1 arg1, T2 arg2, T3 arg3,
+                    T4 arg4, T5 arg5, T6 arg6, T7 arg7,
+                    T8 arg8, T9 arg9, const KeywordArgs &kwargs=NoKeywordArgs) {
+        return MethodCall<T0,T1,T2,T3,T4,T5,T6,T7,T8,T9>::TryCall(this, target, kwargs, arg0, arg1, arg2,
+                                                                  arg3, arg4, arg5, arg6, arg7,
+                                                                  arg8, arg9);
+      }
+      
+      template <typename T0, typename T1, typename T2, typename T3,
+                typename T4, typename T5, typename T6, typename T7,
+                typename T8, typename T9, typename T10>
+      Status tryCall(const CallTarget &target,
+                    T0 arg0, T1 arg1, T2 arg2, T3 arg3,
+                    T4 arg4, T5 arg5, T6 arg6, T7 arg7,
+                    T8 arg8, T9 arg9, T10 arg10, const KeywordArgs &kwargs=NoKeywordArgs) {
+        return MethodCall<T0,T1,T2,T3,T4,T5,T6,T7,T8,T9,T10>::TryCall(this, target, kwargs, arg0, arg1, arg2,
+                                                                      arg3, arg4, arg5, arg6, arg7,
+                                                                      arg8, arg9, arg10);
+      }
+      
+      template <typename T0, typename T1, typename T2, typename T3,
+                typename T4, typename T5, typename T6, typename T7,
+                typename T8, typename T9, typename T10, typename T11>
+      Status tryCall(const CallTarget &target,
+                    T0 arg0, T1 arg1, T2 arg2, T3 arg3,
+                    T4 arg4, T5 arg5, T6 arg6, T7 arg7,
+                    T8 arg8, T9 arg9, T10 arg10, T11 arg11, const KeywordArgs &kwargs=NoKeywordArgs) {
+        return MethodCall<T0,T1,T2,T3,T4,T5,T6,T7,T8,T9,T10,T11>::TryCall(this, target, kwargs, arg0, arg1, arg2,
+                                                                          arg3, arg4, arg5, arg6, arg7,
+                                                                          arg8, arg9, arg10, arg11);
+      }
+      
+      template <typename T0, typename T1, typename T2, typename T3,
+                typename T4, typename T5, typename T6, typename T7,
+                typename T8, typename T9, typename T10, typename T11,
+                typename T12>
+      Status tryCall(const CallTarget &target,
+                    T0 arg0, T1 arg1, T2 arg2, T3 arg3,
+                    T4 arg4, T5 arg5, T6 arg6, T7 arg7,
+                    T8 arg8, T9 arg9, T10 arg10, T11 arg11,
+                    T12 arg12, const KeywordArgs &kwargs=NoKeywordArgs) {
+        return MethodCall<T0,T1,T2,T3,T4,T5,T6,T7,T8,T9,T10,T11,T12>::TryCall(this, target, kwargs, arg0, arg1, arg2,
+                                                                              arg3, arg4, arg5, arg6, arg7,
+                                                                              arg8, arg9, arg10, arg11, arg12);
+      }
+      
+      template <typename T0, typename T1, typename T2, typename T3,
+                typename T4, typename T5, typename T6, typename T7,
+                typename T8, typename T9, typename T10, typename T11,
+                typename T12, typename T13>
+      Status tryCall(const CallTarget &target,
+                    T0 arg0, T1 arg1, T2 arg2, T3 arg3,
+                    T4 arg4, T5 arg5, T6 arg6, T7 arg7,
+                    T8 arg8, T9 arg9, T10 arg10, T11 arg11,
+                    T12 arg12, T13 arg13, const KeywordArgs &kwargs=NoKeywordArgs) {
+        return MethodCall<T0,T1,T2,T3,T4,T5,T6,T7,T8,T9,T10,T11,T12,T13>::TryCall(this, target, kwargs, arg0, arg1, arg2,
+                                                                                  arg3, arg4, arg5, arg6, arg7,
+                                                                                  arg8, arg9, arg10, arg11, arg12,
+                                                                                  arg13);
+      }
+      
+      template <typename T0, typename T1, typename T2, typename T3,
+                typename T4, typename T5, typename T6, typename T7,
+                typename T8, typename T9, typename T10, typename T11,
+                typename T12, typename T13, typename T14>
+      Status tryCall(const CallTarget &target,
+                    T0 arg0, T1 arg1, T2 arg2, T3 arg3,
+                    T4 arg4, T5 arg5, T6 arg6, T7 arg7,
+                    T8 arg8, T9 arg9, T10 arg10, T11 arg11,
+                    T12 arg12, T13 arg13, T14 arg14, const KeywordArgs &kwargs=NoKeywordArgs) {
+        return MethodCall<T0,T1,T2,T3,T4,T5,T6,T7,T8,T9,T10,T11,T12,T13,T14>::TryCall(this, target, kwargs, arg0, arg1, arg2,
+                                                                                      arg3, arg4, arg5, arg6, arg7,
+                                                                                      arg8, arg9, arg10, arg11, arg12,
+                                                                                      arg13, arg14);
+      }
+      
+      template <typename T0, typename T1, typename T2, typename T3,
+                typename T4, typename T5, typename T6, typename T7,
+                typename T8, typename T9, typename T10, typename T11,
+                typename T12, typename T13, typename T14, typename T15>
+      Status tryCall(const CallTarget &target,
+                    T0 arg0, T1 arg1, T2 arg2, T3 arg3,
+                    T4 arg4, T5 arg5, T6 arg6, T7 arg7,
+                    T8 arg8, T9 arg9, T10 arg10, T11 arg11,
+                    T12 arg12, T13 arg13, T14 arg14, T15 arg15, const KeywordArgs &kwargs=NoKeywordArgs) {
+        return MethodCall<T0,T1,T2,T3,T4,T5,T6,T7,T8,T9,T10,T11,T12,T13,T14,T15>::TryCall(this, target, kwargs, arg0, arg1, arg2,
+                                                                                          arg3, arg4, arg5, arg6, arg7,
+                                                                                          arg8, arg9, arg10, arg11, arg12,
+                                                                                          arg13, arg14, arg15);
+      }
+      
 #ifdef LWC_MEMTRACK
       static unsigned long GetInstanceCount();
 #endif
       
+    protected:
+      
+      // Method implementation hook, the default implementation calls the
+      // method pointer. Script objects override it to call into their interpreter
+      virtual void invoke(const char *name, MethodParams &params) throw(std::runtime_error);
+      
+      // Batch dispatch hook, the default implementation loops over invoke.
+      // Implementations check each parameter set with CheckBatchParams
+      virtual void invokeBatch(const char *name, const Method &meth, MethodParams **params, size_t n) throw(std::runtime_error);
+      
+      // Throw if params[i] was not created for meth
+      static void CheckBatchParams(const char *name, const Method &meth, MethodParams **params, size_t i) throw(std::runtime_error);
+      
+    private:
+      
+      // Validate arity against the method signature, then set keyword
+      // arguments and defaults for the arguments not covered by the first
+      // nargs positional ones
+      static bool SetDefaultArgs(const char *name, const Method &meth, MethodParams &params,
+                                 size_t nargs, const KeywordArgs *kwargs, Status &status);
+      
+      // invoke, reporting exceptions in status
+      void tryInvoke(const char *name, MethodParams &params, Status &status);
+      
+      // call and invoke going through the mailbox for actors (see
+      // setMailbox), then the interceptors when any is installed
+      
+      inline void dispatch(const char *name, MethodParams &params) throw(std::runtime_error) {
+        if (mMailbox) {
+          forward(name, params);
+        } else {
+          route(name, params);
+        }
+      }
+      
+      inline void tryDispatch(const char *name, MethodParams &params, Status &status) {
+        if (mMailbox) {
+          tryForward(name, params, status);
+        } else {
+          tryRoute(name, params, status);
+        }
+      }
+      
+      // actors: queue the call unless on the mailbox owner thread
+      void forward(const char *name, MethodParams &params) throw(std::runtime_error);
+      void tryForward(const char *name, MethodParams &params, Status &status);
+      
+      inline void route(const char *name, MethodParams &params) throw(std::runtime_error) {
+        if (InterceptorChain::Active()) {
+          intercept(name, params);
+        } else {
+          execute(name, params);
+        }
+      }
+      
+      inline void tryRoute(const char *name, MethodParams &params, Status &status) {
+        if (InterceptorChain::Active()) {
+          tryIntercept(name, params, status);
+        } else {
+          tryExecute(name, params, status);
+        }
+      }
+      
+      void intercept(const char *name, MethodParams &params) throw(std::runtime_error);
+      void tryIntercept(const char *name, MethodParams &params, Status &status);
+      
+      // call and invoke going through the results cache for memoized methods
+      
+      inline void execute(const char *name, MethodParams &params) throw(std::runtime_error) {
+        if (!params.getMethod().isMemoized()) {
+          invoke(name, params);
+        } else if (!fetchResult(params)) {
+          invoke(name, params);
+          storeResult(params);
+        }
+        params.storeReturn();
+      }
+      
+      inline void tryExecute(const char *name, MethodParams &params, Status &status) {
+        if (!params.getMethod().isMemoized()) {
+          tryInvoke(name, params, status);
+        } else if (!fetchResult(params)) {
+          tryInvoke(name, params, status);
+          if (status.succeeded()) {
+            storeResult(params);
+          }
+        }
+        if (status.succeeded()) {
+          params.storeReturn();
+        }
+      }
+      
+      bool fetchResult(MethodParams &params);
+      void storeResult(const MethodParams &params);
+      
+      // deliver signal to the connected slots (see emitValues)
+      void emitSignal(const char *signal, const ArgumentValue *values, size_t n, Status &status);
+      
+      // Incoming connections bookkeeping: remove the connections to listener
+      // (or through queue), and the ones of the other objects to this one
+      void disconnectListener(Object *listener);
+      void disconnectQueue(SignalQueue *queue);
+      void disconnectSources();
+      // a connection of this object was removed
+      void unlink(Object *listener, SignalQueue *queue);
+      
+      // Throw if the property does not exist or is not of the given type
+      const Property& findTypedProperty(const char *name, Type type) const throw(std::runtime_error);
+      
     private:
       
       inline void setMethodTable(const MethodsTable *methods) {
@@ -406,10 +1016,20 @@ namespace lwc {
       
       friend class Loader;
       friend class Registry;
+      friend class ObjectPool;
+      friend class SignalQueue;
       
       std::string mLoaderName;
       std::string mTypeName;
       const MethodsTable *mMethods;
+      // created on first memoized call
+      ResultCache *mResults;
+      // actor mode owner (not owned)
+      Mailbox *mMailbox;
+      // created on first connection, not copied
+      SignalConnections *mConnections;
+      // objects connected to this one, one entry per connection
+      SignalSources *mSources;
   };
 
 }
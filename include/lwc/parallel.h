@@ -0,0 +1,168 @@
+/*
+
+Copyright (C) 2009, 2010  Gaetan Guidet
+
+This file is part of lwc.
+
+lwc is free software; you can redistribute it and/or modify it
+under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 2.1 of the License, or (at
+your option) any later version.
+
+lwc is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+USA.
+
+*/
+
+#ifndef __lwc_parallel_h__
+#define __lwc_parallel_h__
+
+#include <lwc/object.h>
+#include <gcore/threads.h>
+#include <deque>
+
+namespace lwc {
+  
+  namespace parallel {
+    
+    // Number of hardware threads
+    LWC_API size_t NumCores();
+    
+    // Work-stealing thread pool (owned by the Registry, see Registry::getExecutor)
+    // Each worker owns a tasks deque: it pops its own tasks from the back and, once
+    // empty, steals from the front of the other deques. Ranges are split lazily
+    // (a worker keeps the first half and queues the second one) so that idle workers
+    // steal the largest chunks. The thread waiting for a group also runs tasks.
+    class LWC_API Executor {
+      public:
+        
+        // Called for a [begin, end) sub range of a parallel loop, must not throw
+        typedef void (*RangeFunc)(void *data, size_t begin, size_t end);
+        
+        // Pending work of one or several submit calls
+        class LWC_API Group {
+          public:
+            
+            Group();
+            ~Group();
+            
+            // true once all the submitted work is done
+            bool finished();
+            
+          private:
+            
+            Group(const Group&);
+            Group& operator=(const Group&);
+            
+            void done(size_t count);
+            
+          private:
+            
+            friend class Executor;
+            
+            gcore::Mutex mMutex;
+            gcore::Condition mDone;
+            size_t mPending;
+        };
+        
+      public:
+        
+        // 0 workers: one less than the number of cores (the waiting thread works too)
+        Executor(size_t nworkers=0);
+        ~Executor();
+        
+        inline size_t numWorkers() const {
+          return mWorkers.size();
+        }
+        
+        // true while submitted work is not done
+        bool busy();
+        
+        // Queue func over [0, n) in chunks of at most grain items (0 for automatic)
+        void submit(Group &group, RangeFunc func, void *data, size_t n, size_t grain=0);
+        
+        // Run queued tasks until all the group work is done
+        void wait(Group &group);
+        
+        // submit and wait
+        void run(RangeFunc func, void *data, size_t n, size_t grain=0);
+        
+        // Call one method on all the objects with a copy of params (only input
+        // arguments are allowed). Objects allowing concurrent calls are processed by
+        // the workers, the other ones (script objects) one after the other on the
+        // calling thread, grouped by loader. Objects must be distinct.
+        // Once all calls are done, the first failure (lowest index) is thrown.
+        void broadcast(Object **objects, size_t n, const CallTarget &target,
+                       const MethodParams &params) throw(std::runtime_error);
+        
+      private:
+        
+        Executor(const Executor&);
+        Executor& operator=(const Executor&);
+        
+        struct Task {
+          RangeFunc func;
+          void *data;
+          size_t begin;
+          size_t end;
+          size_t grain;
+          Group *group;
+        };
+        
+        struct Queue {
+          gcore::Mutex mutex;
+          std::deque<Task> tasks;
+        };
+        
+        void push(size_t q, const Task &task);
+        bool pop(size_t q, Task &task);
+        void execute(size_t q, Task &task);
+        
+        int workerMain(void *data);
+        
+      private:
+        
+        // one queue per worker, the last one for waiting threads
+        std::vector<Queue*> mQueues;
+        std::vector<gcore::Thread*> mWorkers;
+        gcore::Mutex mWorkMutex;
+        gcore::Condition mWorkAvailable;
+        size_t mQueued;
+        // submitted items not done yet (see busy)
+        size_t mActive;
+        bool mStop;
+    };
+    
+    // Object forwarding calls to all the objects of a collection (see Executor::broadcast)
+    // Language bindings build the parameters from script values as for a single
+    // object and call the broadcast object instead
+    class LWC_API Broadcast : public Object {
+      public:
+        
+        Broadcast(Executor *executor, Object **objects, size_t n);
+        virtual ~Broadcast();
+        
+      protected:
+        
+        virtual void invoke(const char *name, MethodParams &params) throw(std::runtime_error);
+        
+      private:
+        
+        Executor *mExecutor;
+        Object **mObjects;
+        size_t mNumObjects;
+    };
+    
+  }
+  
+}
+
+#endif
+
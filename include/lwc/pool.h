@@ -0,0 +1,102 @@
+/*
+
+Copyright (C) 2009, 2010  Gaetan Guidet
+
+This file is part of lwc.
+
+lwc is free software; you can redistribute it and/or modify it
+under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 2.1 of the License, or (at
+your option) any later version.
+
+lwc is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+USA.
+
+*/
+
+
+#ifndef __lwc_pool_h__
+#define __lwc_pool_h__
+
+#include <lwc/object.h>
+
+namespace lwc {
+  
+  struct PoolStats {
+    size_t size;              // instances currently pooled
+    size_t maxSize;
+    unsigned long reused;     // creations served from the pool
+    unsigned long allocated;  // creations that had to allocate (warm-up excluded)
+    unsigned long recycled;   // destructions that kept the instance (warm-up included)
+    unsigned long discarded;  // destructions that deleted it (pool full, incoming
+                              // connections or recycle refused)
+  };
+  
+  // Free list of destroyed instances of one type (see Factory::setPool).
+  // Released objects must accept Object::recycle, their memoized results,
+  // signal connections and mailbox are then cleared. Objects still listening
+  // to a signal are not kept. Like the registry, pools are not thread safe.
+  class LWC_API ObjectPool {
+    public:
+      
+      ObjectPool(size_t maxSize);
+      // Pooled instances are deleted
+      ~ObjectPool();
+      
+      // Extra pooled instances are deleted
+      void setMaxSize(size_t n);
+      
+      inline size_t maxSize() const {
+        return mMaxSize;
+      }
+      
+      inline size_t size() const {
+        return mFree.size();
+      }
+      
+      // Pooled instance or 0 if the caller has to allocate one
+      inline Object* acquire() {
+        if (mFree.empty()) {
+          ++mAllocated;
+          return 0;
+        }
+        Object *o = mFree.back();
+        mFree.pop_back();
+        ++mReused;
+        return o;
+      }
+      
+      // false if o was not kept, the caller has to delete it
+      bool release(Object *o);
+      
+      // Move the instances pooled by other (already recycled), the ones
+      // exceeding maxSize are deleted
+      void adopt(ObjectPool &other);
+      
+      void getStats(PoolStats &stats) const;
+      
+    private:
+      
+      ObjectPool(const ObjectPool&);
+      ObjectPool& operator=(const ObjectPool&);
+      
+    private:
+      
+      std::vector<Object*> mFree;
+      size_t mMaxSize;
+      unsigned long mReused;
+      unsigned long mAllocated;
+      unsigned long mRecycled;
+      unsigned long mDiscarded;
+  };
+  
+}
+
+#endif
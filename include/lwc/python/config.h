@@ -39,6 +39,8 @@ USA.
 #include <lwc/memory.h>
 #include <lwc/object.h>
 #include <lwc/registry.h>
+#include <lwc/cmdbuffer.h>
+#include <lwc/signal.h>
 
 #if !defined(_WIN32) || !defined(__APPLE__)
 #  undef _POSIX_C_SOURCE
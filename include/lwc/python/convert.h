@@ -215,6 +215,61 @@ namespace py {
     }
   };
 
+  // Return argument value (AD_RETURN), read from the parameters slot itself
+  inline PyObject* ReturnToPython(const lwc::MethodParams &params, size_t i) {
+    const lwc::ArgumentValue &v = params.rawget(i, false);
+    PyObject *obj = 0;
+    switch (params.getMethod()[i].getType()) {
+      case lwc::AT_BOOL:
+        C2Python<lwc::AT_BOOL>::ToValue(v.boolean, obj);
+        break;
+      case lwc::AT_INT:
+        C2Python<lwc::AT_INT>::ToValue(v.integer, obj);
+        break;
+      case lwc::AT_REAL:
+        C2Python<lwc::AT_REAL>::ToValue(v.real, obj);
+        break;
+      default: {
+        lwc::Object *o = (lwc::Object*) v.ptr;
+        C2Python<lwc::AT_OBJECT>::ToValue(o, obj);
+      }
+    }
+    return obj;
+  }
+  
+  // Bridge values for lwc::Marshal stubs: positional arguments tuple
+  struct MarshalTraits {
+    typedef PyObject* Args;
+    typedef PyObject* Result;
+    
+    static inline size_t Count(PyObject *args) {
+      return size_t(PyTuple_GET_SIZE(args));
+    }
+    template <typename T>
+    static inline bool Get(PyObject *args, size_t i, T &val) {
+      PyObject *obj = PyTuple_GET_ITEM(args, i);
+      if (!PythonType<T>::Check(obj)) {
+        return false;
+      }
+      PythonType<T>::ToC(obj, val);
+      return true;
+    }
+    static inline PyObject* None(PyObject *) {
+      Py_INCREF(Py_None);
+      return Py_None;
+    }
+    template <typename T>
+    static inline PyObject* Value(PyObject *, T val) {
+      PyObject *obj = 0;
+      CType<T>::ToPython(val, obj);
+      return obj;
+    }
+    static inline PyObject* Failed(PyObject *, const lwc::Status &status) {
+      PyErr_SetString(PyExc_RuntimeError, status.getMessage().c_str());
+      return NULL;
+    }
+  };
+  
   template <lwc::Type T> struct ParamConverter {
     typedef typename lwc::Enum2Type<T>::Type Type;
     typedef typename lwc::Enum2Type<T>::Type* Array;
@@ -268,7 +323,7 @@ namespace py {
       
       return false;
     }
-    static bool PreCall(const lwc::Argument &desc, size_t, PyObject *args, PyObject *kwargs, size_t &iarg, std::map<size_t,size_t> &arraySizes, Type &val) {
+    static bool PreCall(const lwc::Argument &desc, size_t, PyObject *args, PyObject *kwarg, size_t &iarg, std::map<size_t,size_t> &arraySizes, Type &val) {
       if (desc.getDir() == lwc::AD_IN || desc.getDir() == lwc::AD_INOUT) {
         if (desc.arrayArg() >= 0) {
           unsigned long idx = (unsigned long) arraySizes[size_t(desc.arrayArg())];
@@ -278,9 +333,8 @@ namespace py {
           if (iarg >= size_t(PyTuple_Size(args))) {
             bool failed = true;
             if (desc.isNamed()) {
-              PyObject *dv = (kwargs ? PyDict_GetItemString(kwargs, desc.getName().c_str()) : 0);
-              if (dv != 0) {
-                Python2C<T>::ToValue(dv, val);
+              if (kwarg != 0) {
+                Python2C<T>::ToValue(kwarg, val);
                 failed = false;
                 
               } else if (desc.hasDefaultValue()) {
@@ -302,13 +356,11 @@ namespace py {
       }
       return true;
     }
-    static void PostCall(const lwc::Argument &desc, size_t, PyObject *args, PyObject *kwargs, size_t &iarg, std::map<size_t,size_t> &arraySizes, Type &val, PyObject *&rv, bool callFailed) {
+    static void PostCall(const lwc::Argument &desc, size_t, PyObject *args, PyObject *kwarg, size_t &iarg, std::map<size_t,size_t> &arraySizes, Type &val, PyObject *&rv, bool callFailed) {
       
       bool dontDispose = false;
       if (iarg >= size_t(PyTuple_Size(args)) && desc.isNamed() &&
-          (kwargs == 0 ||
-           PyDict_GetItemString(kwargs, desc.getName().c_str()) == 0) &&
-          desc.hasDefaultValue()) {
+          kwarg == 0 && desc.hasDefaultValue()) {
         dontDispose = true;
       }
       if (callFailed && desc.getDir() == lwc::AD_OUT) {
@@ -352,15 +404,14 @@ namespace py {
         }
       }
     }
-    static bool PreCallArray(const lwc::Argument &desc, size_t idesc, const lwc::Argument &sdesc, PyObject *args, PyObject *kwargs, size_t &iarg, std::map<size_t,size_t> &arraySizes, Array &ary) {
+    static bool PreCallArray(const lwc::Argument &desc, size_t idesc, const lwc::Argument &sdesc, PyObject *args, PyObject *kwarg, size_t &iarg, std::map<size_t,size_t> &arraySizes, Array &ary) {
       if (desc.getDir() == lwc::AD_IN || desc.getDir() == lwc::AD_INOUT) {
         size_t length;
         if (iarg >= size_t(PyTuple_Size(args))) {
           bool failed = true;
           if (desc.isNamed()) {
-            PyObject *dv = (kwargs ? PyDict_GetItemString(kwargs, desc.getName().c_str()) : 0);
-            if (dv != 0) {
-              Python2C<T>::ToArray(dv, ary, length);
+            if (kwarg != 0) {
+              Python2C<T>::ToArray(kwarg, ary, length);
               arraySizes[idesc] = length;
               failed = false;
               
@@ -390,13 +441,11 @@ namespace py {
       }
       return true;
     }
-    static void PostCallArray(const lwc::Argument &desc, size_t idesc, const lwc::Argument &, PyObject *args, PyObject *kwargs, size_t &iarg, std::map<size_t,size_t> &arraySizes, Array &ary, PyObject *&rv, bool callFailed) {
+    static void PostCallArray(const lwc::Argument &desc, size_t idesc, const lwc::Argument &, PyObject *args, PyObject *kwarg, size_t &iarg, std::map<size_t,size_t> &arraySizes, Array &ary, PyObject *&rv, bool callFailed) {
       
       bool dontDispose = false;
       if (iarg >= size_t(PyTuple_Size(args)) && desc.isNamed() &&
-          (kwargs == 0 ||
-           PyDict_GetItemString(kwargs, desc.getName().c_str()) == 0) &&
-          desc.hasDefaultValue()) {
+          kwarg == 0 && desc.hasDefaultValue()) {
         // only for ptr types
         dontDispose = true;
       }
@@ -42,10 +42,31 @@ namespace py {
         return mSelf;
       }
       
-      virtual void call(const char *name, lwc::MethodParams &params) throw(std::runtime_error);
+      virtual bool allowsConcurrentCalls() const {
+        return false;
+      }
+      
+      // Calls the "recycle" method of the python object if it has one, a False
+      // return value or an exception refuse the recycling
+      virtual bool recycle();
     
     protected:
       
+      virtual void invoke(const char *name, lwc::MethodParams &params) throw(std::runtime_error);
+      
+      // One python call for the whole batch when the object defines "<name>_batch"
+      virtual void invokeBatch(const char *name, const lwc::Method &meth, lwc::MethodParams **params, size_t n) throw(std::runtime_error);
+      
+      // Build the python arguments tuple for the method inputs
+      PyObject* packArgs(lwc::MethodParams &params,
+                         std::map<size_t, size_t> &inoutArgs,
+                         std::map<size_t, size_t> &inoutInSizes) throw(std::runtime_error);
+      
+      // Convert the python return value (and inout arrays) back to the method outputs
+      void unpackResult(lwc::MethodParams &params, PyObject *args, PyObject *rv,
+                        std::map<size_t, size_t> &inoutArgs,
+                        std::map<size_t, size_t> &inoutInSizes) throw(std::runtime_error);
+      
       PyObject *mSelf;
   };
 
@@ -49,6 +49,7 @@ namespace py {
     PyObject_HEAD
     lwc::Object *obj;
     char *method;
+    lwc::CallSiteCache *sites;
   };
 
   struct LWCPY_API PyLWCMethodsTable {
@@ -56,6 +57,18 @@ namespace py {
     lwc::MethodsTable *table;
   };
 
+  struct LWCPY_API PyLWCCommandBuffer {
+    PyObject_HEAD
+    lwc::CommandBuffer *buffer;
+    // recorded objects
+    PyObject *objects;
+  };
+
+  struct LWCPY_API PyLWCSignalQueue {
+    PyObject_HEAD
+    lwc::SignalQueue *queue;
+  };
+
   struct LWCPY_API PyLWCRegistry {
     PyObject_HEAD
   };
@@ -66,6 +79,8 @@ namespace py {
   LWCPY_DATA_API PyTypeObject PyLWCObjectType;
   LWCPY_DATA_API PyTypeObject PyLWCMethodCallType;
   LWCPY_DATA_API PyTypeObject PyLWCMethodsTableType;
+  LWCPY_DATA_API PyTypeObject PyLWCCommandBufferType;
+  LWCPY_DATA_API PyTypeObject PyLWCSignalQueueType;
 
 
   LWCPY_API void SetObjectPointer(PyLWCObject *self, lwc::Object *o);
@@ -73,12 +88,20 @@ namespace py {
   LWCPY_API bool InitMethod(PyObject *);
   LWCPY_API bool InitMethodsTable(PyObject *);
   LWCPY_API bool InitMethodCall(PyObject *);
+  LWCPY_API bool InitCommandBuffer(PyObject *);
+  LWCPY_API bool InitSignalQueue(PyObject *);
   LWCPY_API bool InitObject(PyObject *);
   LWCPY_API bool InitRegistry(PyObject *);
   LWCPY_API PyObject* CreateModule();
   LWCPY_API void CleanupModule();
   
   LWCPY_API bool SetArgDefault(lwc::Argument &a, PyObject *obj);
+  
+  // Call method n of o with python positional and keyword arguments, methods is
+  // the table used to compile the call sites. Returns NULL with the python error set
+  // on failure.
+  LWCPY_API PyObject* CallMethod(lwc::Object *o, const lwc::MethodsTable *methods, const char *n,
+                                 lwc::CallSiteCache &sites, PyObject *args, PyObject *kwargs);
 }
 
 #endif
@@ -25,7 +25,9 @@ USA.
 #define __lwc_registry_h__
 
 #include <lwc/object.h>
+#include <lwc/interface.h>
 #include <lwc/loader.h>
+#include <lwc/parallel.h>
 #include <gcore/dmodule.h>
 #include <gcore/path.h>
 #include <gcore/env.h>
@@ -76,13 +78,64 @@ namespace lwc {
       const char* getTypeName(size_t idx) const;
       
       const MethodsTable* getMethods(const char*n);
+      MethodHandle getMethodHandle(const char *n, const char *methodName) throw(std::runtime_error);
       const char* getDescription(const char *n);
       std::string docString(const char *n, const std::string &indent="");
+      // Loaders with a mailbox create and destroy their objects on the owner
+      // thread (see setLoaderMailbox)
       Object* create(const char *n);
       Object* get(const char *n);
       void destroy(Object *o);
       void destroySingletons();
       
+      // Instance pools: destroy keeps up to maxSize objects of a type that
+      // create hands out again instead of allocating (the type must implement
+      // Object::recycle), warmUp objects are created upfront and maxSize 0
+      // removes the pool. Runs on the loader mailbox thread like create.
+      // Returns false for unknown and singleton types
+      bool setPool(const char *typeName, size_t maxSize, size_t warmUp=0);
+      bool getPoolStats(const char *typeName, PoolStats &stats) const;
+      
+      // Work-stealing thread pool shared by parallel and asynchronous calls,
+      // created on first use (thread safe)
+      parallel::Executor* getExecutor();
+      // Number of pool workers (0 for one less than the number of cores). The
+      // current pool is destroyed if its size differs, returns false (and
+      // keeps it) while parallel or asynchronous calls are pending. Must not
+      // race with the submission of new work
+      bool setNumWorkers(size_t n);
+      inline size_t getNumWorkers() const {
+        return mNumWorkers;
+      }
+      
+      // Call one method on a collection of objects (see parallel::Executor::broadcast)
+      void broadcast(Object **objects, size_t n, const CallTarget &target,
+                     const MethodParams &params) throw(std::runtime_error);
+      
+      // Interfaces: all registered types are checked once against an interface
+      // when it is added, types from modules loaded afterwards when the module
+      // is loaded. Returns false if an interface with the same name exists
+      bool addInterface(const Interface &iface);
+      const Interface* getInterface(const char *name) const;
+      // 0 if either the type or the interface is unknown, check isValid() on
+      // the returned binding to know if the type implements the interface
+      const InterfaceBinding* getBinding(const char *typeName, const char *interfaceName);
+      bool implements(const char *typeName, const char *interfaceName);
+      
+      // Interceptors (not owned) run around calls of the given type, or of all
+      // types when typeName is 0 (including types from modules loaded
+      // afterwards). methodName 0 to intercept all methods.
+      // Returns false if the type is unknown
+      bool addInterceptor(Interceptor *i, const char *typeName=0, const char *methodName=0);
+      // Remove i from all types
+      void removeInterceptor(Interceptor *i);
+      
+      // Actor mode for all the objects a loader creates from now on (see
+      // Object::setMailbox), 0 to stop. Mailboxes are not owned.
+      // Returns false if no loader has this name
+      bool setLoaderMailbox(const char *loaderName, Mailbox *mailbox);
+      Mailbox* getLoaderMailbox(const char *loaderName) const;
+      
       bool enumLoaders(const gcore::Path &p);
       bool enumModules(const gcore::Path &p);
       bool enumLoaderPath(const gcore::Path &p);
@@ -91,6 +144,20 @@ namespace lwc {
     protected:
       
       Registry(const char *hostLang, void *userData);
+      
+      void bindInterfaces();
+      
+      // Create the type chain on first use, starting with the interceptors
+      // installed for all types
+      InterceptorChain* getInterceptors(const char *typeName);
+      void bindInterceptors();
+      
+      // Set the loader mailbox of a newly created object
+      Object* bindMailbox(Object *o);
+      
+      // Create an object of a known type, on the loader mailbox owner thread
+      // if any (see setLoaderMailbox)
+      Object* createObject(const char *name);
     
     protected:
       
@@ -108,8 +175,26 @@ namespace lwc {
       
       std::map<std::string, Object*> mSingletons;
       
+      std::map<std::string, Interface> mInterfaces;
+      
+      // interface name -> type name -> binding
+      std::map<std::string, std::map<std::string, InterfaceBinding> > mBindings;
+      
+      // type name -> interceptors
+      std::map<std::string, InterceptorChain*> mInterceptors;
+      
+      // interceptors installed for all types (empty method name for all methods)
+      std::vector<std::pair<Interceptor*, std::string> > mGlobalInterceptors;
+      
       std::string mHostLang;
       void *mUserData;
+      
+      gcore::Mutex mExecutorMutex;
+      parallel::Executor *mExecutor;
+      size_t mNumWorkers;
+      
+      // loader name -> actor mode mailbox
+      std::map<std::string, Mailbox*> mLoaderMailboxes;
   };
   
 }
@@ -0,0 +1,93 @@
+/*
+
+Copyright (C) 2009, 2010  Gaetan Guidet
+
+This file is part of lwc.
+
+lwc is free software; you can redistribute it and/or modify it
+under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 2.1 of the License, or (at
+your option) any later version.
+
+lwc is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+USA.
+
+*/
+
+
+#ifndef __lwc_resultcache_h__
+#define __lwc_resultcache_h__
+
+#include <lwc/method.h>
+
+namespace lwc {
+  
+  // Bounded cache of memoized method results (see MF_PURE) keyed by the
+  // method and its input argument values. Direct mapped: a new result
+  // replaces the one stored in the same slot.
+  class LWC_API ResultCache {
+    public:
+      
+      enum {
+        DefaultCapacity = 64
+      };
+      
+      // capacity is rounded up to a power of 2
+      ResultCache(size_t capacity=DefaultCapacity);
+      ~ResultCache();
+      
+      // On hit, write the cached results through the output arguments
+      // (params method must be memoized)
+      bool fetch(MethodParams &params);
+      
+      // Record output arguments values of a completed call
+      void store(const MethodParams &params);
+      
+      // Drop all results, counters are kept
+      void clear();
+      
+      inline size_t capacity() const {
+        return mEntries.size();
+      }
+      
+      inline unsigned long numHits() const {
+        return mHits;
+      }
+      
+      inline unsigned long numMisses() const {
+        return mMisses;
+      }
+      
+    private:
+      
+      ResultCache(const ResultCache&);
+      ResultCache& operator=(const ResultCache&);
+      
+      static unsigned int Hash(const MethodParams &params);
+      static bool SameInputs(const std::vector<ArgumentValue> &values, const MethodParams &params);
+      
+    private:
+      
+      struct Entry {
+        const Method *method;
+        unsigned int hash;
+        // inputs by value, outputs by pointed value
+        std::vector<ArgumentValue> values;
+      };
+      
+      std::vector<Entry> mEntries;
+      size_t mMask;
+      unsigned long mHits;
+      unsigned long mMisses;
+  };
+  
+}
+
+#endif
@@ -213,6 +213,67 @@ namespace rb {
     }
   };
   
+  // Return argument value (AD_RETURN), read from the parameters slot itself
+  inline VALUE ReturnToRuby(const lwc::MethodParams &params, size_t i) {
+    const lwc::ArgumentValue &v = params.rawget(i, false);
+    VALUE obj = Qnil;
+    switch (params.getMethod()[i].getType()) {
+      case lwc::AT_BOOL:
+        C2Ruby<lwc::AT_BOOL>::ToValue(v.boolean, obj);
+        break;
+      case lwc::AT_INT:
+        C2Ruby<lwc::AT_INT>::ToValue(v.integer, obj);
+        break;
+      case lwc::AT_REAL:
+        C2Ruby<lwc::AT_REAL>::ToValue(v.real, obj);
+        break;
+      default: {
+        lwc::Object *o = (lwc::Object*) v.ptr;
+        C2Ruby<lwc::AT_OBJECT>::ToValue(o, obj);
+      }
+    }
+    return obj;
+  }
+  
+  // Bridge values for lwc::Marshal stubs: positional arguments array
+  struct MarshalArgs {
+    VALUE *argv;
+    size_t count;
+  };
+  
+  struct MarshalTraits {
+    typedef MarshalArgs Args;
+    // Error when the call failed: the caller raises the stub status once the
+    // stub frames are gone, rb_raise longjmps over C++ frames
+    typedef VALUE Result;
+    
+    static const VALUE Error = Qundef;
+    
+    static inline size_t Count(const MarshalArgs &args) {
+      return args.count;
+    }
+    template <typename T>
+    static inline bool Get(const MarshalArgs &args, size_t i, T &val) {
+      if (!RubyType<T>::Check(args.argv[i])) {
+        return false;
+      }
+      RubyType<T>::ToC(args.argv[i], val);
+      return true;
+    }
+    static inline VALUE None(const MarshalArgs &) {
+      return Qnil;
+    }
+    template <typename T>
+    static inline VALUE Value(const MarshalArgs &, T val) {
+      VALUE obj = Qnil;
+      CType<T>::ToRuby(val, obj);
+      return obj;
+    }
+    static inline VALUE Failed(const MarshalArgs &, const lwc::Status &) {
+      return Error;
+    }
+  };
+  
   template <lwc::Type T> struct ParamConverter {
     
     typedef typename lwc::Enum2Type<T>::Type Type;
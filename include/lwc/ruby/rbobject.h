@@ -45,10 +45,14 @@ namespace rb {
         return mSelf;
       }
       
-      virtual void call(const char *name, lwc::MethodParams &params) throw(std::runtime_error);
+      virtual bool allowsConcurrentCalls() const {
+        return false;
+      }
     
     protected:
       
+      virtual void invoke(const char *name, lwc::MethodParams &params) throw(std::runtime_error);
+      
       VALUE mSelf;
   };
 
@@ -0,0 +1,354 @@
+/*
+
+Copyright (C) 2009, 2010  Gaetan Guidet
+
+This file is part of lwc.
+
+lwc is free software; you can redistribute it and/or modify it
+under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 2.1 of the License, or (at
+your option) any later version.
+
+lwc is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+USA.
+
+*/
+
+#ifndef __lwc_signal_h__
+#define __lwc_signal_h__
+
+#include <lwc/object.h>
+#include <lwc/atomic.h>
+#include <lwc/memory.h>
+
+namespace lwc {
+  
+  struct SignalStats {
+    unsigned long queued;     // events pushed to the queue
+    unsigned long dropped;    // events lost because the queue was full
+    unsigned long delivered;  // events whose slot was called successfully
+    unsigned long failed;     // events whose slot call failed
+    unsigned long depth;      // events currently queued
+    // updated by the processing thread without synchronization: only read
+    // them from that thread (or once processing stopped)
+    double totalLatency;      // sum of the emission to delivery delays (seconds)
+    double maxLatency;        // longest emission to delivery delay (seconds)
+  };
+  
+  // Signals are declared per type alongside the methods (see
+  // MethodsTable::addSignals, LWC_MODULE_TYPE_SIGNALS) and connected to slots,
+  // methods of listener objects of any language (see Object::connect).
+  // Connections without a queue call the slot from the emitting thread (going
+  // through the listener mailbox for actors), the other ones push the event
+  // to their queue and return.
+  //
+  // A signal queue is a bounded lock-free multi-producer queue drained by one
+  // thread at a time, usually the listener thread, with process. Events are
+  // stored inline: scalar and object payloads never allocate, string values
+  // are copied. Events emitted while the queue is full are dropped.
+  // Objects referenced by queued events (listeners and object arguments) must
+  // outlive their delivery. Destroying a queue removes the connections using it.
+  class LWC_API SignalQueue {
+    public:
+      
+      // capacity is rounded up to a power of 2
+      SignalQueue(size_t capacity=1024);
+      // Pending events are discarded, connections using the queue removed
+      ~SignalQueue();
+      
+      inline size_t capacity() const {
+        return mMask + 1;
+      }
+      
+      inline size_t depth() const {
+        long d = atomic::Load(&mQueued) - atomic::Load(&mProcessed);
+        return (d > 0 ? size_t(d) : 0);
+      }
+      
+      // Deliver queued events (at most maxEvents, 0 for all) on the calling
+      // thread. Returns the number of events delivered or failed.
+      // Events keep their listener pointer: process the queue before
+      // destroying a listener that was connected through it
+      size_t process(size_t maxEvents=0);
+      
+      // Queue an event for the slot of listener (see Object::emitValues), the
+      // values match the slot first n arguments. Returns false if the queue is
+      // full, the event is then counted as dropped
+      bool push(Object *listener, const char *slot, const Method &method, const ArgumentValue *values, size_t n);
+      
+      // Counters are atomic, see SignalStats for the latencies
+      void getStats(SignalStats &stats) const;
+      
+    private:
+      
+      SignalQueue(const SignalQueue&);
+      SignalQueue& operator=(const SignalQueue&);
+      
+      friend class Object;
+      
+      struct Event {
+        Object *listener;
+        // owned by the listener methods table
+        const char *slot;
+        const Method *method;
+        size_t count;
+        // bit i set when value i is a copied string
+        unsigned long strings;
+        double time;
+        ArgumentValue values[LWC_MAX_SIGNAL_ARGS];
+      };
+      
+      // sequence is the position the cell is ready to be written for, or
+      // that position + 1 once the event is written
+      struct Cell {
+        volatile long sequence;
+        Event event;
+      };
+      
+      void deliver(Event &event);
+      
+    private:
+      
+      Cell *mCells;
+      size_t mMask;
+      // producers side
+      volatile long mEnqueuePos;
+      char mPad[64];
+      // consumer side
+      long mDequeuePos;
+      
+      volatile long mQueued;
+      volatile long mProcessed;
+      volatile long mDropped;
+      volatile long mDelivered;
+      volatile long mFailed;
+      // processing thread only
+      double mTotalLatency;
+      double mMaxLatency;
+      // emitters connected through the queue, one entry per connection
+      std::vector<Object*> mSources;
+  };
+  
+  namespace details {
+    
+    template <typename T>
+    struct SignalArg {
+      static inline bool Set(const Method &m, size_t i, T value, ArgumentValue &dst, Status &status) {
+        if (GetSet<typename gcore::NoRefOrConst<T>::Type>::Set(m[i], value, dst) != CE_NONE) {
+          status.set(EC_ARGUMENT_TYPE, 0, long(i));
+          return false;
+        }
+        return true;
+      }
+    };
+    
+    template <>
+    struct SignalArg<const char*> {
+      static inline bool Set(const Method &m, size_t i, const char *value, ArgumentValue &dst, Status &status) {
+        return SignalArg<char*>::Set(m, i, (char*) value, dst, status);
+      }
+    };
+    
+    template <>
+    struct SignalArg<Empty> {
+      static inline bool Set(const Method &, size_t, const Empty &, ArgumentValue &, Status &) {
+        return true;
+      }
+    };
+  }
+  
+  // Argument pack of Object::emit (unused slots are Empty)
+  template <typename T0=Empty, typename T1=Empty, typename T2=Empty, typename T3=Empty,
+            typename T4=Empty, typename T5=Empty, typename T6=Empty, typename T7=Empty>
+  struct SignalEmit {
+    
+    enum {
+      Arity = details::CallArity<T0, T1, T2, T3, T4, T5, T6, T7,
+                                 Empty, Empty, Empty, Empty, Empty, Empty, Empty, Empty>::Value
+    };
+    
+    static Status Emit(Object *self, const char *signal,
+                       T0 arg0=T0(), T1 arg1=T1(), T2 arg2=T2(), T3 arg3=T3(),
+                       T4 arg4=T4(), T5 arg5=T5(), T6 arg6=T6(), T7 arg7=T7()) {
+      
+      Status status;
+      
+      // unconnected signals are not even looked up
+      if (!self->hasConnections()) {
+        return status;
+      }
+      
+      const Method *m = self->findSignal(signal);
+      
+      if (!m) {
+        status.set(EC_NO_SIGNAL, signal);
+        return status;
+      }
+      
+      if (m->numArgs() != size_t(Arity)) {
+        status.set(EC_ARGUMENT_COUNT, signal, -1, 0, long(m->numArgs()));
+        return status;
+      }
+      
+      ArgumentValue values[LWC_MAX_SIGNAL_ARGS];
+      
+      if (details::SignalArg<T0>::Set(*m, 0, arg0, values[0], status) &&
+          details::SignalArg<T1>::Set(*m, 1, arg1, values[1], status) &&
+          details::SignalArg<T2>::Set(*m, 2, arg2, values[2], status) &&
+          details::SignalArg<T3>::Set(*m, 3, arg3, values[3], status) &&
+          details::SignalArg<T4>::Set(*m, 4, arg4, values[4], status) &&
+          details::SignalArg<T5>::Set(*m, 5, arg5, values[5], status) &&
+          details::SignalArg<T6>::Set(*m, 6, arg6, values[6], status) &&
+          details::SignalArg<T7>::Set(*m, 7, arg7, values[7], status)) {
+        return self->emitValues(signal, values, size_t(Arity));
+      }
+      
+      status.setMethodName(signal);
+      return status;
+    }
+  };
+  
+  // Language bridge side of the signals, B describes the bridge values as for
+  // Marshal (Get also has to handle Object*)
+  template <class B>
+  struct SignalBridge {
+    
+    typedef typename B::Args Args;
+    
+    // Emit signal from o with the bridge values from first to Count(args)
+    static Status Emit(Object *o, const char *signal, Args args, size_t first) {
+      
+      Status status;
+      
+      if (!o->hasConnections()) {
+        return status;
+      }
+      
+      const Method *m = o->findSignal(signal);
+      
+      if (!m) {
+        status.set(EC_NO_SIGNAL, signal);
+        return status;
+      }
+      
+      size_t n = B::Count(args);
+      
+      if (n < first || n - first != m->numArgs()) {
+        status.set(EC_ARGUMENT_COUNT, signal, -1, 0, long(m->numArgs()));
+        return status;
+      }
+      
+      ArgumentValue values[LWC_MAX_SIGNAL_ARGS];
+      size_t i = 0;
+      
+      for (; i<m->numArgs(); ++i) {
+        bool ok = false;
+        switch ((*m)[i].getType()) {
+          case AT_BOOL:
+            ok = B::Get(args, first+i, values[i].boolean);
+            break;
+          case AT_INT:
+            ok = B::Get(args, first+i, values[i].integer);
+            break;
+          case AT_REAL:
+            ok = B::Get(args, first+i, values[i].real);
+            break;
+          case AT_STRING: {
+            // copy, slots get a mutable string
+            char *str = 0;
+            ok = B::Get(args, first+i, str);
+            values[i].ptr = (void*) str;
+            break;
+          }
+          default: {
+            Object *obj = 0;
+            ok = B::Get(args, first+i, obj);
+            values[i].ptr = (void*) obj;
+          }
+        }
+        if (!ok) {
+          status.set(EC_ARGUMENT_TYPE, signal, long(i));
+          break;
+        }
+      }
+      
+      if (!status.failed()) {
+        status = o->emitValues(signal, values, m->numArgs());
+      }
+      
+      for (size_t j=0; j<i; ++j) {
+        if ((*m)[j].getType() == AT_STRING && values[j].ptr) {
+          memory::Free(values[j].ptr);
+        }
+      }
+      
+      return status;
+    }
+  };
+  
+  // ---
+  
+  template <typename T0>
+  Status Object::emit(const char *signal, T0 arg0) {
+    return SignalEmit<T0>::Emit(this, signal, arg0);
+  }
+  
+  template <typename T0, typename T1>
+  Status Object::emit(const char *signal, T0 arg0, T1 arg1) {
+    return SignalEmit<T0,T1>::Emit(this, signal, arg0, arg1);
+  }
+  
+  template <typename T0, typename T1, typename T2>
+  Status Object::emit(const char *signal, T0 arg0, T1 arg1, T2 arg2) {
+    return SignalEmit<T0,T1,T2>::Emit(this, signal, arg0, arg1, arg2);
+  }
+  
+  template <typename T0, typename T1, typename T2, typename T3>
+  Status Object::emit(const char *signal, T0 arg0, T1 arg1, T2 arg2, T3 arg3) {
+    return SignalEmit<T0,T1,T2,T3>::Emit(this, signal, arg0, arg1, arg2, arg3);
+  }
+  
+  template <typename T0, typename T1, typename T2, typename T3,
+            typename T4>
+  Status Object::emit(const char *signal,
+                      T0 arg0, T1 arg1, T2 arg2, T3 arg3,
+                      T4 arg4) {
+    return SignalEmit<T0,T1,T2,T3,T4>::Emit(this, signal, arg0, arg1, arg2, arg3, arg4);
+  }
+  
+  template <typename T0, typename T1, typename T2, typename T3,
+            typename T4, typename T5>
+  Status Object::emit(const char *signal,
+                      T0 arg0, T1 arg1, T2 arg2, T3 arg3,
+                      T4 arg4, T5 arg5) {
+    return SignalEmit<T0,T1,T2,T3,T4,T5>::Emit(this, signal, arg0, arg1, arg2, arg3, arg4, arg5);
+  }
+  
+  template <typename T0, typename T1, typename T2, typename T3,
+            typename T4, typename T5, typename T6>
+  Status Object::emit(const char *signal,
+                      T0 arg0, T1 arg1, T2 arg2, T3 arg3,
+                      T4 arg4, T5 arg5, T6 arg6) {
+    return SignalEmit<T0,T1,T2,T3,T4,T5,T6>::Emit(this, signal, arg0, arg1, arg2, arg3,
+                                                  arg4, arg5, arg6);
+  }
+  
+  template <typename T0, typename T1, typename T2, typename T3,
+            typename T4, typename T5, typename T6, typename T7>
+  Status Object::emit(const char *signal,
+                      T0 arg0, T1 arg1, T2 arg2, T3 arg3,
+                      T4 arg4, T5 arg5, T6 arg6, T7 arg7) {
+    return SignalEmit<T0,T1,T2,T3,T4,T5,T6,T7>::Emit(this, signal, arg0, arg1, arg2, arg3,
+                                                     arg4, arg5, arg6, arg7);
+  }
+  
+}
+
+#endif
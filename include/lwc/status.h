@@ -0,0 +1,122 @@
+/*
+
+Copyright (C) 2009, 2010  Gaetan Guidet
+
+This file is part of lwc.
+
+lwc is free software; you can redistribute it and/or modify it
+under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 2.1 of the License, or (at
+your option) any later version.
+
+lwc is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+USA.
+
+*/
+
+#ifndef __lwc_status_h__
+#define __lwc_status_h__
+
+#include <lwc/config.h>
+
+namespace lwc {
+  
+  enum ErrorCode {
+    EC_NONE = 0,
+    EC_NO_METHOD,         // no such method
+    EC_INVALID_HANDLE,    // method handle resolved for another type
+    EC_ARGUMENT_COUNT,    // wrong number of arguments
+    EC_ARGUMENT_INDEX,    // argument index out of range
+    EC_ARGUMENT_NAME,     // unknown keyword argument
+    EC_ARGUMENT_TYPE,     // argument type mismatch
+    EC_KEYWORD_TWICE,     // keyword argument also set positionally
+    EC_KEYWORD_TYPE,      // keyword argument type mismatch
+    EC_INVALID_POINTER,   // method has no implementation
+    EC_CALL_SHAPE,        // call site compiled for different arguments
+    EC_SIGNATURE_MISMATCH,// method signature differs from the interface declaration
+    EC_INTERCEPTED,       // call rejected by an interceptor
+    EC_FAILED,            // error raised by the method implementation or a language bridge
+    EC_NO_SIGNAL          // no such signal (see Object::emit)
+  };
+  
+  // Result of an exception free call (see Object::tryCall)
+  // Only the error code and its context are recorded when the error occurs,
+  // the message is formatted when requested. Context strings are copied as
+  // they may come from the caller (keyword names, method names, type names).
+  class LWC_API Status {
+    public:
+      
+      Status();
+      Status(const Status &rhs);
+      ~Status();
+      
+      Status& operator=(const Status &rhs);
+      
+      inline bool succeeded() const {
+        return (mCode == EC_NONE);
+      }
+      
+      inline bool failed() const {
+        return (mCode != EC_NONE);
+      }
+      
+      inline ErrorCode getCode() const {
+        return mCode;
+      }
+      
+      inline const char* getMethodName() const {
+        return mMethod.c_str();
+      }
+      
+      inline long getArgumentIndex() const {
+        return mIndex;
+      }
+      
+      inline void set(ErrorCode code, const char *method=0, long index=-1, const char *name=0, long count=-1) {
+        mCode = code;
+        Assign(mMethod, method);
+        mIndex = index;
+        Assign(mName, name);
+        mCount = count;
+      }
+      
+      inline void setMethodName(const char *method) {
+        Assign(mMethod, method);
+      }
+      
+      void setFailed(const char *method, const char *details);
+      
+      void clear();
+      
+      std::string getMessage() const;
+      
+    private:
+      
+      static inline void Assign(std::string &dst, const char *src) {
+        if (src) {
+          dst = src;
+        } else {
+          dst.clear();
+        }
+      }
+      
+    private:
+      
+      ErrorCode mCode;
+      std::string mMethod;
+      std::string mName;
+      long mIndex;
+      long mCount;
+      std::string mDetails;
+  };
+  
+}
+
+#endif
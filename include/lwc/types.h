@@ -87,268 +87,332 @@ namespace lwc {
   template <> struct Type2Enum<char*> {enum {Enum = AT_STRING};};
   template <> struct Type2Enum<Object*> {enum {Enum = AT_OBJECT};};
   
+  // Allowed is the compile time counterpart of Possible()
   template <typename T, typename U> struct Convertion {
+    enum {Allowed = 0};
     static bool Possible() {return false;}
     static void Do(const T &, U &) {}
   };
   // same type
   template <typename T> struct Convertion<T, T> {
+    enum {Allowed = 1};
     static bool Possible() {return true;}
     static void Do(const T &from, T &to) {to = from;}
   };
   // c++ string to c string
   template <> struct Convertion<std::string, char*> {
+    enum {Allowed = 1};
     static bool Possible() {return true;}
     static void Do(const std::string &from, char *&to) {to = (char*) from.c_str();}
     static void DoRev(const char *&from, std::string &to) {to = from;}
   };
   template <> struct Convertion<char*, std::string> {
+    enum {Allowed = 1};
     static bool Possible() {return true;}
     static void Do(const char *&from, std::string &to) {to = from;}
   };
   // plain type to integer
   template <> struct Convertion<char, Integer> {
+    enum {Allowed = 1};
     static bool Possible() {return true;}
     static void Do(const char &from, Integer &to) {to = (Integer)from;}
   };
   template <> struct Convertion<Integer, char> {
+    enum {Allowed = 1};
     static bool Possible() {return true;}
     static void Do(const Integer &from, char &to) {to = (char)from;}
   };
   template <> struct Convertion<unsigned char, Integer> {
+    enum {Allowed = 1};
     static bool Possible() {return true;}
     static void Do(const unsigned char &from, Integer &to) {to = (Integer)from;}
   };
   template <> struct Convertion<Integer, unsigned char> {
+    enum {Allowed = 1};
     static bool Possible() {return true;}
     static void Do(const Integer &from, unsigned char &to) {to = (unsigned char)from;}
   };
   template <> struct Convertion<short, Integer> {
+    enum {Allowed = 1};
     static bool Possible() {return true;}
     static void Do(const short &from, Integer &to) {to = (Integer)from;}
   };
   template <> struct Convertion<Integer, short> {
+    enum {Allowed = 1};
     static bool Possible() {return true;}
     static void Do(const Integer &from, short &to) {to = (short)from;}
   };
   template <> struct Convertion<unsigned short, Integer> {
+    enum {Allowed = 1};
     static bool Possible() {return true;}
     static void Do(const unsigned short &from, Integer &to) {to = (Integer)from;}
   };
   template <> struct Convertion<Integer, unsigned short> {
+    enum {Allowed = 1};
     static bool Possible() {return true;}
     static void Do(const Integer &from, unsigned short &to) {to = (unsigned short)from;}
   };
   template <> struct Convertion<int, Integer> {
+    enum {Allowed = 1};
     static bool Possible() {return true;}
     static void Do(const int &from, Integer &to) {to = (Integer)from;}
   };
   template <> struct Convertion<Integer, int> {
+    enum {Allowed = 1};
     static bool Possible() {return true;}
     static void Do(const Integer &from, int &to) {to = (int)from;}
   };
   template <> struct Convertion<unsigned int, Integer> {
+    enum {Allowed = 1};
     static bool Possible() {return true;}
     static void Do(const unsigned int &from, Integer &to) {to = (Integer)from;}
   };
   template <> struct Convertion<Integer, unsigned int> {
+    enum {Allowed = 1};
     static bool Possible() {return true;}
     static void Do(const Integer &from, unsigned int &to) {to = (unsigned int)from;}
   };
 #ifndef NATIVE_64BIT_LONG
   template <> struct Convertion<long, Integer> {
+    enum {Allowed = 1};
     static bool Possible() {return true;}
     static void Do(const long &from, Integer &to) {to = (Integer)from;}
   };
   template <> struct Convertion<Integer, long> {
+    enum {Allowed = 1};
     static bool Possible() {return true;}
     static void Do(const Integer &from, long &to) {to = (long)from;}
   };
 #endif
   template <> struct Convertion<unsigned long, Integer> {
+    enum {Allowed = 1};
     static bool Possible() {return true;}
     static void Do(const unsigned long &from, Integer &to) {to = (Integer)from;}
   };
   template <> struct Convertion<Integer, unsigned long> {
+    enum {Allowed = 1};
     static bool Possible() {return true;}
     static void Do(const Integer &from, unsigned long &to) {to = (unsigned long)from;}
   };
   template <> struct Convertion<float, Integer> {
+    enum {Allowed = 1};
     static bool Possible() {return true;}
     static void Do(const float &from, Integer &to) {to = (Integer)from;}
   };
   template <> struct Convertion<Integer, float> {
+    enum {Allowed = 1};
     static bool Possible() {return true;}
     static void Do(const Integer &from, float &to) {to = (float)from;}
   };
   template <> struct Convertion<double, Integer> {
+    enum {Allowed = 1};
     static bool Possible() {return true;}
     static void Do(const double &from, Integer &to) {to = (Integer)from;}
   };
   template <> struct Convertion<Integer, double> {
+    enum {Allowed = 1};
     static bool Possible() {return true;}
     static void Do(const Integer &from, double &to) {to = (double)from;}
   };
   /*
   // plain type to bool
   template <> struct Convertion<char, bool> {
+    enum {Allowed = 1};
     static bool Possible() {return true;}
     static void Do(const char &from, bool &to) {to = (from != 0);}
   };
   template <> struct Convertion<bool, char> {
+    enum {Allowed = 1};
     static bool Possible() {return true;}
     static void Do(const bool &from, char &to) {to = (from ? 1 : 0);}
   };
   template <> struct Convertion<unsigned char, bool> {
+    enum {Allowed = 1};
     static bool Possible() {return true;}
     static void Do(const unsigned char &from, bool &to) {to = (from != 0);}
   };
   template <> struct Convertion<bool, unsigned char> {
+    enum {Allowed = 1};
     static bool Possible() {return true;}
     static void Do(const bool &from, unsigned char &to) {to = (from ? 1 : 0);}
   };
   template <> struct Convertion<short, bool> {
+    enum {Allowed = 1};
     static bool Possible() {return true;}
     static void Do(const short &from, bool &to) {to = (from != 0);}
   };
   template <> struct Convertion<bool, short> {
+    enum {Allowed = 1};
     static bool Possible() {return true;}
     static void Do(const bool &from, short &to) {to = (from ? 1 : 0);}
   };
   template <> struct Convertion<unsigned short, bool> {
+    enum {Allowed = 1};
     static bool Possible() {return true;}
     static void Do(const unsigned short &from, bool &to) {to = (from != 0);}
   };
   template <> struct Convertion<bool, unsigned short> {
+    enum {Allowed = 1};
     static bool Possible() {return true;}
     static void Do(const bool &from, unsigned short &to) {to = (from ? 1 : 0);}
   };
   template <> struct Convertion<int, bool> {
+    enum {Allowed = 1};
     static bool Possible() {return true;}
     static void Do(const int &from, bool &to) {to = (from != 0);}
   };
   template <> struct Convertion<bool, int> {
+    enum {Allowed = 1};
     static bool Possible() {return true;}
     static void Do(const bool &from, int &to) {to = (from ? 1 : 0);}
   };
   template <> struct Convertion<unsigned int, bool> {
+    enum {Allowed = 1};
     static bool Possible() {return true;}
     static void Do(const unsigned int &from, bool &to) {to = (from != 0);}
   };
   template <> struct Convertion<bool, unsigned int> {
+    enum {Allowed = 1};
     static bool Possible() {return true;}
     static void Do(const bool &from, unsigned int &to) {to = (from ? 1 : 0);}
   };
   template <> struct Convertion<long, bool> {
+    enum {Allowed = 1};
     static bool Possible() {return true;}
     static void Do(const long &from, bool &to) {to = (from != 0);}
   };
   template <> struct Convertion<bool, long> {
+    enum {Allowed = 1};
     static bool Possible() {return true;}
     static void Do(const bool &from, long &to) {to = (from ? 1 : 0);}
   };
   template <> struct Convertion<unsigned long, bool> {
+    enum {Allowed = 1};
     static bool Possible() {return true;}
     static void Do(const unsigned long &from, bool &to) {to = (from != 0);}
   };
   template <> struct Convertion<bool, unsigned long> {
+    enum {Allowed = 1};
     static bool Possible() {return true;}
     static void Do(const bool &from, unsigned long &to) {to = (from ? 1 : 0);}
   };
   template <> struct Convertion<float, bool> {
+    enum {Allowed = 1};
     static bool Possible() {return true;}
     static void Do(const float &from, bool &to) {to = (from != 0.0f);}
   };
   template <> struct Convertion<bool, float> {
+    enum {Allowed = 1};
     static bool Possible() {return true;}
     static void Do(const bool &from, float &to) {to = (from ? 1.0f : 0.0f);}
   };
   template <> struct Convertion<double, bool> {
+    enum {Allowed = 1};
     static bool Possible() {return true;}
     static void Do(const double &from, bool &to) {to = (from != 0.0);}
   };
   template <> struct Convertion<bool, double> {
+    enum {Allowed = 1};
     static bool Possible() {return true;}
     static void Do(const bool &from, double &to) {to = (from ? 1.0 : 0.0);}
   };
   */
   // plain type to real
   template <> struct Convertion<char, Real> {
+    enum {Allowed = 1};
     static bool Possible() {return true;}
     static void Do(const char &from, Real &to) {to = (Real)from;}
   };
   template <> struct Convertion<Real, char> {
+    enum {Allowed = 1};
     static bool Possible() {return true;}
     static void Do(const Real &from, char &to) {to = (char)from;}
   };
   template <> struct Convertion<unsigned char, Real> {
+    enum {Allowed = 1};
     static bool Possible() {return true;}
     static void Do(const unsigned char &from, Real &to) {to = (Real)from;}
   };
   template <> struct Convertion<Real, unsigned char> {
+    enum {Allowed = 1};
     static bool Possible() {return true;}
     static void Do(const Real &from, unsigned char &to) {to = (unsigned char)from;}
   };
   template <> struct Convertion<short, Real> {
+    enum {Allowed = 1};
     static bool Possible() {return true;}
     static void Do(const short &from, Real &to) {to = (Real)from;}
   };
   template <> struct Convertion<Real, short> {
+    enum {Allowed = 1};
     static bool Possible() {return true;}
     static void Do(const Real &from, short &to) {to = (short)from;}
   };
   template <> struct Convertion<unsigned short, Real> {
+    enum {Allowed = 1};
     static bool Possible() {return true;}
     static void Do(const unsigned short &from, Real &to) {to = (Real)from;}
   };
   template <> struct Convertion<Real, unsigned short> {
+    enum {Allowed = 1};
     static bool Possible() {return true;}
     static void Do(const Real &from, unsigned short &to) {to = (unsigned short)from;}
   };
   template <> struct Convertion<int, Real> {
+    enum {Allowed = 1};
     static bool Possible() {return true;}
     static void Do(const int &from, Real &to) {to = (Real)from;}
   };
   template <> struct Convertion<Real, int> {
+    enum {Allowed = 1};
     static bool Possible() {return true;}
     static void Do(const Real &from, int &to) {to = (int)from;}
   };
   template <> struct Convertion<unsigned int, Real> {
+    enum {Allowed = 1};
     static bool Possible() {return true;}
     static void Do(const unsigned int &from, Real &to) {to = (Real)from;}
   };
   template <> struct Convertion<Real, unsigned int> {
+    enum {Allowed = 1};
     static bool Possible() {return true;}
     static void Do(const Real &from, unsigned int &to) {to = (unsigned int)from;}
   };
 #ifndef NATIVE_64BIT_LONG
   template <> struct Convertion<long, Real> {
+    enum {Allowed = 1};
     static bool Possible() {return true;}
     static void Do(const long &from, Real &to) {to = (Real)from;}
   };
   template <> struct Convertion<Real, long> {
+    enum {Allowed = 1};
     static bool Possible() {return true;}
     static void Do(const Real &from, long &to) {to = (long)from;}
   };
 #endif
   template <> struct Convertion<unsigned long, Real> {
+    enum {Allowed = 1};
     static bool Possible() {return true;}
     static void Do(const unsigned long &from, Real &to) {to = (Real)from;}
   };
   template <> struct Convertion<Real, unsigned long> {
+    enum {Allowed = 1};
     static bool Possible() {return true;}
     static void Do(const Real &from, unsigned long &to) {to = (unsigned long)from;}
   };
   template <> struct Convertion<float, Real> {
+    enum {Allowed = 1};
     static bool Possible() {return true;}
     static void Do(const float &from, Real &to) {to = (Real)from;}
   };
   template <> struct Convertion<Real, float> {
+    enum {Allowed = 1};
     static bool Possible() {return true;}
     static void Do(const Real &from, float &to) {to = (float)from;}
   };
   // void* to typed pointer
   template <typename T> struct Convertion<void*, T*> {
+    enum {Allowed = 1};
     static bool Possible() {return true;}
     static void Do(void* const &from, T* &to) {to = (T*) from;}
   };
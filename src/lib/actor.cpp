@@ -0,0 +1,345 @@
+/*
+
+Copyright (C) 2009, 2010  Gaetan Guidet
+
+This file is part of lwc.
+
+lwc is free software; you can redistribute it and/or modify it
+under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 2.1 of the License, or (at
+your option) any later version.
+
+lwc is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+USA.
+
+*/
+
+#include <lwc/actor.h>
+#ifdef _WIN32
+# include <windows.h>
+#endif
+
+namespace lwc {
+
+Mailbox::ThreadID Mailbox::CurrentThread() {
+#ifdef _WIN32
+  return GetCurrentThreadId();
+#else
+  return pthread_self();
+#endif
+}
+
+Mailbox::Mailbox(size_t capacity, bool ownThread)
+  : mHead(&mStub), mTail(&mStub), mCapacity(capacity), mDepth(0), mWaitingProducers(0),
+    mSleeping(0), mStop(0), mThread(0), mOwnerSet(0),
+    mSent(0), mPosted(0), mProcessed(0), mFailed(0), mMaxDepth(0), mStalls(0) {
+  
+  mStub.next = 0;
+  
+  if (ownThread) {
+    mThread = new gcore::Thread(this, &Mailbox::ownerMain, 0);
+    // wait for the owner thread to be known
+    mDoneMutex.lock();
+    while (atomic::Load(&mOwnerSet) == 0) {
+      mDone.wait(mDoneMutex);
+    }
+    mDoneMutex.unlock();
+  } else {
+    mOwner = CurrentThread();
+    atomic::Store(&mOwnerSet, 1);
+  }
+}
+
+Mailbox::~Mailbox() {
+  if (mThread) {
+    mWakeMutex.lock();
+    atomic::Store(&mStop, 1);
+    mWake.notify();
+    mWakeMutex.unlock();
+    mThread->wait();
+    delete mThread;
+  } else {
+    // process would do nothing off the owner thread, leaving the senders
+    // blocked and the posted calls allocated
+    drain(0);
+  }
+}
+
+bool Mailbox::isOwnerThread() const {
+#ifdef _WIN32
+  return (mOwner == CurrentThread());
+#else
+  return (pthread_equal(mOwner, CurrentThread()) != 0);
+#endif
+}
+
+void Mailbox::push(Message *msg) {
+  // backpressure (the owner thread would wait for itself)
+  if (mCapacity > 0 && size_t(atomic::Load(&mDepth)) >= mCapacity && !isOwnerThread()) {
+    mRoomMutex.lock();
+    atomic::Increment(&mWaitingProducers);
+    atomic::Increment(&mStalls);
+    while (size_t(atomic::Load(&mDepth)) >= mCapacity) {
+      mRoom.wait(mRoomMutex);
+    }
+    atomic::Decrement(&mWaitingProducers);
+    mRoomMutex.unlock();
+  }
+  
+  atomic::Increment(&mDepth);
+  
+  msg->next = 0;
+  Node *prev = (Node*) atomic::ExchangePointer(&mHead, (Node*) msg);
+  atomic::StorePointer(&(prev->next), (Node*) msg);
+  
+  // ordered with the mDepth increment (see ownerMain)
+  if (atomic::LoadSeqCst(&mSleeping) != 0) {
+    mWakeMutex.lock();
+    mWake.notify();
+    mWakeMutex.unlock();
+  }
+}
+
+Mailbox::Message* Mailbox::pop() {
+  Node *tail = mTail;
+  Node *next = (Node*) atomic::LoadPointer(&(tail->next));
+  
+  if (tail == &mStub) {
+    if (!next) {
+      return 0;
+    }
+    mTail = next;
+    tail = next;
+    next = (Node*) atomic::LoadPointer(&(next->next));
+  }
+  
+  if (next) {
+    mTail = next;
+    return static_cast<Message*>(tail);
+  }
+  
+  if (tail != (Node*) atomic::LoadPointer(&mHead)) {
+    // a producer has not linked its message yet
+    return 0;
+  }
+  
+  // tail is the last message: queue the stub behind it
+  mStub.next = 0;
+  Node *prev = (Node*) atomic::ExchangePointer(&mHead, &mStub);
+  atomic::StorePointer(&(prev->next), &mStub);
+  
+  next = (Node*) atomic::LoadPointer(&(tail->next));
+  if (next) {
+    mTail = next;
+    return static_cast<Message*>(tail);
+  }
+  
+  return 0;
+}
+
+void Mailbox::run(Message *msg) {
+  if (msg->func) {
+    try {
+      msg->func(msg->data);
+    } catch (std::exception &e) {
+      msg->status->setFailed(0, e.what());
+    } catch (...) {
+      msg->status->setFailed(0, "Unknown error");
+    }
+    complete(msg);
+  } else if (msg->status) {
+    *(msg->status) = msg->object->tryCall(msg->name, *(msg->params));
+    atomic::Increment(&mProcessed);
+    complete(msg);
+  } else {
+    PostedMessage *pmsg = static_cast<PostedMessage*>(msg);
+    Status status = pmsg->object->tryCall(pmsg->ownedName.c_str(), *(pmsg->params));
+    if (status.failed()) {
+      atomic::Increment(&mFailed);
+    }
+    atomic::Increment(&mProcessed);
+    delete pmsg->params;
+    delete pmsg;
+  }
+}
+
+void Mailbox::complete(Message *msg) {
+  // the caller owns the message: do not touch it once done is set
+  mDoneMutex.lock();
+  atomic::Store(&(msg->done), 1);
+  mDone.notifyAll();
+  mDoneMutex.unlock();
+}
+
+size_t Mailbox::process(size_t maxCalls) {
+  if (!isOwnerThread()) {
+    return 0;
+  }
+  return drain(maxCalls);
+}
+
+size_t Mailbox::drain(size_t maxCalls) {
+  size_t n = 0;
+  
+  while (maxCalls == 0 || n < maxCalls) {
+    long depth = atomic::Load(&mDepth);
+    
+    Message *msg = pop();
+    if (!msg) {
+      break;
+    }
+    
+    // single writer
+    if (depth > mMaxDepth) {
+      atomic::Store(&mMaxDepth, depth);
+    }
+    
+    atomic::Decrement(&mDepth);
+    if (atomic::Load(&mWaitingProducers) != 0) {
+      mRoomMutex.lock();
+      mRoom.notifyAll();
+      mRoomMutex.unlock();
+    }
+    
+    run(msg);
+    ++n;
+  }
+  
+  return n;
+}
+
+int Mailbox::ownerMain(void *) {
+  mOwner = CurrentThread();
+  
+  mDoneMutex.lock();
+  atomic::Store(&mOwnerSet, 1);
+  mDone.notifyAll();
+  mDoneMutex.unlock();
+  
+  while (true) {
+    if (process() > 0) {
+      continue;
+    }
+    mWakeMutex.lock();
+    // full barrier: producers check mSleeping after queueing, the mDepth
+    // load must not be reordered before the increment (lost wake up)
+    atomic::Increment(&mSleeping);
+    while (atomic::LoadSeqCst(&mDepth) == 0 && atomic::Load(&mStop) == 0) {
+      mWake.wait(mWakeMutex);
+    }
+    atomic::Decrement(&mSleeping);
+    bool stop = (atomic::Load(&mDepth) == 0 && atomic::Load(&mStop) != 0);
+    mWakeMutex.unlock();
+    if (stop) {
+      break;
+    }
+  }
+  
+  return 0;
+}
+
+void Mailbox::send(Object *o, const char *name, MethodParams &params, Status &status) {
+  if (isOwnerThread()) {
+    status = o->tryCall(name, params);
+    return;
+  }
+  
+  Message msg;
+  msg.object = o;
+  msg.name = name;
+  msg.params = &params;
+  msg.status = &status;
+  msg.func = 0;
+  msg.data = 0;
+  
+  atomic::Increment(&mSent);
+  wait(&msg);
+}
+
+void Mailbox::execute(Func func, void *data) throw(std::runtime_error) {
+  if (isOwnerThread()) {
+    func(data);
+    return;
+  }
+  
+  Status status;
+  Message msg;
+  msg.object = 0;
+  msg.name = 0;
+  msg.params = 0;
+  msg.status = &status;
+  msg.func = func;
+  msg.data = data;
+  
+  wait(&msg);
+  
+  if (status.failed()) {
+    throw std::runtime_error(status.getMessage());
+  }
+}
+
+void Mailbox::wait(Message *msg) {
+  msg->done = 0;
+  
+  push(msg);
+  
+  mDoneMutex.lock();
+  while (atomic::Load(&(msg->done)) == 0) {
+    mDone.wait(mDoneMutex);
+  }
+  mDoneMutex.unlock();
+}
+
+void Mailbox::post(Object *o, const char *name, const MethodParams &params) throw(std::runtime_error) {
+  const Method &meth = params.getMethod();
+  
+  for (size_t i=0; i<meth.numArgs(); ++i) {
+    if (meth[i].getDir() != AD_IN || meth[i].isArray()) {
+      std::ostringstream oss;
+      oss << "Mailbox::post: Method \"" << name << "\" has output or array arguments";
+      throw std::runtime_error(oss.str());
+    }
+  }
+  
+  PostedMessage *msg = new PostedMessage();
+  msg->object = o;
+  msg->name = 0;
+  msg->ownedName = name;
+  msg->params = new MethodParams(params);
+  msg->status = 0;
+  msg->func = 0;
+  msg->data = 0;
+  msg->done = 0;
+  
+  // input strings may not outlive the caller
+  msg->strings.reserve(meth.numArgs());
+  ArgumentValue *values = msg->params->rawvalues();
+  for (size_t i=0; i<meth.numArgs(); ++i) {
+    if (meth[i].getType() == AT_STRING && values[i].ptr != 0) {
+      msg->strings.push_back((const char*) values[i].ptr);
+      values[i].ptr = (void*) msg->strings.back().c_str();
+    }
+  }
+  
+  atomic::Increment(&mPosted);
+  push(msg);
+}
+
+void Mailbox::getStats(MailboxStats &stats) const {
+  stats.sent = (unsigned long) atomic::Load(&mSent);
+  stats.posted = (unsigned long) atomic::Load(&mPosted);
+  stats.processed = (unsigned long) atomic::Load(&mProcessed);
+  stats.failed = (unsigned long) atomic::Load(&mFailed);
+  stats.depth = (unsigned long) atomic::Load(&mDepth);
+  stats.maxDepth = (unsigned long) atomic::Load(&mMaxDepth);
+  stats.stalls = (unsigned long) atomic::Load(&mStalls);
+}
+
+}
@@ -30,6 +30,21 @@ const KeywordArgs NoKeywordArgs = KeywordArgs();
 
 const ArgumentValue Argument::_DefVal = {0};
 
+const char* ConversionErrorString(ConversionError err) {
+  switch (err) {
+    case CE_NONE:
+      return "No error";
+    case CE_INDIRECTION:
+      return "Invalid level of indirection";
+    case CE_TYPE:
+      return "Invalid argument type";
+    case CE_EMPTY:
+      return "Empty is not a valid argument type";
+    default:
+      return "Unknown conversion error";
+  }
+}
+
 // ---
 
 BaseArgument::BaseArgument()
@@ -72,7 +87,7 @@ BaseArgument& BaseArgument::operator=(const BaseArgument &rhs) {
 
 BaseArgument& BaseArgument::setDir(Direction d) {
   mDir = d;
-  mIndirectionLevel = (mDir != AD_IN ? 1 : 0) + (mArray ? 1 : 0);
+  mIndirectionLevel = ((mDir == AD_OUT || mDir == AD_INOUT) ? 1 : 0) + (mArray ? 1 : 0);
   return *this;
 }
 
@@ -84,7 +99,7 @@ BaseArgument& BaseArgument::setType(Type t) {
     mType = t;
     mArray = false;
   }
-  mIndirectionLevel = (mDir != AD_IN ? 1 : 0) + (mArray ? 1 : 0);
+  mIndirectionLevel = ((mDir == AD_OUT || mDir == AD_INOUT) ? 1 : 0) + (mArray ? 1 : 0);
   return *this;
 }
 
@@ -0,0 +1,309 @@
+/*
+
+Copyright (C) 2009, 2010  Gaetan Guidet
+
+This file is part of lwc.
+
+lwc is free software; you can redistribute it and/or modify it
+under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 2.1 of the License, or (at
+your option) any later version.
+
+lwc is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+USA.
+
+*/
+
+#include <lwc/callsite.h>
+
+namespace lwc {
+
+CallSite::CallSite()
+  : mBinding(CSB_NATIVE), mNumArgs(0), mDefaults(0), mTyped(false) {
+}
+
+CallSite::CallSite(const MethodHandle &handle, size_t nargs, const KeywordArgs &kwargs) throw(std::runtime_error)
+  : mBinding(CSB_NATIVE), mNumArgs(0), mDefaults(0), mTyped(false) {
+  Status status;
+  if (!compile(handle, nargs, kwargs, status)) {
+    throw std::runtime_error(status.getMessage());
+  }
+}
+
+CallSite::CallSite(const CallSite &rhs) {
+  operator=(rhs);
+}
+
+CallSite::~CallSite() {
+}
+
+CallSite& CallSite::operator=(const CallSite &rhs) {
+  if (this != &rhs) {
+    mHandle = rhs.mHandle;
+    mBinding = rhs.mBinding;
+    mNumArgs = rhs.mNumArgs;
+    mDefaults = rhs.mDefaults;
+    mKeywords = rhs.mKeywords;
+    mTyped = rhs.mTyped;
+    for (size_t k=0; k<mKeywords.size(); ++k) {
+      mKeywordSlots[k] = rhs.mKeywordSlots[k];
+      mKeywordTypes[k] = rhs.mKeywordTypes[k];
+      mKeywordIndirections[k] = rhs.mKeywordIndirections[k];
+      mKeywordConversions[k] = rhs.mKeywordConversions[k];
+    }
+  }
+  return *this;
+}
+
+unsigned long CallSite::ImplicitArgs(const Method &m) {
+  unsigned long mask = 0;
+  for (size_t i=0; i<m.numArgs(); ++i) {
+    if (m[i].getDir() == AD_OUT || m[i].getDir() == AD_RETURN || m[i].arrayArg() >= 0) {
+      mask |= (1UL << i);
+    }
+  }
+  return mask;
+}
+
+bool CallSite::compile(const MethodHandle &handle, size_t nargs, const char **keywords, size_t nkeywords,
+                       Binding binding, Status &status) {
+  
+  // handle may be our own
+  MethodHandle target(handle);
+  
+  mHandle = MethodHandle();
+  mKeywords.clear();
+  mTyped = false;
+  
+  if (!target.isValid()) {
+    status.set(EC_INVALID_HANDLE, handle.getName());
+    return false;
+  }
+  
+  const char *name = handle.getName();
+  const Method &meth = target.getMethod();
+  unsigned long implicit = (binding == CSB_SCRIPT ? ImplicitArgs(meth) : 0);
+  
+  // method arguments covered by the positional values
+  size_t slots = 0;
+  size_t consumed = 0;
+  while (slots < meth.numArgs() && consumed < nargs) {
+    if ((implicit & (1UL << slots)) == 0) {
+      ++consumed;
+    }
+    ++slots;
+  }
+  if (consumed < nargs || nkeywords > LWC_MAX_ARGS) {
+    status.set(EC_ARGUMENT_COUNT, name, -1, 0, long(meth.numArgs()));
+    return false;
+  }
+  
+  unsigned long provided = (slots >= 8 * sizeof(unsigned long) ? ~0UL : (1UL << slots) - 1);
+  
+  for (size_t k=0; k<nkeywords; ++k) {
+    size_t idx = 0;
+    if (!meth.findNamedArg(keywords[k], idx) || (implicit & (1UL << idx)) != 0) {
+      status.set(EC_ARGUMENT_NAME, name, -1, keywords[k]);
+      return false;
+    }
+    if ((provided & (1UL << idx)) != 0) {
+      status.set(EC_KEYWORD_TWICE, name, long(idx), meth[idx].getName().c_str());
+      return false;
+    }
+    mKeywords.push_back(keywords[k]);
+    mKeywordSlots[k] = idx;
+    mKeywordConversions[k] = CONV_NONE;
+    provided |= (1UL << idx);
+  }
+  
+  provided |= implicit;
+  
+  if ((meth.requiredArgsMask() & ~provided) != 0) {
+    status.set(EC_ARGUMENT_COUNT, name, -1, 0, long(meth.numArgs()));
+    mKeywords.clear();
+    return false;
+  }
+  
+  mDefaults = 0;
+  for (size_t i=0; i<meth.numArgs(); ++i) {
+    if ((provided & (1UL << i)) == 0) {
+      mDefaults |= (1UL << i);
+    }
+  }
+  
+  mHandle = target;
+  mBinding = binding;
+  mNumArgs = nargs;
+  
+  return true;
+}
+
+bool CallSite::compile(const MethodHandle &handle, size_t nargs, const KeywordArgs &kwargs, Status &status) {
+  
+  const char *keywords[LWC_MAX_ARGS];
+  size_t nkeywords = 0;
+  
+  KeywordArgs::const_iterator it = kwargs.begin();
+  while (it != kwargs.end() && nkeywords < LWC_MAX_ARGS) {
+    keywords[nkeywords++] = it->first.c_str();
+    ++it;
+  }
+  if (it != kwargs.end()) {
+    status.set(EC_ARGUMENT_COUNT, handle.getName(), -1, 0, long(LWC_MAX_ARGS));
+    return false;
+  }
+  
+  if (!compile(handle, nargs, keywords, nkeywords, CSB_NATIVE, status)) {
+    return false;
+  }
+  
+  const Method &meth = handle.getMethod();
+  
+  size_t k = 0;
+  for (it=kwargs.begin(); it!=kwargs.end(); ++it, ++k) {
+    const Argument &ma = meth[mKeywordSlots[k]];
+    const BaseArgument &kv = it->second;
+    mKeywordTypes[k] = kv.getType();
+    mKeywordIndirections[k] = kv.indirectionLevel();
+    if (!kv.typeMatches(ma)) {
+      // same implicit conversions as Object::SetDefaultArgs
+      if (ma.indirectionLevel() == 0 && kv.indirectionLevel() == 0 &&
+          kv.getType() == AT_INT && ma.getType() == AT_REAL) {
+        mKeywordConversions[k] = CONV_INT_TO_REAL;
+      } else if (ma.indirectionLevel() == 0 && kv.indirectionLevel() == 0 &&
+                 kv.getType() == AT_REAL && ma.getType() == AT_INT) {
+        mKeywordConversions[k] = CONV_REAL_TO_INT;
+      } else {
+        status.set(EC_KEYWORD_TYPE, handle.getName(), long(mKeywordSlots[k]), ma.getName().c_str());
+        mHandle = MethodHandle();
+        mKeywords.clear();
+        return false;
+      }
+    }
+  }
+  
+  mTyped = true;
+  
+  return true;
+}
+
+bool CallSite::matches(const MethodsTable *table, const char *name, size_t nargs,
+                       const char **keywords, size_t nkeywords, Binding binding) const {
+  if (mNumArgs != nargs || mKeywords.size() != nkeywords || mBinding != binding ||
+      mHandle.getMethodsTable() != table || !mHandle.isValid() ||
+      strcmp(mHandle.getName(), name) != 0) {
+    return false;
+  }
+  for (size_t k=0; k<nkeywords; ++k) {
+    if (mKeywords[k] != keywords[k]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool CallSite::bind(MethodParams &params, size_t nargs, const KeywordArgs &kwargs, Status &status) const {
+  
+  const Method &meth = params.getMethod();
+  
+  if (!mTyped || !mHandle.isValid() || &meth != &(mHandle.getMethod()) ||
+      nargs != mNumArgs || kwargs.size() != mKeywords.size()) {
+    status.set(EC_CALL_SHAPE, mHandle.getName());
+    return false;
+  }
+  
+  // start from the default image, keywords overwrite their slots
+  params.setDefaults(nargs);
+  
+  size_t k = 0;
+  KeywordArgs::const_iterator it = kwargs.begin();
+  
+  while (it != kwargs.end()) {
+    const BaseArgument &kv = it->second;
+    if (kv.getType() != mKeywordTypes[k] ||
+        kv.indirectionLevel() != mKeywordIndirections[k] ||
+        it->first != mKeywords[k]) {
+      status.set(EC_CALL_SHAPE, mHandle.getName());
+      return false;
+    }
+    switch (mKeywordConversions[k]) {
+      case CONV_INT_TO_REAL: {
+        ArgumentValue av;
+        av.real = Real(kv.getRawValue().integer);
+        params.rawset(mKeywordSlots[k], av, false);
+        break;
+      }
+      case CONV_REAL_TO_INT: {
+        ArgumentValue av;
+        av.integer = Integer(kv.getRawValue().real);
+        params.rawset(mKeywordSlots[k], av, false);
+        break;
+      }
+      default:
+        params.rawset(mKeywordSlots[k], kv.getRawValue(), false);
+    }
+    ++k;
+    ++it;
+  }
+  
+  return true;
+}
+
+// ---
+
+CallSiteCache::CallSiteCache(size_t capacity)
+  : mCapacity(capacity > 0 ? capacity : 1), mNext(0) {
+}
+
+CallSiteCache::~CallSiteCache() {
+}
+
+const CallSite* CallSiteCache::get(const MethodsTable *table, const char *name, size_t nargs,
+                                   const char **keywords, size_t nkeywords,
+                                   CallSite::Binding binding, Status &status) {
+  
+  for (size_t i=0; i<mSites.size(); ++i) {
+    if (mSites[i].matches(table, name, nargs, keywords, nkeywords, binding)) {
+      return &(mSites[i]);
+    }
+  }
+  
+  if (!table || !table->findMethod(name)) {
+    status.set(EC_NO_METHOD, name);
+    return 0;
+  }
+  
+  CallSite site;
+  
+  if (!site.compile(MethodHandle(table, name), nargs, keywords, nkeywords, binding, status)) {
+    // do not reference the temporary handle name
+    status.setMethodName(name);
+    return 0;
+  }
+  
+  // replace the oldest entry once full
+  if (mSites.size() < mCapacity) {
+    mSites.push_back(site);
+    return &(mSites.back());
+  } else {
+    size_t i = mNext;
+    mNext = (mNext + 1) % mCapacity;
+    mSites[i] = site;
+    return &(mSites[i]);
+  }
+}
+
+void CallSiteCache::clear() {
+  mSites.clear();
+  mNext = 0;
+}
+
+}
+
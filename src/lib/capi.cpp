@@ -0,0 +1,285 @@
+/*
+
+Copyright (C) 2009, 2010  Gaetan Guidet
+
+This file is part of lwc.
+
+lwc is free software; you can redistribute it and/or modify it
+under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 2.1 of the License, or (at
+your option) any later version.
+
+lwc is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+USA.
+
+*/
+
+#include <lwc/capi.h>
+#include <lwc/registry.h>
+#include <gcore/path.h>
+
+namespace lwc {
+  
+  // lwc_value must be usable in place of ArgumentValue
+  typedef char ValueLayoutCheck[(sizeof(lwc_value) == sizeof(ArgumentValue) &&
+                                 sizeof(lwc_integer) == sizeof(Integer)) ? 1 : -1];
+  
+  // per thread so that concurrent callers do not see each other's failures,
+  // messages are truncated to the buffer size
+  static LWC_THREAD_LOCAL char LastError[1024];
+  static LWC_THREAD_LOCAL size_t LastErrorLength;
+  
+  static void SetLastError(const std::string &msg) {
+    size_t n = msg.length();
+    if (n >= sizeof(LastError)) {
+      n = sizeof(LastError) - 1;
+    }
+    memcpy(LastError, msg.c_str(), n);
+    LastError[n] = '\0';
+    LastErrorLength = n;
+  }
+  
+  // lwc_value slots are reinterpreted without conversion: check what can be
+  // checked from the raw bits
+  static bool CheckValues(const Method &meth, const lwc_value *args, long &index) {
+    for (size_t i=0; i<meth.numArgs(); ++i) {
+      Direction dir = meth[i].getDir();
+      if (dir == AD_OUT || dir == AD_INOUT) {
+        if (args[i].ptr == 0) {
+          index = long(i);
+          return false;
+        }
+      } else if (dir == AD_IN && meth[i].getType() == AT_BOOL) {
+        if (args[i].boolean > 1) {
+          index = long(i);
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+  
+  static int Fail(const Status &status) {
+    SetLastError(status.getMessage());
+    return int(status.getCode());
+  }
+  
+  static int Fail(ErrorCode code, const char *method, const std::string &msg) {
+    Status status;
+    status.set(code, method);
+    SetLastError(msg.length() > 0 ? msg : status.getMessage());
+    return int(code);
+  }
+  
+  static inline Registry* ToRegistry(lwc_registry *reg) {
+    return reinterpret_cast<Registry*>(reg);
+  }
+  
+  static inline Object* ToObject(lwc_object *obj) {
+    return reinterpret_cast<Object*>(obj);
+  }
+  
+  static inline const MethodHandle* ToHandle(const lwc_method *method) {
+    return reinterpret_cast<const MethodHandle*>(method);
+  }
+}
+
+using namespace lwc;
+
+extern "C" {
+
+lwc_registry* lwc_registry_create(void) {
+  try {
+    return reinterpret_cast<lwc_registry*>(Registry::Initialize());
+  } catch (std::exception &e) {
+    SetLastError(e.what());
+  } catch (...) {
+    SetLastError("lwc_registry_create: Unknown error");
+  }
+  return 0;
+}
+
+void lwc_registry_destroy(lwc_registry *reg) {
+  if (reg && ToRegistry(reg) == Registry::Instance()) {
+    try {
+      Registry::DeInitialize();
+    } catch (...) {
+      SetLastError("lwc_registry_destroy: Unknown error");
+    }
+  }
+}
+
+int lwc_registry_add_loader_path(lwc_registry *reg, const char *path) {
+  if (!reg || !path) {
+    return Fail(EC_FAILED, 0, "lwc_registry_add_loader_path: Invalid registry or path");
+  }
+  try {
+    ToRegistry(reg)->addLoaderPath(gcore::Path(path));
+  } catch (std::exception &e) {
+    return Fail(EC_FAILED, 0, e.what());
+  } catch (...) {
+    return Fail(EC_FAILED, 0, "lwc_registry_add_loader_path: Unknown error");
+  }
+  return EC_NONE;
+}
+
+int lwc_registry_add_module_path(lwc_registry *reg, const char *path) {
+  if (!reg || !path) {
+    return Fail(EC_FAILED, 0, "lwc_registry_add_module_path: Invalid registry or path");
+  }
+  try {
+    ToRegistry(reg)->addModulePath(gcore::Path(path));
+  } catch (std::exception &e) {
+    return Fail(EC_FAILED, 0, e.what());
+  } catch (...) {
+    return Fail(EC_FAILED, 0, "lwc_registry_add_module_path: Unknown error");
+  }
+  return EC_NONE;
+}
+
+int lwc_registry_has_type(lwc_registry *reg, const char *type) {
+  return ((reg && type && ToRegistry(reg)->hasType(type)) ? 1 : 0);
+}
+
+lwc_object* lwc_object_create(lwc_registry *reg, const char *type) {
+  if (!reg || !type) {
+    SetLastError("lwc_object_create: Invalid registry or type");
+    return 0;
+  }
+  try {
+    Object *o = ToRegistry(reg)->create(type);
+    if (!o) {
+      SetLastError(std::string("lwc_object_create: Unknown type \"") + type + "\"");
+    }
+    return reinterpret_cast<lwc_object*>(o);
+  } catch (std::exception &e) {
+    SetLastError(e.what());
+  } catch (...) {
+    SetLastError("lwc_object_create: Unknown error");
+  }
+  return 0;
+}
+
+void lwc_object_destroy(lwc_registry *reg, lwc_object *obj) {
+  if (!reg || !obj) {
+    return;
+  }
+  try {
+    ToRegistry(reg)->destroy(ToObject(obj));
+  } catch (std::exception &e) {
+    SetLastError(e.what());
+  } catch (...) {
+    SetLastError("lwc_object_destroy: Unknown error");
+  }
+}
+
+const char* lwc_object_type(const lwc_object *obj) {
+  return (obj ? reinterpret_cast<const Object*>(obj)->getTypeName() : 0);
+}
+
+lwc_method* lwc_method_lookup(lwc_registry *reg, const char *type, const char *name) {
+  if (!reg || !type || !name) {
+    SetLastError("lwc_method_lookup: Invalid registry, type or method name");
+    return 0;
+  }
+  try {
+    MethodHandle *handle = new MethodHandle(ToRegistry(reg)->getMethodHandle(type, name));
+    return reinterpret_cast<lwc_method*>(handle);
+  } catch (std::exception &e) {
+    SetLastError(e.what());
+  } catch (...) {
+    SetLastError("lwc_method_lookup: Unknown error");
+  }
+  return 0;
+}
+
+void lwc_method_release(lwc_method *method) {
+  delete reinterpret_cast<MethodHandle*>(method);
+}
+
+size_t lwc_method_num_args(const lwc_method *method) {
+  return (method ? ToHandle(method)->getMethod().numArgs() : 0);
+}
+
+int lwc_method_arg_type(const lwc_method *method, size_t i) {
+  if (!method || i >= ToHandle(method)->getMethod().numArgs()) {
+    return -1;
+  }
+  return int(ToHandle(method)->getMethod()[i].getType());
+}
+
+int lwc_method_arg_dir(const lwc_method *method, size_t i) {
+  if (!method || i >= ToHandle(method)->getMethod().numArgs()) {
+    return -1;
+  }
+  return int(ToHandle(method)->getMethod()[i].getDir());
+}
+
+int lwc_call(lwc_object *obj, const lwc_method *method, lwc_value *args, size_t nargs) {
+  if (!obj || !method) {
+    return Fail(EC_INVALID_HANDLE, (method ? ToHandle(method)->getName() : ""),
+                "lwc_call: Invalid object or method handle");
+  }
+  
+  const MethodHandle &handle = *ToHandle(method);
+  const Method &meth = handle.getMethod();
+  
+  if (nargs != meth.numArgs() || (nargs > 0 && !args)) {
+    Status status;
+    status.set(EC_ARGUMENT_COUNT, handle.getName(), -1, 0, long(meth.numArgs()));
+    return Fail(status);
+  }
+  
+  long badarg = -1;
+  if (!CheckValues(meth, args, badarg)) {
+    Status status;
+    status.set(EC_ARGUMENT_TYPE, handle.getName(), badarg);
+    return Fail(status);
+  }
+  
+  try {
+    MethodParams params(meth);
+    
+    // values are copied as is, no per argument conversion
+    ArgumentValue *values = params.rawvalues();
+    for (size_t i=0; i<nargs; ++i) {
+      values[i] = reinterpret_cast<const ArgumentValue*>(args)[i];
+    }
+    
+    Status status = ToObject(obj)->tryCall(handle, params);
+    if (status.failed()) {
+      return Fail(status);
+    }
+    
+    if (meth.hasReturn()) {
+      size_t r = size_t(meth.returnArg());
+      reinterpret_cast<ArgumentValue*>(args)[r] = values[r];
+    }
+    
+  } catch (std::exception &e) {
+    return Fail(EC_FAILED, handle.getName(), e.what());
+  } catch (...) {
+    return Fail(EC_FAILED, handle.getName(), "");
+  }
+  
+  return EC_NONE;
+}
+
+size_t lwc_last_error(char *buf, size_t size) {
+  size_t len = LastErrorLength;
+  if (buf && size > 0) {
+    size_t n = (len < size ? len : size - 1);
+    memcpy(buf, LastError, n);
+    buf[n] = '\0';
+  }
+  return len;
+}
+
+}
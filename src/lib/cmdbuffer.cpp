@@ -0,0 +1,274 @@
+/*
+
+Copyright (C) 2009, 2010  Gaetan Guidet
+
+This file is part of lwc.
+
+lwc is free software; you can redistribute it and/or modify it
+under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 2.1 of the License, or (at
+your option) any later version.
+
+lwc is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+USA.
+
+*/
+
+#include <lwc/cmdbuffer.h>
+#include <lwc/memory.h>
+
+namespace lwc {
+
+CommandBuffer::Command::Command(Object *o, const char *n, const Method &m, size_t v)
+  : object(o), name(n), params(m), values(v), inputs(0) {
+}
+
+// ---
+
+CommandBuffer::CommandBuffer()
+  : mCompleted(0), mFailed(0) {
+}
+
+CommandBuffer::~CommandBuffer() {
+  releaseOutputs();
+}
+
+void CommandBuffer::clear() {
+  releaseOutputs();
+  mCommands.clear();
+  mValues.clear();
+  mStrings.clear();
+  mFailed = 0;
+}
+
+bool CommandBuffer::tryRecord(Object *o, const CallTarget &target, size_t &index, Status &status) {
+  if (!o) {
+    status.setFailed(target.getName(), "CommandBuffer::record: Invalid object");
+    return false;
+  }
+  
+  const Method *meth = o->findMethod(target, status);
+  
+  if (!meth) {
+    return false;
+  }
+  
+  // owned by the methods table
+  const char *name = o->getMethods()->findMethodName(target.getName());
+  
+  for (size_t i=0; i<meth->numArgs(); ++i) {
+    const Argument &arg = (*meth)[i];
+    if (arg.isArray() || (arg.getDir() == AD_INOUT && arg.getType() == AT_STRING)) {
+      std::ostringstream oss;
+      oss << "Method \"" << name << "\": Array and in/out string arguments are not supported by command buffers";
+      status.setFailed(name, oss.str().c_str());
+      return false;
+    }
+  }
+  
+  index = mCommands.size();
+  
+  mCommands.push_back(Command(o, name, *meth, mValues.size()));
+  mValues.resize(mValues.size() + meth->numArgs());
+  mStrings.resize(mValues.size());
+  
+  Command &c = mCommands.back();
+  
+  c.params.setDefaults();
+  
+  for (size_t i=0; i<meth->numArgs(); ++i) {
+    const Argument &arg = (*meth)[i];
+    mValues[c.values+i].ptr = 0;
+    if (arg.getDir() == AD_INOUT && arg.hasDefaultValue()) {
+      mValues[c.values+i] = arg.getRawDefaultValue();
+    }
+  }
+  
+  return true;
+}
+
+size_t CommandBuffer::record(Object *o, const CallTarget &target) throw(std::runtime_error) {
+  Status status;
+  size_t index = 0;
+  if (!tryRecord(o, target, index, status)) {
+    throw std::runtime_error(status.getMessage());
+  }
+  return index;
+}
+
+void CommandBuffer::pop() {
+  if (mCommands.empty()) {
+    return;
+  }
+  releaseOutputs();
+  mValues.resize(mCommands.back().values);
+  mStrings.resize(mValues.size());
+  mCommands.pop_back();
+}
+
+CommandBuffer::Command* CommandBuffer::command(size_t cmd, Status &status) {
+  if (cmd >= mCommands.size()) {
+    std::ostringstream oss;
+    oss << "CommandBuffer: Invalid command index " << cmd;
+    status.setFailed(0, oss.str().c_str());
+    return 0;
+  }
+  return &(mCommands[cmd]);
+}
+
+const CommandBuffer::Command& CommandBuffer::command(size_t cmd) const throw(std::runtime_error) {
+  if (cmd >= mCommands.size()) {
+    std::ostringstream oss;
+    oss << "CommandBuffer: Invalid command index " << cmd;
+    throw std::runtime_error(oss.str());
+  }
+  return mCommands[cmd];
+}
+
+Object* CommandBuffer::getObject(size_t cmd) const throw(std::runtime_error) {
+  return command(cmd).object;
+}
+
+const char* CommandBuffer::getName(size_t cmd) const throw(std::runtime_error) {
+  return command(cmd).name;
+}
+
+const Method& CommandBuffer::getMethod(size_t cmd) const throw(std::runtime_error) {
+  return command(cmd).params.getMethod();
+}
+
+bool CommandBuffer::inputArg(const Command &c, size_t k, size_t &i, Status &status) const {
+  const Method &meth = c.params.getMethod();
+  size_t n = 0;
+  for (i=0; i<meth.numArgs(); ++i) {
+    if (meth[i].getDir() == AD_IN || meth[i].getDir() == AD_INOUT) {
+      if (n++ == k) {
+        return true;
+      }
+    }
+  }
+  status.set(EC_ARGUMENT_COUNT, c.name, -1, 0, long(n));
+  return false;
+}
+
+bool CommandBuffer::trySetInput(size_t cmd, size_t k, const char *value, Status &status) {
+  Command *c = command(cmd, status);
+  size_t i = 0;
+  if (!c || !inputArg(*c, k, i, status)) {
+    return false;
+  }
+  if (!trySetInput<const char*>(cmd, k, value, status)) {
+    return false;
+  }
+  // the parameters point to the copy from bind
+  mStrings[c->values+i] = (value ? value : "");
+  return true;
+}
+
+bool CommandBuffer::bind(Command &c, Status &status) {
+  const Method &meth = c.params.getMethod();
+  ArgumentValue *values = c.params.rawvalues();
+  bool missing = false;
+  size_t k = 0;
+  
+  for (size_t i=0; i<meth.numArgs(); ++i) {
+    const Argument &arg = meth[i];
+    if (arg.getDir() == AD_IN || arg.getDir() == AD_INOUT) {
+      bool set = ((c.inputs & (1UL << k)) != 0);
+      if (!set && !arg.hasDefaultValue()) {
+        missing = true;
+      }
+      if (set && arg.getType() == AT_STRING && values[i].ptr) {
+        values[i].ptr = (void*) mStrings[c.values+i].c_str();
+      }
+      ++k;
+    }
+    if (arg.getDir() == AD_OUT || arg.getDir() == AD_INOUT) {
+      values[i].ptr = (void*) &(mValues[c.values+i]);
+    }
+  }
+  
+  if (missing) {
+    status.set(EC_ARGUMENT_COUNT, c.name, -1, 0, long(k));
+    return false;
+  }
+  
+  return true;
+}
+
+Status CommandBuffer::trySubmit() {
+  Status status;
+  
+  releaseOutputs();
+  
+  for (mFailed=0; mFailed<mCommands.size(); ++mFailed) {
+    if (!bind(mCommands[mFailed], status)) {
+      return status;
+    }
+  }
+  
+  for (mFailed=0; mFailed<mCommands.size(); ++mFailed) {
+    Command &c = mCommands[mFailed];
+    status = c.object->tryCall(c.name, c.params);
+    if (status.failed()) {
+      break;
+    }
+    ++mCompleted;
+  }
+  
+  return status;
+}
+
+void CommandBuffer::submit() throw(std::runtime_error) {
+  Status status = trySubmit();
+  if (status.failed()) {
+    std::ostringstream oss;
+    oss << "CommandBuffer::submit: Command " << mFailed << ": " << status.getMessage();
+    throw std::runtime_error(oss.str());
+  }
+}
+
+const ArgumentValue& CommandBuffer::output(size_t cmd, size_t i, BaseArgument &arg) const throw(std::runtime_error) {
+  const Command &c = command(cmd);
+  if (cmd >= mCompleted) {
+    std::ostringstream oss;
+    oss << "CommandBuffer::get: Command " << cmd << " did not complete";
+    throw std::runtime_error(oss.str());
+  }
+  const Method &meth = c.params.getMethod();
+  if (i >= meth.numArgs() || meth[i].getDir() == AD_IN) {
+    std::ostringstream oss;
+    oss << "CommandBuffer::get: Method argument " << i << " is not an output";
+    throw std::runtime_error(oss.str());
+  }
+  arg = BaseArgument(AD_IN, meth[i].getType());
+  return (meth[i].getDir() == AD_RETURN ? c.params.rawget(i, false) : mValues[c.values+i]);
+}
+
+void CommandBuffer::releaseOutputs() {
+  for (size_t i=0; i<mCompleted; ++i) {
+    Command &c = mCommands[i];
+    const Method &meth = c.params.getMethod();
+    for (size_t j=0; j<meth.numArgs(); ++j) {
+      // string return values are not allowed (see Method::validateArgs)
+      const Argument &arg = meth[j];
+      if (arg.getType() == AT_STRING && arg.getDir() == AD_OUT) {
+        ArgumentValue &v = mValues[c.values+j];
+        if (v.ptr) {
+          memory::Free(v.ptr);
+          v.ptr = 0;
+        }
+      }
+    }
+  }
+  mCompleted = 0;
+}
+
+}
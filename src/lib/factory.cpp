@@ -22,6 +22,7 @@ USA.
 */
 
 #include <lwc/factory.h>
+#include <algorithm>
 
 namespace lwc {
 
@@ -29,6 +30,92 @@ Factory::Factory() {
 }
 
 Factory::~Factory() {
+  std::map<std::string, ObjectPool*>::iterator it = mPools.begin();
+  while (it != mPools.end()) {
+    delete it->second;
+    ++it;
+  }
+}
+
+bool Factory::setPool(const char *typeName, size_t maxSize, size_t warmUp) {
+  if (!typeName || !getMethods(typeName) || isSingleton(typeName)) {
+    return false;
+  }
+  ObjectPool *current = 0;
+  std::map<std::string, ObjectPool*>::iterator it = mPools.find(typeName);
+  if (it != mPools.end()) {
+    current = it->second;
+    if (maxSize == 0) {
+      mPools.erase(it);
+      delete current;
+      return true;
+    }
+  } else if (maxSize == 0) {
+    return true;
+  }
+  if (warmUp > maxSize) {
+    warmUp = maxSize;
+  } else if (warmUp == 0) {
+    warmUp = 1;
+  }
+  // instances are warmed up in a separate pool, the current one is left
+  // untouched (and out of mPools: create allocates new instances) until they
+  // were all accepted
+  size_t idle = (current ? std::min(current->size(), maxSize) : 0);
+  size_t count = (warmUp > idle ? warmUp - idle : 0);
+  ObjectPool *pool = new ObjectPool(current ? count : maxSize);
+  if (current) {
+    mPools.erase(it);
+  }
+  bool failed = false;
+  while (pool->size() < count) {
+    Object *o = create(typeName);
+    if (!o) {
+      break;
+    }
+    if (!pool->release(o)) {
+      destroy(o);
+      failed = true;
+      break;
+    }
+  }
+  if (failed) {
+    delete pool;
+    if (current) {
+      mPools[typeName] = current;
+    }
+    return false;
+  }
+  if (current) {
+    current->setMaxSize(maxSize);
+    current->adopt(*pool);
+    delete pool;
+    pool = current;
+  }
+  mPools[typeName] = pool;
+  return true;
+}
+
+bool Factory::getPoolStats(const char *typeName, PoolStats &stats) const {
+  if (!typeName) {
+    return false;
+  }
+  std::map<std::string, ObjectPool*>::const_iterator it = mPools.find(typeName);
+  if (it == mPools.end()) {
+    return false;
+  }
+  it->second->getStats(stats);
+  return true;
+}
+
+Object* Factory::acquirePooled(const char *typeName) {
+  std::map<std::string, ObjectPool*>::iterator it = mPools.find(typeName);
+  return (it != mPools.end() ? it->second->acquire() : 0);
+}
+
+bool Factory::releasePooled(Object *o) {
+  std::map<std::string, ObjectPool*>::iterator it = mPools.find(o->getTypeName());
+  return (it != mPools.end() && it->second->release(o));
 }
 
 }
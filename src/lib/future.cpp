@@ -0,0 +1,169 @@
+/*
+
+Copyright (C) 2009, 2010  Gaetan Guidet
+
+This file is part of lwc.
+
+lwc is free software; you can redistribute it and/or modify it
+under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 2.1 of the License, or (at
+your option) any later version.
+
+lwc is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+USA.
+
+*/
+
+#include <lwc/future.h>
+#include <lwc/registry.h>
+#include <lwc/actor.h>
+
+namespace lwc {
+
+Future::Future(Object *o, const char *name, const Method &m)
+  : mObject(o), mName(name), mParams(m), mNumInputs(0), mExecutor(0), mStarted(false), mDone(false) {
+  for (size_t i=0; i<m.numArgs(); ++i) {
+    mValues[i].ptr = 0;
+    if (m[i].getDir() == AD_IN || m[i].getDir() == AD_INOUT) {
+      mInputs[mNumInputs++] = i;
+    }
+  }
+}
+
+Future::~Future() {
+  wait();
+}
+
+bool Future::bind(size_t ninputs, Status &status) {
+  const Method &meth = getMethod();
+  
+  for (size_t i=0; i<meth.numArgs(); ++i) {
+    if (meth[i].isArray() || (meth[i].getDir() == AD_INOUT && meth[i].getType() == AT_STRING)) {
+      std::ostringstream oss;
+      oss << "Method \"" << mName << "\": Array and in/out string arguments are not supported by asynchronous calls";
+      status.setFailed(0, oss.str().c_str());
+      return false;
+    }
+  }
+  
+  if (ninputs > mNumInputs) {
+    status.set(EC_ARGUMENT_COUNT, 0, -1, 0, long(mNumInputs));
+    return false;
+  }
+  
+  mParams.setDefaults();
+  
+  for (size_t k=ninputs; k<mNumInputs; ++k) {
+    const Argument &arg = meth[mInputs[k]];
+    if (!arg.hasDefaultValue()) {
+      status.set(EC_ARGUMENT_COUNT, 0, -1, 0, long(mNumInputs));
+      return false;
+    }
+    if (arg.getDir() == AD_INOUT) {
+      mValues[mInputs[k]] = arg.getRawDefaultValue();
+    }
+  }
+  
+  ArgumentValue *values = mParams.rawvalues();
+  
+  for (size_t i=0; i<meth.numArgs(); ++i) {
+    if (meth[i].getDir() == AD_OUT || meth[i].getDir() == AD_INOUT) {
+      values[i].ptr = (void*) &(mValues[i]);
+    }
+  }
+  
+  return true;
+}
+
+bool Future::keepString(size_t i) {
+  // the caller buffer may be gone by the time the call runs
+  ArgumentValue &value = mParams.rawvalues()[i];
+  if (getMethod()[i].getType() == AT_STRING && value.ptr != 0) {
+    mStrings[i] = (const char*) value.ptr;
+    value.ptr = (void*) mStrings[i].c_str();
+  }
+  return true;
+}
+
+void Future::start() {
+  mStarted = true;
+  Registry *reg = Registry::Instance();
+  Mailbox *mailbox = mObject->getMailbox();
+  if (reg && (mObject->allowsConcurrentCalls() ||
+              (mailbox && mailbox->hasOwnThread() && !mailbox->isOwnerThread()))) {
+    // a worker runs the call or forwards it to the owner thread
+    mExecutor = reg->getExecutor();
+    mExecutor->submit(mGroup, Run, (void*)this, 1, 1);
+  } else {
+    // calling thread, as would a synchronous call
+    run();
+    mDone = true;
+  }
+}
+
+void Future::run() {
+  try {
+    mStatus = mObject->tryCall(mName.c_str(), mParams);
+  } catch (std::exception &e) {
+    mStatus.setFailed(mName.c_str(), e.what());
+  } catch (...) {
+    mStatus.setFailed(mName.c_str(), "Unknown error");
+  }
+}
+
+void Future::Run(void *data, size_t, size_t) {
+  ((Future*) data)->run();
+}
+
+bool Future::ready() {
+  if (!mStarted) {
+    return false;
+  }
+  return (mExecutor ? mGroup.finished() : mDone);
+}
+
+void Future::wait() {
+  // finished calls no longer use the executor (see Registry::setNumWorkers)
+  if (mExecutor && !mGroup.finished()) {
+    mExecutor->wait(mGroup);
+  }
+}
+
+const Status& Future::getStatus() {
+  wait();
+  return mStatus;
+}
+
+void Future::check() throw(std::runtime_error) {
+  wait();
+  if (mStatus.failed()) {
+    throw std::runtime_error(mStatus.getMessage());
+  }
+}
+
+const ArgumentValue& Future::output(size_t i, BaseArgument &arg) throw(std::runtime_error) {
+  check();
+  const Method &meth = getMethod();
+  if (i >= meth.numArgs() || meth[i].getDir() == AD_IN) {
+    std::ostringstream oss;
+    oss << "Future::get: Method argument " << i << " is not an output";
+    throw std::runtime_error(oss.str());
+  }
+  arg = BaseArgument(AD_IN, meth[i].getType());
+  return (meth[i].getDir() == AD_RETURN ? mParams.rawget(i, false) : mValues[i]);
+}
+
+// ---
+
+Future* Object::callAsync(const CallTarget &target) throw(std::runtime_error) {
+  return Future::Call<>::Start(this, target);
+}
+
+}
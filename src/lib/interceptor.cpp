@@ -0,0 +1,123 @@
+/*
+
+Copyright (C) 2009, 2010  Gaetan Guidet
+
+This file is part of lwc.
+
+lwc is free software; you can redistribute it and/or modify it
+under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 2.1 of the License, or (at
+your option) any later version.
+
+lwc is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+USA.
+
+*/
+
+
+#include <lwc/interceptor.h>
+
+namespace lwc {
+
+volatile long InterceptorChain::msNumInstalled = 0;
+
+Interceptor::Interceptor() {
+}
+
+Interceptor::~Interceptor() {
+}
+
+bool Interceptor::before(Object *, const char *, MethodParams &, Status &) {
+  return true;
+}
+
+void Interceptor::after(Object *, const char *, MethodParams &, Status &) {
+}
+
+// ---
+
+InterceptorChain::InterceptorChain() {
+}
+
+InterceptorChain::~InterceptorChain() {
+  for (size_t i=0; i<mEntries.size(); ++i) {
+    atomic::Decrement(&msNumInstalled);
+  }
+}
+
+void InterceptorChain::add(Interceptor *i, const char *methodName) {
+  if (!i) {
+    return;
+  }
+  Entry e;
+  e.interceptor = i;
+  e.method = (methodName ? methodName : "");
+  mEntries.push_back(e);
+  atomic::Increment(&msNumInstalled);
+}
+
+size_t InterceptorChain::remove(Interceptor *i) {
+  size_t n = 0;
+  std::vector<Entry>::iterator it = mEntries.begin();
+  while (it != mEntries.end()) {
+    if (it->interceptor == i) {
+      it = mEntries.erase(it);
+      atomic::Decrement(&msNumInstalled);
+      ++n;
+    } else {
+      ++it;
+    }
+  }
+  return n;
+}
+
+size_t InterceptorChain::before(Object *o, const char *name, MethodParams &params, Status &status) const {
+  for (size_t i=0; i<mEntries.size(); ++i) {
+    if (!matches(i, name)) {
+      continue;
+    }
+    bool accepted = false;
+    // a throwing interceptor rejects the call
+    try {
+      accepted = mEntries[i].interceptor->before(o, name, params, status);
+    } catch (std::exception &e) {
+      status.setFailed(name, e.what());
+    } catch (...) {
+      status.setFailed(name, "Unknown interceptor error");
+    }
+    if (!accepted) {
+      if (status.succeeded()) {
+        status.set(EC_INTERCEPTED, name);
+      }
+      return i;
+    }
+  }
+  return mEntries.size();
+}
+
+void InterceptorChain::after(Object *o, const char *name, MethodParams &params, Status &status, size_t n) const {
+  while (n > 0) {
+    --n;
+    if (!matches(n, name)) {
+      continue;
+    }
+    // the remaining interceptors still see the call
+    try {
+      mEntries[n].interceptor->after(o, name, params, status);
+    } catch (std::exception &e) {
+      status.setFailed(name, e.what());
+    } catch (...) {
+      status.setFailed(name, "Unknown interceptor error");
+    }
+  }
+}
+
+}
+
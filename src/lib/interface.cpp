@@ -0,0 +1,166 @@
+/*
+
+Copyright (C) 2009, 2010  Gaetan Guidet
+
+This file is part of lwc.
+
+lwc is free software; you can redistribute it and/or modify it
+under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 2.1 of the License, or (at
+your option) any later version.
+
+lwc is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+USA.
+
+*/
+
+
+#include <lwc/interface.h>
+#include <sstream>
+
+namespace lwc {
+
+Interface::Interface() {
+}
+
+Interface::Interface(const char *name, const MethodDecl *decls, size_t n) throw(std::runtime_error)
+  : mName(name ? name : "") {
+  
+  for (size_t i=0; i<n; ++i) {
+    
+    const MethodDecl &decl = decls[i];
+    
+    size_t slot = 0;
+    if (findSlot(decl.name, slot)) {
+      std::ostringstream oss;
+      oss << "Interface \"" << mName << "\": Method already declared \"" << decl.name << "\"";
+      throw std::runtime_error(oss.str());
+    }
+    
+    Method m;
+    Argument arg;
+    
+    m.setDescription(decl.desc);
+    
+    for (Integer j=0; j<decl.nargs; ++j) {
+      arg.fromDeclaration(decl.args[j]);
+      m.addArg(arg);
+    }
+    
+    mSlotNames.push_back(decl.name);
+    mSlots.push_back(m);
+  }
+}
+
+Interface::Interface(const Interface &rhs)
+  : mName(rhs.mName), mSlotNames(rhs.mSlotNames), mSlots(rhs.mSlots) {
+}
+
+Interface::~Interface() {
+}
+
+Interface& Interface::operator=(const Interface &rhs) {
+  if (this != &rhs) {
+    mName = rhs.mName;
+    mSlotNames = rhs.mSlotNames;
+    mSlots = rhs.mSlots;
+  }
+  return *this;
+}
+
+bool Interface::findSlot(const char *name, size_t &slot) const {
+  for (size_t i=0; i<mSlotNames.size(); ++i) {
+    if (mSlotNames[i] == name) {
+      slot = i;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool Interface::matches(size_t slot, const Method &m, long &argIndex) const {
+  const Method &sig = mSlots[slot];
+  
+  if (sig.numArgs() != m.numArgs()) {
+    argIndex = -1;
+    return false;
+  }
+  
+  for (size_t i=0; i<sig.numArgs(); ++i) {
+    const Argument &expected = sig[i];
+    const Argument &actual = m[i];
+    if (expected.getDir() != actual.getDir() ||
+        !expected.typeMatches(actual) ||
+        expected.arraySizeArg() != actual.arraySizeArg()) {
+      argIndex = long(i);
+      return false;
+    }
+  }
+  
+  return true;
+}
+
+std::string Interface::toString() const {
+  std::ostringstream oss;
+  oss << mName << std::endl;
+  for (size_t i=0; i<mSlots.size(); ++i) {
+    oss << "  " << i << ": " << mSlotNames[i] << mSlots[i].toString() << std::endl;
+  }
+  return oss.str();
+}
+
+// ---
+
+InterfaceBinding::InterfaceBinding()
+  : mInterface(0), mTable(0) {
+}
+
+InterfaceBinding::InterfaceBinding(const Interface &iface, const MethodsTable *table)
+  : mInterface(&iface), mTable(table) {
+  
+  for (size_t i=0; i<iface.numSlots(); ++i) {
+    
+    const char *name = iface.getSlotName(i);
+    const Method *m = (table ? table->findMethod(name) : 0);
+    long argIndex = -1;
+    
+    if (!m) {
+      mStatus.set(EC_NO_METHOD, name);
+    } else if (!iface.matches(i, *m, argIndex)) {
+      mStatus.set(EC_SIGNATURE_MISMATCH, name, argIndex, iface.getName());
+    } else {
+      mSlots.push_back(MethodHandle(table, name));
+      continue;
+    }
+    
+    mSlots.clear();
+    break;
+  }
+}
+
+InterfaceBinding::InterfaceBinding(const InterfaceBinding &rhs)
+  : mInterface(rhs.mInterface), mTable(rhs.mTable), mSlots(rhs.mSlots), mStatus(rhs.mStatus) {
+}
+
+InterfaceBinding::~InterfaceBinding() {
+}
+
+InterfaceBinding& InterfaceBinding::operator=(const InterfaceBinding &rhs) {
+  if (this != &rhs) {
+    mInterface = rhs.mInterface;
+    mTable = rhs.mTable;
+    mSlots = rhs.mSlots;
+    mStatus = rhs.mStatus;
+  }
+  return *this;
+}
+
+}
+
@@ -117,6 +117,22 @@ void Loader::destroy(Object *o) {
   }
 }
 
+bool Loader::setPool(const char *name, size_t maxSize, size_t warmUp) {
+  if (!name) {
+    return false;
+  }
+  std::map<std::string, Factory*>::iterator it = mFactories.find(name);
+  return (it != mFactories.end() && it->second->setPool(name, maxSize, warmUp));
+}
+
+bool Loader::getPoolStats(const char *name, PoolStats &stats) const {
+  if (!name) {
+    return false;
+  }
+  std::map<std::string, Factory*>::const_iterator it = mFactories.find(name);
+  return (it != mFactories.end() && it->second->getPoolStats(name, stats));
+}
+
 }
 
 
@@ -23,6 +23,11 @@ USA.
 
 #include <lwc/method.h>
 #include <lwc/object.h>
+#ifdef _WIN32
+# include <windows.h>
+#else
+# include <pthread.h>
+#endif
 #include <sstream>
 #include <algorithm>
 #include <set>
@@ -30,21 +35,17 @@ USA.
 
 namespace lwc {
 
-MethodPointer::MethodPointer() {
-}
-
-MethodPointer::~MethodPointer() {
-}
-
-// ---
-
 Method::Method()
-  : mPtr(0), mNumPArgs(0) {
+  : mPtr(0), mNumPArgs(0), mRequiredArgs(0), mDefaultArgs(0), mFlags(MF_NONE), mMemoized(false),
+    mReturnArg(-1), mSignature(SIG_GENERIC) {
 }
 
 Method::Method(const Method &rhs)
   : mArgs(rhs.mArgs), mPtr(rhs.mPtr), mDesc(rhs.mDesc),
-    mNumPArgs(rhs.mNumPArgs), mNArgIndices(rhs.mNArgIndices) {
+    mNumPArgs(rhs.mNumPArgs), mNArgIndices(rhs.mNArgIndices),
+    mRequiredArgs(rhs.mRequiredArgs), mDefaults(rhs.mDefaults),
+    mDefaultArgs(rhs.mDefaultArgs), mFlags(rhs.mFlags), mMemoized(rhs.mMemoized),
+    mReturnArg(rhs.mReturnArg), mSignature(rhs.mSignature) {
 }
 
 Method::~Method() {
@@ -57,6 +58,13 @@ Method& Method::operator=(const Method &rhs) {
     mDesc = rhs.mDesc;
     mNumPArgs = rhs.mNumPArgs;
     mNArgIndices = rhs.mNArgIndices;
+    mRequiredArgs = rhs.mRequiredArgs;
+    mDefaults = rhs.mDefaults;
+    mDefaultArgs = rhs.mDefaultArgs;
+    mFlags = rhs.mFlags;
+    mMemoized = rhs.mMemoized;
+    mReturnArg = rhs.mReturnArg;
+    mSignature = rhs.mSignature;
   }
   return *this;
 }
@@ -89,6 +97,23 @@ std::string Method::docString(const std::string &indent) const {
   return oss.str();
 }
 
+void Method::setFlags(unsigned long flags) {
+  mFlags = flags;
+  mMemoized = false;
+  if (isPure()) {
+    mMemoized = true;
+    for (size_t i=0; i<mArgs.size(); ++i) {
+      const Argument &arg = mArgs[i];
+      if (arg.isArray() || arg.arrayArg() >= 0 ||
+          arg.getDir() == AD_INOUT ||
+          (arg.getType() != AT_BOOL && arg.getType() != AT_INT && arg.getType() != AT_REAL)) {
+        mMemoized = false;
+        break;
+      }
+    }
+  }
+}
+
 void Method::addArg(const Argument &arg) throw(std::runtime_error) {
   if (mArgs.size() >= LWC_MAX_ARGS) {
     std::ostringstream oss;
@@ -105,17 +130,37 @@ void Method::addArg(const Argument &arg) throw(std::runtime_error) {
   } else {
     mNArgIndices[arg.getName()] = mArgs.size();
   }
+  ArgumentValue dv;
+  memset(&dv, 0, sizeof(ArgumentValue));
+  if (!arg.hasDefaultValue()) {
+    mRequiredArgs |= (1UL << mArgs.size());
+  } else {
+    mDefaultArgs |= (1UL << mArgs.size());
+    dv = arg.getRawDefaultValue();
+  }
+  mDefaults.push_back(dv);
   mArgs.push_back(arg);
+  // until validateArgs is called
+  mSignature = SIG_GENERIC;
 }
 
 size_t Method::namedArgIndex(const char *name) const throw(std::runtime_error) {
-  std::map<std::string, size_t>::const_iterator it = mNArgIndices.find(name);
-  if (it == mNArgIndices.end()) {
+  size_t idx = 0;
+  if (!findNamedArg(name, idx)) {
     std::ostringstream oss;
     oss << "Invalid argument name \"" << name << "\"";
     throw std::runtime_error(oss.str());
   }
-  return it->second;
+  return idx;
+}
+
+bool Method::findNamedArg(const char *name, size_t &idx) const {
+  std::map<std::string, size_t>::const_iterator it = mNArgIndices.find(name);
+  if (it == mNArgIndices.end()) {
+    return false;
+  }
+  idx = it->second;
+  return true;
 }
 
 void Method::validateArgs() throw(std::runtime_error) {
@@ -124,18 +169,48 @@ void Method::validateArgs() throw(std::runtime_error) {
   // once a default value is set, all following args must have one too (positional or named)
   // only in arguments can have default
   // out arguments cannot be named
+  // return argument must be the last one and hold a single bool, integer, real or object
   std::string name;
   std::set<std::string> names;
   std::set<std::string>::iterator nit;
   bool mustHaveName = false;
   bool mustHaveDefault = false;
   
+  mRequiredArgs = 0;
+  mDefaultArgs = 0;
+  mReturnArg = -1;
+  mDefaults.resize(mArgs.size());
+  if (!mDefaults.empty()) {
+    memset(&mDefaults[0], 0, mDefaults.size() * sizeof(ArgumentValue));
+  }
+  
   for (size_t i=0; i<mArgs.size(); ++i) {
     
+    if (!mArgs[i].hasDefaultValue()) {
+      mRequiredArgs |= (1UL << i);
+    } else {
+      mDefaultArgs |= (1UL << i);
+      mDefaults[i] = mArgs[i].getRawDefaultValue();
+    }
+    
+    if (mArgs[i].getDir() == AD_RETURN) {
+      if (i+1 != mArgs.size()) {
+        std::ostringstream oss;
+        oss << "return argument " << i << " must be the last argument";
+        throw std::runtime_error(oss.str());
+      }
+      if (mArgs[i].isArray() || mArgs[i].getType() == AT_STRING) {
+        std::ostringstream oss;
+        oss << "return argument " << i << " must be a bool, integer, real or object";
+        throw std::runtime_error(oss.str());
+      }
+      mReturnArg = long(i);
+    }
+    
     name = mArgs[i].getName();
     if (name.length() > 0) {
       mustHaveName = true;
-      if (mArgs[i].getDir() == AD_OUT) {
+      if (mArgs[i].getDir() == AD_OUT || mArgs[i].getDir() == AD_RETURN) {
         std::ostringstream oss;
         oss << "output argument " << i << " cannot be named" << std::endl;
         throw std::runtime_error(oss.str());
@@ -147,7 +222,7 @@ void Method::validateArgs() throw(std::runtime_error) {
         throw std::runtime_error(oss.str());
       }
     //} else if (mArgs[i].getDir() != AD_OUT && mustHaveName) {
-    } else if (mustHaveName && mArgs[i].getDir() != AD_OUT) {
+    } else if (mustHaveName && mArgs[i].getDir() != AD_OUT && mArgs[i].getDir() != AD_RETURN) {
       // reject any positional arguments after keyword ones
       std::ostringstream oss;
       oss << "positional argument " << i << " must precede any named argument";
@@ -162,7 +237,7 @@ void Method::validateArgs() throw(std::runtime_error) {
         throw std::runtime_error(oss.str());
       }
     //} else if (mArgs[i].getDir() == AD_IN && mustHaveDefault) {
-    } else if (mustHaveDefault && mArgs[i].getDir() != AD_OUT) {
+    } else if (mustHaveDefault && mArgs[i].getDir() != AD_OUT && mArgs[i].getDir() != AD_RETURN) {
       // all remaining arguments must have defaults
       std::ostringstream oss;
       oss << "argument " << i << " must have a default value";
@@ -195,67 +270,282 @@ void Method::validateArgs() throw(std::runtime_error) {
       mArgs[idx].setArrayArg(Integer(i));
     }
   }
+  
+  // array size arguments are only known now
+  setFlags(mFlags);
+  
+  mSignature = computeSignature();
+}
+
+Signature Method::computeSignature() const {
+  
+  for (size_t i=0; i<mArgs.size(); ++i) {
+    if (mArgs[i].isArray() || mArgs[i].arrayArg() >= 0) {
+      return SIG_GENERIC;
+    }
+  }
+  
+  if (mArgs.size() == 0) {
+    return SIG_VOID;
+    
+  } else if (mArgs.size() == 1) {
+    switch (mArgs[0].getDir()) {
+      case AD_IN:
+        switch (mArgs[0].getType()) {
+          case AT_BOOL: return SIG_BOOL;
+          case AT_INT: return SIG_INT;
+          case AT_REAL: return SIG_REAL;
+          case AT_STRING: return SIG_STRING;
+          default: return SIG_GENERIC;
+        }
+      case AD_OUT:
+        switch (mArgs[0].getType()) {
+          case AT_BOOL: return SIG_OUT_BOOL;
+          case AT_INT: return SIG_OUT_INT;
+          case AT_REAL: return SIG_OUT_REAL;
+          default: return SIG_GENERIC;
+        }
+      case AD_RETURN:
+        switch (mArgs[0].getType()) {
+          case AT_BOOL: return SIG_RETURN_BOOL;
+          case AT_INT: return SIG_RETURN_INT;
+          case AT_REAL: return SIG_RETURN_REAL;
+          default: return SIG_GENERIC;
+        }
+      default:
+        return SIG_GENERIC;
+    }
+    
+  } else if (mArgs.size() == 2 && mArgs[0].getDir() == AD_IN && mArgs[1].getDir() == AD_IN &&
+             mArgs[0].getType() == mArgs[1].getType()) {
+    switch (mArgs[0].getType()) {
+      case AT_INT: return SIG_INT_INT;
+      case AT_REAL: return SIG_REAL_REAL;
+      default: return SIG_GENERIC;
+    }
+  }
+  
+  return SIG_GENERIC;
+}
+
+// ---
+
+Property::Property()
+  : mType(AT_INT), mGetter(0), mSetter(0) {
+}
+
+Property::Property(const PropertyDecl &decl) throw(std::runtime_error)
+  : mType(decl.type), mGetter(decl.get), mSetter(decl.set),
+    mDesc(decl.desc ? decl.desc : "") {
+  if (mType != AT_BOOL && mType != AT_INT && mType != AT_REAL) {
+    throw std::runtime_error("Property: Only bool, integer and real properties are supported");
+  }
+  if (mGetter == 0) {
+    throw std::runtime_error("Property: No field or getter specified");
+  }
+}
+
+Property::Property(const Property &rhs)
+  : mType(rhs.mType), mGetter(rhs.mGetter), mSetter(rhs.mSetter),
+    mDesc(rhs.mDesc) {
+}
+
+Property::~Property() {
+}
+
+Property& Property::operator=(const Property &rhs) {
+  if (this != &rhs) {
+    mType = rhs.mType;
+    mGetter = rhs.mGetter;
+    mSetter = rhs.mSetter;
+    mDesc = rhs.mDesc;
+  }
+  return *this;
+}
+
+void Property::FieldWritten(Object *self) {
+  self->invalidateResults();
+}
+
+std::string Property::toString() const {
+  static const char* proptype[] = {
+    "bool", "integer", "real"
+  };
+  std::ostringstream oss;
+  oss << "[" << (isReadOnly() ? "get" : "get/set") << "] " << proptype[mType];
+  return oss.str();
+}
+
+std::string Property::docString(const std::string &indent) const {
+  std::ostringstream oss;
+  oss << indent << mDesc << std::endl;
+  oss << indent << toString() << std::endl;
+  return oss.str();
 }
 
 // ---
 
 MethodsTable::MethodsTable(const MethodsTable *parent)
-  : mParent(parent) {
+  : mParent(0), mIndexMask(0), mInterceptors(0) {
+  setParent(parent);
+  buildLookup();
+}
+
+MethodsTable::MethodsTable(const MethodsTable &rhs)
+  : mTable(rhs.mTable), mProperties(rhs.mProperties), mParent(0), mIndexMask(0)
+  , mInterfaces(rhs.mInterfaces), mSignals(rhs.mSignals), mInterceptors(0) {
+  setParent(rhs.mParent);
+  buildLookup();
 }
 
 MethodsTable::~MethodsTable() {
+  setParent(0);
+  // derived tables keep their own methods only
+  while (mDerived.size() > 0) {
+    MethodsTable *derived = mDerived.back();
+    derived->setParent(0);
+    derived->buildLookup();
+  }
   mTable.clear();
+  mProperties.clear();
+  mInterfaces.clear();
+  mSignals.clear();
 }
 
-size_t MethodsTable::numMethods() const {
-  // not of overridden methods
-  
+MethodsTable& MethodsTable::operator=(const MethodsTable &rhs) {
+  if (this != &rhs) {
+    mTable = rhs.mTable;
+    mProperties = rhs.mProperties;
+    setParent(rhs.mParent);
+    mInterfaces = rhs.mInterfaces;
+    mSignals = rhs.mSignals;
+    buildLookup();
+  }
+  return *this;
+}
+
+void MethodsTable::setParent(const MethodsTable *parent) {
+  if (mParent == parent) {
+    return;
+  }
   if (mParent) {
-    size_t n = mParent->numMethods();
-    std::map<std::string, Method>::const_iterator it = mTable.begin();
-    while (it != mTable.end()) {
-      if (mParent->findMethod(it->first.c_str()) == 0) {
-        ++n;
-      }
-      ++it;
-    }
-    return n;
-    
-  } else {
-    return mTable.size();
+    std::vector<MethodsTable*> &siblings = mParent->mDerived;
+    siblings.erase(std::find(siblings.begin(), siblings.end(), this));
+  }
+  mParent = parent;
+  if (mParent) {
+    mParent->mDerived.push_back(this);
   }
 }
 
-size_t MethodsTable::availableMethods(std::vector<std::string> &methodNames) const {
+void MethodsTable::buildLookup() {
+  // names are unique across the whole hierarchy, own methods overriding inherited ones
+  // entries names point to the owning table keys
+  std::map<std::string, Entry> visible;
+  
+  if (mParent) {
+    for (size_t i=0; i<mParent->mEntries.size(); ++i) {
+      visible[mParent->mEntries[i].name] = mParent->mEntries[i];
+    }
+  }
   
   std::map<std::string, Method>::const_iterator it = mTable.begin();
+  while (it != mTable.end()) {
+    Entry &e = visible[it->first];
+    e.name = it->first.c_str();
+    e.hash = Hash(e.name);
+    e.method = &(it->second);
+    ++it;
+  }
   
-  if (mParent) {
-    mParent->availableMethods(methodNames);
-    while (it != mTable.end()) {
-      if (mParent->findMethod(it->first.c_str()) == 0) {
-        methodNames.push_back(it->first);
-      }
-      ++it;
+  mEntries.clear();
+  mEntries.reserve(visible.size());
+  
+  std::map<std::string, Entry>::iterator vit = visible.begin();
+  while (vit != visible.end()) {
+    mEntries.push_back(vit->second);
+    ++vit;
+  }
+  
+  // keep load factor under 0.5
+  size_t size = 4;
+  while (size < 2 * mEntries.size()) {
+    size <<= 1;
+  }
+  
+  mIndex.assign(mEntries.empty() ? 0 : size, 0);
+  mIndexMask = (mEntries.empty() ? 0 : size - 1);
+  
+  for (size_t i=0; i<mEntries.size(); ++i) {
+    size_t j = mEntries[i].hash & mIndexMask;
+    while (mIndex[j] != 0) {
+      j = (j + 1) & mIndexMask;
     }
-    
-  } else {
-    methodNames.clear();
-    while (it != mTable.end()) {
-      methodNames.push_back(it->first);
-      ++it;
+    mIndex[j] = i + 1;
+  }
+  
+  std::map<std::string, PropEntry> props;
+  
+  if (mParent) {
+    for (size_t i=0; i<mParent->mPropEntries.size(); ++i) {
+      props[mParent->mPropEntries[i].name] = mParent->mPropEntries[i];
     }
   }
+  
+  std::map<std::string, Property>::const_iterator pit = mProperties.begin();
+  while (pit != mProperties.end()) {
+    PropEntry &e = props[pit->first];
+    e.name = pit->first.c_str();
+    e.hash = Hash(e.name);
+    e.property = &(pit->second);
+    ++pit;
+  }
+  
+  mPropEntries.clear();
+  mPropEntries.reserve(props.size());
+  
+  std::map<std::string, PropEntry>::iterator ppit = props.begin();
+  while (ppit != props.end()) {
+    mPropEntries.push_back(ppit->second);
+    ++ppit;
+  }
+  
+  // derived views copied ours
+  for (size_t i=0; i<mDerived.size(); ++i) {
+    mDerived[i]->buildLookup();
+  }
+}
+
+size_t MethodsTable::availableMethods(std::vector<std::string> &methodNames) const {
+  methodNames.clear();
+  methodNames.reserve(mEntries.size());
+  for (size_t i=0; i<mEntries.size(); ++i) {
+    methodNames.push_back(mEntries[i].name);
+  }
   return methodNames.size();
 }
 
-void MethodsTable::addMethod(const char *name, const Method &m, bool override) throw(std::runtime_error) {
+size_t MethodsTable::availableProperties(std::vector<std::string> &propertyNames) const {
+  propertyNames.clear();
+  propertyNames.reserve(mPropEntries.size());
+  for (size_t i=0; i<mPropEntries.size(); ++i) {
+    propertyNames.push_back(mPropEntries[i].name);
+  }
+  return propertyNames.size();
+}
+
+void MethodsTable::insertMethod(const char *name, const Method &m, bool override) throw(std::runtime_error) {
   std::map<std::string, Method>::iterator it = mTable.find(name);
   if (override == false && it != mTable.end()) {
     std::ostringstream oss;
     oss << "Object::addMethod: Method already defined \"" << name << "\"";
     throw std::runtime_error(oss.str());
   }
+  if (mProperties.find(name) != mProperties.end() || findProperty(name) != 0) {
+    std::ostringstream oss;
+    oss << "Object::addMethod: Property already defined \"" << name << "\"";
+    throw std::runtime_error(oss.str());
+  }
   mTable[name] = m;
   try {
     mTable[name].validateArgs();
@@ -268,7 +558,163 @@ void MethodsTable::addMethod(const char *name, const Method &m, bool override) t
   }
 }
 
+void MethodsTable::addMethod(const char *name, const Method &m, bool override) throw(std::runtime_error) {
+  // overriding one of our own methods keeps the entries valid
+  bool replaced = (mTable.find(name) != mTable.end());
+  try {
+    insertMethod(name, m, override);
+  } catch (std::runtime_error &) {
+    buildLookup();
+    throw;
+  }
+  if (!replaced) {
+    buildLookup();
+  }
+}
+
 void MethodsTable::fromDeclaration(const MethodDecl *decls, size_t n, bool override) throw(std::runtime_error) {
+  try {
+    for (size_t i=0; i<n; ++i) {
+      
+      const MethodDecl &decl = decls[i];
+      
+      Method m;
+      Argument arg;
+      
+      m.setPointer(decl.ptr);
+      m.setDescription(decl.desc);
+      m.setFlags(decl.flags);
+      
+      for (Integer j=0; j<decl.nargs; ++j) {
+        const ArgumentDecl &a = decl.args[j];
+        
+        arg.fromDeclaration(a);
+        m.addArg(arg);
+      }
+      
+      insertMethod(decl.name, m, override);
+    }
+  } catch (std::runtime_error &) {
+    buildLookup();
+    throw;
+  }
+  buildLookup();
+}
+
+void MethodsTable::insertProperty(const char *name, const Property &p, bool override) throw(std::runtime_error) {
+  if (override == false && mProperties.find(name) != mProperties.end()) {
+    std::ostringstream oss;
+    oss << "Object::addProperty: Property already defined \"" << name << "\"";
+    throw std::runtime_error(oss.str());
+  }
+  if (mTable.find(name) != mTable.end() || findMethod(name) != 0) {
+    std::ostringstream oss;
+    oss << "Object::addProperty: Method already defined \"" << name << "\"";
+    throw std::runtime_error(oss.str());
+  }
+  mProperties[name] = p;
+}
+
+void MethodsTable::addProperty(const char *name, const Property &p, bool override) throw(std::runtime_error) {
+  try {
+    insertProperty(name, p, override);
+  } catch (std::runtime_error &) {
+    buildLookup();
+    throw;
+  }
+  buildLookup();
+}
+
+void MethodsTable::fromDeclaration(const PropertyDecl *decls, size_t n, bool override) throw(std::runtime_error) {
+  try {
+    for (size_t i=0; i<n; ++i) {
+      Property p;
+      try {
+        p = Property(decls[i]);
+      } catch (std::runtime_error &e) {
+        std::ostringstream oss;
+        oss << "Object::addProperty: Invalid property \"" << decls[i].name << "\"" << std::endl;
+        oss << e.what();
+        throw std::runtime_error(oss.str());
+      }
+      insertProperty(decls[i].name, p, override);
+    }
+  } catch (std::runtime_error &) {
+    buildLookup();
+    throw;
+  }
+  buildLookup();
+}
+
+void MethodsTable::addInterface(const char *name, InterfaceCast cast, bool override) throw(std::runtime_error) {
+  if (!name || !cast) {
+    throw std::runtime_error("Object::addInterface: Invalid interface declaration");
+  }
+  for (size_t i=0; i<mInterfaces.size(); ++i) {
+    if (mInterfaces[i].first == name) {
+      if (override == false) {
+        std::ostringstream oss;
+        oss << "Object::addInterface: Interface already defined \"" << name << "\"";
+        throw std::runtime_error(oss.str());
+      }
+      mInterfaces[i].second = cast;
+      return;
+    }
+  }
+  mInterfaces.push_back(std::pair<std::string, InterfaceCast>(name, cast));
+}
+
+void MethodsTable::fromDeclaration(const InterfaceDecl *decls, size_t n, bool override) throw(std::runtime_error) {
+  for (size_t i=0; i<n; ++i) {
+    addInterface(decls[i].name, decls[i].cast, override);
+  }
+}
+
+size_t MethodsTable::availableSignals(std::vector<std::string> &signalNames) const {
+  if (mParent) {
+    mParent->availableSignals(signalNames);
+  } else {
+    signalNames.clear();
+  }
+  for (size_t i=0; i<mSignals.size(); ++i) {
+    if (std::find(signalNames.begin(), signalNames.end(), mSignals[i].first) == signalNames.end()) {
+      signalNames.push_back(mSignals[i].first);
+    }
+  }
+  return signalNames.size();
+}
+
+void MethodsTable::addSignal(const char *name, const Method &m, bool override) throw(std::runtime_error) {
+  if (!name) {
+    throw std::runtime_error("Object::addSignal: Invalid signal declaration");
+  }
+  if (m.numArgs() > LWC_MAX_SIGNAL_ARGS) {
+    std::ostringstream oss;
+    oss << "Object::addSignal: Signal \"" << name << "\" has more than " << LWC_MAX_SIGNAL_ARGS << " arguments";
+    throw std::runtime_error(oss.str());
+  }
+  for (size_t i=0; i<m.numArgs(); ++i) {
+    if (m[i].getDir() != AD_IN || m[i].isArray()) {
+      std::ostringstream oss;
+      oss << "Object::addSignal: Signal \"" << name << "\" argument " << i << " must be a non-array input";
+      throw std::runtime_error(oss.str());
+    }
+  }
+  for (size_t i=0; i<mSignals.size(); ++i) {
+    if (mSignals[i].first == name) {
+      if (override == false) {
+        std::ostringstream oss;
+        oss << "Object::addSignal: Signal already defined \"" << name << "\"";
+        throw std::runtime_error(oss.str());
+      }
+      mSignals[i].second = m;
+      return;
+    }
+  }
+  mSignals.push_back(std::pair<std::string, Method>(name, m));
+}
+
+void MethodsTable::addSignals(const MethodDecl *decls, size_t n, bool override) throw(std::runtime_error) {
   for (size_t i=0; i<n; ++i) {
     
     const MethodDecl &decl = decls[i];
@@ -276,17 +722,14 @@ void MethodsTable::fromDeclaration(const MethodDecl *decls, size_t n, bool overr
     Method m;
     Argument arg;
     
-    m.setPointer(decl.ptr);
     m.setDescription(decl.desc);
     
     for (Integer j=0; j<decl.nargs; ++j) {
-      const ArgumentDecl &a = decl.args[j];
-      
-      arg.fromDeclaration(a);
+      arg.fromDeclaration(decl.args[j]);
       m.addArg(arg);
     }
     
-    addMethod(decl.name, m, override);
+    addSignal(decl.name, m, override);
   }
 }
 
@@ -297,6 +740,11 @@ std::string MethodsTable::toString() const {
     oss << it->first << it->second.toString() << std::endl;
     ++it;
   }
+  std::map<std::string, Property>::const_iterator pit = mProperties.begin();
+  while (pit != mProperties.end()) {
+    oss << pit->first << " " << pit->second.toString() << std::endl;
+    ++pit;
+  }
   if (mParent) {
     oss << "Inherited:" << std::endl;
     oss << mParent->toString();
@@ -312,6 +760,12 @@ std::string MethodsTable::docString(const std::string &indent) const {
     oss << it->second.docString(indent+"  ") << std::endl;
     ++it;
   }
+  std::map<std::string, Property>::const_iterator pit = mProperties.begin();
+  while (pit != mProperties.end()) {
+    oss << indent << pit->first << std::endl;
+    oss << pit->second.docString(indent+"  ") << std::endl;
+    ++pit;
+  }
   if (mParent) {
     oss << std::endl << indent << "Inherited" << std::endl;
     oss << mParent->docString(indent+"  ") << std::endl;
@@ -321,16 +775,120 @@ std::string MethodsTable::docString(const std::string &indent) const {
 
 // ---
 
+MethodHandle::MethodHandle()
+  : mTable(0), mMethod(0) {
+}
+
+MethodHandle::MethodHandle(const MethodsTable *table, const char *name) throw(std::runtime_error)
+  : mTable(table), mMethod(0), mName(name ? name : "") {
+  mMethod = (mTable ? mTable->findMethod(mName.c_str()) : 0);
+  if (!mMethod) {
+    std::ostringstream oss;
+    oss << "MethodHandle: No method \"" << mName << "\" in methods table";
+    throw std::runtime_error(oss.str());
+  }
+}
+
+MethodHandle::MethodHandle(const MethodHandle &rhs)
+  : mTable(rhs.mTable), mMethod(rhs.mMethod), mName(rhs.mName) {
+}
+
+MethodHandle::~MethodHandle() {
+}
+
+MethodHandle& MethodHandle::operator=(const MethodHandle &rhs) {
+  if (this != &rhs) {
+    mTable = rhs.mTable;
+    mMethod = rhs.mMethod;
+    mName = rhs.mName;
+  }
+  return *this;
+}
+
+// ---
+
+// Calls with more than InlineArgs arguments spill to a buffer of LWC_MAX_ARGS
+// values. Each thread keeps its last released buffer in a thread specific
+// slot freed at thread exit: no lock on the call path, and no static
+// container that could be destroyed before the last MethodParams
+
+#ifdef _WIN32
+
+static void WINAPI FreeSpillSlot(void *values) {
+  delete[] reinterpret_cast<ArgumentValue*>(values);
+}
+
+struct SpillSlot {
+  DWORD key;
+  bool ready;
+  SpillSlot() {
+    key = FlsAlloc(FreeSpillSlot);
+    ready = (key != FLS_OUT_OF_INDEXES);
+  }
+  inline void* get() const {return FlsGetValue(key);}
+  inline void set(void *values) const {FlsSetValue(key, values);}
+};
+
+#else
+
+extern "C" {
+static void FreeSpillSlot(void *values) {
+  delete[] reinterpret_cast<lwc::ArgumentValue*>(values);
+}
+}
+
+struct SpillSlot {
+  pthread_key_t key;
+  bool ready;
+  SpillSlot() {
+    ready = (pthread_key_create(&key, FreeSpillSlot) == 0);
+  }
+  inline void* get() const {return pthread_getspecific(key);}
+  inline void set(void *values) const {pthread_setspecific(key, values);}
+};
+
+#endif
+
+// the key is never deleted, buffers released after static destruction are
+// still cached or freed correctly. Before the slot is initialized (static
+// MethodParams in other modules) buffers are plainly allocated
+static SpillSlot Spill;
+
+ArgumentValue* MethodParams::AllocSpill() {
+  if (Spill.ready) {
+    ArgumentValue *values = reinterpret_cast<ArgumentValue*>(Spill.get());
+    if (values) {
+      Spill.set(0);
+      return values;
+    }
+  }
+  return new ArgumentValue[LWC_MAX_ARGS];
+}
+
+void MethodParams::FreeSpill(ArgumentValue *values) {
+  if (Spill.ready && Spill.get() == 0) {
+    Spill.set(values);
+  } else {
+    delete[] values;
+  }
+}
+
 MethodParams::MethodParams(const Method &m)
   : mMethod(m) {
+  mParams = (m.numArgs() <= size_t(InlineArgs) ? mInline : AllocSpill());
+  mReturnTarget.ptr = 0;
 }
 
 MethodParams::MethodParams(const MethodParams &rhs)
-  : mMethod(rhs.mMethod) {
-  memcpy(mParams, rhs.mParams, LWC_MAX_ARGS*sizeof(void*));
+  : mMethod(rhs.mMethod), mReturnTarget(rhs.mReturnTarget) {
+  mParams = (mMethod.numArgs() <= size_t(InlineArgs) ? mInline : AllocSpill());
+  memcpy(mParams, rhs.mParams, mMethod.numArgs()*sizeof(ArgumentValue));
 }
 
 MethodParams::~MethodParams() {
+  if (mParams != mInline) {
+    FreeSpill(mParams);
+  }
 }
 
 }
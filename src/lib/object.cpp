@@ -22,6 +22,8 @@ USA.
 */
 
 #include <lwc/object.h>
+#include <lwc/resultcache.h>
+#include <lwc/actor.h>
 #include <sstream>
 
 namespace lwc {
@@ -34,26 +36,327 @@ unsigned long Object::GetInstanceCount() {
 }
 #endif
 
-Object::Object() : mMethods(0) {
+Object::Object() : mMethods(0), mResults(0), mMailbox(0), mConnections(0), mSources(0) {
+#ifdef LWC_MEMTRACK
+  ++InstanceCount;
+#endif
+}
+
+Object::Object(const Object &rhs)
+  : mLoaderName(rhs.mLoaderName), mTypeName(rhs.mTypeName), mMethods(rhs.mMethods), mResults(0), mMailbox(rhs.mMailbox), mConnections(0), mSources(0) {
 #ifdef LWC_MEMTRACK
   ++InstanceCount;
 #endif
 }
 
 Object::~Object() {
+  if (mResults) {
+    delete mResults;
+  }
+  disconnectAll();
+  disconnectSources();
 #ifdef LWC_MEMTRACK
   --InstanceCount;
 #endif
 }
 
+Object& Object::operator=(const Object &rhs) {
+  if (this != &rhs) {
+    mLoaderName = rhs.mLoaderName;
+    mTypeName = rhs.mTypeName;
+    mMethods = rhs.mMethods;
+    invalidateResults();
+  }
+  return *this;
+}
+
+bool Object::recycle() {
+  return false;
+}
+
+void Object::invalidateResults() {
+  if (mResults) {
+    mResults->clear();
+  }
+}
+
+void Object::getResultStats(unsigned long &hits, unsigned long &misses) const {
+  hits = (mResults ? mResults->numHits() : 0);
+  misses = (mResults ? mResults->numMisses() : 0);
+}
+
+bool Object::fetchResult(MethodParams &params) {
+  if (!mResults) {
+    mResults = new ResultCache();
+  }
+  return mResults->fetch(params);
+}
+
+void Object::storeResult(const MethodParams &params) {
+  mResults->store(params);
+}
+
 void Object::call(const char *name, MethodParams &params) throw(std::runtime_error) {
-  TMethodPointer<Object> *mptr = (TMethodPointer<Object>*) params.getMethod().getPointer();
+  if (&(getMethod(name)) != &(params.getMethod())) {
+    std::ostringstream oss;
+    oss << "Method \"" << name << "\" does not match parameters";
+    throw std::runtime_error(oss.str());
+  }
+  dispatch(name, params);
+}
+
+void Object::invoke(const char *name, MethodParams &params) throw(std::runtime_error) {
+  MethodPointer mptr = params.getMethod().getPointer();
   if (!mptr) {
     std::ostringstream oss;
     oss << "Object::call: Invalid pointer for method \"" << name << "\"";
     throw std::runtime_error(oss.str());
   }
-  mptr->call(this, params);
+  mptr(this, params);
+}
+
+void Object::callBatch(const CallTarget &target, MethodParams **params, size_t n) throw(std::runtime_error) {
+  
+  Status status;
+  
+  const Method *meth = findMethod(target, status);
+  
+  if (!meth) {
+    throw std::runtime_error(status.getMessage());
+  }
+  
+  if (n > 0) {
+    if (mMailbox && !mMailbox->isOwnerThread()) {
+      // the owner thread runs the calls one by one
+      for (size_t i=0; i<n; ++i) {
+        CheckBatchParams(target.getName(), *meth, params, i);
+        forward(target.getName(), *(params[i]));
+      }
+      return;
+    }
+    if (InterceptorChain::Active() && mMethods->getInterceptors() && !mMethods->getInterceptors()->empty()) {
+      // interceptors see each call of the batch
+      for (size_t i=0; i<n; ++i) {
+        CheckBatchParams(target.getName(), *meth, params, i);
+        intercept(target.getName(), *(params[i]));
+      }
+      return;
+    }
+    invokeBatch(target.getName(), *meth, params, n);
+    if (meth->hasReturn()) {
+      for (size_t i=0; i<n; ++i) {
+        params[i]->storeReturn();
+      }
+    }
+  }
+}
+
+void Object::CheckBatchParams(const char *name, const Method &meth, MethodParams **params, size_t i) throw(std::runtime_error) {
+  if (!params[i] || &(params[i]->getMethod()) != &meth) {
+    std::ostringstream oss;
+    oss << "Object::callBatch: Parameters " << i << " do not match method \"" << name << "\"";
+    throw std::runtime_error(oss.str());
+  }
+}
+
+struct PropertyAccess {
+  Object *object;
+  const Property *property;
+  ArgumentValue *value;
+  bool written;
+};
+
+static void ReadProperty(void *data) {
+  PropertyAccess *pa = (PropertyAccess*) data;
+  pa->property->get(pa->object, *(pa->value));
+}
+
+static void WriteProperty(void *data) {
+  PropertyAccess *pa = (PropertyAccess*) data;
+  pa->written = pa->property->set(pa->object, *(pa->value));
+}
+
+void Object::readProperty(const Property &p, ArgumentValue &value) const throw(std::runtime_error) {
+  if (mMailbox && !mMailbox->isOwnerThread()) {
+    PropertyAccess pa = {const_cast<Object*>(this), &p, &value, false};
+    mMailbox->execute(ReadProperty, (void*)&pa);
+  } else {
+    p.get(this, value);
+  }
+}
+
+bool Object::writeProperty(const Property &p, const ArgumentValue &value) throw(std::runtime_error) {
+  if (mMailbox && !mMailbox->isOwnerThread()) {
+    PropertyAccess pa = {this, &p, const_cast<ArgumentValue*>(&value), false};
+    mMailbox->execute(WriteProperty, (void*)&pa);
+    return pa.written;
+  } else {
+    return p.set(this, value);
+  }
+}
+
+const Property& Object::findTypedProperty(const char *name, Type type) const throw(std::runtime_error) {
+  const Property *p = findProperty(name);
+  if (!p) {
+    std::ostringstream oss;
+    oss << "Object has no property \"" << name << "\"";
+    throw std::runtime_error(oss.str());
+  }
+  if (p->getType() != type) {
+    std::ostringstream oss;
+    oss << "Property \"" << name << "\" type mismatch";
+    throw std::runtime_error(oss.str());
+  }
+  return *p;
+}
+
+void Object::invokeBatch(const char *name, const Method &meth, MethodParams **params, size_t n) throw(std::runtime_error) {
+  // parameters checked as we go, a single pass over the batch
+  for (size_t i=0; i<n; ++i) {
+    CheckBatchParams(name, meth, params, i);
+    invoke(name, *(params[i]));
+  }
+}
+
+void Object::forward(const char *name, MethodParams &params) throw(std::runtime_error) {
+  if (mMailbox->isOwnerThread()) {
+    route(name, params);
+  } else {
+    Status status;
+    mMailbox->send(this, name, params, status);
+    if (status.failed()) {
+      throw std::runtime_error(status.getMessage());
+    }
+  }
+}
+
+void Object::tryForward(const char *name, MethodParams &params, Status &status) {
+  if (mMailbox->isOwnerThread()) {
+    tryRoute(name, params, status);
+  } else {
+    mMailbox->send(this, name, params, status);
+  }
+}
+
+void Object::post(const CallTarget &target, const MethodParams &params) throw(std::runtime_error) {
+  Status status;
+  
+  const Method *meth = findMethod(target, status);
+  
+  if (!meth) {
+    throw std::runtime_error(status.getMessage());
+  }
+  if (meth != &(params.getMethod())) {
+    std::ostringstream oss;
+    oss << "Method \"" << target.getName() << "\" does not match parameters";
+    throw std::runtime_error(oss.str());
+  }
+  
+  if (mMailbox && !mMailbox->isOwnerThread()) {
+    mMailbox->post(this, target.getName(), params);
+  } else {
+    MethodParams copy(params);
+    route(target.getName(), copy);
+  }
+}
+
+void Object::intercept(const char *name, MethodParams &params) throw(std::runtime_error) {
+  const InterceptorChain *chain = (mMethods ? mMethods->getInterceptors() : 0);
+  if (!chain || chain->empty()) {
+    execute(name, params);
+  } else {
+    Status status;
+    tryIntercept(name, params, status);
+    if (status.failed()) {
+      throw std::runtime_error(status.getMessage());
+    }
+  }
+}
+
+void Object::tryIntercept(const char *name, MethodParams &params, Status &status) {
+  const InterceptorChain *chain = (mMethods ? mMethods->getInterceptors() : 0);
+  if (!chain || chain->empty()) {
+    tryExecute(name, params, status);
+  } else {
+    size_t n = chain->before(this, name, params, status);
+    if (status.succeeded()) {
+      tryExecute(name, params, status);
+    }
+    chain->after(this, name, params, status, n);
+  }
+}
+
+void Object::tryInvoke(const char *name, MethodParams &params, Status &status) {
+  try {
+    invoke(name, params);
+  } catch (std::exception &e) {
+    status.setFailed(name, e.what());
+  }
+}
+
+bool Object::SetDefaultArgs(const char *name, const Method &meth, MethodParams &params,
+                            size_t nargs, const KeywordArgs *kwargs, Status &status) {
+  
+  if (nargs > meth.numArgs()) {
+    status.set(EC_ARGUMENT_COUNT, name, -1, 0, long(meth.numArgs()));
+    return false;
+  }
+  
+  // start from the default image, keywords overwrite their slots
+  params.setDefaults(nargs);
+  
+  unsigned long provided = (nargs >= 8 * sizeof(unsigned long) ? ~0UL : (1UL << nargs) - 1);
+  
+  if (kwargs) {
+    KeywordArgs::const_iterator it = kwargs->begin();
+    while (it != kwargs->end()) {
+      size_t idx = 0;
+      if (!meth.findNamedArg(it->first.c_str(), idx)) {
+        status.set(EC_ARGUMENT_NAME, name, -1, it->first.c_str());
+        return false;
+      }
+      const Argument &ma = meth[idx];
+      if (idx < nargs) {
+        status.set(EC_KEYWORD_TWICE, name, long(idx), ma.getName().c_str());
+        return false;
+      }
+      const ArgumentValue &kv = it->second.getRawValue();
+      if (!it->second.typeMatches(ma)) {
+        // at the time keyword arguments are set, we don't know yet which
+        // method they will be applied to, so don't know the exact target type
+        // for plain type, we should allow int to real and real to int conversions
+        // as allow in Argument::setValue, MethodParams::set/setn
+        if (ma.indirectionLevel() == 0 && // plain type
+            it->second.indirectionLevel() == ma.indirectionLevel() &&
+            ((it->second.getType() == AT_INT && // int -> real
+              ma.getType() == AT_REAL) ||
+             (it->second.getType() == AT_REAL && // real -> int
+              ma.getType() == AT_INT))) {
+          ArgumentValue av;
+          if (ma.getType() == AT_REAL) {
+            av.real = Real(kv.integer);
+          } else {
+            av.integer = Integer(kv.real);
+          }
+          params.rawset(idx, av, false);
+        } else {
+          status.set(EC_KEYWORD_TYPE, name, long(idx), ma.getName().c_str());
+          return false;
+        }
+      } else {
+        params.rawset(idx, kv, false);
+      }
+      provided |= (1UL << idx);
+      ++it;
+    }
+  }
+  
+  if ((meth.requiredArgsMask() & ~provided) != 0) {
+    status.set(EC_ARGUMENT_COUNT, name, -1, 0, long(meth.numArgs()));
+    return false;
+  }
+  
+  return true;
 }
 
 } // namespace lwc
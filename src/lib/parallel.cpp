@@ -0,0 +1,415 @@
+/*
+
+Copyright (C) 2009, 2010  Gaetan Guidet
+
+This file is part of lwc.
+
+lwc is free software; you can redistribute it and/or modify it
+under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 2.1 of the License, or (at
+your option) any later version.
+
+lwc is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+USA.
+
+*/
+
+#include <lwc/parallel.h>
+#ifdef _WIN32
+# include <windows.h>
+#else
+# include <unistd.h>
+#endif
+
+namespace lwc {
+
+namespace parallel {
+
+size_t NumCores() {
+#ifdef _WIN32
+  SYSTEM_INFO si;
+  GetSystemInfo(&si);
+  return size_t(si.dwNumberOfProcessors);
+#else
+  long n = sysconf(_SC_NPROCESSORS_ONLN);
+  return (n > 0 ? size_t(n) : 1);
+#endif
+}
+
+// ---
+
+Executor::Group::Group()
+  : mPending(0) {
+}
+
+Executor::Group::~Group() {
+}
+
+bool Executor::Group::finished() {
+  mMutex.lock();
+  bool rv = (mPending == 0);
+  mMutex.unlock();
+  return rv;
+}
+
+void Executor::Group::done(size_t count) {
+  mMutex.lock();
+  mPending -= count;
+  if (mPending == 0) {
+    mDone.notifyAll();
+  }
+  mMutex.unlock();
+}
+
+// ---
+
+Executor::Executor(size_t nworkers)
+  : mQueued(0), mActive(0), mStop(false) {
+  
+  if (nworkers == 0) {
+    nworkers = NumCores() - 1;
+  }
+  
+  for (size_t i=0; i<=nworkers; ++i) {
+    mQueues.push_back(new Queue());
+  }
+  
+  for (size_t i=0; i<nworkers; ++i) {
+    mWorkers.push_back(new gcore::Thread(this, &Executor::workerMain, (void*)i));
+  }
+}
+
+Executor::~Executor() {
+  mWorkMutex.lock();
+  mStop = true;
+  mWorkAvailable.notifyAll();
+  mWorkMutex.unlock();
+  
+  for (size_t i=0; i<mWorkers.size(); ++i) {
+    mWorkers[i]->wait();
+    delete mWorkers[i];
+  }
+  for (size_t i=0; i<mQueues.size(); ++i) {
+    delete mQueues[i];
+  }
+}
+
+void Executor::push(size_t q, const Task &task) {
+  // count the task before it can be popped so that mQueued never underflows
+  mWorkMutex.lock();
+  ++mQueued;
+  mQueues[q]->mutex.lock();
+  mQueues[q]->tasks.push_back(task);
+  mQueues[q]->mutex.unlock();
+  mWorkAvailable.notify();
+  mWorkMutex.unlock();
+}
+
+bool Executor::pop(size_t q, Task &task) {
+  size_t nq = mQueues.size();
+  
+  for (size_t k=0; k<nq; ++k) {
+    Queue *queue = mQueues[(q + k) % nq];
+    queue->mutex.lock();
+    if (!queue->tasks.empty()) {
+      if (k == 0) {
+        // own queue: most recent (smallest) task
+        task = queue->tasks.back();
+        queue->tasks.pop_back();
+      } else {
+        // steal the oldest (largest) task
+        task = queue->tasks.front();
+        queue->tasks.pop_front();
+      }
+      queue->mutex.unlock();
+      mWorkMutex.lock();
+      --mQueued;
+      mWorkMutex.unlock();
+      return true;
+    }
+    queue->mutex.unlock();
+  }
+  
+  return false;
+}
+
+void Executor::execute(size_t q, Task &task) {
+  while (task.end - task.begin > task.grain) {
+    Task rest = task;
+    rest.begin = task.begin + (task.end - task.begin) / 2;
+    task.end = rest.begin;
+    push(q, rest);
+  }
+  task.func(task.data, task.begin, task.end);
+  // busy is false as soon as the waiters can see their group done
+  mWorkMutex.lock();
+  mActive -= (task.end - task.begin);
+  task.group->done(task.end - task.begin);
+  mWorkMutex.unlock();
+}
+
+bool Executor::busy() {
+  mWorkMutex.lock();
+  bool rv = (mActive > 0);
+  mWorkMutex.unlock();
+  return rv;
+}
+
+int Executor::workerMain(void *data) {
+  size_t q = (size_t) data;
+  Task task;
+  
+  while (true) {
+    if (pop(q, task)) {
+      execute(q, task);
+      continue;
+    }
+    mWorkMutex.lock();
+    while (mQueued == 0 && !mStop) {
+      mWorkAvailable.wait(mWorkMutex);
+    }
+    bool stop = (mQueued == 0 && mStop);
+    mWorkMutex.unlock();
+    if (stop) {
+      break;
+    }
+  }
+  
+  return 0;
+}
+
+void Executor::submit(Group &group, RangeFunc func, void *data, size_t n, size_t grain) {
+  if (n == 0) {
+    return;
+  }
+  
+  if (mWorkers.size() == 0) {
+    func(data, 0, n);
+    return;
+  }
+  
+  if (grain == 0) {
+    // a few chunks per thread to balance uneven call costs
+    grain = n / (8 * mQueues.size());
+    if (grain == 0) {
+      grain = 1;
+    }
+  }
+  
+  group.mMutex.lock();
+  group.mPending += n;
+  group.mMutex.unlock();
+  
+  mWorkMutex.lock();
+  mActive += n;
+  mWorkMutex.unlock();
+  
+  Task task;
+  task.func = func;
+  task.data = data;
+  task.begin = 0;
+  task.end = n;
+  task.grain = grain;
+  task.group = &group;
+  
+  push(mQueues.size() - 1, task);
+}
+
+void Executor::wait(Group &group) {
+  size_t q = mQueues.size() - 1;
+  Task task;
+  
+  while (true) {
+    group.mMutex.lock();
+    bool done = (group.mPending == 0);
+    group.mMutex.unlock();
+    if (done) {
+      return;
+    }
+    if (!pop(q, task)) {
+      break;
+    }
+    execute(q, task);
+  }
+  
+  // remaining tasks are being run by the workers
+  group.mMutex.lock();
+  while (group.mPending > 0) {
+    group.mDone.wait(group.mMutex);
+  }
+  group.mMutex.unlock();
+}
+
+void Executor::run(RangeFunc func, void *data, size_t n, size_t grain) {
+  Group group;
+  submit(group, func, data, n, grain);
+  wait(group);
+}
+
+// ---
+
+struct BroadcastData {
+  Object **objects;
+  const size_t *indices;
+  const CallTarget *target;
+  const MethodParams *params;
+  gcore::Mutex mutex;
+  bool failed;
+  size_t failedIndex;
+  std::string error;
+};
+
+static bool SameSignature(const Method &m0, const Method &m1, size_t &idx) {
+  if (m0.numArgs() != m1.numArgs()) {
+    idx = 0;
+    return false;
+  }
+  for (idx=0; idx<m0.numArgs(); ++idx) {
+    if (m0[idx].getDir() != m1[idx].getDir() || !m0[idx].typeMatches(m1[idx])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static void BroadcastCall(BroadcastData *bd, size_t i) {
+  Object *o = bd->objects[i];
+  const Method &pm = bd->params->getMethod();
+  const char *name = bd->target->getName();
+  Status status;
+  
+  const Method *meth = o->findMethod(*(bd->target), status);
+  
+  if (meth == &pm) {
+    MethodParams params(*(bd->params));
+    status = o->tryCall(name, params);
+    
+  } else if (meth) {
+    // same method name on another type
+    size_t idx = 0;
+    if (SameSignature(*meth, pm, idx)) {
+      MethodParams params(*meth);
+      for (size_t j=0; j<meth->numArgs(); ++j) {
+        params.rawset(j, bd->params->rawget(j, false), false);
+      }
+      status = o->tryCall(name, params);
+    } else if (meth->numArgs() != pm.numArgs()) {
+      status.set(EC_ARGUMENT_COUNT, name, -1, 0, long(meth->numArgs()));
+    } else {
+      status.set(EC_ARGUMENT_TYPE, name, long(idx));
+    }
+  }
+  
+  if (status.failed()) {
+    bd->mutex.lock();
+    if (!bd->failed || i < bd->failedIndex) {
+      std::ostringstream oss;
+      oss << "Broadcast to object " << i << " (" << o->getTypeName() << "): " << status.getMessage();
+      bd->failed = true;
+      bd->failedIndex = i;
+      bd->error = oss.str();
+    }
+    bd->mutex.unlock();
+  }
+}
+
+static void BroadcastRange(void *data, size_t begin, size_t end) {
+  BroadcastData *bd = (BroadcastData*) data;
+  for (size_t k=begin; k<end; ++k) {
+    BroadcastCall(bd, bd->indices[k]);
+  }
+}
+
+struct LoaderOrder {
+  Object **objects;
+  bool operator()(size_t i0, size_t i1) const {
+    return (strcmp(objects[i0]->getLoaderName(), objects[i1]->getLoaderName()) < 0);
+  }
+};
+
+void Executor::broadcast(Object **objects, size_t n, const CallTarget &target,
+                         const MethodParams &params) throw(std::runtime_error) {
+  
+  const Method &meth = params.getMethod();
+  
+  for (size_t i=0; i<meth.numArgs(); ++i) {
+    if (meth[i].getDir() != AD_IN) {
+      std::ostringstream oss;
+      oss << "Executor::broadcast: Method \"" << target.getName() << "\" has output arguments";
+      throw std::runtime_error(oss.str());
+    }
+  }
+  
+  std::vector<size_t> concurrent;
+  std::vector<size_t> serial;
+  
+  concurrent.reserve(n);
+  
+  for (size_t i=0; i<n; ++i) {
+    if (!objects[i]) {
+      std::ostringstream oss;
+      oss << "Executor::broadcast: Invalid object " << i;
+      throw std::runtime_error(oss.str());
+    }
+    if (objects[i]->allowsConcurrentCalls()) {
+      concurrent.push_back(i);
+    } else {
+      serial.push_back(i);
+    }
+  }
+  
+  BroadcastData bd;
+  bd.objects = objects;
+  bd.target = &target;
+  bd.params = &params;
+  bd.failed = false;
+  bd.failedIndex = 0;
+  
+  Group group;
+  
+  if (concurrent.size() > 0) {
+    bd.indices = &(concurrent[0]);
+    submit(group, BroadcastRange, (void*)&bd, concurrent.size());
+  }
+  
+  // one interpreter after the other while the workers process the native objects
+  if (serial.size() > 0) {
+    LoaderOrder order;
+    order.objects = objects;
+    std::stable_sort(serial.begin(), serial.end(), order);
+    for (size_t k=0; k<serial.size(); ++k) {
+      BroadcastCall(&bd, serial[k]);
+    }
+  }
+  
+  wait(group);
+  
+  if (bd.failed) {
+    throw std::runtime_error(bd.error);
+  }
+}
+
+// ---
+
+Broadcast::Broadcast(Executor *executor, Object **objects, size_t n)
+  : Object(), mExecutor(executor), mObjects(objects), mNumObjects(n) {
+}
+
+Broadcast::~Broadcast() {
+}
+
+void Broadcast::invoke(const char *name, MethodParams &params) throw(std::runtime_error) {
+  mExecutor->broadcast(mObjects, mNumObjects, name, params);
+}
+
+}
+
+}
+
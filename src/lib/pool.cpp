@@ -0,0 +1,90 @@
+/*
+
+Copyright (C) 2009, 2010  Gaetan Guidet
+
+This file is part of lwc.
+
+lwc is free software; you can redistribute it and/or modify it
+under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 2.1 of the License, or (at
+your option) any later version.
+
+lwc is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+USA.
+
+*/
+
+
+#include <lwc/pool.h>
+#include <lwc/resultcache.h>
+
+namespace lwc {
+
+ObjectPool::ObjectPool(size_t maxSize)
+  : mMaxSize(maxSize), mReused(0), mAllocated(0), mRecycled(0), mDiscarded(0) {
+  mFree.reserve(maxSize);
+}
+
+ObjectPool::~ObjectPool() {
+  setMaxSize(0);
+}
+
+void ObjectPool::setMaxSize(size_t n) {
+  while (mFree.size() > n) {
+    delete mFree.back();
+    mFree.pop_back();
+  }
+  mMaxSize = n;
+}
+
+bool ObjectPool::release(Object *o) {
+  // emitters and queued events still reference a listener: it must go through
+  // deletion (~Object removes the incoming connections)
+  if (mFree.size() >= mMaxSize || o->numIncomingConnections() > 0 || !o->recycle()) {
+    ++mDiscarded;
+    return false;
+  }
+  // a new instance has none of those
+  if (o->mResults) {
+    delete o->mResults;
+    o->mResults = 0;
+  }
+  o->disconnectAll();
+  o->mMailbox = 0;
+  mFree.push_back(o);
+  ++mRecycled;
+  return true;
+}
+
+void ObjectPool::adopt(ObjectPool &other) {
+  while (!other.mFree.empty()) {
+    Object *o = other.mFree.back();
+    other.mFree.pop_back();
+    if (mFree.size() < mMaxSize) {
+      mFree.push_back(o);
+      ++mRecycled;
+    } else {
+      delete o;
+      ++mDiscarded;
+    }
+  }
+}
+
+void ObjectPool::getStats(PoolStats &stats) const {
+  stats.size = mFree.size();
+  stats.maxSize = mMaxSize;
+  stats.reused = mReused;
+  stats.allocated = mAllocated;
+  stats.recycled = mRecycled;
+  stats.discarded = mDiscarded;
+}
+
+}
+
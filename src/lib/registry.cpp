@@ -23,6 +23,7 @@ USA.
 
 #include <lwc/registry.h>
 #include <lwc/memory.h>
+#include <lwc/actor.h>
 #include <gcore/path.h>
 
 namespace lwc {
@@ -103,7 +104,7 @@ void fini()
 */
 
 Registry::Registry(const char *hostLang, void *userData)
-  : mHostLang(hostLang), mUserData(userData) {
+  : mHostLang(hostLang), mUserData(userData), mExecutor(0), mNumWorkers(0) {
   msInstance = this;
   gcore::Env::EachInPathFunc enumerator;
   gcore::Bind(this, METHOD(Registry, enumLoaderPath), enumerator);
@@ -113,6 +114,22 @@ Registry::Registry(const char *hostLang, void *userData)
 }
 
 Registry::~Registry() {
+  if (mExecutor) {
+    delete mExecutor;
+    mExecutor = 0;
+  }
+  // bindings reference the loaders methods tables
+  mBindings.clear();
+  std::map<std::string, InterceptorChain*>::iterator iit = mInterceptors.begin();
+  while (iit != mInterceptors.end()) {
+    const MethodsTable *methods = getMethods(iit->first.c_str());
+    if (methods) {
+      methods->mInterceptors = 0;
+    }
+    delete iit->second;
+    ++iit;
+  }
+  mInterceptors.clear();
   for (size_t i=0; i<mLoaders.size(); ++i) {
     LoaderEntry &le = mLoaders[i];
     LWC_DestroyLoader deinit = (LWC_DestroyLoader) le.lib->_getSymbol(LWC_DESTROYLOADER_STR);
@@ -144,6 +161,8 @@ bool Registry::enumModules(const gcore::Path &path) {
     Loader *loader = findLoader(path.basename());
     if (loader) {
       loader->load(path, this);
+      bindInterfaces();
+      bindInterceptors();
     }
   }
   return true;
@@ -258,6 +277,16 @@ const MethodsTable* Registry::getMethods(const char *name) {
   }
 }
 
+MethodHandle Registry::getMethodHandle(const char *name, const char *methodName) throw(std::runtime_error) {
+  const MethodsTable *methods = getMethods(name);
+  if (!methods) {
+    std::ostringstream oss;
+    oss << "Registry::getMethodHandle: Unknown type \"" << name << "\"";
+    throw std::runtime_error(oss.str());
+  }
+  return MethodHandle(methods, methodName);
+}
+
 const char* Registry::getDescription(const char *name) {
   if (hasType(name)) {
     return mObjectLoaders[name]->getDescription(name);
@@ -274,16 +303,43 @@ std::string Registry::docString(const char *n, const std::string &indent) {
   }
 }
 
+struct LoaderCall {
+  Loader *loader;
+  const char *name;
+  Object *object;
+};
+
+static void LoaderCreate(void *data) {
+  LoaderCall *lc = (LoaderCall*) data;
+  lc->object = lc->loader->create(lc->name);
+}
+
+static void LoaderDestroy(void *data) {
+  LoaderCall *lc = (LoaderCall*) data;
+  lc->loader->destroy(lc->object);
+}
+
+Object* Registry::createObject(const char *name) {
+  LoaderCall lc = {mObjectLoaders[name], name, 0};
+  Mailbox *mailbox = getLoaderMailbox(lc.loader->getName());
+  if (mailbox) {
+    mailbox->execute(LoaderCreate, (void*)&lc);
+  } else {
+    LoaderCreate((void*)&lc);
+  }
+  return bindMailbox(lc.object);
+}
+
 Object* Registry::create(const char *name) {
   if (hasType(name)) {
     std::map<std::string, Object*>::iterator it = mSingletons.find(name);
     if (it != mSingletons.end()) {
       if (it->second == 0) {
-        it->second = mObjectLoaders[name]->create(name);
+        it->second = createObject(name);
       }
       return it->second;
     } else {
-      return mObjectLoaders[name]->create(name);
+      return createObject(name);
     }
   } else {
     return 0;
@@ -294,7 +350,7 @@ Object* Registry::get(const char *name) {
   std::map<std::string, Object*>::iterator it = mSingletons.find(name);
   if (it != mSingletons.end()) {
     if (it->second == 0) {
-      it->second = mObjectLoaders[name]->create(name);
+      it->second = createObject(name);
     }
     return it->second;
   } else {
@@ -306,11 +362,19 @@ void Registry::destroy(Object *o) {
   if (!o) {
     return;
   }
-  const char *tn = o->mTypeName.c_str();
-  if (!hasType(tn)) {
+  // o is gone after the loader destroy
+  std::string tn = o->mTypeName;
+  if (!hasType(tn.c_str())) {
     return;
   }
-  mObjectLoaders[tn]->destroy(o);
+  LoaderCall lc = {mObjectLoaders[tn], 0, o};
+  // the object mailbox may differ from the loader one (Object::setMailbox)
+  Mailbox *mailbox = o->getMailbox();
+  if (mailbox) {
+    mailbox->execute(LoaderDestroy, (void*)&lc);
+  } else {
+    LoaderDestroy((void*)&lc);
+  }
   std::map<std::string, Object*>::iterator it = mSingletons.find(tn);
   if (it != mSingletons.end()) {
     it->second = 0;
@@ -325,6 +389,218 @@ void Registry::destroySingletons() {
   }
 }
 
+struct PoolCall {
+  Loader *loader;
+  const char *name;
+  size_t maxSize;
+  size_t warmUp;
+  bool result;
+};
+
+static void LoaderSetPool(void *data) {
+  PoolCall *pc = (PoolCall*) data;
+  pc->result = pc->loader->setPool(pc->name, pc->maxSize, pc->warmUp);
+}
+
+bool Registry::setPool(const char *typeName, size_t maxSize, size_t warmUp) {
+  if (!hasType(typeName)) {
+    return false;
+  }
+  // warm-up creates instances: same thread as createObject
+  PoolCall pc = {mObjectLoaders[typeName], typeName, maxSize, warmUp, false};
+  Mailbox *mailbox = getLoaderMailbox(pc.loader->getName());
+  if (mailbox) {
+    mailbox->execute(LoaderSetPool, (void*)&pc);
+  } else {
+    LoaderSetPool((void*)&pc);
+  }
+  return pc.result;
+}
+
+bool Registry::getPoolStats(const char *typeName, PoolStats &stats) const {
+  if (!hasType(typeName)) {
+    return false;
+  }
+  return mObjectLoaders.find(typeName)->second->getPoolStats(typeName, stats);
+}
+
+bool Registry::addInterface(const Interface &iface) {
+  if (mInterfaces.find(iface.getName()) != mInterfaces.end()) {
+    return false;
+  }
+  mInterfaces[iface.getName()] = iface;
+  bindInterfaces();
+  return true;
+}
+
+const Interface* Registry::getInterface(const char *name) const {
+  std::map<std::string, Interface>::const_iterator it = mInterfaces.find(name);
+  return (it != mInterfaces.end() ? &(it->second) : 0);
+}
+
+void Registry::bindInterfaces() {
+  std::map<std::string, Interface>::const_iterator iit = mInterfaces.begin();
+  while (iit != mInterfaces.end()) {
+    std::map<std::string, InterfaceBinding> &bindings = mBindings[iit->first];
+    std::map<std::string, Loader*>::iterator lit = mObjectLoaders.begin();
+    while (lit != mObjectLoaders.end()) {
+      if (bindings.find(lit->first) == bindings.end()) {
+        bindings[lit->first] = InterfaceBinding(iit->second, lit->second->getMethods(lit->first.c_str()));
+      }
+      ++lit;
+    }
+    ++iit;
+  }
+}
+
+const InterfaceBinding* Registry::getBinding(const char *typeName, const char *interfaceName) {
+  const Interface *iface = getInterface(interfaceName);
+  if (!iface || !hasType(typeName)) {
+    return 0;
+  }
+  std::map<std::string, InterfaceBinding> &bindings = mBindings[interfaceName];
+  std::map<std::string, InterfaceBinding>::iterator it = bindings.find(typeName);
+  if (it == bindings.end()) {
+    // type registered outside of a module
+    it = bindings.insert(std::make_pair(std::string(typeName), InterfaceBinding(*iface, getMethods(typeName)))).first;
+  }
+  return &(it->second);
+}
+
+bool Registry::implements(const char *typeName, const char *interfaceName) {
+  const InterfaceBinding *binding = getBinding(typeName, interfaceName);
+  return (binding != 0 && binding->isValid());
+}
+
+InterceptorChain* Registry::getInterceptors(const char *typeName) {
+  std::map<std::string, InterceptorChain*>::iterator it = mInterceptors.find(typeName);
+  if (it != mInterceptors.end()) {
+    return it->second;
+  }
+  InterceptorChain *chain = new InterceptorChain();
+  for (size_t i=0; i<mGlobalInterceptors.size(); ++i) {
+    const std::string &methodName = mGlobalInterceptors[i].second;
+    chain->add(mGlobalInterceptors[i].first, (methodName.length() > 0 ? methodName.c_str() : 0));
+  }
+  mInterceptors[typeName] = chain;
+  const MethodsTable *methods = getMethods(typeName);
+  if (methods) {
+    methods->mInterceptors = chain;
+  }
+  return chain;
+}
+
+void Registry::bindInterceptors() {
+  if (mGlobalInterceptors.size() == 0) {
+    return;
+  }
+  std::map<std::string, Loader*>::iterator it = mObjectLoaders.begin();
+  while (it != mObjectLoaders.end()) {
+    getInterceptors(it->first.c_str());
+    ++it;
+  }
+}
+
+bool Registry::addInterceptor(Interceptor *i, const char *typeName, const char *methodName) {
+  if (!i) {
+    return false;
+  }
+  if (typeName) {
+    if (!hasType(typeName)) {
+      return false;
+    }
+    getInterceptors(typeName)->add(i, methodName);
+  } else {
+    // existing chains get the new entry, new ones are seeded with it
+    std::map<std::string, InterceptorChain*>::iterator it = mInterceptors.begin();
+    while (it != mInterceptors.end()) {
+      it->second->add(i, methodName);
+      ++it;
+    }
+    mGlobalInterceptors.push_back(std::make_pair(i, std::string(methodName ? methodName : "")));
+    bindInterceptors();
+  }
+  return true;
+}
+
+void Registry::removeInterceptor(Interceptor *i) {
+  std::map<std::string, InterceptorChain*>::iterator it = mInterceptors.begin();
+  while (it != mInterceptors.end()) {
+    it->second->remove(i);
+    ++it;
+  }
+  std::vector<std::pair<Interceptor*, std::string> >::iterator git = mGlobalInterceptors.begin();
+  while (git != mGlobalInterceptors.end()) {
+    if (git->first == i) {
+      git = mGlobalInterceptors.erase(git);
+    } else {
+      ++git;
+    }
+  }
+}
+
+bool Registry::setLoaderMailbox(const char *loaderName, Mailbox *mailbox) {
+  for (size_t i=0; i<mLoaders.size(); ++i) {
+    if (!strcmp(mLoaders[i].loader->getName(), loaderName)) {
+      if (mailbox) {
+        mLoaderMailboxes[loaderName] = mailbox;
+      } else {
+        mLoaderMailboxes.erase(loaderName);
+      }
+      return true;
+    }
+  }
+  return false;
+}
+
+Mailbox* Registry::getLoaderMailbox(const char *loaderName) const {
+  std::map<std::string, Mailbox*>::const_iterator it = mLoaderMailboxes.find(loaderName);
+  return (it != mLoaderMailboxes.end() ? it->second : 0);
+}
+
+Object* Registry::bindMailbox(Object *o) {
+  if (o && !mLoaderMailboxes.empty()) {
+    std::map<std::string, Mailbox*>::iterator it = mLoaderMailboxes.find(o->getLoaderName());
+    if (it != mLoaderMailboxes.end()) {
+      o->setMailbox(it->second);
+    }
+  }
+  return o;
+}
+
+parallel::Executor* Registry::getExecutor() {
+  mExecutorMutex.lock();
+  if (!mExecutor) {
+    mExecutor = new parallel::Executor(mNumWorkers);
+  }
+  parallel::Executor *executor = mExecutor;
+  mExecutorMutex.unlock();
+  return executor;
+}
+
+bool Registry::setNumWorkers(size_t n) {
+  bool rv = true;
+  mExecutorMutex.lock();
+  if (mExecutor && mExecutor->numWorkers() != (n > 0 ? n : parallel::NumCores() - 1)) {
+    if (mExecutor->busy()) {
+      rv = false;
+    } else {
+      delete mExecutor;
+      mExecutor = 0;
+    }
+  }
+  if (rv) {
+    mNumWorkers = n;
+  }
+  mExecutorMutex.unlock();
+  return rv;
+}
+
+void Registry::broadcast(Object **objects, size_t n, const CallTarget &target,
+                         const MethodParams &params) throw(std::runtime_error) {
+  getExecutor()->broadcast(objects, n, target, params);
+}
+
 }
 
 
@@ -0,0 +1,178 @@
+/*
+
+Copyright (C) 2009, 2010  Gaetan Guidet
+
+This file is part of lwc.
+
+lwc is free software; you can redistribute it and/or modify it
+under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 2.1 of the License, or (at
+your option) any later version.
+
+lwc is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+USA.
+
+*/
+
+
+#include <lwc/resultcache.h>
+#include <cstring>
+
+namespace lwc {
+
+// memoized methods only have bool, integer and real arguments
+
+static inline void ReadValue(Type t, const void *ptr, ArgumentValue &v) {
+  switch (t) {
+    case AT_BOOL:
+      v.boolean = *((const bool*)ptr);
+      break;
+    case AT_INT:
+      v.integer = *((const Integer*)ptr);
+      break;
+    default:
+      v.real = *((const Real*)ptr);
+  }
+}
+
+static inline void WriteValue(Type t, const ArgumentValue &v, void *ptr) {
+  switch (t) {
+    case AT_BOOL:
+      *((bool*)ptr) = v.boolean;
+      break;
+    case AT_INT:
+      *((Integer*)ptr) = v.integer;
+      break;
+    default:
+      *((Real*)ptr) = v.real;
+  }
+}
+
+static inline bool SameValue(Type t, const ArgumentValue &v0, const ArgumentValue &v1) {
+  switch (t) {
+    case AT_BOOL:
+      return (v0.boolean == v1.boolean);
+    case AT_INT:
+      return (v0.integer == v1.integer);
+    default:
+      // bitwise, NaN results are cached too
+      return (memcmp(&(v0.real), &(v1.real), sizeof(Real)) == 0);
+  }
+}
+
+ResultCache::ResultCache(size_t capacity)
+  : mMask(0), mHits(0), mMisses(0) {
+  size_t n = 1;
+  while (n < capacity) {
+    n = n << 1;
+  }
+  Entry e;
+  e.method = 0;
+  e.hash = 0;
+  mEntries.resize(n, e);
+  mMask = n - 1;
+}
+
+ResultCache::~ResultCache() {
+}
+
+unsigned int ResultCache::Hash(const MethodParams &params) {
+  // FNV-1a over the method address and the input values
+  const Method &meth = params.getMethod();
+  size_t addr = (size_t) &meth;
+  unsigned int h = 2166136261U;
+  const unsigned char *bytes = (const unsigned char*) &addr;
+  for (size_t b=0; b<sizeof(size_t); ++b) {
+    h = (h ^ bytes[b]) * 16777619U;
+  }
+  for (size_t i=0; i<meth.numArgs(); ++i) {
+    const Argument &arg = meth[i];
+    if (arg.getDir() != AD_IN) {
+      continue;
+    }
+    const ArgumentValue &v = params.rawget(i, false);
+    size_t n = (arg.getType() == AT_BOOL ? sizeof(bool) : (arg.getType() == AT_INT ? sizeof(Integer) : sizeof(Real)));
+    bytes = (const unsigned char*) &v;
+    for (size_t b=0; b<n; ++b) {
+      h = (h ^ bytes[b]) * 16777619U;
+    }
+  }
+  return h;
+}
+
+bool ResultCache::SameInputs(const std::vector<ArgumentValue> &values, const MethodParams &params) {
+  const Method &meth = params.getMethod();
+  for (size_t i=0; i<meth.numArgs(); ++i) {
+    const Argument &arg = meth[i];
+    if (arg.getDir() == AD_IN && !SameValue(arg.getType(), values[i], params.rawget(i, false))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ResultCache::fetch(MethodParams &params) {
+  unsigned int h = Hash(params);
+  const Entry &e = mEntries[h & mMask];
+  
+  if (e.method != &(params.getMethod()) || e.hash != h || !SameInputs(e.values, params)) {
+    ++mMisses;
+    return false;
+  }
+  
+  const Method &meth = params.getMethod();
+  for (size_t i=0; i<meth.numArgs(); ++i) {
+    const Argument &arg = meth[i];
+    if (arg.getDir() == AD_OUT) {
+      void *ptr = params.rawget(i, false).ptr;
+      if (ptr) {
+        WriteValue(arg.getType(), e.values[i], ptr);
+      }
+    } else if (arg.getDir() == AD_RETURN) {
+      params.rawset(i, e.values[i], false);
+    }
+  }
+  
+  ++mHits;
+  return true;
+}
+
+void ResultCache::store(const MethodParams &params) {
+  unsigned int h = Hash(params);
+  Entry &e = mEntries[h & mMask];
+  const Method &meth = params.getMethod();
+  
+  e.method = &meth;
+  e.hash = h;
+  e.values.resize(meth.numArgs());
+  
+  for (size_t i=0; i<meth.numArgs(); ++i) {
+    const Argument &arg = meth[i];
+    const ArgumentValue &v = params.rawget(i, false);
+    if (arg.getDir() == AD_IN || arg.getDir() == AD_RETURN) {
+      e.values[i] = v;
+    } else if (v.ptr) {
+      ReadValue(arg.getType(), v.ptr, e.values[i]);
+    } else {
+      // output not retrieved by the caller, cannot be replayed
+      e.method = 0;
+      return;
+    }
+  }
+}
+
+void ResultCache::clear() {
+  for (size_t i=0; i<mEntries.size(); ++i) {
+    mEntries[i].method = 0;
+  }
+}
+
+}
+
@@ -0,0 +1,435 @@
+/*
+
+Copyright (C) 2009, 2010  Gaetan Guidet
+
+This file is part of lwc.
+
+lwc is free software; you can redistribute it and/or modify it
+under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 2.1 of the License, or (at
+your option) any later version.
+
+lwc is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+USA.
+
+*/
+
+#include <lwc/signal.h>
+#include <lwc/memory.h>
+#include <string.h>
+#ifdef _WIN32
+# include <windows.h>
+#else
+# include <time.h>
+# include <sys/time.h>
+#endif
+
+namespace lwc {
+
+struct SignalConnection {
+  // owned by the emitter methods table
+  const char *signal;
+  size_t nargs;
+  Object *listener;
+  // owned by the listener methods table
+  const char *slot;
+  const Method *method;
+  SignalQueue *queue;
+};
+
+struct SignalConnections {
+  std::vector<SignalConnection> list;
+};
+
+struct SignalSources {
+  std::vector<Object*> list;
+};
+
+// remove one entry (one per connection)
+static void RemoveSource(std::vector<Object*> &sources, Object *o) {
+  for (size_t i=sources.size(); i>0; --i) {
+    if (sources[i-1] == o) {
+      sources.erase(sources.begin() + (i-1));
+      return;
+    }
+  }
+}
+
+// monotonic clock for the delivery latency
+static double Now() {
+#ifdef _WIN32
+  LARGE_INTEGER freq, count;
+  QueryPerformanceFrequency(&freq);
+  QueryPerformanceCounter(&count);
+  return double(count.QuadPart) / double(freq.QuadPart);
+#elif defined(CLOCK_MONOTONIC)
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return double(ts.tv_sec) + 1.0e-9 * double(ts.tv_nsec);
+#else
+  struct timeval tv;
+  gettimeofday(&tv, 0);
+  return double(tv.tv_sec) + 1.0e-6 * double(tv.tv_usec);
+#endif
+}
+
+// ---
+
+SignalQueue::SignalQueue(size_t capacity)
+  : mCells(0), mMask(0), mEnqueuePos(0), mDequeuePos(0), mQueued(0), mProcessed(0),
+    mDropped(0), mDelivered(0), mFailed(0), mTotalLatency(0.0), mMaxLatency(0.0) {
+  size_t n = 2;
+  while (n < capacity) {
+    n <<= 1;
+  }
+  mCells = new Cell[n];
+  mMask = n - 1;
+  for (size_t i=0; i<n; ++i) {
+    mCells[i].sequence = long(i);
+  }
+}
+
+SignalQueue::~SignalQueue() {
+  while (!mSources.empty()) {
+    mSources.back()->disconnectQueue(this);
+  }
+  // free the strings of the pending events
+  for (;;) {
+    Cell &cell = mCells[size_t(mDequeuePos) & mMask];
+    if (atomic::Load(&cell.sequence) - (mDequeuePos + 1) < 0) {
+      break;
+    }
+    for (size_t i=0; i<cell.event.count; ++i) {
+      if ((cell.event.strings & (1UL << i)) != 0) {
+        memory::Free(cell.event.values[i].ptr);
+      }
+    }
+    ++mDequeuePos;
+  }
+  delete[] mCells;
+}
+
+bool SignalQueue::push(Object *listener, const char *slot, const Method &method, const ArgumentValue *values, size_t n) {
+  long pos = atomic::Load(&mEnqueuePos);
+  Cell *cell = 0;
+  
+  for (;;) {
+    cell = &mCells[size_t(pos) & mMask];
+    long diff = atomic::Load(&cell->sequence) - pos;
+    if (diff == 0) {
+      if (atomic::CompareExchange(&mEnqueuePos, pos, pos + 1)) {
+        break;
+      }
+      pos = atomic::Load(&mEnqueuePos);
+    } else if (diff < 0) {
+      // the cell still holds the event from the previous lap: full
+      atomic::Increment(&mDropped);
+      return false;
+    } else {
+      pos = atomic::Load(&mEnqueuePos);
+    }
+  }
+  
+  Event &event = cell->event;
+  event.listener = listener;
+  event.slot = slot;
+  event.method = &method;
+  event.count = n;
+  event.strings = 0;
+  event.time = Now();
+  for (size_t i=0; i<n; ++i) {
+    if (method[i].getType() == AT_STRING && values[i].ptr != 0) {
+      size_t len = strlen((const char*) values[i].ptr);
+      char *str = (char*) memory::Alloc(len + 1, sizeof(char));
+      memcpy(str, values[i].ptr, len + 1);
+      event.values[i].ptr = (void*) str;
+      event.strings |= (1UL << i);
+    } else {
+      event.values[i] = values[i];
+    }
+  }
+  
+  atomic::Increment(&mQueued);
+  atomic::Store(&cell->sequence, pos + 1);
+  
+  return true;
+}
+
+size_t SignalQueue::process(size_t maxEvents) {
+  size_t count = 0;
+  Event event;
+  
+  while (maxEvents == 0 || count < maxEvents) {
+    Cell &cell = mCells[size_t(mDequeuePos) & mMask];
+    long pos = mDequeuePos;
+    if (atomic::Load(&cell.sequence) - (pos + 1) < 0) {
+      break;
+    }
+    // copy the event out so that the cell is released before the slot runs
+    event = cell.event;
+    mDequeuePos = pos + 1;
+    atomic::Store(&cell.sequence, pos + long(mMask) + 1);
+    deliver(event);
+    ++count;
+  }
+  
+  return count;
+}
+
+void SignalQueue::deliver(Event &event) {
+  MethodParams params(*event.method);
+  
+  params.setDefaults(event.count);
+  memcpy(params.rawvalues(), event.values, event.count * sizeof(ArgumentValue));
+  
+  Status status = event.listener->tryCall(event.slot, params);
+  
+  double latency = Now() - event.time;
+  
+  for (size_t i=0; i<event.count; ++i) {
+    if ((event.strings & (1UL << i)) != 0) {
+      memory::Free(event.values[i].ptr);
+    }
+  }
+  
+  if (status.succeeded()) {
+    atomic::Increment(&mDelivered);
+  } else {
+    atomic::Increment(&mFailed);
+  }
+  mTotalLatency += latency;
+  if (latency > mMaxLatency) {
+    mMaxLatency = latency;
+  }
+  atomic::Increment(&mProcessed);
+}
+
+void SignalQueue::getStats(SignalStats &stats) const {
+  stats.queued = (unsigned long) atomic::Load(&mQueued);
+  stats.dropped = (unsigned long) atomic::Load(&mDropped);
+  stats.delivered = (unsigned long) atomic::Load(&mDelivered);
+  stats.failed = (unsigned long) atomic::Load(&mFailed);
+  stats.depth = (unsigned long) depth();
+  stats.totalLatency = mTotalLatency;
+  stats.maxLatency = mMaxLatency;
+}
+
+// ---
+
+void Object::connect(const char *signal, Object *listener, const char *slot, SignalQueue *queue) throw(std::runtime_error) {
+  const char *name = (mMethods && signal ? mMethods->findSignalName(signal) : 0);
+  if (!name) {
+    std::ostringstream oss;
+    oss << "Object::connect: Object has no signal \"" << (signal ? signal : "") << "\"";
+    throw std::runtime_error(oss.str());
+  }
+  
+  const MethodsTable *listenerMethods = (listener ? listener->getMethods() : 0);
+  const char *slotName = (listenerMethods && slot ? listenerMethods->findMethodName(slot) : 0);
+  if (!slotName) {
+    std::ostringstream oss;
+    oss << "Object::connect: Listener has no method \"" << (slot ? slot : "") << "\"";
+    throw std::runtime_error(oss.str());
+  }
+  
+  const Method &sig = *(mMethods->findSignal(name));
+  const Method &meth = *(listenerMethods->findMethod(slotName));
+  size_t n = sig.numArgs();
+  
+  bool matches = (meth.numArgs() >= n);
+  for (size_t i=0; matches && i<n; ++i) {
+    matches = (meth[i].getDir() == AD_IN && !meth[i].isArray() && meth[i].getType() == sig[i].getType());
+  }
+  if (!matches || (meth.requiredArgsMask() >> n) != 0) {
+    std::ostringstream oss;
+    oss << "Object::connect: Method \"" << slotName << "\" does not match signal \"" << name << "\"";
+    throw std::runtime_error(oss.str());
+  }
+  
+  SignalConnection c;
+  c.signal = name;
+  c.nargs = n;
+  c.listener = listener;
+  c.slot = slotName;
+  c.method = &meth;
+  c.queue = queue;
+  
+  if (!mConnections) {
+    mConnections = new SignalConnections();
+  }
+  mConnections->list.push_back(c);
+  
+  if (!listener->mSources) {
+    listener->mSources = new SignalSources();
+  }
+  listener->mSources->list.push_back(this);
+  if (queue) {
+    queue->mSources.push_back(this);
+  }
+}
+
+void Object::unlink(Object *listener, SignalQueue *queue) {
+  if (listener->mSources) {
+    RemoveSource(listener->mSources->list, this);
+    if (listener->mSources->list.empty()) {
+      delete listener->mSources;
+      listener->mSources = 0;
+    }
+  }
+  if (queue) {
+    RemoveSource(queue->mSources, this);
+  }
+}
+
+size_t Object::disconnect(const char *signal, Object *listener, const char *slot) {
+  if (!mConnections || !signal) {
+    return 0;
+  }
+  std::vector<SignalConnection> &conns = mConnections->list;
+  size_t count = 0;
+  size_t i = 0;
+  while (i < conns.size()) {
+    SignalConnection c = conns[i];
+    if (c.listener == listener && !strcmp(c.signal, signal) && (!slot || !strcmp(c.slot, slot))) {
+      conns.erase(conns.begin() + i);
+      unlink(c.listener, c.queue);
+      ++count;
+    } else {
+      ++i;
+    }
+  }
+  if (conns.empty()) {
+    disconnectAll();
+  }
+  return count;
+}
+
+void Object::disconnectAll() {
+  if (mConnections) {
+    std::vector<SignalConnection> &conns = mConnections->list;
+    for (size_t i=0; i<conns.size(); ++i) {
+      unlink(conns[i].listener, conns[i].queue);
+    }
+    delete mConnections;
+    mConnections = 0;
+  }
+}
+
+void Object::disconnectListener(Object *listener) {
+  if (!mConnections) {
+    return;
+  }
+  std::vector<SignalConnection> &conns = mConnections->list;
+  size_t i = 0;
+  while (i < conns.size()) {
+    SignalConnection c = conns[i];
+    if (c.listener == listener) {
+      conns.erase(conns.begin() + i);
+      unlink(c.listener, c.queue);
+    } else {
+      ++i;
+    }
+  }
+  if (conns.empty()) {
+    disconnectAll();
+  }
+}
+
+void Object::disconnectQueue(SignalQueue *queue) {
+  if (!mConnections) {
+    return;
+  }
+  std::vector<SignalConnection> &conns = mConnections->list;
+  size_t i = 0;
+  while (i < conns.size()) {
+    SignalConnection c = conns[i];
+    if (c.queue == queue) {
+      conns.erase(conns.begin() + i);
+      unlink(c.listener, c.queue);
+    } else {
+      ++i;
+    }
+  }
+  if (conns.empty()) {
+    disconnectAll();
+  }
+}
+
+void Object::disconnectSources() {
+  // each disconnection removes its source entries
+  while (mSources) {
+    mSources->list.back()->disconnectListener(this);
+  }
+}
+
+size_t Object::numIncomingConnections() const {
+  return (mSources ? mSources->list.size() : 0);
+}
+
+size_t Object::numConnections(const char *signal) const {
+  if (!mConnections) {
+    return 0;
+  }
+  if (!signal) {
+    return mConnections->list.size();
+  }
+  size_t count = 0;
+  for (size_t i=0; i<mConnections->list.size(); ++i) {
+    if (!strcmp(mConnections->list[i].signal, signal)) {
+      ++count;
+    }
+  }
+  return count;
+}
+
+Status Object::emit(const char *signal) {
+  return SignalEmit<>::Emit(this, signal);
+}
+
+void Object::emitSignal(const char *signal, const ArgumentValue *values, size_t n, Status &status) {
+  bool found = false;
+  
+  // slots may change the connections: copy each one before using it
+  for (size_t i=0; mConnections && i<mConnections->list.size(); ++i) {
+    
+    SignalConnection c = mConnections->list[i];
+    
+    if (c.signal != signal && strcmp(c.signal, signal)) {
+      continue;
+    }
+    
+    if (n != c.nargs) {
+      status.set(EC_ARGUMENT_COUNT, c.signal, -1, 0, long(c.nargs));
+      return;
+    }
+    
+    found = true;
+    
+    if (c.queue) {
+      // dropped events are counted by the queue
+      c.queue->push(c.listener, c.slot, *(c.method), values, n);
+      
+    } else {
+      MethodParams params(*(c.method));
+      params.setDefaults(n);
+      memcpy(params.rawvalues(), values, n * sizeof(ArgumentValue));
+      Status rv = c.listener->tryCall(c.slot, params);
+      if (rv.failed() && status.succeeded()) {
+        status = rv;
+      }
+    }
+  }
+  
+  if (!found && !findSignal(signal)) {
+    status.set(EC_NO_SIGNAL, signal);
+  }
+}
+
+}
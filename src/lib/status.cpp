@@ -0,0 +1,125 @@
+/*
+
+Copyright (C) 2009  Gaetan Guidet
+
+This file is part of lwc.
+
+lwc is free software; you can redistribute it and/or modify it
+under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 2.1 of the License, or (at
+your option) any later version.
+
+lwc is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+USA.
+
+*/
+
+#include <lwc/status.h>
+#include <sstream>
+
+namespace lwc {
+
+Status::Status()
+  : mCode(EC_NONE), mIndex(-1), mCount(-1) {
+}
+
+Status::Status(const Status &rhs)
+  : mCode(rhs.mCode), mMethod(rhs.mMethod), mName(rhs.mName),
+    mIndex(rhs.mIndex), mCount(rhs.mCount), mDetails(rhs.mDetails) {
+}
+
+Status::~Status() {
+}
+
+Status& Status::operator=(const Status &rhs) {
+  if (this != &rhs) {
+    mCode = rhs.mCode;
+    mMethod = rhs.mMethod;
+    mName = rhs.mName;
+    mIndex = rhs.mIndex;
+    mCount = rhs.mCount;
+    mDetails = rhs.mDetails;
+  }
+  return *this;
+}
+
+void Status::setFailed(const char *method, const char *details) {
+  set(EC_FAILED, method);
+  mDetails = (details ? details : "");
+}
+
+void Status::clear() {
+  set(EC_NONE);
+  mDetails.clear();
+}
+
+std::string Status::getMessage() const {
+  std::ostringstream oss;
+  const char *method = mMethod.c_str();
+  const char *name = mName.c_str();
+  
+  switch (mCode) {
+    case EC_NONE:
+      break;
+    case EC_NO_METHOD:
+      oss << "Object has not method \"" << method << "\"";
+      break;
+    case EC_INVALID_HANDLE:
+      oss << "Method handle \"" << method << "\" was not resolved for type \"" << name << "\"";
+      break;
+    case EC_ARGUMENT_COUNT:
+      oss << "Method \"" << method << "\" expects " << mCount << " arguments";
+      break;
+    case EC_ARGUMENT_INDEX:
+      oss << "In method \"" << method << "\": Invalid method argument index " << mIndex;
+      break;
+    case EC_ARGUMENT_NAME:
+      oss << "In method \"" << method << "\": Invalid argument name \"" << name << "\"";
+      break;
+    case EC_ARGUMENT_TYPE:
+      oss << "In method \"" << method << "\": Method argument " << mIndex << ": Invalid argument type";
+      break;
+    case EC_KEYWORD_TWICE:
+      oss << "Method \"" << method << "\" keyword argument \"" << name << "\" is set twice";
+      break;
+    case EC_KEYWORD_TYPE:
+      oss << "In method \"" << method << "\": Keyword argument type mismatch";
+      break;
+    case EC_INVALID_POINTER:
+      oss << "Object::call: Invalid pointer for method \"" << method << "\"";
+      break;
+    case EC_CALL_SHAPE:
+      oss << "Call site for method \"" << method << "\" does not match call arguments";
+      break;
+    case EC_SIGNATURE_MISMATCH:
+      oss << "Method \"" << method << "\" does not match interface \"" << name << "\"";
+      if (mIndex >= 0) {
+        oss << " (argument " << mIndex << ")";
+      } else {
+        oss << " (arguments count)";
+      }
+      break;
+    case EC_INTERCEPTED:
+      oss << "Call to method \"" << method << "\" rejected by interceptor";
+      break;
+    case EC_FAILED:
+      oss << mDetails;
+      break;
+    case EC_NO_SIGNAL:
+      oss << "Object has no signal \"" << method << "\"";
+      break;
+    default:
+      oss << "Unknown error";
+  }
+  
+  return oss.str();
+}
+
+}
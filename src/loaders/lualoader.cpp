@@ -96,6 +96,10 @@ class LuaFactory : public lwc::Factory {
     virtual lwc::Object* create(const char *typeName) {
       std::map<std::string, TypeEntry>::iterator it = mTypes.find(typeName);
       if (it != mTypes.end()) {
+        lwc::Object *pooled = acquire(typeName);
+        if (pooled) {
+          return pooled;
+        }
         int oldtop = lua_gettop(mState);
         lua::Object *obj = 0;
         lua_getfield(mState, LUA_REGISTRYINDEX, typeName);
@@ -113,7 +117,7 @@ class LuaFactory : public lwc::Factory {
     }
     
     virtual void destroy(lwc::Object *o) {
-      if (o) {
+      if (o && !release(o)) {
         delete o;
       }
     }
@@ -211,13 +215,29 @@ class LuaFactory : public lwc::Factory {
         lwc::Method meth;
         size_t nargs = lua_objlen(mState, -1);
         
-        if (nargs < 1 || nargs > 2) {
-          std::cout << "lualoader: \"Methods\" table value array must have 1 or 2 elements" << std::endl;
+        if (nargs < 1 || nargs > 3) {
+          std::cout << "lualoader: \"Methods\" table value array must have 1 to 3 elements" << std::endl;
           lua_pop(mState, 1);
           continue;
         }
         
-        if (nargs == 2) {
+        if (nargs == 3) {
+          lua_pushinteger(mState, 3);
+          lua_gettable(mState, -2);
+          if (lua_isnumber(mState, -1)) {
+            meth.setFlags((unsigned long) lua_tointeger(mState, -1));
+          } else {
+            add = false;
+          }
+          lua_pop(mState, 1);
+          if (!add) {
+            std::cout << "lualoader: \"Methods\" table value array 3rd element must be an integer" << std::endl;
+            lua_pop(mState, 1);
+            continue;
+          }
+        }
+        
+        if (nargs >= 2) {
           lua_pushinteger(mState, 2);
           lua_gettable(mState, -2);
           if (lua_isstring(mState, -1)) {
@@ -56,6 +56,10 @@ class PFactory : public lwc::Factory {
     virtual lwc::Object* create(const char *typeName) {
       std::map<std::string, TypeEntry>::iterator it = mTypes.find(typeName);
       if (it != mTypes.end()) {
+        lwc::Object *pooled = acquire(typeName);
+        if (pooled) {
+          return pooled;
+        }
         PyObject *pyObj = PyObject_CallObject(it->second.klass, NULL);
         py::Object *obj = new py::Object(pyObj);
         //SetObjectPointer((PyLWCObject*)pyObj, obj);
@@ -90,7 +94,7 @@ class PFactory : public lwc::Factory {
     }
     
     virtual void destroy(lwc::Object *o) {
-      if (o) {
+      if (o && !release(o)) {
         delete o;
       }
     }
@@ -156,13 +160,13 @@ class PFactory : public lwc::Factory {
           continue;
         }
         
-        bool add = true;
         char *mname = PyString_AsString(key);
         char *mdesc = NULL;
+        unsigned long mflags = lwc::MF_NONE;
         
         long n = PyTuple_Size(value);
-        if (n < 1 || n > 2) {
-          std::cout << "pyloader: \"Methods\" dict values must be tuples with 1 to 2 elements" << std::endl;
+        if (n < 1 || n > 3) {
+          std::cout << "pyloader: \"Methods\" dict values must be tuples with 1 to 3 elements" << std::endl;
           continue;
         }
         
@@ -172,7 +176,7 @@ class PFactory : public lwc::Factory {
           continue;
         }
         
-        if (n == 2) {
+        if (n >= 2) {
           PyObject *pdesc = PyTuple_GetItem(value, 1);
           if (!PyString_Check(pdesc)) {
             std::cout << "pyloader: \"Methods\" dict values' tuple second element must be a string" << std::endl;
@@ -181,65 +185,23 @@ class PFactory : public lwc::Factory {
           mdesc = PyString_AsString(pdesc);
         }
         
+        if (n == 3) {
+          PyObject *pflags = PyTuple_GetItem(value, 2);
+          if (!PyInt_Check(pflags)) {
+            std::cout << "pyloader: \"Methods\" dict values' tuple third element must be an integer (method flags)" << std::endl;
+            continue;
+          }
+          mflags = (unsigned long) PyInt_AsLong(pflags);
+        }
+        
         lwc::Method meth;
         
         if (mdesc) {
           meth.setDescription(mdesc);
         }
+        meth.setFlags(mflags);
         
-        n = PyList_Size(args);
-        
-        for (long i=0; i<n; ++i) {
-          PyObject *arg = PyList_GetItem(args, i);
-          Py_ssize_t ts = PyTuple_Size(arg);
-          if (!PyTuple_Check(arg) || ts < 2 || ts > 6) {
-            std::cout << "pyloader: Arguments must be tuples with 2 to 6 elements" << std::endl;
-            add = false;
-            break;
-          }
-          lwc::Argument a;
-          a.setDir(lwc::Direction(PyInt_AsLong(PyTuple_GetItem(arg, 0))));
-          a.setType(lwc::Type(PyInt_AsLong(PyTuple_GetItem(arg, 1))));
-          if (ts >= 3) {
-            a.setArraySizeArg(PyInt_AsLong(PyTuple_GetItem(arg, 2)));
-          }
-          if (ts >= 4) {
-            PyObject *ahd = PyTuple_GetItem(arg, 3);
-            if (!PyBool_Check(ahd)) {
-              std::cout << "pyloader: Argument's tuple 4th element must be a boolean" << std::endl;
-              add = false;
-              break;
-            }
-            if (ahd == Py_True) {
-              if (ts < 5) {
-                std::cout << "pyloader: Argument is missing default value" << std::endl;
-                add = false;
-                break;
-              } else {
-                PyObject *pdv = PyTuple_GetItem(arg, 4);
-                py::SetArgDefault(a, pdv);
-              }
-            }
-            // hasDefault (yes, no)
-            // if yes -> must have at least 5
-          }
-          if (ts >= 6) {
-            PyObject *aname = PyTuple_GetItem(arg, 5);
-            if (!PyString_Check(aname)) {
-              std::cout << "pyloader: Arguments name must be a string" << std::endl;
-              add = false;
-              break;
-            }
-            a.setName(PyString_AsString(aname));
-          }
-          try {
-            meth.addArg(a);
-          } catch (std::exception &e) {
-            std::cout << "pyloader: " << e.what() << std::endl;
-            add = false;
-            break;
-          }
-        }
+        bool add = ParseArgs(args, meth);
         
         if (!add) {
           std::cout << "pyloader: Skipped method (1) \"" << mname << "\" for type \"" << name << "\"" << std::endl;
@@ -283,6 +245,13 @@ class PFactory : public lwc::Factory {
       
       Py_DECREF(mt);
       
+      // optional, own class member only (base classes signals are inherited
+      // through the parent methods table)
+      PyObject *sd = PyDict_GetItemString(((PyTypeObject*)klass)->tp_dict, "Signals");
+      if (sd && typeMethods) {
+        addSignals(name, sd, typeMethods);
+      }
+      
       if (typeMethods) {
         if (typeMethods->numMethods() == 0) {
           std::cout << "pyloader: MethodsTable is empty for type \"" << name << "\"" << std::endl;
@@ -307,6 +276,100 @@ class PFactory : public lwc::Factory {
     
   protected:
     
+    // "Signals" dict: signal name -> (arguments list, description), arguments
+    // use the "Methods" format and must be inputs
+    static void addSignals(const char *name, PyObject *signals, lwc::MethodsTable *typeMethods) {
+      if (!PyDict_Check(signals)) {
+        std::cout << "pyloader: \"Signals\" must be a dict of tuples" << std::endl;
+        return;
+      }
+      
+      PyObject *key;
+      PyObject *value;
+      Py_ssize_t pos = 0;
+      
+      while (PyDict_Next(signals, &pos, &key, &value)) {
+        
+        if (!PyString_Check(key) || !PyTuple_Check(value) || PyTuple_Size(value) < 1 || PyTuple_Size(value) > 2 ||
+            !PyList_Check(PyTuple_GetItem(value, 0))) {
+          std::cout << "pyloader: \"Signals\" dict values must be tuples with an arguments list and an optional description" << std::endl;
+          continue;
+        }
+        
+        const char *sname = PyString_AsString(key);
+        lwc::Method sig;
+        
+        if (PyTuple_Size(value) == 2 && PyString_Check(PyTuple_GetItem(value, 1))) {
+          sig.setDescription(PyString_AsString(PyTuple_GetItem(value, 1)));
+        }
+        
+        if (!ParseArgs(PyTuple_GetItem(value, 0), sig)) {
+          std::cout << "pyloader: Skipped signal \"" << sname << "\" for type \"" << name << "\"" << std::endl;
+          continue;
+        }
+        
+        try {
+          typeMethods->addSignal(sname, sig);
+        } catch (std::runtime_error &e) {
+          std::cout << "pyloader: Skipped signal \"" << sname << "\" for type \"" << name << "\"" << std::endl;
+          std::cout << e.what() << std::endl;
+        }
+      }
+    }
+    
+    // Method arguments from a list of argument tuples
+    static bool ParseArgs(PyObject *args, lwc::Method &meth) {
+      long n = PyList_Size(args);
+      
+      for (long i=0; i<n; ++i) {
+        PyObject *arg = PyList_GetItem(args, i);
+        Py_ssize_t ts = PyTuple_Size(arg);
+        if (!PyTuple_Check(arg) || ts < 2 || ts > 6) {
+          std::cout << "pyloader: Arguments must be tuples with 2 to 6 elements" << std::endl;
+          return false;
+        }
+        lwc::Argument a;
+        a.setDir(lwc::Direction(PyInt_AsLong(PyTuple_GetItem(arg, 0))));
+        a.setType(lwc::Type(PyInt_AsLong(PyTuple_GetItem(arg, 1))));
+        if (ts >= 3) {
+          a.setArraySizeArg(PyInt_AsLong(PyTuple_GetItem(arg, 2)));
+        }
+        if (ts >= 4) {
+          PyObject *ahd = PyTuple_GetItem(arg, 3);
+          if (!PyBool_Check(ahd)) {
+            std::cout << "pyloader: Argument's tuple 4th element must be a boolean" << std::endl;
+            return false;
+          }
+          if (ahd == Py_True) {
+            if (ts < 5) {
+              std::cout << "pyloader: Argument is missing default value" << std::endl;
+              return false;
+            } else {
+              PyObject *pdv = PyTuple_GetItem(arg, 4);
+              py::SetArgDefault(a, pdv);
+            }
+          }
+          // hasDefault (yes, no)
+          // if yes -> must have at least 5
+        }
+        if (ts >= 6) {
+          PyObject *aname = PyTuple_GetItem(arg, 5);
+          if (!PyString_Check(aname)) {
+            std::cout << "pyloader: Arguments name must be a string" << std::endl;
+            return false;
+          }
+          a.setName(PyString_AsString(aname));
+        }
+        try {
+          meth.addArg(a);
+        } catch (std::exception &e) {
+          std::cout << "pyloader: " << e.what() << std::endl;
+          return false;
+        }
+      }
+      return true;
+    }
+    
     struct TypeEntry {
       PyObject *klass;
       bool singleton;
@@ -180,18 +180,29 @@ class RbFactory : public lwc::Factory {
           continue;
         }
         
-        // 1 or 2 items
+        // 1 to 3 items
         
         const char *mname = rb_id2name(SYM2ID(key));
         const char *mdesc = 0;
+        unsigned long mflags = lwc::MF_NONE;
         
         long n = RARRAY(val)->len;
-        if (n < 1 || n > 2) {
-          std::cout << "rbloader: \"Methods\" dict value array must have 1 or 2 elements" << std::endl;
+        if (n < 1 || n > 3) {
+          std::cout << "rbloader: \"Methods\" dict value array must have 1 to 3 elements" << std::endl;
           continue;
         }
         
-        if (n == 2) {
+        if (n == 3) {
+          // third element must be an integer (method flags)
+          VALUE rmflags = RARRAY(val)->ptr[2];
+          if (TYPE(rmflags) != T_FIXNUM) {
+            std::cout << "rbloader: \"Methods\" dict value array 3rd element must be an integer" << std::endl;
+            continue;
+          }
+          mflags = NUM2ULONG(rmflags);
+        }
+        
+        if (n >= 2) {
           // second element must be a string
           VALUE rmdesc = rb_check_string_type(RARRAY(val)->ptr[1]);
           if (NIL_P(rmdesc)) {
@@ -214,6 +225,7 @@ class RbFactory : public lwc::Factory {
         if (mdesc) {
           meth.setDescription(mdesc);
         }
+        meth.setFlags(mflags);
         
         //std::cout << "Add method: " << name << std::endl;
         for (long j=0; j<n; ++j) {
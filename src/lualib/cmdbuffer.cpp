@@ -0,0 +1,235 @@
+/*
+
+Copyright (C) 2009, 2010  Gaetan Guidet
+
+This file is part of lwc.
+
+lwc is free software; you can redistribute it and/or modify it
+under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 2.1 of the License, or (at
+your option) any later version.
+
+lwc is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+USA.
+
+*/
+
+#include <lwc/lua/types.h>
+#include <lwc/lua/convert.h>
+
+namespace lua {
+
+typedef lwc::CommandBridge<MarshalTraits> CommandBridge;
+
+LuaCommandBuffer::LuaCommandBuffer() {
+}
+
+LuaCommandBuffer::~LuaCommandBuffer() {
+}
+
+size_t LuaCommandBuffer::AllocSize() {
+  return (sizeof(LuaCommandBuffer));
+}
+
+const char* LuaCommandBuffer::RegistryKey() {
+  return "__lwc_lua_cmdbuffer";
+}
+
+int LuaCommandBuffer::New(lua_State *L) {
+  CheckArgCount(L, 0);
+  void *ud = lua_newuserdata(L, LuaCommandBuffer::AllocSize());
+  new (ud) LuaCommandBuffer();
+  lua_getfield(L, LUA_REGISTRYINDEX, LuaCommandBuffer::RegistryKey());
+  lua_setmetatable(L, -2);
+  return 1;
+}
+
+lwc::CommandBuffer& LuaCommandBuffer::UnWrap(lua_State *L, int narg, bool upValue) {
+  int idx = (upValue ? lua_upvalueindex(narg) : narg);
+  void *p = lua_touserdata(L, idx);
+  if (!p) {
+    luaL_typerror(L, narg, "llwc.CommandBuffer");
+  }
+  lua_getfield(L, LUA_REGISTRYINDEX, LuaCommandBuffer::RegistryKey());
+  if (!lua_getmetatable(L, idx) || !lua_rawequal(L, -1, -2)) {
+    luaL_typerror(L, narg, "llwc.CommandBuffer");
+  }
+  lua_pop(L, 2);
+  return ((LuaCommandBuffer*) p)->buffer;
+}
+
+int LuaCommandBuffer::Del(lua_State *L) {
+  CheckArgCount(L, 1);
+  void *ud = lua_touserdata(L, 1);
+  ((LuaCommandBuffer*)ud)->~LuaCommandBuffer();
+  lua_pop(L, 1);
+  return 0;
+}
+
+// ---
+
+// Record the call described by the count values from first (object, method
+// name, input values...), pushes the error message on failure
+static bool Record(lwc::CommandBuffer &buffer, lua_State *L, int first, size_t count, size_t &index) {
+  if (count < 2 || !LuaType<lwc::Object*>::Check(L, first) || lua_isnil(L, first) ||
+      lua_type(L, first+1) != LUA_TSTRING) {
+    lua_pushstring(L, "llwc.CommandBuffer: expected object, method name and input values");
+    return false;
+  }
+  
+  MarshalArgs args = {L, first, count};
+  
+  lwc::Object *o = LuaObject::UnWrap(L, first);
+  const char *name = lua_tostring(L, first+1);
+  
+  lwc::Status status;
+  
+  if (!CommandBridge::Record(buffer, o, name, args, 2, index, status)) {
+    lua_pushstring(L, status.getMessage().c_str());
+    return false;
+  }
+  
+  return true;
+}
+
+static int luacmdbuf_new(lua_State *L) {
+  return LuaCommandBuffer::New(L);
+}
+
+static int luacmdbuf_del(lua_State *L) {
+  return LuaCommandBuffer::Del(L);
+}
+
+static int luacmdbuf_record(lua_State *L) {
+  lwc::CommandBuffer &buffer = LuaCommandBuffer::UnWrap(L, 1);
+  size_t index = 0;
+  if (!Record(buffer, L, 2, size_t(lua_gettop(L) - 1), index)) {
+    return lua_error(L);
+  }
+  lua_settop(L, 0);
+  lua_pushinteger(L, lua_Integer(index + 1));
+  return 1;
+}
+
+static int luacmdbuf_extend(lua_State *L) {
+  CheckArgCount(L, 2);
+  lwc::CommandBuffer &buffer = LuaCommandBuffer::UnWrap(L, 1);
+  if (!lua_istable(L, 2)) {
+    return luaL_typerror(L, 2, "table");
+  }
+  size_t n = lua_objlen(L, 2);
+  size_t index = 0;
+  for (size_t i=1; i<=n; ++i) {
+    lua_rawgeti(L, 2, int(i));
+    if (!lua_istable(L, 3)) {
+      lua_pushstring(L, "llwc.CommandBuffer.extend: expected array of tables");
+      return lua_error(L);
+    }
+    size_t count = lua_objlen(L, 3);
+    for (size_t j=1; j<=count; ++j) {
+      lua_rawgeti(L, 3, int(j));
+    }
+    if (!Record(buffer, L, 4, count, index)) {
+      return lua_error(L);
+    }
+    lua_settop(L, 2);
+  }
+  lua_settop(L, 0);
+  return 0;
+}
+
+// Returns an array with the output values of each command (unpack them to get
+// the direct call results)
+static int luacmdbuf_submit(lua_State *L) {
+  CheckArgCount(L, 1);
+  lwc::CommandBuffer &buffer = LuaCommandBuffer::UnWrap(L, 1);
+  lua_pop(L, 1);
+  
+  bool failed = false;
+  {
+    lwc::Status status = buffer.trySubmit();
+    if (status.failed()) {
+      lua_pushfstring(L, "Command %d: %s", int(buffer.failedCommand() + 1), status.getMessage().c_str());
+      failed = true;
+    }
+  }
+  if (failed) {
+    return lua_error(L);
+  }
+  
+  MarshalArgs args = {L, 1, 0};
+  
+  lua_newtable(L);
+  
+  for (size_t i=0; i<buffer.size(); ++i) {
+    const lwc::Method &meth = buffer.getMethod(i);
+    lua_newtable(L);
+    int n = 0;
+    for (size_t j=0; j<meth.numArgs(); ++j) {
+      if (meth[j].getDir() != lwc::AD_IN) {
+        CommandBridge::Output(buffer, i, j, args);
+        lua_rawseti(L, -2, ++n);
+      }
+    }
+    lua_rawseti(L, -2, int(i + 1));
+  }
+  
+  return 1;
+}
+
+static int luacmdbuf_clear(lua_State *L) {
+  CheckArgCount(L, 1);
+  lwc::CommandBuffer &buffer = LuaCommandBuffer::UnWrap(L, 1);
+  lua_pop(L, 1);
+  buffer.clear();
+  return 0;
+}
+
+static int luacmdbuf_size(lua_State *L) {
+  CheckArgCount(L, 1);
+  lwc::CommandBuffer &buffer = LuaCommandBuffer::UnWrap(L, 1);
+  lua_pop(L, 1);
+  lua_pushinteger(L, lua_Integer(buffer.size()));
+  return 1;
+}
+
+// ---
+
+bool InitCommandBuffer(lua_State *L, int module) {
+  
+  lua_newtable(L);
+  int klass = lua_gettop(L);
+  
+  lua_pushvalue(L, klass);
+  lua_setfield(L, klass, "__index");
+  
+  lua_pushcfunction(L, luacmdbuf_new);
+  lua_setfield(L, klass, "new");
+  lua_pushcfunction(L, luacmdbuf_del);
+  lua_setfield(L, klass, "__gc");
+  lua_pushcfunction(L, luacmdbuf_record);
+  lua_setfield(L, klass, "record");
+  lua_pushcfunction(L, luacmdbuf_extend);
+  lua_setfield(L, klass, "extend");
+  lua_pushcfunction(L, luacmdbuf_submit);
+  lua_setfield(L, klass, "submit");
+  lua_pushcfunction(L, luacmdbuf_clear);
+  lua_setfield(L, klass, "clear");
+  lua_pushcfunction(L, luacmdbuf_size);
+  lua_setfield(L, klass, "size");
+  
+  lua_pushvalue(L, klass);
+  lua_setfield(L, LUA_REGISTRYINDEX, LuaCommandBuffer::RegistryKey());
+  lua_setfield(L, module, "CommandBuffer");
+  
+  return true;
+}
+
+}
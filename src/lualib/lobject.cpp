@@ -59,39 +59,33 @@ int Object::self() {
   lua_remove(mState, -2);
   return lua_gettop(mState);
 }
-      
-void Object::call(const char *name, lwc::MethodParams &params) throw(std::runtime_error) {
-  
-  //std::cout << "lua::Object::call(\"" << name << "\")" << std::endl;
-  
+
+bool Object::recycle() {
   int oldtop = lua_gettop(mState);
-  //int mSelf = self();
+  bool rc = false;
   lua_pushlightuserdata(mState, (void*)this);
   lua_gettable(mState, LUA_REGISTRYINDEX);
-  int mSelf = lua_gettop(mState);
-  
-  if (lua_isnil(mState, mSelf)) {
-    throw std::runtime_error("Underlying lua object does not exist");
-  }
-  
-  lua_getmetatable(mState, mSelf);
-  lua_getfield(mState, -1, name);
-  if (lua_isnil(mState, -1)) {
-    std::ostringstream oss;
-    oss << "Method missing \"" << name << "\"";
-    throw std::runtime_error(oss.str());
+  int inst = lua_gettop(mState);
+  if (!lua_isnil(mState, inst) && lua_getmetatable(mState, inst)) {
+    lua_getfield(mState, -1, "recycle");
+    if (lua_isfunction(mState, -1)) {
+      lua_pushvalue(mState, inst);
+      if (lua_pcall(mState, 1, 1, 0) == 0) {
+        rc = (lua_isnil(mState, -1) || lua_toboolean(mState, -1));
+      } else {
+        std::cout << "lua::Object::recycle: " << lua_tostring(mState, -1) << std::endl;
+      }
+    }
   }
-  // remove metatable from stack
-  lua_remove(mState, -2);
-  // save inout insert point
-  int inoutPos = lua_gettop(mState);
-  // push self as first argument
-  lua_pushvalue(mState, -2);
-  
-  const lwc::Method &meth = params.getMethod();
+  lua_settop(mState, oldtop);
+  return rc;
+}
 
-  size_t ninputs = 0;
-  size_t noutputs = 0;
+// Count the method arguments seen by lua (array sizes are implicit)
+static void CountArgs(const lwc::Method &meth, size_t &ninputs, size_t &noutputs) throw(std::runtime_error) {
+  
+  ninputs = 0;
+  noutputs = 0;
   
   for (size_t i=0; i<meth.numArgs(); ++i) {
     const lwc::Argument &arg = meth[i];
@@ -106,11 +100,31 @@ void Object::call(const char *name, lwc::MethodParams &params) throw(std::runtim
       }
     }
   }
+}
+
+// Format the lua error message at the top of the stack and raise it as a C++ exception
+// error message at the top of the stack, the stack is reset to top before
+// throwing
+static void RaiseLuaError(lua_State *L, int top) throw(std::runtime_error) {
+  std::ostringstream oss;
+  const char *msg = lua_tostring(L, -1);
+  std::string lines = (msg ? msg : "");
+  lua_settop(L, top);
+  size_t p0 = 0, p1 = lines.find('\n', p0);
+  while (p1 != std::string::npos) {
+    std::string line = lines.substr(p0, p1-p0);
+    oss << std::endl << "--- Lua --- " << line;
+    p0 = p1 + 1;
+    p1 = lines.find('\n', p0);
+  }
+  oss << std::endl;
+  throw std::runtime_error(oss.str().c_str());
+}
+
+void Object::pushArgs(lwc::MethodParams &params, int &inoutPos,
+                      std::map<size_t, size_t> &inoutInSizes) throw(std::runtime_error) {
   
-  std::map<size_t, size_t> inoutArgs;
-  std::map<size_t, size_t> inoutInSizes;
-  
-  size_t cur = 0;
+  const lwc::Method &meth = params.getMethod();
   
   for (size_t i=0; i<meth.numArgs(); ++i) {
     const lwc::Argument &arg = meth[i];
@@ -272,35 +286,20 @@ void Object::call(const char *name, lwc::MethodParams &params) throw(std::runtim
     //args[cur] = rarg;
     //++cur;
   }
+}
+
+void Object::getOutputs(lwc::MethodParams &params, int retPos, size_t noutputs,
+                        std::map<size_t, size_t> &inoutArgs,
+                        std::map<size_t, size_t> &inoutInSizes) throw(std::runtime_error) {
   
-  // ninputs + 1 because we always add mSelf as first arg
-  //lua_call(mState, ninputs+1, noutputs);
-  // instead of 0, giving the index of an error function would enable printing of more precise information
-  // (need to investigate that)
-  int err = lua_pcall(mState, ninputs+1, noutputs, 0);
-  if (err != 0) {
-    // error string is at the top of the stack
-    std::ostringstream oss;
-    std::string lines = lua_tostring(mState, -1);
-    size_t p0 = 0, p1 = lines.find('\n', p0);
-    while (p1 != std::string::npos) {
-      std::string line = lines.substr(p0, p1-p0);
-      oss << std::endl << "--- Lua --- " << line;
-      p0 = p1 + 1;
-      p1 = lines.find('\n', p0);
-    }
-    oss << std::endl;
-    throw std::runtime_error(oss.str().c_str());
-  }
+  const lwc::Method &meth = params.getMethod();
   
   // convert Lua outputs to C
   
   // params.get(idx, var) is not quite the same as: params.set(idx, var)
   // beware, the last is called by the caller to set the address of an output var
   // that will receive the value.
-  int retPos = lua_gettop(mState) - noutputs + 1;
-  
-  cur = 0;
+  size_t cur = 0;
   //bool array = (noutputs > 0 ? lua_istable(mState, -1) : false);
   
   for (size_t i=0; i<meth.numArgs(); ++i) {
@@ -405,6 +404,39 @@ void Object::call(const char *name, lwc::MethodParams &params) throw(std::runtim
       }
       ++cur;
       
+      if (arg.getDir() == lwc::AD_RETURN) {
+        // stored in the parameters slot itself
+        switch(arg.getType()) {
+          case lwc::AT_BOOL: {
+            bool val = false;
+            Lua2C<lwc::AT_BOOL>::ToValue(mState, crv, val);
+            params.setReturn(val);
+            break;
+          }
+          case lwc::AT_INT: {
+            lwc::Integer val = 0;
+            Lua2C<lwc::AT_INT>::ToValue(mState, crv, val);
+            params.setReturn(val);
+            break;
+          }
+          case lwc::AT_REAL: {
+            lwc::Real val = 0.0;
+            Lua2C<lwc::AT_REAL>::ToValue(mState, crv, val);
+            params.setReturn(val);
+            break;
+          }
+          case lwc::AT_OBJECT: {
+            lwc::Object *val = 0;
+            Lua2C<lwc::AT_OBJECT>::ToValue(mState, crv, val);
+            params.setReturn(val);
+            break;
+          }
+          default:
+            throw std::runtime_error("Invalid return argument type");
+        }
+        continue;
+      }
+      
       switch(arg.getType()) {
         case lwc::AT_BOOL: {
           bool *val;
@@ -441,9 +473,178 @@ void Object::call(const char *name, lwc::MethodParams &params) throw(std::runtim
       }
     }
   }
+}
+
+void Object::invoke(const char *name, lwc::MethodParams &params) throw(std::runtime_error) {
+  
+  //std::cout << "lua::Object::call(\"" << name << "\")" << std::endl;
+  
+  int oldtop = lua_gettop(mState);
+  //int mSelf = self();
+  lua_pushlightuserdata(mState, (void*)this);
+  lua_gettable(mState, LUA_REGISTRYINDEX);
+  int mSelf = lua_gettop(mState);
+  
+  if (lua_isnil(mState, mSelf)) {
+    lua_settop(mState, oldtop);
+    throw std::runtime_error("Underlying lua object does not exist");
+  }
+  
+  lua_getmetatable(mState, mSelf);
+  lua_getfield(mState, -1, name);
+  if (lua_isnil(mState, -1)) {
+    lua_settop(mState, oldtop);
+    std::ostringstream oss;
+    oss << "Method missing \"" << name << "\"";
+    throw std::runtime_error(oss.str());
+  }
+  // remove metatable from stack
+  lua_remove(mState, -2);
+  // save inout insert point
+  int inoutPos = lua_gettop(mState);
+  // push self as first argument
+  lua_pushvalue(mState, -2);
+  
+  size_t ninputs = 0;
+  size_t noutputs = 0;
+  
+  CountArgs(params.getMethod(), ninputs, noutputs);
+  
+  std::map<size_t, size_t> inoutArgs;
+  std::map<size_t, size_t> inoutInSizes;
+  
+  try {
+    pushArgs(params, inoutPos, inoutInSizes);
+  } catch (...) {
+    lua_settop(mState, oldtop);
+    throw;
+  }
+  
+  // ninputs + 1 because we always add mSelf as first arg
+  //lua_call(mState, ninputs+1, noutputs);
+  // instead of 0, giving the index of an error function would enable printing of more precise information
+  // (need to investigate that)
+  int err = lua_pcall(mState, ninputs+1, noutputs, 0);
+  if (err != 0) {
+    // error string is at the top of the stack
+    RaiseLuaError(mState, oldtop);
+  }
+  
+  // convert Lua outputs to C
+  
+  // params.get(idx, var) is not quite the same as: params.set(idx, var)
+  // beware, the last is called by the caller to set the address of an output var
+  // that will receive the value.
+  try {
+    getOutputs(params, lua_gettop(mState) - noutputs + 1, noutputs, inoutArgs, inoutInSizes);
+  } catch (...) {
+    lua_settop(mState, oldtop);
+    throw;
+  }
   
   lua_settop(mState, oldtop);
 }
 
+void Object::invokeBatch(const char *name, const lwc::Method &meth, lwc::MethodParams **params, size_t n) throw(std::runtime_error) {
+  
+  size_t ninputs = 0;
+  size_t noutputs = 0;
+  
+  CountArgs(meth, ninputs, noutputs);
+  
+  for (size_t i=0; i<n; ++i) {
+    CheckBatchParams(name, meth, params, i);
+  }
+  
+  // inout arrays are passed back through the call stack, use single calls
+  for (size_t i=0; i<meth.numArgs(); ++i) {
+    if (meth[i].getDir() == lwc::AD_INOUT) {
+      lwc::Object::invokeBatch(name, meth, params, n);
+      return;
+    }
+  }
+  
+  int oldtop = lua_gettop(mState);
+  lua_pushlightuserdata(mState, (void*)this);
+  lua_gettable(mState, LUA_REGISTRYINDEX);
+  int mSelf = lua_gettop(mState);
+  
+  if (lua_isnil(mState, mSelf)) {
+    lua_settop(mState, oldtop);
+    throw std::runtime_error("Underlying lua object does not exist");
+  }
+  
+  // "<name>_batch" receives the array of argument tables and returns the array
+  // of results (one value per call, or a table of values for multiple outputs)
+  std::string bname = std::string(name) + "_batch";
+  
+  lua_getmetatable(mState, mSelf);
+  lua_getfield(mState, -1, bname.c_str());
+  lua_remove(mState, -2);
+  
+  if (lua_isnil(mState, -1)) {
+    lua_settop(mState, oldtop);
+    lwc::Object::invokeBatch(name, meth, params, n);
+    return;
+  }
+  
+  int inoutPos = lua_gettop(mState);
+  std::map<size_t, size_t> inoutArgs;
+  std::map<size_t, size_t> inoutInSizes;
+  
+  lua_pushvalue(mState, mSelf);
+  lua_newtable(mState);
+  int batch = lua_gettop(mState);
+  
+  try {
+    for (size_t i=0; i<n; ++i) {
+      lua_newtable(mState);
+      int args = lua_gettop(mState);
+      pushArgs(*(params[i]), inoutPos, inoutInSizes);
+      for (int k=lua_gettop(mState)-args; k>0; --k) {
+        lua_rawseti(mState, args, k);
+      }
+      lua_rawseti(mState, batch, int(i+1));
+    }
+  } catch (...) {
+    lua_settop(mState, oldtop);
+    throw;
+  }
+  
+  if (lua_pcall(mState, 2, 1, 0) != 0) {
+    RaiseLuaError(mState, oldtop);
+  }
+  
+  int res = lua_gettop(mState);
+  
+  if (noutputs > 0) {
+    
+    if (!lua_istable(mState, res)) {
+      lua_settop(mState, oldtop);
+      std::ostringstream oss;
+      oss << "Lua method \"" << bname << "\" should return an array of results";
+      throw std::runtime_error(oss.str());
+    }
+    
+    try {
+      for (size_t i=0; i<n; ++i) {
+        lua_rawgeti(mState, res, int(i+1));
+        if (noutputs > 1) {
+          int values = lua_gettop(mState);
+          for (size_t k=1; k<=noutputs; ++k) {
+            lua_rawgeti(mState, values, int(k));
+          }
+        }
+        getOutputs(*(params[i]), lua_gettop(mState) - noutputs + 1, noutputs, inoutArgs, inoutInSizes);
+        lua_settop(mState, res);
+      }
+    } catch (...) {
+      lua_settop(mState, oldtop);
+      throw;
+    }
+  }
+  
+  lua_settop(mState, oldtop);
 }
 
+}
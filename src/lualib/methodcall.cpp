@@ -23,13 +23,24 @@ USA.
 
 #include <lwc/lua/methodcall.h>
 #include <lwc/lua/convert.h>
+#include <lwc/marshal.h>
 
 namespace lua {
 
+// Raise lua error for the outermost call only, inner calls just report
+// the failure so that every level of the recursion frees its converted values
+static int CallFailed(lua_State *L, int cArg, const lwc::Status &status) {
+  if (cArg == 0) {
+    lua_pushstring(L, status.getMessage().c_str());
+    lua_error(L);
+  }
+  return BAD_METHOD_CALL;
+}
+
 int CallMethod(lwc::Object *o, const char *n,
                lwc::MethodParams &params, int cArg,
-               lua_State *L, int firstArg, size_t nargs, int kwargs, size_t luaArg,
-               std::map<size_t,size_t> &arraySizes) throw(std::runtime_error) {
+               lua_State *L, int firstArg, size_t nargs, const int *kwargs, size_t luaArg,
+               std::map<size_t,size_t> &arraySizes, lwc::Status &status) {
   
   // are INOUT dealt properly? [see convert.h]
   
@@ -38,17 +49,15 @@ int CallMethod(lwc::Object *o, const char *n,
   if (m.numArgs() == size_t(cArg)) {
     
     if (luaArg != nargs) {
-      if (cArg == 0) {
-        lua_pushstring(L, "Invalid arguments. None expected");
-        lua_error(L);
-        return BAD_METHOD_CALL;
-      
-      } else {
-        throw std::runtime_error("Invalid arguments. None expected");
-      }
+      status.setFailed(n, "Invalid arguments. None expected");
+      return CallFailed(L, cArg, status);
     }
     
-    o->call(n, params);
+    status = o->tryCall(n, params);
+    
+    if (status.failed()) {
+      return CallFailed(L, cArg, status);
+    }
     
     if (m.numArgs() == 0) {
       return NO_RETVAL;
@@ -64,14 +73,35 @@ int CallMethod(lwc::Object *o, const char *n,
     const lwc::Argument &ad = m[cArg];
     
     if (!ad.isArray() && ad.getDir() == lwc::AD_INOUT) {
+      status.setFailed(n, "inout non array arguments not supported in lua");
+      return CallFailed(L, cArg, status);
+    }
+    
+    if (ad.getDir() == lwc::AD_RETURN) {
+      // last argument: the method fills the slot, no temporary to bind
+      if (luaArg != nargs) {
+        status.setFailed(n, "Invalid arguments. None expected");
+        return CallFailed(L, cArg, status);
+      }
+      
+      status = o->tryCall(n, params);
+      
+      if (status.failed()) {
+        return CallFailed(L, cArg, status);
+      }
+      
       if (cArg == 0) {
-        lua_pushstring(L, "inout non array arguments not supported in lua");
-        lua_error(L);
-        return BAD_METHOD_CALL;
+        // single result, pushed as is
+        PushReturn(L, params, 0);
+        return 1;
+      }
       
-      } else {
-        throw std::runtime_error("inout non array arguments not supported in lua");
-      } 
+      lua_newtable(L);
+      rv = lua_gettop(L);
+      lua_pushinteger(L, 1);
+      PushReturn(L, params, size_t(cArg));
+      lua_settable(L, rv);
+      return rv;
     }
     
     bool failed = false;
@@ -83,27 +113,22 @@ int CallMethod(lwc::Object *o, const char *n,
         if (ad.isArray()) {
           bool *ary=0;
           const lwc::Argument &sad = m[ad.arraySizeArg()];
-          if (ParamConverter<lwc::AT_BOOL>::PreCallArray(ad, cArg, sad, L, firstArg, nargs, kwargs, luaArg, arraySizes, ary, err)) {
-            try {
-              if (ad.getDir() == lwc::AD_IN) {
-                params.set(cArg, ary, false);
-              } else {
-                params.set(cArg, &ary, false);
-              }
-            } catch (std::exception &e) {
-              err = e.what();
-              failed = true;
+          if (ParamConverter<lwc::AT_BOOL>::PreCallArray(ad, cArg, sad, L, firstArg, nargs, kwargs[cArg], luaArg, arraySizes, ary, err)) {
+            if (ad.getDir() == lwc::AD_IN) {
+              failed = !params.trySet(cArg, ary, status, false);
+            } else {
+              failed = !params.trySet(cArg, &ary, status, false);
             }
-            if (!failed) {
-              try {
-                rv = CallMethod(o, n, params, cArg+1, L, firstArg, nargs, kwargs, luaArg, arraySizes);
-              } catch (std::exception &e) {
+            if (failed) {
+              status.setMethodName(n);
+            } else {
+              rv = CallMethod(o, n, params, cArg+1, L, firstArg, nargs, kwargs, luaArg, arraySizes, status);
+              if (rv == BAD_METHOD_CALL) {
                 rv = 0;
-                err = e.what();
                 failed = true;
               }
             }
-            ParamConverter<lwc::AT_BOOL>::PostCallArray(ad, cArg, sad, L, firstArg, nargs, kwargs, oldLuaArg, arraySizes, ary, rv, failed);
+            ParamConverter<lwc::AT_BOOL>::PostCallArray(ad, cArg, sad, L, firstArg, nargs, kwargs[cArg], oldLuaArg, arraySizes, ary, rv, failed);
             
           } else {
             failed = true;
@@ -111,27 +136,22 @@ int CallMethod(lwc::Object *o, const char *n,
           
         } else {
           bool val;
-          if (ParamConverter<lwc::AT_BOOL>::PreCall(ad, cArg, L, firstArg, nargs, kwargs, luaArg, arraySizes, val, err)) {
-            try {
-              if (ad.getDir() == lwc::AD_IN) {
-                params.set(cArg, val, false);
-              } else {
-                params.set(cArg, &val, false);
-              }
-            } catch (std::exception &e) {
-              err = e.what();
-              failed = true;
+          if (ParamConverter<lwc::AT_BOOL>::PreCall(ad, cArg, L, firstArg, nargs, kwargs[cArg], luaArg, arraySizes, val, err)) {
+            if (ad.getDir() == lwc::AD_IN) {
+              failed = !params.trySet(cArg, val, status, false);
+            } else {
+              failed = !params.trySet(cArg, &val, status, false);
             }
-            if (!failed) {
-              try {
-                rv = CallMethod(o, n, params, cArg+1, L, firstArg, nargs, kwargs, luaArg, arraySizes);
-              } catch (std::exception &e) {
+            if (failed) {
+              status.setMethodName(n);
+            } else {
+              rv = CallMethod(o, n, params, cArg+1, L, firstArg, nargs, kwargs, luaArg, arraySizes, status);
+              if (rv == BAD_METHOD_CALL) {
                 rv = 0;
-                err = e.what();
                 failed = true;
               }
             }
-            ParamConverter<lwc::AT_BOOL>::PostCall(ad, cArg, L, firstArg, nargs, kwargs, oldLuaArg, arraySizes, val, rv, failed);
+            ParamConverter<lwc::AT_BOOL>::PostCall(ad, cArg, L, firstArg, nargs, kwargs[cArg], oldLuaArg, arraySizes, val, rv, failed);
           
           } else {
             failed = true;
@@ -143,27 +163,22 @@ int CallMethod(lwc::Object *o, const char *n,
         if (ad.isArray()) {
           lwc::Integer *ary=0;
           const lwc::Argument &sad = m[ad.arraySizeArg()];
-          if (ParamConverter<lwc::AT_INT>::PreCallArray(ad, cArg, sad, L, firstArg, nargs, kwargs, luaArg, arraySizes, ary, err)) {
-            try {
-              if (ad.getDir() == lwc::AD_IN) {
-                params.set(cArg, ary, false);
-              } else {
-                params.set(cArg, &ary, false);
-              }
-            } catch (std::exception &e) {
-              err = e.what();
-              failed = true;
+          if (ParamConverter<lwc::AT_INT>::PreCallArray(ad, cArg, sad, L, firstArg, nargs, kwargs[cArg], luaArg, arraySizes, ary, err)) {
+            if (ad.getDir() == lwc::AD_IN) {
+              failed = !params.trySet(cArg, ary, status, false);
+            } else {
+              failed = !params.trySet(cArg, &ary, status, false);
             }
-            if (!failed) {
-              try {
-                rv = CallMethod(o, n, params, cArg+1, L, firstArg, nargs, kwargs, luaArg, arraySizes);
-              } catch (std::exception &e) {
+            if (failed) {
+              status.setMethodName(n);
+            } else {
+              rv = CallMethod(o, n, params, cArg+1, L, firstArg, nargs, kwargs, luaArg, arraySizes, status);
+              if (rv == BAD_METHOD_CALL) {
                 rv = 0;
-                err = e.what();
                 failed = true;
               }
             }
-            ParamConverter<lwc::AT_INT>::PostCallArray(ad, cArg, sad, L, firstArg, nargs, kwargs, oldLuaArg, arraySizes, ary, rv, failed);
+            ParamConverter<lwc::AT_INT>::PostCallArray(ad, cArg, sad, L, firstArg, nargs, kwargs[cArg], oldLuaArg, arraySizes, ary, rv, failed);
             
           } else {
             failed = true;
@@ -171,27 +186,22 @@ int CallMethod(lwc::Object *o, const char *n,
           
         } else {
           lwc::Integer val;
-          if (ParamConverter<lwc::AT_INT>::PreCall(ad, cArg, L, firstArg, nargs, kwargs, luaArg, arraySizes, val, err)) {
-            try {
-              if (ad.getDir() == lwc::AD_IN) {
-                params.set(cArg, val, false);
-              } else {
-                params.set(cArg, &val, false);
-              }
-            } catch (std::exception &e) {
-              err = e.what();
-              failed = true;
+          if (ParamConverter<lwc::AT_INT>::PreCall(ad, cArg, L, firstArg, nargs, kwargs[cArg], luaArg, arraySizes, val, err)) {
+            if (ad.getDir() == lwc::AD_IN) {
+              failed = !params.trySet(cArg, val, status, false);
+            } else {
+              failed = !params.trySet(cArg, &val, status, false);
             }
-            if (!failed) {
-              try {
-                rv = CallMethod(o, n, params, cArg+1, L, firstArg, nargs, kwargs, luaArg, arraySizes);
-              } catch (std::exception &e) {
+            if (failed) {
+              status.setMethodName(n);
+            } else {
+              rv = CallMethod(o, n, params, cArg+1, L, firstArg, nargs, kwargs, luaArg, arraySizes, status);
+              if (rv == BAD_METHOD_CALL) {
                 rv = 0;
-                err = e.what();
                 failed = true;
               }
             }
-            ParamConverter<lwc::AT_INT>::PostCall(ad, cArg, L, firstArg, nargs, kwargs, oldLuaArg, arraySizes, val, rv, failed);
+            ParamConverter<lwc::AT_INT>::PostCall(ad, cArg, L, firstArg, nargs, kwargs[cArg], oldLuaArg, arraySizes, val, rv, failed);
             
           } else {
             failed = true;
@@ -203,27 +213,22 @@ int CallMethod(lwc::Object *o, const char *n,
         if (ad.isArray()) {
           lwc::Real *ary=0;
           const lwc::Argument &sad = m[ad.arraySizeArg()];
-          if (ParamConverter<lwc::AT_REAL>::PreCallArray(ad, cArg, sad, L, firstArg, nargs, kwargs, luaArg, arraySizes, ary, err)) {
-            try {
-              if (ad.getDir() == lwc::AD_IN) {
-                params.set(cArg, ary, false);
-              } else {
-                params.set(cArg, &ary, false);
-              }
-            } catch (std::exception &e) {
-              err = e.what();
-              failed = true;
+          if (ParamConverter<lwc::AT_REAL>::PreCallArray(ad, cArg, sad, L, firstArg, nargs, kwargs[cArg], luaArg, arraySizes, ary, err)) {
+            if (ad.getDir() == lwc::AD_IN) {
+              failed = !params.trySet(cArg, ary, status, false);
+            } else {
+              failed = !params.trySet(cArg, &ary, status, false);
             }
-            if (!failed) {
-              try {
-                rv = CallMethod(o, n, params, cArg+1, L, firstArg, nargs, kwargs, luaArg, arraySizes);
-              } catch (std::exception &e) {
+            if (failed) {
+              status.setMethodName(n);
+            } else {
+              rv = CallMethod(o, n, params, cArg+1, L, firstArg, nargs, kwargs, luaArg, arraySizes, status);
+              if (rv == BAD_METHOD_CALL) {
                 rv = 0;
-                err = e.what();
                 failed = true;
               }
             }
-            ParamConverter<lwc::AT_REAL>::PostCallArray(ad, cArg, sad, L, firstArg, nargs, kwargs, oldLuaArg, arraySizes, ary, rv, failed);
+            ParamConverter<lwc::AT_REAL>::PostCallArray(ad, cArg, sad, L, firstArg, nargs, kwargs[cArg], oldLuaArg, arraySizes, ary, rv, failed);
             
           } else {
             failed = true;
@@ -231,27 +236,22 @@ int CallMethod(lwc::Object *o, const char *n,
           
         } else {
           lwc::Real val;
-          if (ParamConverter<lwc::AT_REAL>::PreCall(ad, cArg, L, firstArg, nargs, kwargs, luaArg, arraySizes, val, err)) {
-            try {
-              if (ad.getDir() == lwc::AD_IN) {
-                params.set(cArg, val, false);
-              } else {
-                params.set(cArg, &val, false);
-              }
-            } catch (std::exception &e) {
-              err = e.what();
-              failed = true;
+          if (ParamConverter<lwc::AT_REAL>::PreCall(ad, cArg, L, firstArg, nargs, kwargs[cArg], luaArg, arraySizes, val, err)) {
+            if (ad.getDir() == lwc::AD_IN) {
+              failed = !params.trySet(cArg, val, status, false);
+            } else {
+              failed = !params.trySet(cArg, &val, status, false);
             }
-            if (!failed) {
-              try {
-                rv = CallMethod(o, n, params, cArg+1, L, firstArg, nargs, kwargs, luaArg, arraySizes);
-              } catch (std::exception &e) {
+            if (failed) {
+              status.setMethodName(n);
+            } else {
+              rv = CallMethod(o, n, params, cArg+1, L, firstArg, nargs, kwargs, luaArg, arraySizes, status);
+              if (rv == BAD_METHOD_CALL) {
                 rv = 0;
-                err = e.what();
                 failed = true;
               }
             }
-            ParamConverter<lwc::AT_REAL>::PostCall(ad, cArg, L, firstArg, nargs, kwargs, oldLuaArg, arraySizes, val, rv, failed);
+            ParamConverter<lwc::AT_REAL>::PostCall(ad, cArg, L, firstArg, nargs, kwargs[cArg], oldLuaArg, arraySizes, val, rv, failed);
             
           } else {
             failed = true;
@@ -263,27 +263,22 @@ int CallMethod(lwc::Object *o, const char *n,
         if (ad.isArray()) {
           char **ary=0;
           const lwc::Argument &sad = m[ad.arraySizeArg()];
-          if (ParamConverter<lwc::AT_STRING>::PreCallArray(ad, cArg, sad, L, firstArg, nargs, kwargs, luaArg, arraySizes, ary, err)) {
-            try {
-              if (ad.getDir() == lwc::AD_IN) {
-                params.set(cArg, ary, false);
-              } else {
-                params.set(cArg, &ary, false);
-              }
-            } catch (std::exception &e) {
-              err = e.what();
-              failed = true;
+          if (ParamConverter<lwc::AT_STRING>::PreCallArray(ad, cArg, sad, L, firstArg, nargs, kwargs[cArg], luaArg, arraySizes, ary, err)) {
+            if (ad.getDir() == lwc::AD_IN) {
+              failed = !params.trySet(cArg, ary, status, false);
+            } else {
+              failed = !params.trySet(cArg, &ary, status, false);
             }
-            if (!failed) {
-              try {
-                rv = CallMethod(o, n, params, cArg+1, L, firstArg, nargs, kwargs, luaArg, arraySizes);
-              } catch (std::exception &e) {
+            if (failed) {
+              status.setMethodName(n);
+            } else {
+              rv = CallMethod(o, n, params, cArg+1, L, firstArg, nargs, kwargs, luaArg, arraySizes, status);
+              if (rv == BAD_METHOD_CALL) {
                 rv = 0;
-                err = e.what();
                 failed = true;
               }
             }
-            ParamConverter<lwc::AT_STRING>::PostCallArray(ad, cArg, sad, L, firstArg, nargs, kwargs, oldLuaArg, arraySizes, ary, rv, failed);
+            ParamConverter<lwc::AT_STRING>::PostCallArray(ad, cArg, sad, L, firstArg, nargs, kwargs[cArg], oldLuaArg, arraySizes, ary, rv, failed);
             
           } else {
             failed = true;
@@ -291,27 +286,22 @@ int CallMethod(lwc::Object *o, const char *n,
           
         } else {
           char *val;
-          if (ParamConverter<lwc::AT_STRING>::PreCall(ad, cArg, L, firstArg, nargs, kwargs, luaArg, arraySizes, val, err)) {
-            try {
-              if (ad.getDir() == lwc::AD_IN) {
-                params.set(cArg, val, false);
-              } else {
-                params.set(cArg, &val, false);
-              }
-            } catch (std::exception &e) {
-              err = e.what();
-              failed = true;
+          if (ParamConverter<lwc::AT_STRING>::PreCall(ad, cArg, L, firstArg, nargs, kwargs[cArg], luaArg, arraySizes, val, err)) {
+            if (ad.getDir() == lwc::AD_IN) {
+              failed = !params.trySet(cArg, val, status, false);
+            } else {
+              failed = !params.trySet(cArg, &val, status, false);
             }
-            if (!failed) {
-              try {
-                rv = CallMethod(o, n, params, cArg+1, L, firstArg, nargs, kwargs, luaArg, arraySizes);
-              } catch (std::exception &e) {
+            if (failed) {
+              status.setMethodName(n);
+            } else {
+              rv = CallMethod(o, n, params, cArg+1, L, firstArg, nargs, kwargs, luaArg, arraySizes, status);
+              if (rv == BAD_METHOD_CALL) {
                 rv = 0;
-                err = e.what();
                 failed = true;
               }
             }
-            ParamConverter<lwc::AT_STRING>::PostCall(ad, cArg, L, firstArg, nargs, kwargs, oldLuaArg, arraySizes, val, rv, failed);
+            ParamConverter<lwc::AT_STRING>::PostCall(ad, cArg, L, firstArg, nargs, kwargs[cArg], oldLuaArg, arraySizes, val, rv, failed);
             
           } else {
             failed = true;
@@ -323,27 +313,22 @@ int CallMethod(lwc::Object *o, const char *n,
         if (ad.isArray()) {
           lwc::Object **ary=0;
           const lwc::Argument &sad = m[ad.arraySizeArg()];
-          if (ParamConverter<lwc::AT_OBJECT>::PreCallArray(ad, cArg, sad, L, firstArg, nargs, kwargs, luaArg, arraySizes, ary, err)) {
-            try {
-              if (ad.getDir() == lwc::AD_IN) {
-                params.set(cArg, ary, false);
-              } else {
-                params.set(cArg, &ary, false);
-              }
-            } catch (std::exception &e) {
-              err = e.what();
-              failed = true;
+          if (ParamConverter<lwc::AT_OBJECT>::PreCallArray(ad, cArg, sad, L, firstArg, nargs, kwargs[cArg], luaArg, arraySizes, ary, err)) {
+            if (ad.getDir() == lwc::AD_IN) {
+              failed = !params.trySet(cArg, ary, status, false);
+            } else {
+              failed = !params.trySet(cArg, &ary, status, false);
             }
-            if (!failed) {
-              try {
-                rv = CallMethod(o, n, params, cArg+1, L, firstArg, nargs, kwargs, luaArg, arraySizes);
-              } catch (std::exception &e) {
+            if (failed) {
+              status.setMethodName(n);
+            } else {
+              rv = CallMethod(o, n, params, cArg+1, L, firstArg, nargs, kwargs, luaArg, arraySizes, status);
+              if (rv == BAD_METHOD_CALL) {
                 rv = 0;
-                err = e.what();
                 failed = true;
               }
             }
-            ParamConverter<lwc::AT_OBJECT>::PostCallArray(ad, cArg, sad, L, firstArg, nargs, kwargs, oldLuaArg, arraySizes, ary, rv, failed);
+            ParamConverter<lwc::AT_OBJECT>::PostCallArray(ad, cArg, sad, L, firstArg, nargs, kwargs[cArg], oldLuaArg, arraySizes, ary, rv, failed);
             
           } else {
             failed = true;
@@ -351,27 +336,22 @@ int CallMethod(lwc::Object *o, const char *n,
           
         } else {
           lwc::Object *val;
-          if (ParamConverter<lwc::AT_OBJECT>::PreCall(ad, cArg, L, firstArg, nargs, kwargs, luaArg, arraySizes, val, err)) {
-            try {
-              if (ad.getDir() == lwc::AD_IN) {
-                params.set(cArg, val, false);
-              } else {
-                params.set(cArg, &val, false);
-              }
-            } catch (std::exception &e) {
-              err = e.what();
-              failed = true;
+          if (ParamConverter<lwc::AT_OBJECT>::PreCall(ad, cArg, L, firstArg, nargs, kwargs[cArg], luaArg, arraySizes, val, err)) {
+            if (ad.getDir() == lwc::AD_IN) {
+              failed = !params.trySet(cArg, val, status, false);
+            } else {
+              failed = !params.trySet(cArg, &val, status, false);
             }
-            if (!failed) {
-              try {
-                rv = CallMethod(o, n, params, cArg+1, L, firstArg, nargs, kwargs, luaArg, arraySizes);
-              } catch (std::exception &e) {
+            if (failed) {
+              status.setMethodName(n);
+            } else {
+              rv = CallMethod(o, n, params, cArg+1, L, firstArg, nargs, kwargs, luaArg, arraySizes, status);
+              if (rv == BAD_METHOD_CALL) {
                 rv = 0;
-                err = e.what();
                 failed = true;
               }
             }
-            ParamConverter<lwc::AT_OBJECT>::PostCall(ad, cArg, L, firstArg, nargs, kwargs, oldLuaArg, arraySizes, val, rv, failed);
+            ParamConverter<lwc::AT_OBJECT>::PostCall(ad, cArg, L, firstArg, nargs, kwargs[cArg], oldLuaArg, arraySizes, val, rv, failed);
             
           } else {
             failed = true;
@@ -388,17 +368,11 @@ int CallMethod(lwc::Object *o, const char *n,
     }
     
     if (failed) {
-      // should I throw exception if not final call [cArg == 0]
-      // -> yes because we want all calls to CallMethod in recursion chain to have
-      //    a chance to free its convertion values
-      if (cArg == 0) {
-        lua_pushstring(L, err.c_str());
-        lua_error(L);
-        return BAD_METHOD_CALL;
-        
-      } else {
-        throw std::runtime_error(err.c_str());
+      // conversion errors are only known at this level
+      if (status.succeeded()) {
+        status.setFailed(n, err.c_str());
       }
+      return CallFailed(L, cArg, status);
     }
     
     if (cArg == 0) {
@@ -426,4 +400,102 @@ int CallMethod(lwc::Object *o, const char *n,
   }
 }
 
+// Errors are pushed and reported with MarshalTraits::Error so that lua_error
+// does not skip the destructors of this frame (see CallMethod below)
+static int TryCallMethod(lwc::Object *o, const lwc::MethodsTable *methods, const char *mn,
+                         lwc::CallSiteCache &sites, lua_State *L, int firstArg) {
+  
+  try {
+    std::map<size_t, size_t> arraySizes;
+    
+    size_t nargs = lua_gettop(L) - firstArg + 1;
+    
+    // sorted keyword names and stack index of their values
+    const char *names[LWC_MAX_ARGS];
+    int values[LWC_MAX_ARGS];
+    size_t nkw = 0;
+    
+    if (nargs > 0 && lua_istable(L, -1)) {
+      // last arg is a table with string keys only -> keyword args
+      // values are left on the stack, above the table
+      int kwtable = lua_gettop(L);
+      bool keywords = true;
+      lua_checkstack(L, LWC_MAX_ARGS + 2);
+      lua_pushnil(L);
+      while (lua_next(L, kwtable) != 0) {
+        if (lua_type(L, -2) != LUA_TSTRING || nkw >= LWC_MAX_ARGS) {
+          keywords = false;
+          break;
+        }
+        lua_insert(L, -2);
+        const char *name = lua_tostring(L, -1);
+        size_t i = nkw++;
+        while (i > 0 && strcmp(names[i-1], name) > 0) {
+          names[i] = names[i-1];
+          values[i] = values[i-1];
+          --i;
+        }
+        names[i] = name;
+        values[i] = lua_gettop(L) - 1;
+      }
+      if (keywords) {
+        nargs -= 1;
+      } else {
+        // array argument
+        lua_settop(L, kwtable);
+        nkw = 0;
+      }
+    }
+    
+    lwc::Status status;
+    
+    const lwc::CallSite *site = sites.get(methods, mn, nargs, names, nkw,
+                                          lwc::CallSite::CSB_SCRIPT, status);
+    if (!site) {
+      lua_pushstring(L, status.getMessage().c_str());
+      return MarshalTraits::Error;
+    }
+    
+    int kwargs[LWC_MAX_ARGS];
+    memset(kwargs, 0, LWC_MAX_ARGS * sizeof(int));
+    for (size_t k=0; k<nkw; ++k) {
+      kwargs[site->getKeywordSlot(k)] = values[k];
+    }
+    
+    lwc::MethodParams params(site->getHandle().getMethod());
+    
+    if (nkw == 0) {
+      // common signatures skip the generic conversion
+      lwc::Marshal<MarshalTraits>::Stub stub = lwc::Marshal<MarshalTraits>::Find(params.getMethod());
+      MarshalArgs margs = {L, firstArg, nargs};
+      int nret = 0;
+      if (stub && stub(o, mn, params, margs, status, nret)) {
+        return nret;
+      }
+    }
+    
+    int rv = CallMethod(o, mn, params, 0, L, firstArg, nargs, kwargs, 0, arraySizes, status);
+    
+    if (rv == NO_RETVAL) {
+      return 0;
+      
+    } else {
+      // lua does not auto expand array as return value
+      //return 1;
+      return rv;
+    }
+  
+  } catch (std::exception &e) {
+  
+    lua_pushstring(L, e.what());
+    return MarshalTraits::Error;
+  }
+}
+
+int CallMethod(lwc::Object *o, const lwc::MethodsTable *methods, const char *mn,
+               lwc::CallSiteCache &sites, lua_State *L, int firstArg) {
+  int rv = TryCallMethod(o, methods, mn, sites, L, firstArg);
+  return (rv == MarshalTraits::Error ? lua_error(L) : rv);
+}
+
 }
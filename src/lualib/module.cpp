@@ -44,6 +44,9 @@ static void InitEnumConstants() {
   EnumConstants["AD_IN"] = lwc::AD_IN;
   EnumConstants["AD_INOUT"] = lwc::AD_INOUT;
   EnumConstants["AD_OUT"] = lwc::AD_OUT;
+  EnumConstants["AD_RETURN"] = lwc::AD_RETURN;
+  EnumConstants["MF_NONE"] = lwc::MF_NONE;
+  EnumConstants["MF_PURE"] = lwc::MF_PURE;
 }
 
 // ---
@@ -110,6 +113,16 @@ int CreateModule(lua_State *L) {
     return 0;
   }
   
+  if (!InitCommandBuffer(L, module)) {
+    lua_pop(L, 1);
+    return 0;
+  }
+  
+  if (!InitSignalQueue(L, module)) {
+    lua_pop(L, 1);
+    return 0;
+  }
+  
   if (!InitRegistry(L, module)) {
     lua_pop(L, 1);
     return 0;
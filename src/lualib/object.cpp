@@ -23,6 +23,7 @@ USA.
 
 #include <lwc/lua/types.h>
 #include <lwc/lua/methodcall.h>
+#include <lwc/lua/convert.h>
 
 namespace lua {
 
@@ -63,6 +64,10 @@ int LuaObject::Wrap(lua_State *L, lwc::Object *o) {
 }
 
 lwc::Object* LuaObject::UnWrap(lua_State *L, int narg, bool upValue) {
+  return UnWrapObject(L, narg, upValue)->obj;
+}
+
+LuaObject* LuaObject::UnWrapObject(lua_State *L, int narg, bool upValue) {
   int idx = (upValue ? lua_upvalueindex(narg) : narg);
   int top = lua_gettop(L);
   if (lua_istable(L, idx)) {
@@ -82,7 +87,7 @@ lwc::Object* LuaObject::UnWrap(lua_State *L, int narg, bool upValue) {
     luaL_typerror(L, narg, "llwc.Object");
   }
   lua_settop(L, top);
-  return ((LuaObject*) p)->obj;
+  return (LuaObject*) p;
 }
 
 int LuaObject::Del(lua_State *L) {
@@ -178,6 +183,33 @@ static int luaobj_getTypeName(lua_State *L) {
   }
 }
 
+static int luaobj_invalidateResults(lua_State *L) {
+  CheckArgCount(L, 1);
+  lwc::Object *o = LuaObject::UnWrap(L, 1);
+  if (!o) {
+    lua_pushstring(L, "llwc.Object: not underlying object");
+    return lua_error(L);
+  }
+  lua_pop(L, 1);
+  o->invalidateResults();
+  return 0;
+}
+
+static int luaobj_getResultStats(lua_State *L) {
+  CheckArgCount(L, 1);
+  lwc::Object *o = LuaObject::UnWrap(L, 1);
+  if (!o) {
+    lua_pushstring(L, "llwc.Object: not underlying object");
+    return lua_error(L);
+  }
+  lua_pop(L, 1);
+  unsigned long hits = 0, misses = 0;
+  o->getResultStats(hits, misses);
+  lua_pushinteger(L, lua_Integer(hits));
+  lua_pushinteger(L, lua_Integer(misses));
+  return 2;
+}
+
 static int luaobj_getLoaderName(lua_State *L) {
   CheckArgCount(L, 1);
   lwc::Object *o = LuaObject::UnWrap(L, 1);
@@ -216,39 +248,128 @@ static int luaobj_availableMethods(lua_State *L) {
   return 1;
 }
 
+// Signals: listeners (and queues) must be kept alive while connected
+
+static int luaobj_availableSignals(lua_State *L) {
+  CheckArgCount(L, 1);
+  lwc::Object *o = LuaObject::UnWrap(L, 1);
+  if (!o) {
+    lua_pushstring(L, "llwc.Object: not underlying object");
+    return lua_error(L);
+  }
+  lua_pop(L, 1);
+  std::vector<std::string> names;
+  if (o->getMethods()) {
+    o->getMethods()->availableSignals(names);
+  }
+  lua_newtable(L);
+  for (size_t i=0; i<names.size(); ++i) {
+    lua_pushinteger(L, i+1);
+    lua_pushstring(L, names[i].c_str());
+    lua_settable(L, -3);
+  }
+  return 1;
+}
+
+// args: signal name, listener, slot name [, queue]
+static int luaobj_connect(lua_State *L) {
+  int n = lua_gettop(L);
+  if (n != 4 && n != 5) {
+    lua_pushstring(L, "llwc.Object.connect: expected signal, listener, slot and optional queue");
+    return lua_error(L);
+  }
+  lwc::Object *o = LuaObject::UnWrap(L, 1);
+  lwc::Object *listener = LuaObject::UnWrap(L, 3);
+  if (!o || !listener) {
+    lua_pushstring(L, "llwc.Object: not underlying object");
+    return lua_error(L);
+  }
+  const char *signal = luaL_checkstring(L, 2);
+  const char *slot = luaL_checkstring(L, 4);
+  lwc::SignalQueue *queue = ((n == 5 && !lua_isnil(L, 5)) ? LuaSignalQueue::UnWrap(L, 5) : 0);
+  try {
+    o->connect(signal, listener, slot, queue);
+  } catch (std::exception &e) {
+    lua_pushstring(L, e.what());
+    return lua_error(L);
+  }
+  lua_settop(L, 0);
+  return 0;
+}
+
+// args: signal name, listener [, slot name], returns the number of
+// connections removed
+static int luaobj_disconnect(lua_State *L) {
+  int n = lua_gettop(L);
+  if (n != 3 && n != 4) {
+    lua_pushstring(L, "llwc.Object.disconnect: expected signal, listener and optional slot");
+    return lua_error(L);
+  }
+  lwc::Object *o = LuaObject::UnWrap(L, 1);
+  lwc::Object *listener = LuaObject::UnWrap(L, 3);
+  if (!o || !listener) {
+    lua_pushstring(L, "llwc.Object: not underlying object");
+    return lua_error(L);
+  }
+  const char *signal = luaL_checkstring(L, 2);
+  const char *slot = ((n == 4 && !lua_isnil(L, 4)) ? luaL_checkstring(L, 4) : 0);
+  size_t count = o->disconnect(signal, listener, slot);
+  lua_settop(L, 0);
+  lua_pushinteger(L, lua_Integer(count));
+  return 1;
+}
+
+// args: signal name, signal arguments...
+static int luaobj_emit(lua_State *L) {
+  lwc::Object *o = LuaObject::UnWrap(L, 1);
+  if (!o) {
+    lua_pushstring(L, "llwc.Object: not underlying object");
+    return lua_error(L);
+  }
+  const char *signal = luaL_checkstring(L, 2);
+  MarshalArgs args = {L, 3, size_t(lua_gettop(L) - 2)};
+  bool failed = false;
+  {
+    lwc::Status status = lwc::SignalBridge<MarshalTraits>::Emit(o, signal, args, 0);
+    if (status.failed()) {
+      lua_pushstring(L, status.getMessage().c_str());
+      failed = true;
+    }
+  }
+  if (failed) {
+    return lua_error(L);
+  }
+  lua_settop(L, 0);
+  return 0;
+}
+
 static int luaobj_call(lua_State *L) {
   int idx = lua_upvalueindex(1);
   const char *mn = lua_tostring(L, idx);
   
-  try {
-    std::map<size_t, size_t> arraySizes;
-    
-    lwc::Object *o = LuaObject::UnWrap(L, 1);
-    lwc::MethodParams params(o->getMethod(mn));
-    size_t nargs = lua_gettop(L) - 1;
-    
-    int kwargs = 0;
-    if (nargs > 0 && lua_istable(L, -1)) {
-      // last arg is a table -> keyword args
-      nargs -= 1;
-      kwargs = lua_gettop(L);
-    }
-  
-    int rv = CallMethod(o, mn, params, 0, L, 2, nargs, kwargs, 0, arraySizes);
-    
-    if (rv == NO_RETVAL) {
-      return 0;
-      
-    } else {
-      // lua does not auto expand array as return value
-      //return 1;
-      return rv;
-    }
+  LuaObject *lo = LuaObject::UnWrapObject(L, 1);
   
+  return CallMethod(lo->obj, lo->obj->getMethods(), mn, lo->sites, L, 2);
+}
+
+// Errors are pushed, the caller raises them outside of the catch block
+static bool ReadProperty(lua_State *L, lwc::Object *o, const lwc::Property *prop, lwc::ArgumentValue &v) {
+  try {
+    o->readProperty(*prop, v);
+    return true;
   } catch (std::exception &e) {
-  
     lua_pushstring(L, e.what());
-    return lua_error(L);
+    return false;
+  }
+}
+
+static bool WriteProperty(lua_State *L, lwc::Object *o, const lwc::Property *prop, const lwc::ArgumentValue &v, bool &written) {
+  try {
+    written = o->writeProperty(*prop, v);
+    return true;
+  } catch (std::exception &e) {
+    lua_pushstring(L, e.what());
+    return false;
   }
 }
 
@@ -263,6 +384,26 @@ static int luaobj_index(lua_State *L) {
   
   const char *mn = lua_tostring(L, 2);
   
+  // properties are read straight from the object (see Object::readProperty)
+  const lwc::Property *prop = (mn ? o->findProperty(mn) : 0);
+  if (prop) {
+    lwc::ArgumentValue v;
+    if (!ReadProperty(L, o, prop, v)) {
+      return lua_error(L);
+    }
+    switch (prop->getType()) {
+      case lwc::AT_BOOL:
+        lua_pushboolean(L, v.boolean ? 1 : 0);
+        break;
+      case lwc::AT_INT:
+        lua_pushinteger(L, lua_Integer(v.integer));
+        break;
+      default:
+        lua_pushnumber(L, lua_Number(v.real));
+    }
+    return 1;
+  }
+  
   //lua_getmetatable(L, 1);
   lua_getfield(L, LUA_REGISTRYINDEX, LuaObject::RegistryKey());
   lua_pushvalue(L, 2);
@@ -278,6 +419,57 @@ static int luaobj_index(lua_State *L) {
   }
 }
 
+static int luaobj_newindex(lua_State *L) {
+  CheckArgCount(L, 3);
+  
+  lwc::Object *o = LuaObject::UnWrap(L, 1);
+  if (!o) {
+    lua_pushstring(L, "llwc.Object: no underlying object");
+    return lua_error(L);
+  }
+  
+  const char *pn = lua_tostring(L, 2);
+  
+  const lwc::Property *prop = (pn ? o->findProperty(pn) : 0);
+  if (!prop) {
+    lua_pushfstring(L, "llwc.Object: no property named \"%s\"", (pn ? pn : "?"));
+    return lua_error(L);
+  }
+  
+  lwc::ArgumentValue v;
+  switch (prop->getType()) {
+    case lwc::AT_BOOL:
+      if (!lua_isboolean(L, 3)) {
+        return luaL_typerror(L, 3, "boolean");
+      }
+      v.boolean = (lua_toboolean(L, 3) != 0);
+      break;
+    case lwc::AT_INT:
+      if (!lua_isnumber(L, 3)) {
+        return luaL_typerror(L, 3, "number");
+      }
+      v.integer = lwc::Integer(lua_tointeger(L, 3));
+      break;
+    default:
+      if (!lua_isnumber(L, 3)) {
+        return luaL_typerror(L, 3, "number");
+      }
+      v.real = lwc::Real(lua_tonumber(L, 3));
+  }
+  
+  bool written = false;
+  if (!WriteProperty(L, o, prop, v, written)) {
+    return lua_error(L);
+  }
+  if (!written) {
+    lua_pushfstring(L, "llwc.Object: property \"%s\" is read only", pn);
+    return lua_error(L);
+  }
+  
+  lua_pop(L, 3);
+  return 0;
+}
+
 // ---
 
 bool InitObject(lua_State *L, int module) {
@@ -287,6 +479,8 @@ bool InitObject(lua_State *L, int module) {
   
   lua_pushcfunction(L, luaobj_index);
   lua_setfield(L, klass, "__index");
+  lua_pushcfunction(L, luaobj_newindex);
+  lua_setfield(L, klass, "__newindex");
   lua_pushcfunction(L, luaobj_new);
   lua_setfield(L, klass, "new");
   lua_pushcfunction(L, luaobj_del);
@@ -301,8 +495,20 @@ bool InitObject(lua_State *L, int module) {
   lua_setfield(L, klass, "getLoaderName");
   lua_pushcfunction(L, luaobj_getTypeName);
   lua_setfield(L, klass, "getTypeName");
+  lua_pushcfunction(L, luaobj_invalidateResults);
+  lua_setfield(L, klass, "invalidateResults");
+  lua_pushcfunction(L, luaobj_getResultStats);
+  lua_setfield(L, klass, "getResultStats");
   lua_pushcfunction(L, luaobj_availableMethods);
   lua_setfield(L, klass, "availableMethods");
+  lua_pushcfunction(L, luaobj_availableSignals);
+  lua_setfield(L, klass, "availableSignals");
+  lua_pushcfunction(L, luaobj_connect);
+  lua_setfield(L, klass, "connect");
+  lua_pushcfunction(L, luaobj_disconnect);
+  lua_setfield(L, klass, "disconnect");
+  lua_pushcfunction(L, luaobj_emit);
+  lua_setfield(L, klass, "emit");
   
   lua_pushvalue(L, klass);
   lua_setfield(L, LUA_REGISTRYINDEX, LuaObject::RegistryKey());
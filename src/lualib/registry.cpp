@@ -22,6 +22,7 @@ USA.
 */
 
 #include <lwc/lua/types.h>
+#include <lwc/lua/methodcall.h>
 
 namespace lua {
 
@@ -357,6 +358,104 @@ static int luareg_addModulePath(lua_State *L) {
   return 0;
 }
 
+static int luareg_broadcast(lua_State *L) {
+  if (lua_gettop(L) < 3) {
+    lua_pushstring(L, "llwc.Registry.broadcast: expected objects table and method name");
+    return lua_error(L);
+  }
+  lwc::Registry *reg = LuaRegistry::UnWrap(L, 1);
+  if (!reg) {
+    reg = lwc::Registry::Instance();
+    if (!reg) {
+      lua_pushstring(L, "llwc.Registry has not been initialized");
+      return lua_error(L);
+    }
+  }
+  if (!lua_istable(L, 2)) {
+    return luaL_typerror(L, 2, "table");
+  }
+  if (!lua_isstring(L, 3)) {
+    return luaL_typerror(L, 3, "string");
+  }
+  const char *mn = lua_tostring(L, 3);
+  size_t n = lua_objlen(L, 2);
+  if (n == 0) {
+    return 0;
+  }
+  std::vector<lwc::Object*> objects(n, 0);
+  for (size_t i=0; i<n; ++i) {
+    lua_rawgeti(L, 2, int(i + 1));
+    objects[i] = LuaObject::UnWrap(L, lua_gettop(L));
+    lua_pop(L, 1);
+  }
+  lwc::parallel::Broadcast target(reg->getExecutor(), &objects[0], n);
+  lwc::CallSiteCache sites(1);
+  // method arguments are built as for a call on the first object
+  return CallMethod(&target, objects[0]->getMethods(), mn, sites, L, 4);
+}
+
+static int luareg_setPool(lua_State *L) {
+  if (lua_gettop(L) < 3 || lua_gettop(L) > 4) {
+    lua_pushstring(L, "llwc.Registry.setPool: expected type name, maximum size and optional warm-up count");
+    return lua_error(L);
+  }
+  lwc::Registry *reg = LuaRegistry::UnWrap(L, 1);
+  if (!reg) {
+    reg = lwc::Registry::Instance();
+    if (!reg) {
+      lua_pushstring(L, "llwc.Registry has not been initialized");
+      return lua_error(L);
+    }
+  }
+  const char *t = luaL_checkstring(L, 2);
+  int maxSize = luaL_checkint(L, 3);
+  int warmUp = (lua_gettop(L) == 4 ? luaL_checkint(L, 4) : 0);
+  if (maxSize < 0 || warmUp < 0) {
+    lua_pushstring(L, "llwc.Registry.setPool: sizes must be positive");
+    return lua_error(L);
+  }
+  bool rv = reg->setPool(t, size_t(maxSize), size_t(warmUp));
+  lua_settop(L, 0);
+  lua_pushboolean(L, (rv ? 1 : 0));
+  return 1;
+}
+
+static int luareg_getPoolStats(lua_State *L) {
+  CheckArgCount(L, 2);
+  lwc::Registry *reg = LuaRegistry::UnWrap(L, 1);
+  if (!reg) {
+    reg = lwc::Registry::Instance();
+    if (!reg) {
+      lua_pushstring(L, "llwc.Registry has not been initialized");
+      return lua_error(L);
+    }
+  }
+  if (!lua_isstring(L, 2)) {
+    return luaL_typerror(L, 2, "string");
+  }
+  lwc::PoolStats stats;
+  bool found = reg->getPoolStats(lua_tostring(L, 2), stats);
+  lua_pop(L, 2);
+  if (!found) {
+    lua_pushnil(L);
+    return 1;
+  }
+  lua_newtable(L);
+  lua_pushinteger(L, lua_Integer(stats.size));
+  lua_setfield(L, -2, "size");
+  lua_pushinteger(L, lua_Integer(stats.maxSize));
+  lua_setfield(L, -2, "maxSize");
+  lua_pushinteger(L, lua_Integer(stats.reused));
+  lua_setfield(L, -2, "reused");
+  lua_pushinteger(L, lua_Integer(stats.allocated));
+  lua_setfield(L, -2, "allocated");
+  lua_pushinteger(L, lua_Integer(stats.recycled));
+  lua_setfield(L, -2, "recycled");
+  lua_pushinteger(L, lua_Integer(stats.discarded));
+  lua_setfield(L, -2, "discarded");
+  return 1;
+}
+
 // ---
 
 bool InitRegistry(lua_State *L, int module) {
@@ -393,6 +492,12 @@ bool InitRegistry(lua_State *L, int module) {
   lua_setfield(L, klass, "get");
   lua_pushcfunction(L, luareg_destroy);
   lua_setfield(L, klass, "destroy");
+  lua_pushcfunction(L, luareg_broadcast);
+  lua_setfield(L, klass, "broadcast");
+  lua_pushcfunction(L, luareg_setPool);
+  lua_setfield(L, klass, "setPool");
+  lua_pushcfunction(L, luareg_getPoolStats);
+  lua_setfield(L, klass, "getPoolStats");
   
   lua_pushvalue(L, klass);
   lua_setfield(L, LUA_REGISTRYINDEX, LuaRegistry::RegistryKey());
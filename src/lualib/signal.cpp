@@ -0,0 +1,177 @@
+/*
+
+Copyright (C) 2009, 2010  Gaetan Guidet
+
+This file is part of lwc.
+
+lwc is free software; you can redistribute it and/or modify it
+under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 2.1 of the License, or (at
+your option) any later version.
+
+lwc is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+USA.
+
+*/
+
+#include <lwc/lua/types.h>
+
+namespace lua {
+
+LuaSignalQueue::LuaSignalQueue(size_t capacity)
+  : queue(new lwc::SignalQueue(capacity)) {
+}
+
+LuaSignalQueue::~LuaSignalQueue() {
+  delete queue;
+}
+
+size_t LuaSignalQueue::AllocSize() {
+  return (sizeof(LuaSignalQueue));
+}
+
+const char* LuaSignalQueue::RegistryKey() {
+  return "__lwc_lua_signalqueue";
+}
+
+int LuaSignalQueue::New(lua_State *L) {
+  size_t capacity = 1024;
+  if (lua_gettop(L) >= 1) {
+    int n = luaL_checkint(L, 1);
+    if (n <= 0) {
+      lua_pushstring(L, "llwc.SignalQueue: capacity must be positive");
+      return lua_error(L);
+    }
+    capacity = size_t(n);
+  }
+  lua_settop(L, 0);
+  void *ud = lua_newuserdata(L, LuaSignalQueue::AllocSize());
+  new (ud) LuaSignalQueue(capacity);
+  lua_getfield(L, LUA_REGISTRYINDEX, LuaSignalQueue::RegistryKey());
+  lua_setmetatable(L, -2);
+  return 1;
+}
+
+lwc::SignalQueue* LuaSignalQueue::UnWrap(lua_State *L, int narg, bool upValue) {
+  int idx = (upValue ? lua_upvalueindex(narg) : narg);
+  void *p = lua_touserdata(L, idx);
+  if (!p) {
+    luaL_typerror(L, narg, "llwc.SignalQueue");
+  }
+  lua_getfield(L, LUA_REGISTRYINDEX, LuaSignalQueue::RegistryKey());
+  if (!lua_getmetatable(L, idx) || !lua_rawequal(L, -1, -2)) {
+    luaL_typerror(L, narg, "llwc.SignalQueue");
+  }
+  lua_pop(L, 2);
+  return ((LuaSignalQueue*) p)->queue;
+}
+
+int LuaSignalQueue::Del(lua_State *L) {
+  CheckArgCount(L, 1);
+  void *ud = lua_touserdata(L, 1);
+  ((LuaSignalQueue*)ud)->~LuaSignalQueue();
+  lua_pop(L, 1);
+  return 0;
+}
+
+// ---
+
+static int luasigqueue_new(lua_State *L) {
+  return LuaSignalQueue::New(L);
+}
+
+static int luasigqueue_del(lua_State *L) {
+  return LuaSignalQueue::Del(L);
+}
+
+// optional maximum number of events, all by default
+static int luasigqueue_process(lua_State *L) {
+  lwc::SignalQueue *queue = LuaSignalQueue::UnWrap(L, 1);
+  size_t maxEvents = 0;
+  if (lua_gettop(L) >= 2) {
+    int n = luaL_checkint(L, 2);
+    maxEvents = (n > 0 ? size_t(n) : 0);
+  }
+  lua_settop(L, 0);
+  lua_pushinteger(L, lua_Integer(queue->process(maxEvents)));
+  return 1;
+}
+
+static int luasigqueue_depth(lua_State *L) {
+  CheckArgCount(L, 1);
+  lwc::SignalQueue *queue = LuaSignalQueue::UnWrap(L, 1);
+  lua_pop(L, 1);
+  lua_pushinteger(L, lua_Integer(queue->depth()));
+  return 1;
+}
+
+static int luasigqueue_capacity(lua_State *L) {
+  CheckArgCount(L, 1);
+  lwc::SignalQueue *queue = LuaSignalQueue::UnWrap(L, 1);
+  lua_pop(L, 1);
+  lua_pushinteger(L, lua_Integer(queue->capacity()));
+  return 1;
+}
+
+static int luasigqueue_getStats(lua_State *L) {
+  CheckArgCount(L, 1);
+  lwc::SignalQueue *queue = LuaSignalQueue::UnWrap(L, 1);
+  lua_pop(L, 1);
+  lwc::SignalStats stats;
+  queue->getStats(stats);
+  lua_newtable(L);
+  lua_pushinteger(L, lua_Integer(stats.queued));
+  lua_setfield(L, -2, "queued");
+  lua_pushinteger(L, lua_Integer(stats.dropped));
+  lua_setfield(L, -2, "dropped");
+  lua_pushinteger(L, lua_Integer(stats.delivered));
+  lua_setfield(L, -2, "delivered");
+  lua_pushinteger(L, lua_Integer(stats.failed));
+  lua_setfield(L, -2, "failed");
+  lua_pushinteger(L, lua_Integer(stats.depth));
+  lua_setfield(L, -2, "depth");
+  lua_pushnumber(L, lua_Number(stats.totalLatency));
+  lua_setfield(L, -2, "totalLatency");
+  lua_pushnumber(L, lua_Number(stats.maxLatency));
+  lua_setfield(L, -2, "maxLatency");
+  return 1;
+}
+
+// ---
+
+bool InitSignalQueue(lua_State *L, int module) {
+  
+  lua_newtable(L);
+  int klass = lua_gettop(L);
+  
+  lua_pushvalue(L, klass);
+  lua_setfield(L, klass, "__index");
+  
+  lua_pushcfunction(L, luasigqueue_new);
+  lua_setfield(L, klass, "new");
+  lua_pushcfunction(L, luasigqueue_del);
+  lua_setfield(L, klass, "__gc");
+  lua_pushcfunction(L, luasigqueue_process);
+  lua_setfield(L, klass, "process");
+  lua_pushcfunction(L, luasigqueue_depth);
+  lua_setfield(L, klass, "depth");
+  lua_pushcfunction(L, luasigqueue_capacity);
+  lua_setfield(L, klass, "capacity");
+  lua_pushcfunction(L, luasigqueue_getStats);
+  lua_setfield(L, klass, "getStats");
+  
+  lua_pushvalue(L, klass);
+  lua_setfield(L, LUA_REGISTRYINDEX, LuaSignalQueue::RegistryKey());
+  lua_setfield(L, module, "SignalQueue");
+  
+  return true;
+}
+
+}
@@ -25,14 +25,16 @@ USA.
 #include <lwc/factory.h>
 #include <lwc/registry.h>
 #include <lwc/moduleutils.h>
+#include <lwc/signal.h>
+#include "box.h"
 
-class Box : public lwc::Object {
+class Box : public lwc::Object, public IBox {
   public:
     Box()
-      : lwc::Object(), mX(0), mY(0), mW(1), mH(1) {
+      : lwc::Object(), mX(0), mY(0), mW(1), mH(1), mContainsCalls(0) {
     }
     Box(const Box &rhs)
-      : lwc::Object(rhs), mX(rhs.mX), mY(rhs.mY), mW(rhs.mW), mH(rhs.mH) {
+      : lwc::Object(rhs), mX(rhs.mX), mY(rhs.mY), mW(rhs.mW), mH(rhs.mH), mContainsCalls(0) {
     }
     virtual ~Box() {
     }
@@ -65,24 +67,82 @@ class Box : public lwc::Object {
       std::cout << "  => {" << c[0] << ", " << c[1] << "}, " << n << ", normalize=" << normalize << ", scale=" << s << "}" << std::endl;
       mX = c[0];
       mY = c[1];
+      invalidateResults();
     }
-    void setX(lwc::MethodParams &p) {lwc::Integer x; p.get(0, x); mX = x;}
-    void setY(lwc::MethodParams &p) {lwc::Integer y; p.get(0, y); mY = y;}
-    void setWidth(lwc::MethodParams &p) {lwc::Integer w; p.get(0, w); mW = w;}
-    void setHeight(lwc::MethodParams &p) {lwc::Integer h; p.get(0, h); mH = h;}
-    
-    void getX(lwc::MethodParams &p) {lwc::Integer *x; p.get(0, x); *x = mX;}
-    void getY(lwc::MethodParams &p) {lwc::Integer *y; p.get(0, y); *y = mY;}
-    void getWidth(lwc::MethodParams &p) {lwc::Integer *w; p.get(0, w); *w =  mW;}
-    void getHeight(lwc::MethodParams &p) {lwc::Integer *h; p.get(0, h); *h = mH;}
+    void setX(lwc::MethodParams &p) {lwc::Integer x; p.get(0, x); mX = x; invalidateResults();}
+    void setY(lwc::MethodParams &p) {lwc::Integer y; p.get(0, y); mY = y; invalidateResults();}
+    void setWidth(lwc::MethodParams &p) {lwc::Integer w; p.get(0, w); mW = w; invalidateResults(); emit("resized", mW, mH);}
+    void setHeight(lwc::MethodParams &p) {lwc::Integer h; p.get(0, h); mH = h; invalidateResults(); emit("resized", mW, mH);}
+    
+    void getX(lwc::MethodParams &p) {p.setReturn(mX);}
+    void getY(lwc::MethodParams &p) {p.setReturn(mY);}
+    void getWidth(lwc::MethodParams &p) {p.setReturn(mW);}
+    void getHeight(lwc::MethodParams &p) {p.setReturn(mH);}
+    // pure: memoized until invalidateResults is called
+    void contains(lwc::MethodParams &p) {
+      lwc::Integer x, y;
+      bool *inside;
+      p.get(0, x);
+      p.get(1, y);
+      p.get(2, inside);
+      *inside = (x >= mX && x < mX + mW && y >= mY && y < mY + mH);
+      ++mContainsCalls;
+    }
+    
+    lwc::Integer containsCalls() const {return mContainsCalls;}
+    
+    // pooled instances (see Registry::setPool) start over as new boxes
+    virtual bool recycle() {mX = 0; mY = 0; mW = 1; mH = 1; mContainsCalls = 0; return true;}
+    
+    // auto bound (see LWC_AUTO_METHOD)
+    void move(lwc::Integer dx, lwc::Integer dy) {mX += dx; mY += dy; invalidateResults();}
+    lwc::Integer area() const {return mW * mH;}
+    void getSize(lwc::Integer *w, lwc::Integer *h) const {*w = mW; *h = mH;}
+    void grow(lwc::Integer &amount) {mW += amount; mH += amount; amount = mW * mH; invalidateResults();}
+    lwc::Integer measure(const char *text) const {return (text ? lwc::Integer(strlen(text)) : 0);}
+    // cpu bound (see asynchronous calls benchmark)
+    lwc::Integer sample(lwc::Integer n) const {
+      lwc::Integer hits = 0;
+      unsigned long seed = 1;
+      for (lwc::Integer i=0; i<n; ++i) {
+        seed = seed * 1103515245UL + 12345UL;
+        lwc::Integer x = lwc::Integer((seed >> 16) % 1024);
+        seed = seed * 1103515245UL + 12345UL;
+        lwc::Integer y = lwc::Integer((seed >> 16) % 1024);
+        hits += (x >= mX && x < mX + mW && y >= mY && y < mY + mH) ? 1 : 0;
+      }
+      return hits;
+    }
+    
+    void sum(lwc::MethodParams &p) {
+      lwc::Integer v, *total;
+      p.get(9, total);
+      *total = 0;
+      for (size_t i=0; i<9; ++i) {
+        p.get(i, v);
+        *total += v;
+      }
+    }
+    virtual lwc::Integer x() const {return mX;}
+    virtual lwc::Integer y() const {return mY;}
+    virtual lwc::Integer width() const {return mW;}
+    virtual lwc::Integer height() const {return mH;}
+    virtual void x(lwc::Integer v) {mX = v; invalidateResults();}
+    virtual void y(lwc::Integer v) {mY = v; invalidateResults();}
+    virtual void width(lwc::Integer v) {mW = v; invalidateResults();}
+    virtual void height(lwc::Integer v) {mH = v; invalidateResults();}
+    
     //void getX(lwc::MethodParams &p) {p.set(0, mX);}
     //void getY(lwc::MethodParams &p) {p.set(0, mY);}
     //void getWidth(lwc::MethodParams &p) {p.set(0, mW);}
     //void getHeight(lwc::MethodParams &p) {p.set(0, mH);}
+    
+    static lwc::PropertyDecl Properties[5];
   
   protected:
     
     lwc::Integer mX, mY, mW, mH;
+    lwc::Integer mContainsCalls;
 };
 
 class DoubleBox : public Box {
@@ -102,13 +162,22 @@ class DoubleBox : public Box {
       return *this;
     }
     
-    void setX(lwc::MethodParams &p) {lwc::Integer x; p.get(0, x); mX = 2*x;}
+    void setX(lwc::MethodParams &p) {lwc::Integer x; p.get(0, x); mX = 2*x; invalidateResults();}
+    
+    void setY(lwc::MethodParams &p) {lwc::Integer y; p.get(0, y); mY = 2*y; invalidateResults();}
     
-    void setY(lwc::MethodParams &p) {lwc::Integer y; p.get(0, y); mY = 2*y;}
+    void setWidth(lwc::MethodParams &p) {lwc::Integer w; p.get(0, w); mW = 2*w; invalidateResults(); emit("resized", mW, mH);}
     
-    void setWidth(lwc::MethodParams &p) {lwc::Integer w; p.get(0, w); mW = 2*w;}
+    void setHeight(lwc::MethodParams &p) {lwc::Integer h; p.get(0, h); mH = 2*h; invalidateResults(); emit("resized", mW, mH);}
     
-    void setHeight(lwc::MethodParams &p) {lwc::Integer h; p.get(0, h); mH = 2*h;}
+    virtual lwc::Integer x() const {return mX;}
+    virtual lwc::Integer y() const {return mY;}
+    virtual lwc::Integer width() const {return mW;}
+    virtual lwc::Integer height() const {return mH;}
+    virtual void x(lwc::Integer v) {mX = 2*v; invalidateResults();}
+    virtual void y(lwc::Integer v) {mY = 2*v; invalidateResults();}
+    virtual void width(lwc::Integer v) {mW = 2*v; invalidateResults();}
+    virtual void height(lwc::Integer v) {mH = 2*v; invalidateResults();}
     
     void toBox(lwc::MethodParams &p) {
       lwc::Object **b;
@@ -133,10 +202,29 @@ static lwc::MethodDecl BoxMethods[] = {
   {"setY", 1,      {{lwc::AD_IN,  lwc::AT_INT, -1, LWC_NODEF, NULL}}, LWC_METHOD(Box, setY), "Set box origin y coord"},
   {"setWidth", 1,  {{lwc::AD_IN,  lwc::AT_INT, -1, LWC_NODEF, NULL}}, LWC_METHOD(Box, setWidth), "Set box width"},
   {"setHeight", 1, {{lwc::AD_IN,  lwc::AT_INT, -1, LWC_NODEF, NULL}}, LWC_METHOD(Box, setHeight), "Set box height"},
-  {"getX", 1,      {{lwc::AD_OUT, lwc::AT_INT, -1, LWC_NODEF, NULL}}, LWC_METHOD(Box, getX), "Get box origin x coord"},
-  {"getY", 1,      {{lwc::AD_OUT, lwc::AT_INT, -1, LWC_NODEF, NULL}}, LWC_METHOD(Box, getY), "Get box origin y coord"},
-  {"getWidth", 1,  {{lwc::AD_OUT, lwc::AT_INT, -1, LWC_NODEF, NULL}}, LWC_METHOD(Box, getWidth), "Get box width"},
-  {"getHeight", 1, {{lwc::AD_OUT, lwc::AT_INT, -1, LWC_NODEF, NULL}}, LWC_METHOD(Box, getHeight), "Get box height"},
+  {"getX", 1,      {{lwc::AD_RETURN, lwc::AT_INT, -1, LWC_NODEF, NULL}}, LWC_METHOD(Box, getX), "Get box origin x coord"},
+  {"getY", 1,      {{lwc::AD_RETURN, lwc::AT_INT, -1, LWC_NODEF, NULL}}, LWC_METHOD(Box, getY), "Get box origin y coord"},
+  {"getWidth", 1,  {{lwc::AD_RETURN, lwc::AT_INT, -1, LWC_NODEF, NULL}}, LWC_METHOD(Box, getWidth), "Get box width"},
+  {"getHeight", 1, {{lwc::AD_RETURN, lwc::AT_INT, -1, LWC_NODEF, NULL}}, LWC_METHOD(Box, getHeight), "Get box height"},
+  {"contains", 3, {{lwc::AD_IN,  lwc::AT_INT,  -1, LWC_NODEF, NULL},
+                    {lwc::AD_IN,  lwc::AT_INT,  -1, LWC_NODEF, NULL},
+                    {lwc::AD_OUT, lwc::AT_BOOL, -1, LWC_NODEF, NULL}}, LWC_METHOD(Box, contains), "Check if point is inside box", lwc::MF_PURE},
+  {"sum", 10, {{lwc::AD_IN,  lwc::AT_INT, -1, LWC_NODEF, NULL},
+               {lwc::AD_IN,  lwc::AT_INT, -1, LWC_NODEF, NULL},
+               {lwc::AD_IN,  lwc::AT_INT, -1, LWC_NODEF, NULL},
+               {lwc::AD_IN,  lwc::AT_INT, -1, LWC_NODEF, NULL},
+               {lwc::AD_IN,  lwc::AT_INT, -1, LWC_NODEF, NULL},
+               {lwc::AD_IN,  lwc::AT_INT, -1, LWC_NODEF, NULL},
+               {lwc::AD_IN,  lwc::AT_INT, -1, LWC_NODEF, NULL},
+               {lwc::AD_IN,  lwc::AT_INT, -1, LWC_NODEF, NULL},
+               {lwc::AD_IN,  lwc::AT_INT, -1, LWC_NODEF, NULL},
+               {lwc::AD_OUT, lwc::AT_INT, -1, LWC_NODEF, NULL}}, LWC_METHOD(Box, sum), "Sum 9 integers"},
+  LWC_AUTO_METHOD(Box, move, "Move box origin"),
+  LWC_AUTO_METHOD(Box, area, "Get box area"),
+  LWC_AUTO_METHOD(Box, getSize, "Get box width and height"),
+  LWC_AUTO_METHOD(Box, grow, "Grow box by amount, set amount to the new area"),
+  LWC_AUTO_METHOD(Box, sample, "Count the box points among n pseudo random ones in [0, 1024)"),
+  LWC_AUTO_METHOD(Box, measure, "Get text length"),
 };
 
 static lwc::MethodDecl DoubleBoxMethods[] = {
@@ -147,7 +235,36 @@ static lwc::MethodDecl DoubleBoxMethods[] = {
   {"toBox", 1,     {{lwc::AD_OUT, lwc::AT_OBJECT, -1, LWC_NODEF, NULL}}, LWC_METHOD(DoubleBox, toBox), "Convert to standard box"},
 };
 
+// fields are directly read and written
+lwc::PropertyDecl Box::Properties[5] = {
+  {"x",      LWC_FIELD(Box, mX), "Box origin x coord"},
+  {"y",      LWC_FIELD(Box, mY), "Box origin y coord"},
+  {"width",  LWC_FIELD(Box, mW), "Box width"},
+  {"height", LWC_FIELD(Box, mH), "Box height"},
+  {"containsCalls", LWC_GETTER(Box, lwc::Integer, containsCalls), "Number of contains evaluations"}
+};
+
+static lwc::PropertyDecl DoubleBoxProperties[] = {
+  {"x",      LWC_ACCESSORS(DoubleBox, lwc::Integer, x, x),           "Box origin x coord"},
+  {"y",      LWC_ACCESSORS(DoubleBox, lwc::Integer, y, y),           "Box origin y coord"},
+  {"width",  LWC_ACCESSORS(DoubleBox, lwc::Integer, width, width),   "Box width"},
+  {"height", LWC_ACCESSORS(DoubleBox, lwc::Integer, height, height), "Box height"}
+};
+
+// emitted by setWidth and setHeight, inherited by test.DoubleBox
+static lwc::MethodDecl BoxSignals[] = {
+  {"resized", 2, {{lwc::AD_IN, lwc::AT_INT, -1, LWC_NODEF, NULL},
+                  {lwc::AD_IN, lwc::AT_INT, -1, LWC_NODEF, NULL}}, NULL, "Box dimensions changed (width, height)"}
+};
+
+// inherited by test.DoubleBox
+static lwc::InterfaceDecl BoxInterfaces[] = {
+  {LWC_IMPLEMENTS(Box, IBox)}
+};
+
 LWC_BEGIN_MODULE(2)
-LWC_MODULE_TYPE(0, "test.Box", Box, BoxMethods, false, "Box primitive")
-LWC_MODULE_DERIVED_TYPE(1, "test.DoubleBox", DoubleBox, DoubleBoxMethods, false, "Box primitive that doubles its origin and dimensions", 0)
+LWC_MODULE_TYPE_WITH_PROPERTIES(0, "test.Box", Box, BoxMethods, Box::Properties, false, "Box primitive")
+LWC_MODULE_TYPE_INTERFACES(0, Box, BoxInterfaces)
+LWC_MODULE_TYPE_SIGNALS(0, Box, BoxSignals)
+LWC_MODULE_DERIVED_TYPE_WITH_PROPERTIES(1, "test.DoubleBox", DoubleBox, DoubleBoxMethods, DoubleBoxProperties, false, "Box primitive that doubles its origin and dimensions", 0)
 LWC_END_MODULE()
@@ -0,0 +1,49 @@
+/*
+
+Copyright (C) 2009, 2010  Gaetan Guidet
+
+This file is part of lwc.
+
+lwc is free software; you can redistribute it and/or modify it
+under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 2.1 of the License, or (at
+your option) any later version.
+
+lwc is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+USA.
+
+*/
+
+
+#ifndef __lwc_test_box_h__
+#define __lwc_test_box_h__
+
+#include <lwc/method.h>
+
+// Native interface of test.Box and test.DoubleBox (see Object::queryInterface)
+class IBox {
+  public:
+    
+    LWC_INTERFACE("test.IBox")
+    
+    virtual ~IBox() {
+    }
+    
+    virtual lwc::Integer x() const = 0;
+    virtual lwc::Integer y() const = 0;
+    virtual lwc::Integer width() const = 0;
+    virtual lwc::Integer height() const = 0;
+    virtual void x(lwc::Integer v) = 0;
+    virtual void y(lwc::Integer v) = 0;
+    virtual void width(lwc::Integer v) = 0;
+    virtual void height(lwc::Integer v) = 0;
+};
+
+#endif
@@ -66,6 +66,13 @@ Dict.set = function (self, key, val)
   self.dict[key] = val
 end
 
+-- Object::callBatch hook: one call for an array of set argument tables
+Dict.set_batch = function (self, calls)
+  for i, args in ipairs(calls) do
+    self.dict[args[1]] = args[2]
+  end
+end
+
 Dict.get = function (self, key)
   return self.dict[key]
 end
@@ -78,6 +85,11 @@ Dict.size = function (self)
   return n
 end
 
+-- Registry.setPool hook: destroyed dictionaries are emptied and reused
+Dict.recycle = function (self)
+  self.dict = {}
+end
+
 -- Type inheritance in a single component
 
 local Dict2         = {}
@@ -41,7 +41,13 @@ class ObjectList(lwcpy.Object):
                         "Remove last object in list"),
              "printInt": ([(lwcpy.AD_IN, lwcpy.AT_INT),
                            (lwcpy.AD_IN, lwcpy.AT_STRING, -1, True, "", "indent")],
-                          "Print an integer number with optional indent")}
+                          "Print an integer number with optional indent"),
+             "onResized": ([(lwcpy.AD_IN, lwcpy.AT_INT),
+                            (lwcpy.AD_IN, lwcpy.AT_INT)],
+                           "Print new box dimensions (test.Box resized slot)")}
+  
+  Signals = {"sizeChanged": ([(lwcpy.AD_IN, lwcpy.AT_INT)],
+                             "Number of objects in list changed")}
   
   Description = "List of lwc::Object instances."
   
@@ -54,12 +60,22 @@ class ObjectList(lwcpy.Object):
   
   def push(self, obj):
     self.lst.append(obj)
+    self.emit("sizeChanged", len(self.lst))
   
   def at(self, idx):
     if idx < 0 or idx >= len(self.lst):
       raise Exception("Invalid index %s in list" % idx)
     return self.lst[idx]
   
+  # Object::callBatch hook: one call for a list of at argument tuples,
+  # returns the list of results
+  def at_batch(self, calls):
+    n = len(self.lst)
+    for args in calls:
+      if args[0] < 0 or args[0] >= n:
+        raise Exception("Invalid index %s in list" % args[0])
+    return [self.lst[args[0]] for args in calls]
+  
   def set(self, idx, obj):
     if idx < 0 or idx >= len(self.lst):
       raise Exception("Invalid index %s in list" % idx)
@@ -81,14 +97,23 @@ class ObjectList(lwcpy.Object):
     if idx < 0 or idx >= len(self.lst):
       raise Exception("Invalid index %s in list" % idx)
     self.lst.remove(self.lst[idx])
+    self.emit("sizeChanged", len(self.lst))
   
   def pop(self):
     if len(self.lst) > 0:
       self.lst = self.lst[:-1]
+      self.emit("sizeChanged", len(self.lst))
   
   def printInt(self, val, indent=""):
     print("%s%s" % (indent, val))
   
+  def onResized(self, w, h):
+    print("resized to %dx%d" % (w, h))
+  
+  # Registry.setPool hook: destroyed lists are emptied and reused
+  def recycle(self):
+    self.lst = []
+  
 
 class ObjectList2(ObjectList):
   
@@ -102,6 +127,7 @@ class ObjectList2(ObjectList):
   
   def clear(self):
     self.lst = []
+    self.emit("sizeChanged", 0)
   
 
 
@@ -253,7 +253,7 @@ static int lwcarg_init(PyObject *pself, PyObject *args, PyObject *kwargs) {
     if (pDefVal) {
       SetArgDefault(self->arg, pDefVal);
     }
-    if (dir != lwc::AD_OUT) {
+    if (dir != lwc::AD_OUT && dir != lwc::AD_RETURN) {
       // check for name value only on IN/INOUT attributes
       PyObject *pName = PyDict_GetItemString(kwargs, "name");
       if (pName) {
@@ -427,6 +427,7 @@ bool InitArgument(PyObject *m) {
   PyModule_AddIntConstant(m, "AD_IN", lwc::AD_IN);
   PyModule_AddIntConstant(m, "AD_INOUT", lwc::AD_INOUT);
   PyModule_AddIntConstant(m, "AD_OUT", lwc::AD_OUT);
+  PyModule_AddIntConstant(m, "AD_RETURN", lwc::AD_RETURN);
   
   memset(&PyLWCArgumentType, 0, sizeof(PyTypeObject));
   PyLWCArgumentType.ob_refcnt = 1;
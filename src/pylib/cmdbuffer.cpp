@@ -0,0 +1,248 @@
+/*
+
+Copyright (C) 2009, 2010  Gaetan Guidet
+
+This file is part of lwc.
+
+lwc is free software; you can redistribute it and/or modify it
+under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 2.1 of the License, or (at
+your option) any later version.
+
+lwc is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+USA.
+
+*/
+
+#include <lwc/python/types.h>
+#include <lwc/python/convert.h>
+
+namespace py {
+
+PyTypeObject PyLWCCommandBufferType;
+
+typedef lwc::CommandBridge<MarshalTraits> CommandBridge;
+
+// ---
+
+static PyObject* lwccmdbuf_new(PyTypeObject *type, PyObject *, PyObject *) {
+  PyLWCCommandBuffer *self = (PyLWCCommandBuffer*) type->tp_alloc(type, 0);
+  if (!self) {
+    return NULL;
+  }
+  self->buffer = 0;
+  self->objects = PyList_New(0);
+  if (!self->objects) {
+    Py_DECREF((PyObject*)self);
+    return NULL;
+  }
+  self->buffer = new lwc::CommandBuffer();
+  return (PyObject*)self;
+}
+
+static int lwccmdbuf_init(PyObject *, PyObject *, PyObject *) {
+  return 0;
+}
+
+static void lwccmdbuf_free(PyObject *pself) {
+  PyLWCCommandBuffer *self = (PyLWCCommandBuffer*) pself;
+  delete self->buffer;
+  Py_XDECREF(self->objects);
+  pself->ob_type->tp_free(pself);
+}
+
+// args: object, method name, input values...
+static bool Record(PyLWCCommandBuffer *self, PyObject *args, size_t &index) {
+  if (PyTuple_Size(args) < 2 ||
+      !PyObject_TypeCheck(PyTuple_GetItem(args, 0), &PyLWCObjectType) ||
+      !PyString_Check(PyTuple_GetItem(args, 1))) {
+    PyErr_SetString(PyExc_RuntimeError, "lwcpy.CommandBuffer: expected object, method name and input values");
+    return false;
+  }
+  
+  PyObject *pobj = PyTuple_GetItem(args, 0);
+  lwc::Object *o = ((PyLWCObject*)pobj)->obj;
+  const char *name = PyString_AsString(PyTuple_GetItem(args, 1));
+  
+  // keep the object alive as long as the command
+  if (PyList_Append(self->objects, pobj) != 0) {
+    return false;
+  }
+  
+  lwc::Status status;
+  
+  if (!CommandBridge::Record(*(self->buffer), o, name, args, 2, index, status)) {
+    Py_ssize_t n = PyList_Size(self->objects);
+    PyList_SetSlice(self->objects, n-1, n, NULL);
+    PyErr_SetString(PyExc_RuntimeError, status.getMessage().c_str());
+    return false;
+  }
+  
+  return true;
+}
+
+static PyObject* lwccmdbuf_record(PyObject *pself, PyObject *args) {
+  PyLWCCommandBuffer *self = (PyLWCCommandBuffer*) pself;
+  size_t index = 0;
+  if (!Record(self, args, index)) {
+    return NULL;
+  }
+  return PyInt_FromLong(long(index));
+}
+
+static PyObject* lwccmdbuf_extend(PyObject *pself, PyObject *args) {
+  PyLWCCommandBuffer *self = (PyLWCCommandBuffer*) pself;
+  PyObject *commands = 0;
+  if (!PyArg_ParseTuple(args, "O", &commands)) {
+    return NULL;
+  }
+  if (!PyList_Check(commands)) {
+    PyErr_SetString(PyExc_RuntimeError, "lwcpy.CommandBuffer.extend: expected list of tuples");
+    return NULL;
+  }
+  size_t index = 0;
+  for (Py_ssize_t i=0; i<PyList_Size(commands); ++i) {
+    PyObject *command = PyList_GetItem(commands, i);
+    if (!PyTuple_Check(command)) {
+      PyErr_SetString(PyExc_RuntimeError, "lwcpy.CommandBuffer.extend: expected list of tuples");
+      return NULL;
+    }
+    if (!Record(self, command, index)) {
+      return NULL;
+    }
+  }
+  Py_INCREF(Py_None);
+  return Py_None;
+}
+
+static void ReleaseOutputs(PyObject **outputs, size_t n) {
+  for (size_t k=0; k<n; ++k) {
+    Py_DECREF(outputs[k]);
+  }
+}
+
+static PyObject* lwccmdbuf_submit(PyObject *pself, PyObject *args) {
+  PyLWCCommandBuffer *self = (PyLWCCommandBuffer*) pself;
+  lwc::CommandBuffer &buffer = *(self->buffer);
+  
+  lwc::Status status = buffer.trySubmit();
+  
+  if (status.failed()) {
+    PyErr_Format(PyExc_RuntimeError, "Command %lu: %s", (unsigned long) buffer.failedCommand(), status.getMessage().c_str());
+    return NULL;
+  }
+  
+  // one entry per command, valued as the direct call would be
+  PyObject *rv = PyList_New(buffer.size());
+  
+  if (!rv) {
+    return NULL;
+  }
+  
+  PyObject *outputs[LWC_MAX_ARGS];
+  size_t n = 0;
+  
+  try {
+    for (size_t i=0; i<buffer.size(); ++i) {
+      const lwc::Method &meth = buffer.getMethod(i);
+      n = 0;
+      for (size_t j=0; j<meth.numArgs(); ++j) {
+        if (meth[j].getDir() != lwc::AD_IN) {
+          PyObject *output = CommandBridge::Output(buffer, i, j, args);
+          if (!output) {
+            ReleaseOutputs(outputs, n);
+            Py_DECREF(rv);
+            if (!PyErr_Occurred()) {
+              PyErr_Format(PyExc_RuntimeError, "Command %lu: Could not convert argument %lu", (unsigned long) i, (unsigned long) j);
+            }
+            return NULL;
+          }
+          outputs[n++] = output;
+        }
+      }
+      PyObject *item = 0;
+      if (n == 0) {
+        item = Py_None;
+        Py_INCREF(item);
+      } else if (n == 1) {
+        item = outputs[0];
+      } else {
+        item = PyTuple_New(n);
+        if (!item) {
+          ReleaseOutputs(outputs, n);
+          Py_DECREF(rv);
+          return NULL;
+        }
+        for (size_t k=0; k<n; ++k) {
+          PyTuple_SET_ITEM(item, k, outputs[k]);
+        }
+      }
+      n = 0;
+      PyList_SET_ITEM(rv, i, item);
+    }
+    
+  } catch (std::exception &e) {
+    ReleaseOutputs(outputs, n);
+    Py_DECREF(rv);
+    PyErr_SetString(PyExc_RuntimeError, e.what());
+    return NULL;
+  }
+  
+  return rv;
+}
+
+static PyObject* lwccmdbuf_clear(PyObject *pself, PyObject *) {
+  PyLWCCommandBuffer *self = (PyLWCCommandBuffer*) pself;
+  self->buffer->clear();
+  PyList_SetSlice(self->objects, 0, PyList_Size(self->objects), NULL);
+  Py_INCREF(Py_None);
+  return Py_None;
+}
+
+static PyObject* lwccmdbuf_size(PyObject *pself, PyObject *) {
+  PyLWCCommandBuffer *self = (PyLWCCommandBuffer*) pself;
+  return PyInt_FromLong(long(self->buffer->size()));
+}
+
+static PyMethodDef lwccmdbuf_methods[] = {
+  {"record", lwccmdbuf_record, METH_VARARGS, "Record a method call (object, name, inputs...), returns the command index"},
+  {"extend", lwccmdbuf_extend, METH_VARARGS, "Record a list of (object, name, inputs...) method calls"},
+  {"submit", lwccmdbuf_submit, METH_VARARGS, "Call the recorded methods, returns the list of their results"},
+  {"clear", lwccmdbuf_clear, METH_VARARGS, "Remove all commands"},
+  {"size", lwccmdbuf_size, METH_VARARGS, "Get commands count"},
+  {NULL, NULL, 0, NULL}
+};
+
+// ---
+
+bool InitCommandBuffer(PyObject *m) {
+  
+  memset(&PyLWCCommandBufferType, 0, sizeof(PyTypeObject));
+  PyLWCCommandBufferType.ob_refcnt = 1;
+  PyLWCCommandBufferType.ob_size = 0;
+  PyLWCCommandBufferType.tp_name = "lwcpy.CommandBuffer";
+  PyLWCCommandBufferType.tp_basicsize = sizeof(PyLWCCommandBuffer);
+  PyLWCCommandBufferType.tp_flags = Py_TPFLAGS_DEFAULT;
+  PyLWCCommandBufferType.tp_doc = "Command buffer class";
+  PyLWCCommandBufferType.tp_new = lwccmdbuf_new;
+  PyLWCCommandBufferType.tp_init = lwccmdbuf_init;
+  PyLWCCommandBufferType.tp_dealloc = lwccmdbuf_free;
+  PyLWCCommandBufferType.tp_methods = lwccmdbuf_methods;
+  if (PyType_Ready(&PyLWCCommandBufferType) < 0) {
+    return false;
+  }
+  
+  Py_INCREF((PyObject*) &PyLWCCommandBufferType);
+  PyModule_AddObject(m, "CommandBuffer", (PyObject*)&PyLWCCommandBufferType);
+  
+  return true;
+}
+
+}
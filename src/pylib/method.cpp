@@ -197,6 +197,9 @@ bool InitMethod(PyObject *m) {
   Py_INCREF((PyObject*) &PyLWCMethodType);
   PyModule_AddObject(m, "Method", (PyObject*)&PyLWCMethodType);
   
+  PyModule_AddIntConstant(m, "MF_NONE", lwc::MF_NONE);
+  PyModule_AddIntConstant(m, "MF_PURE", lwc::MF_PURE);
+  
   return true;
 }
 
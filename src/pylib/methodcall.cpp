@@ -23,6 +23,7 @@ USA.
 
 #include <lwc/python/types.h>
 #include <lwc/python/convert.h>
+#include <lwc/marshal.h>
 
 namespace py {
 
@@ -34,6 +35,7 @@ static PyObject* methcall_new(PyTypeObject *type, PyObject *, PyObject *) {
   PyLWCMethodCall *self = (PyLWCMethodCall*) type->tp_alloc(type, 0);
   self->obj = 0;
   self->method = 0;
+  self->sites = 0;
   return (PyObject*)self;
 }
 
@@ -46,13 +48,20 @@ static void methcall_free(PyObject *pself) {
   if (self->method) {
     free(self->method);
   }
+  if (self->sites) {
+    delete self->sites;
+  }
   pself->ob_type->tp_free(pself);
 }
 
 // This needs to be a recursive call rather than a for loop inside
 // because real parameters are created on the stack [important for return value]
+// Failures set the python error and return NULL, the lwc call itself goes through
+// Object::tryCall so that no exception crosses the recursion
+// kwargs holds the keyword value for each method argument (resolved by the call site)
 PyObject* CallMethod(lwc::Object *o, const char *n, lwc::MethodParams &params, int cArg,
-                     PyObject *args, PyObject *kwargs, size_t pyArg, std::map<size_t,size_t> &arraySizes) throw(std::runtime_error) {
+                     PyObject *args, PyObject **kwargs, size_t pyArg, std::map<size_t,size_t> &arraySizes,
+                     lwc::Status &status) {
   
   const lwc::Method &m = params.getMethod();
   
@@ -62,7 +71,12 @@ PyObject* CallMethod(lwc::Object *o, const char *n, lwc::MethodParams &params, i
       return NULL;
     }
     
-    o->call(n, params);
+    status = o->tryCall(n, params);
+    
+    if (status.failed()) {
+      PyErr_SetString(PyExc_RuntimeError, status.getMessage().c_str());
+      return NULL;
+    }
     
     if (m.numArgs() == 0) {
       Py_INCREF(Py_None);
@@ -82,6 +96,32 @@ PyObject* CallMethod(lwc::Object *o, const char *n, lwc::MethodParams &params, i
       return NULL;
     }
     
+    if (ad.getDir() == lwc::AD_RETURN) {
+      // last argument: the method fills the slot, no temporary to bind
+      if (pyArg != size_t(PyTuple_Size(args))) {
+        PyErr_SetString(PyExc_RuntimeError, "Invalid arguments. None expected");
+        return NULL;
+      }
+      
+      status = o->tryCall(n, params);
+      
+      if (status.failed()) {
+        PyErr_SetString(PyExc_RuntimeError, status.getMessage().c_str());
+        return NULL;
+      }
+      
+      PyObject *val = ReturnToPython(params, size_t(cArg));
+      
+      if (cArg == 0) {
+        // single result, returned as is
+        return val;
+      }
+      
+      rv = PyTuple_New(1);
+      PyTuple_SetItem(rv, 0, val);
+      return rv;
+    }
+    
     // PreCallArray will increment pyArg if necessarys
     size_t oldPyArg = pyArg;
     bool failed = false;
@@ -91,27 +131,20 @@ PyObject* CallMethod(lwc::Object *o, const char *n, lwc::MethodParams &params, i
         if (ad.isArray()) {
           bool *ary=0;
           const lwc::Argument &sad = m[ad.arraySizeArg()];
-          if (ParamConverter<lwc::AT_BOOL>::PreCallArray(ad, cArg, sad, args, kwargs, pyArg, arraySizes, ary)) {
-            try {
-              if (ad.getDir() == lwc::AD_IN) {
-                params.set(cArg, ary, false);
-              } else {
-                params.set(cArg, &ary, false);
-              }
-            } catch (std::exception &e) {
-              PyErr_SetString(PyExc_RuntimeError, e.what());
-              failed = true;
+          if (ParamConverter<lwc::AT_BOOL>::PreCallArray(ad, cArg, sad, args, kwargs[cArg], pyArg, arraySizes, ary)) {
+            if (ad.getDir() == lwc::AD_IN) {
+              failed = !params.trySet(cArg, ary, status, false);
+            } else {
+              failed = !params.trySet(cArg, &ary, status, false);
             }
-            if (!failed) {
-              try {
-                rv = CallMethod(o, n, params, cArg+1, args, kwargs, pyArg, arraySizes);
-              } catch (std::exception &e) {
-                rv = NULL;
-                PyErr_SetString(PyExc_RuntimeError, e.what());
-                failed = true;
-              }
+            if (failed) {
+              status.setMethodName(n);
+              PyErr_SetString(PyExc_RuntimeError, status.getMessage().c_str());
+            } else {
+              rv = CallMethod(o, n, params, cArg+1, args, kwargs, pyArg, arraySizes, status);
+              failed = (rv == NULL);
             }
-            ParamConverter<lwc::AT_BOOL>::PostCallArray(ad, cArg, sad, args, kwargs, oldPyArg, arraySizes, ary, rv, failed);
+            ParamConverter<lwc::AT_BOOL>::PostCallArray(ad, cArg, sad, args, kwargs[cArg], oldPyArg, arraySizes, ary, rv, failed);
             
           } else {
             failed = true;
@@ -119,27 +152,20 @@ PyObject* CallMethod(lwc::Object *o, const char *n, lwc::MethodParams &params, i
           
         } else {
           bool val;
-          if (ParamConverter<lwc::AT_BOOL>::PreCall(ad, cArg, args, kwargs, pyArg, arraySizes, val)) {
-            try {
-              if (ad.getDir() == lwc::AD_IN) {
-                params.set(cArg, val, false);
-              } else {
-                params.set(cArg, &val, false);
-              }
-            } catch (std::exception &e) {
-              PyErr_SetString(PyExc_RuntimeError, e.what());
-              failed = true;
+          if (ParamConverter<lwc::AT_BOOL>::PreCall(ad, cArg, args, kwargs[cArg], pyArg, arraySizes, val)) {
+            if (ad.getDir() == lwc::AD_IN) {
+              failed = !params.trySet(cArg, val, status, false);
+            } else {
+              failed = !params.trySet(cArg, &val, status, false);
             }
-            if (!failed) {
-              try {
-                rv = CallMethod(o, n, params, cArg+1, args, kwargs, pyArg, arraySizes);
-              } catch (std::exception &e) {
-                rv = NULL;
-                PyErr_SetString(PyExc_RuntimeError, e.what());
-                failed = true;
-              }
+            if (failed) {
+              status.setMethodName(n);
+              PyErr_SetString(PyExc_RuntimeError, status.getMessage().c_str());
+            } else {
+              rv = CallMethod(o, n, params, cArg+1, args, kwargs, pyArg, arraySizes, status);
+              failed = (rv == NULL);
             }
-            ParamConverter<lwc::AT_BOOL>::PostCall(ad, cArg, args, kwargs, oldPyArg, arraySizes, val, rv, failed);
+            ParamConverter<lwc::AT_BOOL>::PostCall(ad, cArg, args, kwargs[cArg], oldPyArg, arraySizes, val, rv, failed);
             
           } else {
             failed = true;
@@ -151,27 +177,20 @@ PyObject* CallMethod(lwc::Object *o, const char *n, lwc::MethodParams &params, i
         if (ad.isArray()) {
           lwc::Integer *ary=0;
           const lwc::Argument &sad = m[ad.arraySizeArg()];
-          if (ParamConverter<lwc::AT_INT>::PreCallArray(ad, cArg, sad, args, kwargs, pyArg, arraySizes, ary)) {
-            try {
-              if (ad.getDir() == lwc::AD_IN) {
-                params.set(cArg, ary, false);
-              } else {
-                params.set(cArg, &ary, false);
-              }
-            } catch (std::exception &e) {
-              PyErr_SetString(PyExc_RuntimeError, e.what());
-              failed = true;
+          if (ParamConverter<lwc::AT_INT>::PreCallArray(ad, cArg, sad, args, kwargs[cArg], pyArg, arraySizes, ary)) {
+            if (ad.getDir() == lwc::AD_IN) {
+              failed = !params.trySet(cArg, ary, status, false);
+            } else {
+              failed = !params.trySet(cArg, &ary, status, false);
             }
-            if (!failed) {
-              try {
-                rv = CallMethod(o, n, params, cArg+1, args, kwargs, pyArg, arraySizes);
-              } catch (std::exception &e) {
-                rv = NULL;
-                PyErr_SetString(PyExc_RuntimeError, e.what());
-                failed = true;
-              }
+            if (failed) {
+              status.setMethodName(n);
+              PyErr_SetString(PyExc_RuntimeError, status.getMessage().c_str());
+            } else {
+              rv = CallMethod(o, n, params, cArg+1, args, kwargs, pyArg, arraySizes, status);
+              failed = (rv == NULL);
             }
-            ParamConverter<lwc::AT_INT>::PostCallArray(ad, cArg, sad, args, kwargs, oldPyArg, arraySizes, ary, rv, failed);
+            ParamConverter<lwc::AT_INT>::PostCallArray(ad, cArg, sad, args, kwargs[cArg], oldPyArg, arraySizes, ary, rv, failed);
             
           } else {
             failed = true;
@@ -179,27 +198,20 @@ PyObject* CallMethod(lwc::Object *o, const char *n, lwc::MethodParams &params, i
           
         } else {
           lwc::Integer val;
-          if (ParamConverter<lwc::AT_INT>::PreCall(ad, cArg, args, kwargs, pyArg, arraySizes, val)) {
-            try {
-              if (ad.getDir() == lwc::AD_IN) {
-                params.set(cArg, val, false);
-              } else {
-                params.set(cArg, &val, false);
-              }
-            } catch (std::exception &e) {
-              PyErr_SetString(PyExc_RuntimeError, e.what());
-              failed = true;
+          if (ParamConverter<lwc::AT_INT>::PreCall(ad, cArg, args, kwargs[cArg], pyArg, arraySizes, val)) {
+            if (ad.getDir() == lwc::AD_IN) {
+              failed = !params.trySet(cArg, val, status, false);
+            } else {
+              failed = !params.trySet(cArg, &val, status, false);
             }
-            if (!failed) {
-              try {
-                rv = CallMethod(o, n, params, cArg+1, args, kwargs, pyArg, arraySizes);
-              } catch (std::exception &e) {
-                rv = NULL;
-                PyErr_SetString(PyExc_RuntimeError, e.what());
-                failed = true;
-              }
+            if (failed) {
+              status.setMethodName(n);
+              PyErr_SetString(PyExc_RuntimeError, status.getMessage().c_str());
+            } else {
+              rv = CallMethod(o, n, params, cArg+1, args, kwargs, pyArg, arraySizes, status);
+              failed = (rv == NULL);
             }
-            ParamConverter<lwc::AT_INT>::PostCall(ad, cArg, args, kwargs, oldPyArg, arraySizes, val, rv, failed);
+            ParamConverter<lwc::AT_INT>::PostCall(ad, cArg, args, kwargs[cArg], oldPyArg, arraySizes, val, rv, failed);
             
           } else {
             failed = true;
@@ -211,54 +223,40 @@ PyObject* CallMethod(lwc::Object *o, const char *n, lwc::MethodParams &params, i
         if (ad.isArray()) {
           lwc::Real *ary=0;
           const lwc::Argument &sad = m[ad.arraySizeArg()];
-          if (ParamConverter<lwc::AT_REAL>::PreCallArray(ad, cArg, sad, args, kwargs, pyArg, arraySizes, ary)) {
-            try {
-              if (ad.getDir() == lwc::AD_IN) {
-                params.set(cArg, ary, false);
-              } else {
-                params.set(cArg, &ary, false);
-              }
-            } catch (std::exception &e) {
-              PyErr_SetString(PyExc_RuntimeError, e.what());
-              failed = true;
+          if (ParamConverter<lwc::AT_REAL>::PreCallArray(ad, cArg, sad, args, kwargs[cArg], pyArg, arraySizes, ary)) {
+            if (ad.getDir() == lwc::AD_IN) {
+              failed = !params.trySet(cArg, ary, status, false);
+            } else {
+              failed = !params.trySet(cArg, &ary, status, false);
             }
-            if (!failed) {
-              try {
-                rv = CallMethod(o, n, params, cArg+1, args, kwargs, pyArg, arraySizes);
-              } catch (std::exception &e) {
-                rv = NULL;
-                PyErr_SetString(PyExc_RuntimeError, e.what());
-                failed = true;
-              }
+            if (failed) {
+              status.setMethodName(n);
+              PyErr_SetString(PyExc_RuntimeError, status.getMessage().c_str());
+            } else {
+              rv = CallMethod(o, n, params, cArg+1, args, kwargs, pyArg, arraySizes, status);
+              failed = (rv == NULL);
             }
-            ParamConverter<lwc::AT_REAL>::PostCallArray(ad, cArg, sad, args, kwargs, oldPyArg, arraySizes, ary, rv, failed);
+            ParamConverter<lwc::AT_REAL>::PostCallArray(ad, cArg, sad, args, kwargs[cArg], oldPyArg, arraySizes, ary, rv, failed);
           } else {
             failed = true;
           }
           
         } else {
           lwc::Real val;
-          if (ParamConverter<lwc::AT_REAL>::PreCall(ad, cArg, args, kwargs, pyArg, arraySizes, val)) {
-            try {
-              if (ad.getDir() == lwc::AD_IN) {
-                params.set(cArg, val, false);
-              } else {
-                params.set(cArg, &val, false);
-              }
-            } catch (std::exception &e) {
-              PyErr_SetString(PyExc_RuntimeError, e.what());
-              failed = true;
+          if (ParamConverter<lwc::AT_REAL>::PreCall(ad, cArg, args, kwargs[cArg], pyArg, arraySizes, val)) {
+            if (ad.getDir() == lwc::AD_IN) {
+              failed = !params.trySet(cArg, val, status, false);
+            } else {
+              failed = !params.trySet(cArg, &val, status, false);
             }
-            if (!failed) {
-              try {
-                rv = CallMethod(o, n, params, cArg+1, args, kwargs, pyArg, arraySizes);
-              } catch (std::exception &e) {
-                rv = NULL;
-                PyErr_SetString(PyExc_RuntimeError, e.what());
-                failed = true;
-              }
+            if (failed) {
+              status.setMethodName(n);
+              PyErr_SetString(PyExc_RuntimeError, status.getMessage().c_str());
+            } else {
+              rv = CallMethod(o, n, params, cArg+1, args, kwargs, pyArg, arraySizes, status);
+              failed = (rv == NULL);
             }
-            ParamConverter<lwc::AT_REAL>::PostCall(ad, cArg, args, kwargs, oldPyArg, arraySizes, val, rv, failed);
+            ParamConverter<lwc::AT_REAL>::PostCall(ad, cArg, args, kwargs[cArg], oldPyArg, arraySizes, val, rv, failed);
             
           } else {
             failed = true;
@@ -270,27 +268,20 @@ PyObject* CallMethod(lwc::Object *o, const char *n, lwc::MethodParams &params, i
         if (ad.isArray()) {
           char **ary=0;
           const lwc::Argument &sad = m[ad.arraySizeArg()];
-          if (ParamConverter<lwc::AT_STRING>::PreCallArray(ad, cArg, sad, args, kwargs, pyArg, arraySizes, ary)) {
-            try {
-              if (ad.getDir() == lwc::AD_IN) {
-                params.set(cArg, ary, false);
-              } else {
-                params.set(cArg, &ary, false);
-              }
-            } catch (std::exception &e) {
-              PyErr_SetString(PyExc_RuntimeError, e.what());
-              failed = true;
+          if (ParamConverter<lwc::AT_STRING>::PreCallArray(ad, cArg, sad, args, kwargs[cArg], pyArg, arraySizes, ary)) {
+            if (ad.getDir() == lwc::AD_IN) {
+              failed = !params.trySet(cArg, ary, status, false);
+            } else {
+              failed = !params.trySet(cArg, &ary, status, false);
             }
-            if (!failed) {
-              try {
-                rv = CallMethod(o, n, params, cArg+1, args, kwargs, pyArg, arraySizes);
-              } catch (std::exception &e) {
-                rv = NULL;
-                PyErr_SetString(PyExc_RuntimeError, e.what());
-                failed = true;
-              }
+            if (failed) {
+              status.setMethodName(n);
+              PyErr_SetString(PyExc_RuntimeError, status.getMessage().c_str());
+            } else {
+              rv = CallMethod(o, n, params, cArg+1, args, kwargs, pyArg, arraySizes, status);
+              failed = (rv == NULL);
             }
-            ParamConverter<lwc::AT_STRING>::PostCallArray(ad, cArg, sad, args, kwargs, oldPyArg, arraySizes, ary, rv, failed);
+            ParamConverter<lwc::AT_STRING>::PostCallArray(ad, cArg, sad, args, kwargs[cArg], oldPyArg, arraySizes, ary, rv, failed);
             
           } else {
             failed = true;
@@ -298,27 +289,20 @@ PyObject* CallMethod(lwc::Object *o, const char *n, lwc::MethodParams &params, i
           
         } else {
           char *val;
-          if (ParamConverter<lwc::AT_STRING>::PreCall(ad, cArg, args, kwargs, pyArg, arraySizes, val)) {
-            try {
-              if (ad.getDir() == lwc::AD_IN) {
-                params.set(cArg, val, false);
-              } else {
-                params.set(cArg, &val, false);
-              }
-            } catch (std::exception &e) {
-              PyErr_SetString(PyExc_RuntimeError, e.what());
-              failed = true;
+          if (ParamConverter<lwc::AT_STRING>::PreCall(ad, cArg, args, kwargs[cArg], pyArg, arraySizes, val)) {
+            if (ad.getDir() == lwc::AD_IN) {
+              failed = !params.trySet(cArg, val, status, false);
+            } else {
+              failed = !params.trySet(cArg, &val, status, false);
             }
-            if (!failed) {
-              try {
-                rv = CallMethod(o, n, params, cArg+1, args, kwargs, pyArg, arraySizes);
-              } catch (std::exception &e) {
-                rv = NULL;
-                PyErr_SetString(PyExc_RuntimeError, e.what());
-                failed = true;
-              }
+            if (failed) {
+              status.setMethodName(n);
+              PyErr_SetString(PyExc_RuntimeError, status.getMessage().c_str());
+            } else {
+              rv = CallMethod(o, n, params, cArg+1, args, kwargs, pyArg, arraySizes, status);
+              failed = (rv == NULL);
             }
-            ParamConverter<lwc::AT_STRING>::PostCall(ad, cArg, args, kwargs, oldPyArg, arraySizes, val, rv, failed);
+            ParamConverter<lwc::AT_STRING>::PostCall(ad, cArg, args, kwargs[cArg], oldPyArg, arraySizes, val, rv, failed);
             
           } else {
             failed = true;
@@ -330,27 +314,20 @@ PyObject* CallMethod(lwc::Object *o, const char *n, lwc::MethodParams &params, i
         if (ad.isArray()) {
           lwc::Object **ary=0;
           const lwc::Argument &sad = m[ad.arraySizeArg()];
-          if (ParamConverter<lwc::AT_OBJECT>::PreCallArray(ad, cArg, sad, args, kwargs, pyArg, arraySizes, ary)) {
-            try {
-              if (ad.getDir() == lwc::AD_IN) {
-                params.set(cArg, ary, false);
-              } else {
-                params.set(cArg, &ary, false);
-              }
-            } catch (std::exception &e) {
-              PyErr_SetString(PyExc_RuntimeError, e.what());
-              failed = true;
+          if (ParamConverter<lwc::AT_OBJECT>::PreCallArray(ad, cArg, sad, args, kwargs[cArg], pyArg, arraySizes, ary)) {
+            if (ad.getDir() == lwc::AD_IN) {
+              failed = !params.trySet(cArg, ary, status, false);
+            } else {
+              failed = !params.trySet(cArg, &ary, status, false);
             }
-            if (!failed) {
-              try {
-                rv = CallMethod(o, n, params, cArg+1, args, kwargs, pyArg, arraySizes);
-              } catch (std::exception &e) {
-                rv = NULL;
-                PyErr_SetString(PyExc_RuntimeError, e.what());
-                failed = true;
-              }
+            if (failed) {
+              status.setMethodName(n);
+              PyErr_SetString(PyExc_RuntimeError, status.getMessage().c_str());
+            } else {
+              rv = CallMethod(o, n, params, cArg+1, args, kwargs, pyArg, arraySizes, status);
+              failed = (rv == NULL);
             }
-            ParamConverter<lwc::AT_OBJECT>::PostCallArray(ad, cArg, sad, args, kwargs, oldPyArg, arraySizes, ary, rv, failed);
+            ParamConverter<lwc::AT_OBJECT>::PostCallArray(ad, cArg, sad, args, kwargs[cArg], oldPyArg, arraySizes, ary, rv, failed);
             
           } else {
             failed = true;
@@ -358,27 +335,20 @@ PyObject* CallMethod(lwc::Object *o, const char *n, lwc::MethodParams &params, i
           
         } else {
           lwc::Object *val;
-          if (ParamConverter<lwc::AT_OBJECT>::PreCall(ad, cArg, args, kwargs, pyArg, arraySizes, val)) {
-            try {
-              if (ad.getDir() == lwc::AD_IN) {
-                params.set(cArg, val, false);
-              } else {
-                params.set(cArg, &val, false);
-              }
-            } catch (std::exception &e) {
-              PyErr_SetString(PyExc_RuntimeError, e.what());
-              failed = true;
+          if (ParamConverter<lwc::AT_OBJECT>::PreCall(ad, cArg, args, kwargs[cArg], pyArg, arraySizes, val)) {
+            if (ad.getDir() == lwc::AD_IN) {
+              failed = !params.trySet(cArg, val, status, false);
+            } else {
+              failed = !params.trySet(cArg, &val, status, false);
             }
-            if (!failed) {
-              try {
-                rv = CallMethod(o, n, params, cArg+1, args, kwargs, pyArg, arraySizes);
-              } catch (std::exception &e) {
-                rv = NULL;
-                PyErr_SetString(PyExc_RuntimeError, e.what());
-                failed = true;
-              }
+            if (failed) {
+              status.setMethodName(n);
+              PyErr_SetString(PyExc_RuntimeError, status.getMessage().c_str());
+            } else {
+              rv = CallMethod(o, n, params, cArg+1, args, kwargs, pyArg, arraySizes, status);
+              failed = (rv == NULL);
             }
-            ParamConverter<lwc::AT_OBJECT>::PostCall(ad, cArg, args, kwargs, oldPyArg, arraySizes, val, rv, failed);
+            ParamConverter<lwc::AT_OBJECT>::PostCall(ad, cArg, args, kwargs[cArg], oldPyArg, arraySizes, val, rv, failed);
             
           } else {
             failed = true;
@@ -431,20 +401,75 @@ PyObject* CallMethod(lwc::Object *o, const char *n, lwc::MethodParams &params, i
   }
 }
 
+PyObject* CallMethod(lwc::Object *o, const lwc::MethodsTable *methods, const char *n,
+                     lwc::CallSiteCache &sites, PyObject *args, PyObject *kwargs) {
+  
+  // sorted keyword names and values
+  const char *names[LWC_MAX_ARGS];
+  PyObject *values[LWC_MAX_ARGS];
+  size_t nkw = 0;
+  
+  if (kwargs) {
+    Py_ssize_t pos = 0;
+    PyObject *key, *value;
+    while (PyDict_Next(kwargs, &pos, &key, &value)) {
+      if (!PyString_Check(key) || nkw >= LWC_MAX_ARGS) {
+        PyErr_SetString(PyExc_RuntimeError, "Invalid keyword arguments");
+        return 0;
+      }
+      const char *name = PyString_AsString(key);
+      size_t i = nkw++;
+      while (i > 0 && strcmp(names[i-1], name) > 0) {
+        names[i] = names[i-1];
+        values[i] = values[i-1];
+        --i;
+      }
+      names[i] = name;
+      values[i] = value;
+    }
+  }
+  
+  lwc::Status status;
+  
+  const lwc::CallSite *site = sites.get(methods, n, size_t(PyTuple_Size(args)),
+                                        names, nkw, lwc::CallSite::CSB_SCRIPT, status);
+  if (!site) {
+    PyErr_SetString(PyExc_RuntimeError, status.getMessage().c_str());
+    return 0;
+  }
+  
+  PyObject *kwvalues[LWC_MAX_ARGS];
+  memset(kwvalues, 0, LWC_MAX_ARGS * sizeof(PyObject*));
+  for (size_t k=0; k<nkw; ++k) {
+    kwvalues[site->getKeywordSlot(k)] = values[k];
+  }
+  
+  lwc::MethodParams params(site->getHandle().getMethod());
+  
+  if (nkw == 0) {
+    // common signatures skip the generic conversion
+    lwc::Marshal<MarshalTraits>::Stub stub = lwc::Marshal<MarshalTraits>::Find(params.getMethod());
+    PyObject *rv = 0;
+    if (stub && stub(o, n, params, args, status, rv)) {
+      return rv;
+    }
+  }
+  
+  std::map<size_t, size_t> arraySizes;
+  return CallMethod(o, n, params, 0, args, kwvalues, 0, arraySizes, status);
+}
+
 static PyObject *methcall_doit(PyObject *pself, PyObject *args, PyObject *kwargs) {
   PyLWCMethodCall *self = (PyLWCMethodCall*) pself;
 //#ifdef _DEBUG
 //  std::cout << "MethodCall: " << PyDict_Size(kwargs) << " keyword arguments (kwargs=" << std::hex << kwargs << std::dec << ")" << std::endl;
 //#endif
-  try {
-    const lwc::Method &m = self->obj->getMethod(self->method);
-    std::map<size_t, size_t> arraySizes;
-    lwc::MethodParams params = lwc::MethodParams(m);
-    return CallMethod(self->obj, self->method, params, 0, args, kwargs, 0, arraySizes);
-  } catch (std::runtime_error &e) {
-    PyErr_SetString(PyExc_RuntimeError, e.what());
-    return 0;
+  
+  if (!self->sites) {
+    self->sites = new lwc::CallSiteCache();
   }
+  
+  return CallMethod(self->obj, self->obj->getMethods(), self->method, *(self->sites), args, kwargs);
 }
 
 // ---
@@ -71,6 +71,16 @@ PyObject* CreateModule() {
     Py_DECREF(m);
     return 0;
   }
+  if (!InitCommandBuffer(m)) {
+    PyErr_SetString(PyExc_RuntimeError, "Could not intialize lwcpy.CommandBuffer class");
+    Py_DECREF(m);
+    return 0;
+  }
+  if (!InitSignalQueue(m)) {
+    PyErr_SetString(PyExc_RuntimeError, "Could not intialize lwcpy.SignalQueue class");
+    Py_DECREF(m);
+    return 0;
+  }
   if (!InitMethodsTable(m)) {
     PyErr_SetString(PyExc_RuntimeError, "Could not intialize lwcpy.MethodsTable class");
     Py_DECREF(m);
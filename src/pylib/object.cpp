@@ -23,6 +23,7 @@ USA.
 
 #include <lwc/python/types.h>
 #include <lwc/python/pobject.h>
+#include <lwc/python/convert.h>
 
 namespace py {
 
@@ -143,6 +144,111 @@ static PyObject* lwcobj_getTypeName(PyObject *pself, PyObject *) {
   return PyString_FromString(self->obj->getTypeName());
 }
 
+static PyObject* lwcobj_invalidateResults(PyObject *pself, PyObject *) {
+  PyLWCObject *self = (PyLWCObject*) pself;
+  if (!self->obj) {
+    PyErr_SetString(PyExc_RuntimeError, "lwcpy.Object: underlying object does not exists");
+    return NULL;
+  }
+  self->obj->invalidateResults();
+  Py_INCREF(Py_None);
+  return Py_None;
+}
+
+static PyObject* lwcobj_getResultStats(PyObject *pself, PyObject *) {
+  PyLWCObject *self = (PyLWCObject*) pself;
+  if (!self->obj) {
+    PyErr_SetString(PyExc_RuntimeError, "lwcpy.Object: underlying object does not exists");
+    return NULL;
+  }
+  unsigned long hits = 0, misses = 0;
+  self->obj->getResultStats(hits, misses);
+  return Py_BuildValue("(kk)", hits, misses);
+}
+
+// Signals: listeners (and queues) must be kept alive while connected
+
+static PyObject* lwcobj_availableSignals(PyObject *pself, PyObject *) {
+  PyLWCObject *self = (PyLWCObject*) pself;
+  if (!self->obj) {
+    PyErr_SetString(PyExc_RuntimeError, "lwcpy.Object: underlying object does not exists");
+    return NULL;
+  }
+  std::vector<std::string> names;
+  size_t n = (self->obj->getMethods() ? self->obj->getMethods()->availableSignals(names) : 0);
+  PyObject *sl = PyList_New(n);
+  for (size_t i=0; i<n; ++i) {
+    PyList_SetItem(sl, i, PyString_FromString(names[i].c_str()));
+  }
+  return sl;
+}
+
+static PyObject* lwcobj_connect(PyObject *pself, PyObject *args) {
+  PyLWCObject *self = (PyLWCObject*) pself;
+  if (!self->obj) {
+    PyErr_SetString(PyExc_RuntimeError, "lwcpy.Object: underlying object does not exists");
+    return NULL;
+  }
+  const char *signal = 0;
+  const char *slot = 0;
+  PyObject *listener = 0;
+  PyObject *queue = Py_None;
+  if (!PyArg_ParseTuple(args, "sO!s|O", &signal, &PyLWCObjectType, &listener, &slot, &queue)) {
+    return NULL;
+  }
+  if (queue != Py_None && !PyObject_TypeCheck(queue, &PyLWCSignalQueueType)) {
+    PyErr_SetString(PyExc_RuntimeError, "lwcpy.Object.connect: queue must be a lwcpy.SignalQueue or None");
+    return NULL;
+  }
+  try {
+    self->obj->connect(signal, ((PyLWCObject*)listener)->obj, slot,
+                       (queue == Py_None ? 0 : ((PyLWCSignalQueue*)queue)->queue));
+  } catch (std::runtime_error &e) {
+    PyErr_SetString(PyExc_RuntimeError, e.what());
+    return NULL;
+  }
+  Py_INCREF(Py_None);
+  return Py_None;
+}
+
+static PyObject* lwcobj_disconnect(PyObject *pself, PyObject *args) {
+  PyLWCObject *self = (PyLWCObject*) pself;
+  if (!self->obj) {
+    PyErr_SetString(PyExc_RuntimeError, "lwcpy.Object: underlying object does not exists");
+    return NULL;
+  }
+  const char *signal = 0;
+  const char *slot = 0;
+  PyObject *listener = 0;
+  if (!PyArg_ParseTuple(args, "sO!|z", &signal, &PyLWCObjectType, &listener, &slot)) {
+    return NULL;
+  }
+  size_t n = self->obj->disconnect(signal, ((PyLWCObject*)listener)->obj, slot);
+  return PyInt_FromLong(long(n));
+}
+
+// args: signal name, signal arguments...
+static PyObject* lwcobj_emit(PyObject *pself, PyObject *args) {
+  PyLWCObject *self = (PyLWCObject*) pself;
+  if (!self->obj) {
+    PyErr_SetString(PyExc_RuntimeError, "lwcpy.Object: underlying object does not exists");
+    return NULL;
+  }
+  if (PyTuple_Size(args) < 1 || !PyString_Check(PyTuple_GetItem(args, 0))) {
+    PyErr_SetString(PyExc_RuntimeError, "lwcpy.Object.emit: expected signal name and arguments");
+    return NULL;
+  }
+  lwc::Status status = lwc::SignalBridge<MarshalTraits>::Emit(self->obj, PyString_AsString(PyTuple_GetItem(args, 0)), args, 1);
+  if (status.failed()) {
+    if (!PyErr_Occurred()) {
+      PyErr_SetString(PyExc_RuntimeError, status.getMessage().c_str());
+    }
+    return NULL;
+  }
+  Py_INCREF(Py_None);
+  return Py_None;
+}
+
 static PyMethodDef lwcobj_methods[] = {
   {"getMethod", lwcobj_getMethod, METH_VARARGS, "Get method by name"},
   {"availableMethods", lwcobj_availableMethods, METH_VARARGS, "List available methods"},
@@ -150,10 +256,90 @@ static PyMethodDef lwcobj_methods[] = {
   {"getMethods", lwcobj_getMethods, METH_VARARGS, "Get object methods table"},
   {"getTypeName", lwcobj_getTypeName, METH_VARARGS, "Get object type name"},
   {"getLoaderName", lwcobj_getLoaderName, METH_VARARGS, "Get object loader name"},
+  {"invalidateResults", lwcobj_invalidateResults, METH_VARARGS, "Drop memoized results of pure methods"},
+  {"getResultStats", lwcobj_getResultStats, METH_VARARGS, "Get memoized results (hits, misses) counters"},
+  {"availableSignals", lwcobj_availableSignals, METH_VARARGS, "List available signals"},
+  {"connect", lwcobj_connect, METH_VARARGS, "Connect signal to a listener object method (signal, listener, slot, queue=None)"},
+  {"disconnect", lwcobj_disconnect, METH_VARARGS, "Disconnect signal from listener (signal, listener, slot=None), returns the number of connections removed"},
+  {"emit", lwcobj_emit, METH_VARARGS, "Emit signal (signal, arguments...)"},
   {NULL, NULL, 0, NULL}
 };
 
+// Properties are read and written straight from/to the object, no MethodParams
+// (see Object::readProperty)
+
+static PyObject* lwcobj_getprop(lwc::Object *obj, const lwc::Property *p) {
+  lwc::ArgumentValue v;
+  try {
+    obj->readProperty(*p, v);
+  } catch (std::exception &e) {
+    PyErr_SetString(PyExc_RuntimeError, e.what());
+    return NULL;
+  }
+  switch (p->getType()) {
+    case lwc::AT_BOOL:
+      return PyBool_FromLong(v.boolean ? 1 : 0);
+    case lwc::AT_INT:
+      return PyInt_FromLong(long(v.integer));
+    default:
+      return PyFloat_FromDouble(v.real);
+  }
+}
+
+static int lwcobj_setprop(lwc::Object *obj, const char *name, const lwc::Property *p, PyObject *value) {
+  if (!value) {
+    PyErr_Format(PyExc_AttributeError, "lwcpy.Object: cannot delete property \"%s\"", name);
+    return -1;
+  }
+  lwc::ArgumentValue v;
+  switch (p->getType()) {
+    case lwc::AT_BOOL:
+      if (!PyBool_Check(value)) {
+        PyErr_Format(PyExc_TypeError, "lwcpy.Object: bool value expected for property \"%s\"", name);
+        return -1;
+      }
+      v.boolean = (value == Py_True);
+      break;
+    case lwc::AT_INT:
+      if (!PyInt_Check(value) && !PyLong_Check(value)) {
+        PyErr_Format(PyExc_TypeError, "lwcpy.Object: integer value expected for property \"%s\"", name);
+        return -1;
+      }
+      v.integer = lwc::Integer(PyInt_Check(value) ? PyInt_AsLong(value) : PyLong_AsLongLong(value));
+      break;
+    default:
+      if (!PyFloat_Check(value) && !PyInt_Check(value) && !PyLong_Check(value)) {
+        PyErr_Format(PyExc_TypeError, "lwcpy.Object: real value expected for property \"%s\"", name);
+        return -1;
+      }
+      v.real = PyFloat_AsDouble(value);
+  }
+  if (PyErr_Occurred()) {
+    return -1;
+  }
+  bool written = false;
+  try {
+    written = obj->writeProperty(*p, v);
+  } catch (std::exception &e) {
+    PyErr_SetString(PyExc_RuntimeError, e.what());
+    return -1;
+  }
+  if (!written) {
+    PyErr_Format(PyExc_AttributeError, "lwcpy.Object: property \"%s\" is read only", name);
+    return -1;
+  }
+  return 0;
+}
+
 static PyObject* lwcobj_getattr(PyObject *pself, char *name) {
+  PyLWCObject *self = (PyLWCObject*) pself;
+  
+  // properties first: no python attribute lookup, no method call
+  const lwc::Property *prop = (self->obj ? self->obj->findProperty(name) : 0);
+  if (prop) {
+    return lwcobj_getprop(self->obj, prop);
+  }
+  
   // This one replace the "call" method
   PyObject *os = PyString_FromString(name);
   PyObject *o = PyObject_GenericGetAttr(pself, os);
@@ -161,7 +347,6 @@ static PyObject* lwcobj_getattr(PyObject *pself, char *name) {
   if (!o) {
     
     PyErr_Clear();
-    PyLWCObject *self = (PyLWCObject*) pself;
     
     if (!self->obj) {
       PyErr_SetString(PyExc_AttributeError, "lwcpy.Object: underlying object does not exists");
@@ -181,6 +366,20 @@ static PyObject* lwcobj_getattr(PyObject *pself, char *name) {
   return o;
 }
 
+static int lwcobj_setattr(PyObject *pself, char *name, PyObject *value) {
+  PyLWCObject *self = (PyLWCObject*) pself;
+  
+  const lwc::Property *prop = (self->obj ? self->obj->findProperty(name) : 0);
+  if (prop) {
+    return lwcobj_setprop(self->obj, name, prop, value);
+  }
+  
+  PyObject *os = PyString_FromString(name);
+  int rv = PyObject_GenericSetAttr(pself, os, value);
+  Py_DECREF(os);
+  return rv;
+}
+
 // ---
 
 bool InitObject(PyObject *m) {
@@ -197,6 +396,7 @@ bool InitObject(PyObject *m) {
   PyLWCObjectType.tp_dealloc = lwcobj_free;
   PyLWCObjectType.tp_methods = lwcobj_methods;
   PyLWCObjectType.tp_getattr = lwcobj_getattr;
+  PyLWCObjectType.tp_setattr = lwcobj_setattr;
   if (PyType_Ready(&PyLWCObjectType) < 0) {
     return false;
   }
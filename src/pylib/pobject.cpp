@@ -39,12 +39,94 @@ Object::~Object() {
   }
 }
 
-void Object::call(const char *name, lwc::MethodParams &params) throw(std::runtime_error) {
-  
+bool Object::recycle() {
   if (mSelf == 0) {
-    throw std::runtime_error("Underlying python object does not exist");
+    return false;
+  }
+  PyObject *func = PyObject_GetAttrString(mSelf, "recycle");
+  if (!func) {
+    PyErr_Clear();
+    return false;
+  }
+  PyObject *rv = PyObject_CallObject(func, NULL);
+  Py_DECREF(func);
+  if (!rv) {
+    PyErr_Print();
+    return false;
+  }
+  bool rc = (rv != Py_False);
+  Py_DECREF(rv);
+  return rc;
+}
+
+// Format the pending python exception and traceback, and raise it as a C++ exception
+static void RaisePythonError() throw(std::runtime_error) {
+  
+  std::ostringstream oss;
+  
+  PyObject *et=0, *ev=0, *etb=0, *s=0;
+  
+  PyErr_Fetch(&et, &ev, &etb);
+  
+  //s = PyObject_Str(et);
+  //oss << std::endl << "--- Python --- " << PyString_AsString(s);
+  //Py_DECREF(s);
+  
+  if (ev) {
+    s = PyObject_Str(ev);
+    oss << std::endl << "--- Python --- " << PyString_AsString(s);
+    Py_DECREF(s);
+  }
+  
+  if (etb) {
+    PyObject *tbmn = PyString_FromString("traceback");
+    PyObject *tbm = PyImport_Import(tbmn);
+    Py_DECREF(tbmn);
+    if (tbm) {
+      PyObject *mdict = PyModule_GetDict(tbm);
+      PyObject *func = PyDict_GetItemString(mdict, "format_tb"); // borrowed reference
+      if (func && PyCallable_Check(func)) {
+        PyObject *tbargs = PyTuple_New(1);
+        PyTuple_SetItem(tbargs, 0, etb);
+        PyObject *tbl = PyObject_CallObject(func, tbargs);
+        if (tbl) {
+          Py_ssize_t nf = PyList_Size(tbl);
+          for (Py_ssize_t f=0; f<nf; ++f) {
+            PyObject *fs = PyList_GetItem(tbl, f);
+            std::string lines = PyString_AsString(fs);
+            size_t p0 = 0, p1 = lines.find('\n', p0);
+            while (p1 != std::string::npos) {
+              std::string line = lines.substr(p0, p1-p0);
+              oss << std::endl << "--- Python --- " << line;
+              p0 = p1 + 1;
+              p1 = lines.find('\n', p0);
+            }
+            oss << std::endl << "--- Python --- " << lines.substr(p0);
+          }
+          Py_DECREF(tbl);
+        }
+        Py_DECREF(tbargs);
+      }
+      Py_DECREF(tbm);
+    }
   }
   
+  Py_XDECREF(et);
+  Py_XDECREF(ev);
+  Py_XDECREF(etb);
+  
+  oss << std::endl;
+  
+  // Should this be called? -> NO PyErr_Fetch does it
+  //PyErr_Clear();
+  
+  throw std::runtime_error(oss.str().c_str());
+}
+
+PyObject* Object::packArgs(lwc::MethodParams &params,
+                           std::map<size_t, size_t> &inoutArgs,
+                           std::map<size_t, size_t> &inoutInSizes) throw(std::runtime_error) {
+  
   const lwc::Method &meth = params.getMethod();
 
   size_t ninputs = 0;
@@ -62,9 +144,6 @@ void Object::call(const char *name, lwc::MethodParams &params) throw(std::runtim
   PyObject *args = PyTuple_New(ninputs);
   // no need to actually use keyword arguments
   
-  std::map<size_t, size_t> inoutArgs;
-  std::map<size_t, size_t> inoutInSizes;
-  
   Py_ssize_t cur = 0;
   
   for (size_t i=0; i<meth.numArgs(); ++i) {
@@ -222,78 +301,14 @@ void Object::call(const char *name, lwc::MethodParams &params) throw(std::runtim
     ++cur;
   }
   
-  // call python method
-  PyObject *func = PyObject_GetAttrString(mSelf, name);
-  if (!func) {
-    std::ostringstream oss;
-    oss << "Python object has no method named \"" << name << "\"";
-    throw std::runtime_error(oss.str());
-  }
-  // Check for errors
-  PyObject *rv = PyObject_CallObject(func, args);
-  Py_DECREF(func);
-  if (rv == NULL) {
-    // exception was raised
-    std::ostringstream oss;
-    
-    PyObject *et=0, *ev=0, *etb=0, *s=0;
-    
-    PyErr_Fetch(&et, &ev, &etb);
-    
-    //s = PyObject_Str(et);
-    //oss << std::endl << "--- Python --- " << PyString_AsString(s);
-    //Py_DECREF(s);
-    
-    if (ev) {
-      s = PyObject_Str(ev);
-      oss << std::endl << "--- Python --- " << PyString_AsString(s);
-      Py_DECREF(s);
-    }
-    
-    if (etb) {
-      PyObject *tbmn = PyString_FromString("traceback");
-      PyObject *tbm = PyImport_Import(tbmn);
-      Py_DECREF(tbmn);
-      if (tbm) {
-        PyObject *mdict = PyModule_GetDict(tbm);
-        PyObject *func = PyDict_GetItemString(mdict, "format_tb"); // borrowed reference
-        if (func && PyCallable_Check(func)) {
-          PyObject *tbargs = PyTuple_New(1);
-          PyTuple_SetItem(tbargs, 0, etb);
-          PyObject *tbl = PyObject_CallObject(func, tbargs);
-          if (tbl) {
-            Py_ssize_t nf = PyList_Size(tbl);
-            for (Py_ssize_t f=0; f<nf; ++f) {
-              PyObject *fs = PyList_GetItem(tbl, f);
-              std::string lines = PyString_AsString(fs);
-              size_t p0 = 0, p1 = lines.find('\n', p0);
-              while (p1 != std::string::npos) {
-                std::string line = lines.substr(p0, p1-p0);
-                oss << std::endl << "--- Python --- " << line;
-                p0 = p1 + 1;
-                p1 = lines.find('\n', p0);
-              }
-              oss << std::endl << "--- Python --- " << lines.substr(p0);
-            }
-            Py_DECREF(tbl);
-          }
-          Py_DECREF(tbargs);
-        }
-        Py_DECREF(tbm);
-      }
-    }
-    
-    Py_XDECREF(et);
-    Py_XDECREF(ev);
-    Py_XDECREF(etb);
-    
-    oss << std::endl;
-    
-    // Should this be called? -> NO PyErr_Fetch does it
-    //PyErr_Clear();
-    
-    throw std::runtime_error(oss.str().c_str());
-  }
+  return args;
+}
+
+void Object::unpackResult(lwc::MethodParams &params, PyObject *args, PyObject *rv,
+                          std::map<size_t, size_t> &inoutArgs,
+                          std::map<size_t, size_t> &inoutInSizes) throw(std::runtime_error) {
+  
+  const lwc::Method &meth = params.getMethod();
   
   // convert Python outputs to C
   
@@ -301,7 +316,7 @@ void Object::call(const char *name, lwc::MethodParams &params) throw(std::runtim
   // beware, the last is called by the caller to set the address of an output var
   // that will receive the value.
   
-  cur = 0;
+  Py_ssize_t cur = 0;
   bool tuple = (PyTuple_Check(rv) == 1);
   
   for (size_t i=0; i<meth.numArgs(); ++i) {
@@ -425,6 +440,39 @@ void Object::call(const char *name, lwc::MethodParams &params) throw(std::runtim
       }
       ++cur;
       
+      if (arg.getDir() == lwc::AD_RETURN) {
+        // stored in the parameters slot itself
+        switch(arg.getType()) {
+          case lwc::AT_BOOL: {
+            bool val = false;
+            Python2C<lwc::AT_BOOL>::ToValue(crv, val);
+            params.setReturn(val);
+            break;
+          }
+          case lwc::AT_INT: {
+            lwc::Integer val = 0;
+            Python2C<lwc::AT_INT>::ToValue(crv, val);
+            params.setReturn(val);
+            break;
+          }
+          case lwc::AT_REAL: {
+            lwc::Real val = 0.0;
+            Python2C<lwc::AT_REAL>::ToValue(crv, val);
+            params.setReturn(val);
+            break;
+          }
+          case lwc::AT_OBJECT: {
+            lwc::Object *val = 0;
+            Python2C<lwc::AT_OBJECT>::ToValue(crv, val);
+            params.setReturn(val);
+            break;
+          }
+          default:
+            throw std::runtime_error("Invalid return argument type");
+        }
+        continue;
+      }
+      
       switch(arg.getType()) {
         case lwc::AT_BOOL: {
           bool *val;
@@ -462,8 +510,169 @@ void Object::call(const char *name, lwc::MethodParams &params) throw(std::runtim
     }
     
   }
+}
+
+void Object::invoke(const char *name, lwc::MethodParams &params) throw(std::runtime_error) {
+  
+  if (mSelf == 0) {
+    throw std::runtime_error("Underlying python object does not exist");
+  }
+  
+  std::map<size_t, size_t> inoutArgs;
+  std::map<size_t, size_t> inoutInSizes;
+  
+  PyObject *args = packArgs(params, inoutArgs, inoutInSizes);
   
+  // call python method
+  PyObject *func = PyObject_GetAttrString(mSelf, name);
+  if (!func) {
+    PyErr_Clear();
+    Py_DECREF(args);
+    std::ostringstream oss;
+    oss << "Python object has no method named \"" << name << "\"";
+    throw std::runtime_error(oss.str());
+  }
+  // Check for errors
+  PyObject *rv = PyObject_CallObject(func, args);
+  Py_DECREF(func);
+  if (rv == NULL) {
+    // exception was raised
+    Py_DECREF(args);
+    RaisePythonError();
+  }
+  
+  // outputs are copied to C, rv and args can go once unpacked
+  try {
+    unpackResult(params, args, rv, inoutArgs, inoutInSizes);
+  } catch (...) {
+    Py_DECREF(rv);
+    Py_DECREF(args);
+    throw;
+  }
+  
+  Py_DECREF(rv);
   Py_DECREF(args);
 }
 
+void Object::invokeBatch(const char *name, const lwc::Method &meth, lwc::MethodParams **params, size_t n) throw(std::runtime_error) {
+  
+  if (mSelf == 0) {
+    throw std::runtime_error("Underlying python object does not exist");
+  }
+  
+  for (size_t i=0; i<n; ++i) {
+    CheckBatchParams(name, meth, params, i);
+  }
+  
+  std::vector< std::map<size_t, size_t> > inoutArgs(n);
+  std::vector< std::map<size_t, size_t> > inoutInSizes(n);
+  
+  // "<name>_batch" receives the list of argument tuples and returns the list
+  // of results (or None when the method has no outputs)
+  std::string bname = std::string(name) + "_batch";
+  
+  PyObject *func = PyObject_GetAttrString(mSelf, bname.c_str());
+  
+  if (!func) {
+    
+    PyErr_Clear();
+    
+    // no batch hook: resolve the method once and call it for each set
+    func = PyObject_GetAttrString(mSelf, name);
+    if (!func) {
+      PyErr_Clear();
+      std::ostringstream oss;
+      oss << "Python object has no method named \"" << name << "\"";
+      throw std::runtime_error(oss.str());
+    }
+    
+    for (size_t i=0; i<n; ++i) {
+      PyObject *args = 0;
+      try {
+        args = packArgs(*(params[i]), inoutArgs[i], inoutInSizes[i]);
+      } catch (...) {
+        Py_DECREF(func);
+        throw;
+      }
+      PyObject *rv = PyObject_CallObject(func, args);
+      if (rv == NULL) {
+        Py_DECREF(args);
+        Py_DECREF(func);
+        RaisePythonError();
+      }
+      try {
+        unpackResult(*(params[i]), args, rv, inoutArgs[i], inoutInSizes[i]);
+      } catch (...) {
+        Py_DECREF(rv);
+        Py_DECREF(args);
+        Py_DECREF(func);
+        throw;
+      }
+      Py_DECREF(rv);
+      Py_DECREF(args);
+    }
+    
+    Py_DECREF(func);
+    return;
+  }
+  
+  PyObject *batch = PyList_New(Py_ssize_t(n));
+  if (!batch) {
+    Py_DECREF(func);
+    RaisePythonError();
+  }
+  
+  try {
+    for (size_t i=0; i<n; ++i) {
+      // PyList_SetItem steals the reference
+      PyList_SetItem(batch, Py_ssize_t(i), packArgs(*(params[i]), inoutArgs[i], inoutInSizes[i]));
+    }
+  } catch (...) {
+    Py_DECREF(batch);
+    Py_DECREF(func);
+    throw;
+  }
+  
+  PyObject *bargs = PyTuple_New(1);
+  if (!bargs) {
+    Py_DECREF(batch);
+    Py_DECREF(func);
+    RaisePythonError();
+  }
+  // PyTuple_SetItem steals the reference, batch is kept alive for inout arguments
+  Py_INCREF(batch);
+  PyTuple_SetItem(bargs, 0, batch);
+  
+  PyObject *rv = PyObject_CallObject(func, bargs);
+  Py_DECREF(bargs);
+  Py_DECREF(func);
+  
+  if (rv == NULL) {
+    Py_DECREF(batch);
+    RaisePythonError();
+  }
+  
+  if (rv != Py_None && (!PyList_Check(rv) || PyList_Size(rv) != Py_ssize_t(n))) {
+    Py_DECREF(rv);
+    Py_DECREF(batch);
+    std::ostringstream oss;
+    oss << "Python method \"" << bname << "\" should return a list of " << n << " result(s) or None";
+    throw std::runtime_error(oss.str());
+  }
+  
+  try {
+    for (size_t i=0; i<n; ++i) {
+      PyObject *crv = (rv == Py_None ? Py_None : PyList_GetItem(rv, Py_ssize_t(i)));
+      unpackResult(*(params[i]), PyList_GetItem(batch, Py_ssize_t(i)), crv, inoutArgs[i], inoutInSizes[i]);
+    }
+  } catch (...) {
+    Py_DECREF(rv);
+    Py_DECREF(batch);
+    throw;
+  }
+  
+  Py_DECREF(rv);
+  Py_DECREF(batch);
+}
+
 }
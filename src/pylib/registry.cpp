@@ -247,6 +247,91 @@ static PyObject* lwcreg_docString(PyObject *, PyObject *args, PyObject *kwargs)
   return PyString_FromString(reg->docString(name, indent).c_str());
 }
 
+static PyObject* lwcreg_broadcast(PyObject *, PyObject *args, PyObject *kwargs) {
+  lwc::Registry *reg = lwc::Registry::Instance();
+  if (!reg) {
+    PyErr_SetString(PyExc_RuntimeError, "lwcpy.Registry has not yet been initialized");
+    return NULL;
+  }
+  Py_ssize_t nargs = PyTuple_Size(args);
+  if (nargs < 2) {
+    PyErr_SetString(PyExc_RuntimeError, "Expected a sequence of lwcpy.Object and a method name");
+    return NULL;
+  }
+  PyObject *seq = PySequence_Fast(PyTuple_GetItem(args, 0), "Expected a sequence of lwcpy.Object");
+  if (!seq) {
+    return NULL;
+  }
+  PyObject *pname = PyTuple_GetItem(args, 1);
+  if (!PyString_Check(pname)) {
+    Py_DECREF(seq);
+    PyErr_SetString(PyExc_RuntimeError, "Expected a string method name");
+    return NULL;
+  }
+  Py_ssize_t n = PySequence_Fast_GET_SIZE(seq);
+  std::vector<lwc::Object*> objects(n, 0);
+  for (Py_ssize_t i=0; i<n; ++i) {
+    PyObject *item = PySequence_Fast_GET_ITEM(seq, i);
+    if (!PyObject_TypeCheck(item, &PyLWCObjectType) || !((PyLWCObject*)item)->obj) {
+      Py_DECREF(seq);
+      PyErr_SetString(PyExc_RuntimeError, "Expected a sequence of lwcpy.Object");
+      return NULL;
+    }
+    objects[i] = ((PyLWCObject*)item)->obj;
+  }
+  Py_DECREF(seq);
+  if (n == 0) {
+    Py_INCREF(Py_None);
+    return Py_None;
+  }
+  // python objects are called on this thread, the lock is kept
+  lwc::parallel::Broadcast target(reg->getExecutor(), &objects[0], size_t(n));
+  lwc::CallSiteCache sites(1);
+  PyObject *cargs = PyTuple_GetSlice(args, 2, nargs);
+  // method arguments are built as for a call on the first object
+  PyObject *rv = CallMethod(&target, objects[0]->getMethods(), PyString_AsString(pname), sites, cargs, kwargs);
+  Py_DECREF(cargs);
+  return rv;
+}
+
+static PyObject* lwcreg_setPool(PyObject *, PyObject *args) {
+  lwc::Registry *reg = lwc::Registry::Instance();
+  if (!reg) {
+    PyErr_SetString(PyExc_RuntimeError, "lwcpy.Registry has not yet been initialized");
+    return NULL;
+  }
+  const char *name;
+  unsigned long maxSize, warmUp = 0;
+  if (!PyArg_ParseTuple(args, "sk|k", &name, &maxSize, &warmUp)) {
+    return NULL;
+  }
+  return PyBool_FromLong(reg->setPool(name, size_t(maxSize), size_t(warmUp)) ? 1 : 0);
+}
+
+static PyObject* lwcreg_getPoolStats(PyObject *, PyObject *args) {
+  lwc::Registry *reg = lwc::Registry::Instance();
+  if (!reg) {
+    PyErr_SetString(PyExc_RuntimeError, "lwcpy.Registry has not yet been initialized");
+    return NULL;
+  }
+  const char *name;
+  if (!PyArg_ParseTuple(args, "s", &name)) {
+    return NULL;
+  }
+  lwc::PoolStats stats;
+  if (!reg->getPoolStats(name, stats)) {
+    Py_INCREF(Py_None);
+    return Py_None;
+  }
+  return Py_BuildValue("{s:k,s:k,s:k,s:k,s:k,s:k}",
+                       "size", (unsigned long) stats.size,
+                       "maxSize", (unsigned long) stats.maxSize,
+                       "reused", stats.reused,
+                       "allocated", stats.allocated,
+                       "recycled", stats.recycled,
+                       "discarded", stats.discarded);
+}
+
 static PyMethodDef lwcreg_methods[] = {
   {"addLoaderPath", lwcreg_addLoaderPath, METH_VARARGS, "Add path to look loaders for"},
   {"addModulePath", lwcreg_addModulePath, METH_VARARGS, "Add path to look modules for"},
@@ -259,6 +344,9 @@ static PyMethodDef lwcreg_methods[] = {
   {"destroy", lwcreg_destroy, METH_VARARGS, "Destroy an object"},
   {"getDescription", lwcreg_getDesc, METH_VARARGS, "Get type description"},
   {"docString", (PyCFunction) lwcreg_docString, METH_VARARGS|METH_KEYWORDS, "Get type documentation string"},
+  {"broadcast", (PyCFunction) lwcreg_broadcast, METH_VARARGS|METH_KEYWORDS, "Call a method on all objects of a sequence"},
+  {"setPool", lwcreg_setPool, METH_VARARGS, "Keep up to maxSize destroyed objects of a type for reuse, warmUp are created upfront (maxSize 0 removes the pool)"},
+  {"getPoolStats", lwcreg_getPoolStats, METH_VARARGS, "Get type pool counters dict (size, maxSize, reused, allocated, recycled, discarded) or None"},
   {NULL, NULL, 0, NULL}
 };
 
@@ -0,0 +1,136 @@
+/*
+
+Copyright (C) 2009, 2010  Gaetan Guidet
+
+This file is part of lwc.
+
+lwc is free software; you can redistribute it and/or modify it
+under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 2.1 of the License, or (at
+your option) any later version.
+
+lwc is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+USA.
+
+*/
+
+#include <lwc/python/types.h>
+
+namespace py {
+
+PyTypeObject PyLWCSignalQueueType;
+
+// ---
+
+// the queue exists even if __init__ is not called
+static PyObject* lwcsigqueue_new(PyTypeObject *type, PyObject *, PyObject *) {
+  PyLWCSignalQueue *self = (PyLWCSignalQueue*) type->tp_alloc(type, 0);
+  if (!self) {
+    return NULL;
+  }
+  self->queue = new lwc::SignalQueue();
+  return (PyObject*)self;
+}
+
+static int lwcsigqueue_init(PyObject *pself, PyObject *args, PyObject *) {
+  PyLWCSignalQueue *self = (PyLWCSignalQueue*) pself;
+  long capacity = 0;
+  if (!PyArg_ParseTuple(args, "|l", &capacity)) {
+    return -1;
+  }
+  if (PyTuple_Size(args) == 0) {
+    return 0;
+  }
+  if (capacity <= 0) {
+    PyErr_SetString(PyExc_RuntimeError, "lwcpy.SignalQueue: capacity must be positive");
+    return -1;
+  }
+  // removes the connections using the previous queue
+  delete self->queue;
+  self->queue = new lwc::SignalQueue(size_t(capacity));
+  return 0;
+}
+
+static void lwcsigqueue_free(PyObject *pself) {
+  PyLWCSignalQueue *self = (PyLWCSignalQueue*) pself;
+  if (self->queue) {
+    delete self->queue;
+  }
+  pself->ob_type->tp_free(pself);
+}
+
+static PyObject* lwcsigqueue_process(PyObject *pself, PyObject *args) {
+  PyLWCSignalQueue *self = (PyLWCSignalQueue*) pself;
+  long maxEvents = 0;
+  if (!PyArg_ParseTuple(args, "|l", &maxEvents)) {
+    return NULL;
+  }
+  size_t n = self->queue->process(maxEvents > 0 ? size_t(maxEvents) : 0);
+  return PyInt_FromLong(long(n));
+}
+
+static PyObject* lwcsigqueue_depth(PyObject *pself, PyObject *) {
+  PyLWCSignalQueue *self = (PyLWCSignalQueue*) pself;
+  return PyInt_FromLong(long(self->queue->depth()));
+}
+
+static PyObject* lwcsigqueue_capacity(PyObject *pself, PyObject *) {
+  PyLWCSignalQueue *self = (PyLWCSignalQueue*) pself;
+  return PyInt_FromLong(long(self->queue->capacity()));
+}
+
+static PyObject* lwcsigqueue_getStats(PyObject *pself, PyObject *) {
+  PyLWCSignalQueue *self = (PyLWCSignalQueue*) pself;
+  lwc::SignalStats stats;
+  self->queue->getStats(stats);
+  return Py_BuildValue("{s:k,s:k,s:k,s:k,s:k,s:d,s:d}",
+                       "queued", stats.queued,
+                       "dropped", stats.dropped,
+                       "delivered", stats.delivered,
+                       "failed", stats.failed,
+                       "depth", stats.depth,
+                       "totalLatency", stats.totalLatency,
+                       "maxLatency", stats.maxLatency);
+}
+
+static PyMethodDef lwcsigqueue_methods[] = {
+  {"process", lwcsigqueue_process, METH_VARARGS, "Deliver queued events (at most n, all by default), returns the number of events processed"},
+  {"depth", lwcsigqueue_depth, METH_VARARGS, "Get number of queued events"},
+  {"capacity", lwcsigqueue_capacity, METH_VARARGS, "Get maximum number of queued events"},
+  {"getStats", lwcsigqueue_getStats, METH_VARARGS, "Get queue counters dict (queued, dropped, delivered, failed, depth, totalLatency, maxLatency)"},
+  {NULL, NULL, 0, NULL}
+};
+
+// ---
+
+bool InitSignalQueue(PyObject *m) {
+  
+  memset(&PyLWCSignalQueueType, 0, sizeof(PyTypeObject));
+  PyLWCSignalQueueType.ob_refcnt = 1;
+  PyLWCSignalQueueType.ob_size = 0;
+  PyLWCSignalQueueType.tp_name = "lwcpy.SignalQueue";
+  PyLWCSignalQueueType.tp_basicsize = sizeof(PyLWCSignalQueue);
+  PyLWCSignalQueueType.tp_flags = Py_TPFLAGS_DEFAULT;
+  PyLWCSignalQueueType.tp_doc = "Signal delivery queue class";
+  PyLWCSignalQueueType.tp_new = lwcsigqueue_new;
+  PyLWCSignalQueueType.tp_init = lwcsigqueue_init;
+  PyLWCSignalQueueType.tp_dealloc = lwcsigqueue_free;
+  PyLWCSignalQueueType.tp_methods = lwcsigqueue_methods;
+  if (PyType_Ready(&PyLWCSignalQueueType) < 0) {
+    return false;
+  }
+  
+  Py_INCREF((PyObject*) &PyLWCSignalQueueType);
+  PyModule_AddObject(m, "SignalQueue", (PyObject*)&PyLWCSignalQueueType);
+  
+  return true;
+}
+
+}
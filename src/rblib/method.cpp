@@ -166,6 +166,8 @@ bool InitMethod(VALUE mod) {
   rb_define_method(cLWCMethod, "description", RBM(rbmeth_getDesc), 0);
   rb_define_method(cLWCMethod, "description=", RBM(rbmeth_setDesc), 1);
   rb_define_method(cLWCMethod, "docString", RBM(rbmeth_docString), -1);
+  rb_define_const(mod, "MF_NONE", INT2NUM(lwc::MF_NONE));
+  rb_define_const(mod, "MF_PURE", INT2NUM(lwc::MF_PURE));
   return true;
 }
 
@@ -28,8 +28,18 @@ USA.
 
 namespace rb {
 
+// Raise ruby error for the outermost call only, inner calls just report
+// the failure so that every level of the recursion frees its converted values
+static VALUE CallFailed(int cArg, const lwc::Status &status) {
+  if (cArg == 0) {
+    rb_raise(rb_eRuntimeError, "%s", status.getMessage().c_str());
+  }
+  return Qnil;
+}
+
 VALUE CallMethod(lwc::Object *o, const char *n, lwc::MethodParams &params, int cArg,
-                 VALUE *args, VALUE kwargs, size_t nargs, size_t rbArg, std::map<size_t,size_t> &arraySizes) throw(std::runtime_error) {
+                 VALUE *args, VALUE kwargs, size_t nargs, size_t rbArg, std::map<size_t,size_t> &arraySizes,
+                 lwc::Status &status) {
   
   //std::cout << "rb::CallMethod(\"" << n << "\", " << cArg << ", " << nargs << ", " << rbArg << ")" << std::endl;
   const lwc::Method &m = params.getMethod();
@@ -37,16 +47,16 @@ VALUE CallMethod(lwc::Object *o, const char *n, lwc::MethodParams &params, int c
   if (m.numArgs() == size_t(cArg)) {
     
     if (rbArg != nargs) {
-      if (cArg == 0) {
-        rb_raise(rb_eRuntimeError, "Invalid arguments. None expected");
-        return Qnil;
-      } else {
-        throw std::runtime_error("Invalid arugments. None expected");
-      }
+      status.setFailed(n, "Invalid arguments. None expected");
+      return CallFailed(cArg, status);
     }
     
     //std::cout << "  " << cArg << ": call C++ proxy" << std::endl;
-    o->call(n, params);
+    status = o->tryCall(n, params);
+    
+    if (status.failed()) {
+      return CallFailed(cArg, status);
+    }
     
     if (m.numArgs() == 0) {
       return Qnil;
@@ -61,12 +71,31 @@ VALUE CallMethod(lwc::Object *o, const char *n, lwc::MethodParams &params, int c
     const lwc::Argument &ad = m[cArg];
     
     if (!ad.isArray() && ad.getDir() == lwc::AD_INOUT) {
+      status.setFailed(n, "inout non array arguments not supported in ruby");
+      return CallFailed(cArg, status);
+    }
+    
+    if (ad.getDir() == lwc::AD_RETURN) {
+      // last argument: the method fills the slot, no temporary to bind
+      if (rbArg != nargs) {
+        status.setFailed(n, "Invalid arguments. None expected");
+        return CallFailed(cArg, status);
+      }
+      
+      status = o->tryCall(n, params);
+      
+      if (status.failed()) {
+        return CallFailed(cArg, status);
+      }
+      
       if (cArg == 0) {
-        rb_raise(rb_eRuntimeError, "inout non array arguments not supported in ruby");
-        return Qnil;
-      } else {
-        throw std::runtime_error("inout non array arguments not supported in ruby");
+        // single result, returned as is
+        return ReturnToRuby(params, 0);
       }
+      
+      rv = rb_ary_new();
+      rb_ary_push(rv, ReturnToRuby(params, size_t(cArg)));
+      return rv;
     }
     
     // PreCallArray will increment rbArg if necessarys
@@ -80,22 +109,17 @@ VALUE CallMethod(lwc::Object *o, const char *n, lwc::MethodParams &params, int c
           bool *ary=0;
           const lwc::Argument &sad = m[ad.arraySizeArg()];
           if (ParamConverter<lwc::AT_BOOL>::PreCallArray(ad, cArg, sad, args, kwargs, nargs, rbArg, arraySizes, ary, err)) {
-            try {
-              if (ad.getDir() == lwc::AD_IN) {
-                params.set(cArg, ary, false);
-              } else {
-                params.set(cArg, &ary, false);
-              }
-            } catch (std::exception &e) {
-              err = e.what();
-              failed = true;
+            if (ad.getDir() == lwc::AD_IN) {
+              failed = !params.trySet(cArg, ary, status, false);
+            } else {
+              failed = !params.trySet(cArg, &ary, status, false);
             }
-            if (!failed) {
-              try {
-                rv = CallMethod(o, n, params, cArg+1, args, kwargs, nargs, rbArg, arraySizes);
-              } catch (std::exception &e) {
+            if (failed) {
+              status.setMethodName(n);
+            } else {
+              rv = CallMethod(o, n, params, cArg+1, args, kwargs, nargs, rbArg, arraySizes, status);
+              if (status.failed()) {
                 rv = Qnil;
-                err = e.what();
                 failed = true;
               }
             }
@@ -108,22 +132,17 @@ VALUE CallMethod(lwc::Object *o, const char *n, lwc::MethodParams &params, int c
         } else {
           bool val;
           if (ParamConverter<lwc::AT_BOOL>::PreCall(ad, cArg, args, kwargs, nargs, rbArg, arraySizes, val, err)) {
-            try {
-              if (ad.getDir() == lwc::AD_IN) {
-                params.set(cArg, val, false);
-              } else {
-                params.set(cArg, &val, false);
-              }
-            } catch (std::exception &e) {
-              err = e.what();
-              failed = true;
+            if (ad.getDir() == lwc::AD_IN) {
+              failed = !params.trySet(cArg, val, status, false);
+            } else {
+              failed = !params.trySet(cArg, &val, status, false);
             }
-            if (!failed) {
-              try {
-                rv = CallMethod(o, n, params, cArg+1, args, kwargs, nargs, rbArg, arraySizes);
-              } catch (std::exception &e) {
+            if (failed) {
+              status.setMethodName(n);
+            } else {
+              rv = CallMethod(o, n, params, cArg+1, args, kwargs, nargs, rbArg, arraySizes, status);
+              if (status.failed()) {
                 rv = Qnil;
-                err = e.what();
                 failed = true;
               }
             }
@@ -140,22 +159,17 @@ VALUE CallMethod(lwc::Object *o, const char *n, lwc::MethodParams &params, int c
           lwc::Integer *ary=0;
           const lwc::Argument &sad = m[ad.arraySizeArg()];
           if (ParamConverter<lwc::AT_INT>::PreCallArray(ad, cArg, sad, args, kwargs, nargs, rbArg, arraySizes, ary, err)) {
-            try {
-              if (ad.getDir() == lwc::AD_IN) {
-                params.set(cArg, ary, false);
-              } else {
-                params.set(cArg, &ary, false);
-              }
-            } catch (std::exception &e) {
-              err = e.what();
-              failed = true;
+            if (ad.getDir() == lwc::AD_IN) {
+              failed = !params.trySet(cArg, ary, status, false);
+            } else {
+              failed = !params.trySet(cArg, &ary, status, false);
             }
-            if (!failed) {
-              try {
-                rv = CallMethod(o, n, params, cArg+1, args, kwargs, nargs, rbArg, arraySizes);
-              } catch (std::exception &e) {
+            if (failed) {
+              status.setMethodName(n);
+            } else {
+              rv = CallMethod(o, n, params, cArg+1, args, kwargs, nargs, rbArg, arraySizes, status);
+              if (status.failed()) {
                 rv = Qnil;
-                err = e.what();
                 failed = true;
               }
             }
@@ -168,22 +182,17 @@ VALUE CallMethod(lwc::Object *o, const char *n, lwc::MethodParams &params, int c
         } else {
           lwc::Integer val;
           if (ParamConverter<lwc::AT_INT>::PreCall(ad, cArg, args, kwargs, nargs, rbArg, arraySizes, val, err)) {
-            try {
-              if (ad.getDir() == lwc::AD_IN) {
-                params.set(cArg, val, false);
-              } else {
-                params.set(cArg, &val, false);
-              }
-            } catch (std::exception &e) {
-              err = e.what();
-              failed = true;
+            if (ad.getDir() == lwc::AD_IN) {
+              failed = !params.trySet(cArg, val, status, false);
+            } else {
+              failed = !params.trySet(cArg, &val, status, false);
             }
-            if (!failed) {
-              try {
-                rv = CallMethod(o, n, params, cArg+1, args, kwargs, nargs, rbArg, arraySizes);
-              } catch (std::exception &e) {
+            if (failed) {
+              status.setMethodName(n);
+            } else {
+              rv = CallMethod(o, n, params, cArg+1, args, kwargs, nargs, rbArg, arraySizes, status);
+              if (status.failed()) {
                 rv = Qnil;
-                err = e.what();
                 failed = true;
               }
             }
@@ -200,22 +209,17 @@ VALUE CallMethod(lwc::Object *o, const char *n, lwc::MethodParams &params, int c
           lwc::Real *ary=0;
           const lwc::Argument &sad = m[ad.arraySizeArg()];
           if (ParamConverter<lwc::AT_REAL>::PreCallArray(ad, cArg, sad, args, kwargs, nargs, rbArg, arraySizes, ary, err)) {
-            try {
-              if (ad.getDir() == lwc::AD_IN) {
-                params.set(cArg, ary, false);
-              } else {
-                params.set(cArg, &ary, false);
-              }
-            } catch (std::exception &e) {
-              err = e.what();
-              failed = true;
+            if (ad.getDir() == lwc::AD_IN) {
+              failed = !params.trySet(cArg, ary, status, false);
+            } else {
+              failed = !params.trySet(cArg, &ary, status, false);
             }
-            if (!failed) {
-              try {
-                rv = CallMethod(o, n, params, cArg+1, args, kwargs, nargs, rbArg, arraySizes);
-              } catch (std::exception &e) {
+            if (failed) {
+              status.setMethodName(n);
+            } else {
+              rv = CallMethod(o, n, params, cArg+1, args, kwargs, nargs, rbArg, arraySizes, status);
+              if (status.failed()) {
                 rv = Qnil;
-                err = e.what();
                 failed = true;
               }
             }
@@ -228,22 +232,17 @@ VALUE CallMethod(lwc::Object *o, const char *n, lwc::MethodParams &params, int c
         } else {
           lwc::Real val;
           if (ParamConverter<lwc::AT_REAL>::PreCall(ad, cArg, args, kwargs, nargs, rbArg, arraySizes, val, err)) {
-            try {
-              if (ad.getDir() == lwc::AD_IN) {
-                params.set(cArg, val, false);
-              } else {
-                params.set(cArg, &val, false);
-              }
-            } catch (std::exception &e) {
-              err = e.what();
-              failed = true;
+            if (ad.getDir() == lwc::AD_IN) {
+              failed = !params.trySet(cArg, val, status, false);
+            } else {
+              failed = !params.trySet(cArg, &val, status, false);
             }
-            if (!failed) {
-              try {
-                rv = CallMethod(o, n, params, cArg+1, args, kwargs, nargs, rbArg, arraySizes);
-              } catch (std::exception &e) {
+            if (failed) {
+              status.setMethodName(n);
+            } else {
+              rv = CallMethod(o, n, params, cArg+1, args, kwargs, nargs, rbArg, arraySizes, status);
+              if (status.failed()) {
                 rv = Qnil;
-                err = e.what();
                 failed = true;
               }
             }
@@ -260,22 +259,17 @@ VALUE CallMethod(lwc::Object *o, const char *n, lwc::MethodParams &params, int c
           char **ary=0;
           const lwc::Argument &sad = m[ad.arraySizeArg()];
           if (ParamConverter<lwc::AT_STRING>::PreCallArray(ad, cArg, sad, args, kwargs, nargs, rbArg, arraySizes, ary, err)) {
-            try {
-              if (ad.getDir() == lwc::AD_IN) {
-                params.set(cArg, ary, false);
-              } else {
-                params.set(cArg, &ary, false);
-              }
-            } catch (std::exception &e) {
-              err = e.what();
-              failed = true;
+            if (ad.getDir() == lwc::AD_IN) {
+              failed = !params.trySet(cArg, ary, status, false);
+            } else {
+              failed = !params.trySet(cArg, &ary, status, false);
             }
-            if (!failed) {
-              try {
-                rv = CallMethod(o, n, params, cArg+1, args, kwargs, nargs, rbArg, arraySizes);
-              } catch (std::exception &e) {
+            if (failed) {
+              status.setMethodName(n);
+            } else {
+              rv = CallMethod(o, n, params, cArg+1, args, kwargs, nargs, rbArg, arraySizes, status);
+              if (status.failed()) {
                 rv = Qnil;
-                err = e.what();
                 failed = true;
               }
             }
@@ -288,22 +282,17 @@ VALUE CallMethod(lwc::Object *o, const char *n, lwc::MethodParams &params, int c
         } else {
           char *val;
           if (ParamConverter<lwc::AT_STRING>::PreCall(ad, cArg, args, kwargs, nargs, rbArg, arraySizes, val, err)) {
-            try {
-              if (ad.getDir() == lwc::AD_IN) {
-                params.set(cArg, val, false);
-              } else {
-                params.set(cArg, &val, false);
-              }
-            } catch (std::exception &e) {
-              err = e.what();
-              failed = true;
+            if (ad.getDir() == lwc::AD_IN) {
+              failed = !params.trySet(cArg, val, status, false);
+            } else {
+              failed = !params.trySet(cArg, &val, status, false);
             }
-            if (!failed) {
-              try {
-                rv = CallMethod(o, n, params, cArg+1, args, kwargs, nargs, rbArg, arraySizes);
-              } catch (std::exception &e) {
+            if (failed) {
+              status.setMethodName(n);
+            } else {
+              rv = CallMethod(o, n, params, cArg+1, args, kwargs, nargs, rbArg, arraySizes, status);
+              if (status.failed()) {
                 rv = Qnil;
-                err = e.what();
                 failed = true;
               }
             }
@@ -320,22 +309,17 @@ VALUE CallMethod(lwc::Object *o, const char *n, lwc::MethodParams &params, int c
           lwc::Object **ary=0;
           const lwc::Argument &sad = m[ad.arraySizeArg()];
           if (ParamConverter<lwc::AT_OBJECT>::PreCallArray(ad, cArg, sad, args, kwargs, nargs, rbArg, arraySizes, ary, err)) {
-            try {
-              if (ad.getDir() == lwc::AD_IN) {
-                params.set(cArg, ary, false);
-              } else {
-                params.set(cArg, &ary, false);
-              }
-            } catch (std::exception &e) {
-              err = e.what();
-              failed = true;
+            if (ad.getDir() == lwc::AD_IN) {
+              failed = !params.trySet(cArg, ary, status, false);
+            } else {
+              failed = !params.trySet(cArg, &ary, status, false);
             }
-            if (!failed) {
-              try {
-                rv = CallMethod(o, n, params, cArg+1, args, kwargs, nargs, rbArg, arraySizes);
-              } catch (std::exception &e) {
+            if (failed) {
+              status.setMethodName(n);
+            } else {
+              rv = CallMethod(o, n, params, cArg+1, args, kwargs, nargs, rbArg, arraySizes, status);
+              if (status.failed()) {
                 rv = Qnil;
-                err = e.what();
                 failed = true;
               }
             }
@@ -348,22 +332,17 @@ VALUE CallMethod(lwc::Object *o, const char *n, lwc::MethodParams &params, int c
         } else {
           lwc::Object *val=0;
           if (ParamConverter<lwc::AT_OBJECT>::PreCall(ad, cArg, args, kwargs, nargs, rbArg, arraySizes, val, err)) {
-            try {
-              if (ad.getDir() == lwc::AD_IN) {
-                params.set(cArg, val, false);
-              } else {
-                params.set(cArg, &val, false);
-              }
-            } catch (std::exception &e) {
-              err = e.what();
-              failed = true;
+            if (ad.getDir() == lwc::AD_IN) {
+              failed = !params.trySet(cArg, val, status, false);
+            } else {
+              failed = !params.trySet(cArg, &val, status, false);
             }
-            if (!failed) {
-              try {
-                rv = CallMethod(o, n, params, cArg+1, args, kwargs, nargs, rbArg, arraySizes);
-              } catch (std::exception &e) {
+            if (failed) {
+              status.setMethodName(n);
+            } else {
+              rv = CallMethod(o, n, params, cArg+1, args, kwargs, nargs, rbArg, arraySizes, status);
+              if (status.failed()) {
                 rv = Qnil;
-                err = e.what();
                 failed = true;
               }
             }
@@ -382,12 +361,11 @@ VALUE CallMethod(lwc::Object *o, const char *n, lwc::MethodParams &params, int c
     
     if (failed) {
       std::cout << "Return Qnil because of param convertion failure" << std::endl;
-      if (cArg == 0) {
-        rb_raise(rb_eRuntimeError, err.c_str());
-        return Qnil;
-      } else {
-        throw std::runtime_error(err.c_str());
+      // conversion errors are only known at this level
+      if (status.succeeded()) {
+        status.setFailed(n, err.c_str());
       }
+      return CallFailed(cArg, status);
     }
     
     if (cArg == 0)  {
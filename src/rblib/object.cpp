@@ -24,7 +24,9 @@ USA.
 #include <lwc/ruby/types.h>
 #include <lwc/ruby/utils.h>
 #include <lwc/ruby/methodcall.h>
+#include <lwc/ruby/convert.h>
 #include <lwc/ruby/rbobject.h>
+#include <lwc/marshal.h>
 
 namespace rb {
 
@@ -120,6 +122,50 @@ static VALUE rbobj_getTypeName(VALUE self) {
   return rb_str_new2(obj->getTypeName());
 }
 
+static VALUE rbobj_invalidateResults(VALUE self) {
+  lwc::Object *obj = 0;
+  rb::Exc::GetPointer(self, obj);
+  obj->invalidateResults();
+  return self;
+}
+
+static VALUE rbobj_getResultStats(VALUE self) {
+  lwc::Object *obj = 0;
+  rb::Exc::GetPointer(self, obj);
+  unsigned long hits = 0, misses = 0;
+  obj->getResultStats(hits, misses);
+  VALUE rv = rb_ary_new2(2);
+  rb_ary_push(rv, ULONG2NUM(hits));
+  rb_ary_push(rv, ULONG2NUM(misses));
+  return rv;
+}
+
+// Marshaling stub call (see lwc::Marshal), false when the generic conversion
+// is needed. The C++ values live in this frame only: failures are returned as
+// a ruby exception in exc for the caller to raise
+static bool CallStub(lwc::Object *obj, const char *methodName, VALUE *argv, size_t nargs,
+                     VALUE &rv, VALUE &exc) {
+  lwc::Status status;
+  const lwc::Method *m = obj->findMethod(methodName, status);
+  if (!m) {
+    exc = rb_exc_new2(rb_eRuntimeError, status.getMessage().c_str());
+    return true;
+  }
+  lwc::Marshal<MarshalTraits>::Stub stub = lwc::Marshal<MarshalTraits>::Find(*m);
+  if (!stub) {
+    return false;
+  }
+  lwc::MethodParams params(*m);
+  MarshalArgs margs = {argv, nargs};
+  if (!stub(obj, methodName, params, margs, status, rv)) {
+    return false;
+  }
+  if (rv == MarshalTraits::Error) {
+    exc = rb_exc_new2(rb_eRuntimeError, status.getMessage().c_str());
+  }
+  return true;
+}
+
 static VALUE rbobj_mmissing(int argc, VALUE *argv, VALUE self) {
   // first argument is the method name
   // last argument can be a Hash
@@ -136,6 +182,72 @@ static VALUE rbobj_mmissing(int argc, VALUE *argv, VALUE self) {
   
   size_t nargs = (size_t) (argc - (NIL_P(kwargs) ? 1 : 2));
   
+  // properties: "name" reads, "name=" writes the object value directly
+  if (argc <= 2 && obj) {
+    size_t len = strlen(methodName);
+    bool assign = (argc == 2 && len > 1 && methodName[len-1] == '=');
+    const lwc::Property *prop = 0;
+    if (assign) {
+      std::string pn(methodName, len-1);
+      prop = obj->findProperty(pn.c_str());
+    } else if (argc == 1) {
+      prop = obj->findProperty(methodName);
+    }
+    if (prop) {
+      lwc::ArgumentValue v;
+      VALUE rv = Qnil;
+      std::string error;
+      if (!assign) {
+        try {
+          obj->readProperty(*prop, v);
+        } catch (std::exception &e) {
+          error = e.what();
+        }
+        if (error.length() > 0) {
+          rb_raise(rb_eRuntimeError, "%s", error.c_str());
+        }
+        switch (prop->getType()) {
+          case lwc::AT_BOOL: CType<bool>::ToRuby(v.boolean, rv); break;
+          case lwc::AT_INT: CType<lwc::Integer>::ToRuby(v.integer, rv); break;
+          default: CType<lwc::Real>::ToRuby(v.real, rv);
+        }
+        return rv;
+      }
+      switch (prop->getType()) {
+        case lwc::AT_BOOL:
+          if (!RubyType<bool>::Check(argv[1])) {
+            rb_raise(rb_eTypeError, "RLWC::Object: boolean value expected for property \"%s\"", methodName);
+          }
+          RubyType<bool>::ToC(argv[1], v.boolean);
+          break;
+        case lwc::AT_INT:
+          if (!RubyType<lwc::Integer>::Check(argv[1])) {
+            rb_raise(rb_eTypeError, "RLWC::Object: integer value expected for property \"%s\"", methodName);
+          }
+          RubyType<lwc::Integer>::ToC(argv[1], v.integer);
+          break;
+        default:
+          if (!RubyType<lwc::Real>::Check(argv[1])) {
+            rb_raise(rb_eTypeError, "RLWC::Object: real value expected for property \"%s\"", methodName);
+          }
+          RubyType<lwc::Real>::ToC(argv[1], v.real);
+      }
+      bool written = false;
+      try {
+        written = obj->writeProperty(*prop, v);
+      } catch (std::exception &e) {
+        error = e.what();
+      }
+      if (error.length() > 0) {
+        rb_raise(rb_eRuntimeError, "%s", error.c_str());
+      }
+      if (!written) {
+        rb_raise(rb_eRuntimeError, "RLWC::Object: property \"%s\" is read only", methodName);
+      }
+      return argv[1];
+    }
+  }
+  
   //if (!strcmp(obj->getLoaderName(), "rbloader")) {
   //  std::cout << "  Is a ruby object" << std::endl;
   //  return rb_funcall2(((RbObject*)obj)->self(), rb_intern(methodName), argc-1, argv+1);
@@ -149,19 +261,30 @@ LWCRB_API VALUE CallMethod(lwc::Object *o, const char *n,
                              std::map<size_t,size_t> &arraySizes) throw(std::runtime_error)
      */
     
-    try {
-      const lwc::Method &m = obj->getMethod(methodName);
-      std::map<size_t, size_t> arraySizes;
-      lwc::MethodParams params(m);
-      if (nargs == 0) {
-        return CallMethod(obj, methodName, params, 0, NULL, kwargs, 0, 0, arraySizes);
-      } else {
-        return CallMethod(obj, methodName, params, 0, argv+1, kwargs, nargs, 0, arraySizes);
+    if (NIL_P(kwargs)) {
+      // common signatures skip the generic conversion
+      VALUE rv = Qnil;
+      VALUE exc = Qnil;
+      if (CallStub(obj, methodName, argv+1, nargs, rv, exc)) {
+        if (!NIL_P(exc)) {
+          rb_exc_raise(exc);
+        }
+        return rv;
       }
-    } catch (std::runtime_error &e) {
-      rb_raise(rb_eRuntimeError, e.what());
+    }
+    lwc::Status status;
+    const lwc::Method *m = obj->findMethod(methodName, status);
+    if (!m) {
+      rb_raise(rb_eRuntimeError, "%s", status.getMessage().c_str());
       return Qnil;
     }
+    lwc::MethodParams params(*m);
+    std::map<size_t, size_t> arraySizes;
+    if (nargs == 0) {
+      return CallMethod(obj, methodName, params, 0, NULL, kwargs, 0, 0, arraySizes, status);
+    } else {
+      return CallMethod(obj, methodName, params, 0, argv+1, kwargs, nargs, 0, arraySizes, status);
+    }
   //}
 }
 
@@ -175,6 +298,8 @@ bool InitObject(VALUE mod) {
   rb_define_method(cLWCObject, "getMethods", RBM(rbobj_getMethods), 0);
   rb_define_method(cLWCObject, "getLoaderName", RBM(rbobj_getLoaderName), 0);
   rb_define_method(cLWCObject, "getTypeName", RBM(rbobj_getTypeName), 0);
+  rb_define_method(cLWCObject, "invalidateResults", RBM(rbobj_invalidateResults), 0);
+  rb_define_method(cLWCObject, "getResultStats", RBM(rbobj_getResultStats), 0);
   rb_define_method(cLWCObject, "method_missing", RBM(rbobj_mmissing), -1);
   return true;
 }
@@ -57,7 +57,7 @@ Object::~Object() {
   }
 }
 
-void Object::call(const char *name, lwc::MethodParams &params) throw(std::runtime_error) {
+void Object::invoke(const char *name, lwc::MethodParams &params) throw(std::runtime_error) {
   
   if (mSelf == Qnil) {
     throw std::runtime_error("Underlying ruby object does not exist");
@@ -417,6 +417,39 @@ void Object::call(const char *name, lwc::MethodParams &params) throw(std::runtim
       }
       ++cur;
       
+      if (arg.getDir() == lwc::AD_RETURN) {
+        // stored in the parameters slot itself
+        switch(arg.getType()) {
+          case lwc::AT_BOOL: {
+            bool val = false;
+            Ruby2C<lwc::AT_BOOL>::ToValue(crv, val);
+            params.setReturn(val);
+            break;
+          }
+          case lwc::AT_INT: {
+            lwc::Integer val = 0;
+            Ruby2C<lwc::AT_INT>::ToValue(crv, val);
+            params.setReturn(val);
+            break;
+          }
+          case lwc::AT_REAL: {
+            lwc::Real val = 0.0;
+            Ruby2C<lwc::AT_REAL>::ToValue(crv, val);
+            params.setReturn(val);
+            break;
+          }
+          case lwc::AT_OBJECT: {
+            lwc::Object *val = 0;
+            Ruby2C<lwc::AT_OBJECT>::ToValue(crv, val);
+            params.setReturn(val);
+            break;
+          }
+          default:
+            throw std::runtime_error("Invalid return argument type");
+        }
+        continue;
+      }
+      
       switch(arg.getType()) {
         case lwc::AT_BOOL: {
           bool *val;
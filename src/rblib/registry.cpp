@@ -23,6 +23,7 @@ USA.
 
 #include <lwc/ruby/types.h>
 #include <lwc/ruby/utils.h>
+#include <lwc/ruby/methodcall.h>
 #include <lwc/ruby/rbobject.h>
 
 namespace rb {
@@ -230,6 +231,49 @@ static VALUE rbreg_destroy(VALUE self, VALUE robj) {
   return self;
 }
 
+static VALUE rbreg_broadcast(int argc, VALUE *argv, VALUE) {
+  // objects array, method name, method arguments (last one can be a Hash)
+  if (argc < 2) {
+    rb_raise(rb_eArgError, "RLWC::Registry.broadcast expects an array of objects and a method name");
+  }
+  lwc::Registry *reg = lwc::Registry::Instance();
+  if (!reg) {
+    rb_raise(rb_eRuntimeError, "lwc::Registry has not yet been initialized");
+  }
+  VALUE robjs = rb_check_array_type(argv[0]);
+  if (NIL_P(robjs)) {
+    rb_raise(rb_eTypeError, "RLWC::Registry.broadcast expects an array as first argument");
+  }
+  VALUE sname = rb_check_string_type(argv[1]);
+  if (NIL_P(sname)) {
+    rb_raise(rb_eTypeError, "RLWC::Registry.broadcast expects a string as second argument");
+  }
+  char *name = RSTRING(sname)->ptr;
+  long n = RARRAY(robjs)->len;
+  if (n == 0) {
+    return Qnil;
+  }
+  std::vector<lwc::Object*> objects(n, 0);
+  for (long i=0; i<n; ++i) {
+    rb::Exc::GetTypedPointer(RARRAY(robjs)->ptr[i], objects[i], cLWCObject);
+  }
+  VALUE kwargs = Qnil;
+  if (argc > 2) {
+    kwargs = rb_check_convert_type(argv[argc-1], T_HASH, "Hash", "to_hash");
+  }
+  size_t nargs = (size_t) (argc - (NIL_P(kwargs) ? 2 : 3));
+  lwc::Status status;
+  const lwc::Method *m = objects[0]->findMethod(name, status);
+  if (!m) {
+    rb_raise(rb_eRuntimeError, "%s", status.getMessage().c_str());
+  }
+  // method arguments are built as for a call on the first object
+  lwc::parallel::Broadcast target(reg->getExecutor(), &objects[0], size_t(n));
+  std::map<size_t, size_t> arraySizes;
+  lwc::MethodParams params(*m);
+  return CallMethod(&target, name, params, 0, (nargs == 0 ? NULL : argv+2), kwargs, nargs, 0, arraySizes, status);
+}
+
 bool InitRegistry(VALUE mod) {
   cLWCRegistry = rb_define_class_under(mod, "Registry", rb_cObject);
   rb_define_alloc_func(cLWCRegistry, rbreg_alloc);
@@ -245,6 +289,7 @@ bool InitRegistry(VALUE mod) {
   rb_define_method(cLWCRegistry, "destroy", RBM(rbreg_destroy), 1);
   rb_define_method(cLWCRegistry, "docString", RBM(rbreg_docString), -1);
   rb_define_method(cLWCRegistry, "getDescription", RBM(rbreg_getDesc), 1);
+  rb_define_method(cLWCRegistry, "broadcast", RBM(rbreg_broadcast), -1);
   return true;
 }
 
@@ -0,0 +1,797 @@
+/*
+
+Copyright (C) 2009, 2010  Gaetan Guidet
+
+This file is part of lwc.
+
+lwc is free software; you can redistribute it and/or modify it
+under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 2.1 of the License, or (at
+your option) any later version.
+
+lwc is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+USA.
+
+*/
+
+#include <lwc/object.h>
+#include <lwc/registry.h>
+#include <lwc/capi.h>
+#include <lwc/future.h>
+#include <lwc/actor.h>
+#include <lwc/cmdbuffer.h>
+#include <lwc/signal.h>
+#include "../modules/box.h"
+#ifdef _WIN32
+# include <windows.h>
+#else
+# include <sys/time.h>
+#endif
+
+using lwc::Integer;
+
+// ---
+
+static double Now() {
+#ifdef _WIN32
+  LARGE_INTEGER freq, count;
+  QueryPerformanceFrequency(&freq);
+  QueryPerformanceCounter(&count);
+  return double(count.QuadPart) / double(freq.QuadPart);
+#else
+  struct timeval tv;
+  gettimeofday(&tv, 0);
+  return double(tv.tv_sec) + 1.0e-6 * double(tv.tv_usec);
+#endif
+}
+
+static void Report(const char *what, size_t count, double elapsed) {
+  std::cout << what << ": " << count << " calls in " << elapsed << "s ("
+            << (1.0e9 * elapsed / double(count)) << " ns/call)" << std::endl;
+}
+
+// ---
+
+static void BenchHandles(lwc::Registry *reg, size_t count) {
+  lwc::Object *b = reg->create("test.Box");
+  if (!b) {
+    std::cout << "test.Box not registered" << std::endl;
+    return;
+  }
+  
+  Integer val = 0;
+  double t0, t1;
+  
+  std::cout << "=== By name vs by handle (test.Box)" << std::endl;
+  
+  t0 = Now();
+  for (size_t i=0; i<count; ++i) {
+    b->call("setX", Integer(i));
+    b->call("getX", &val);
+  }
+  t1 = Now();
+  Report("by name  ", 2*count, t1-t0);
+  
+  lwc::MethodHandle setX = b->getMethodHandle("setX");
+  lwc::MethodHandle getX = reg->getMethodHandle("test.Box", "getX");
+  
+  t0 = Now();
+  for (size_t i=0; i<count; ++i) {
+    b->call(setX, Integer(i));
+    b->call(getX, &val);
+  }
+  t1 = Now();
+  Report("by handle", 2*count, t1-t0);
+  
+  reg->destroy(b);
+}
+
+static void BenchInherited(lwc::Registry *reg, size_t count) {
+  lwc::Object *b = reg->create("test.Box");
+  lwc::Object *db = reg->create("test.DoubleBox");
+  if (!b || !db) {
+    std::cout << "test.Box or test.DoubleBox not registered" << std::endl;
+    if (b) reg->destroy(b);
+    if (db) reg->destroy(db);
+    return;
+  }
+  
+  Integer val = 0;
+  double t0, t1;
+  
+  std::cout << "=== Own vs inherited method by name (getX)" << std::endl;
+  
+  t0 = Now();
+  for (size_t i=0; i<count; ++i) {
+    b->call("getX", &val);
+  }
+  t1 = Now();
+  Report("test.Box      ", count, t1-t0);
+  
+  t0 = Now();
+  for (size_t i=0; i<count; ++i) {
+    db->call("getX", &val);
+  }
+  t1 = Now();
+  Report("test.DoubleBox", count, t1-t0);
+  
+  reg->destroy(db);
+  reg->destroy(b);
+}
+
+static void BenchCallSite(lwc::Registry *reg, size_t count) {
+  lwc::Object *b = reg->create("test.Box");
+  if (!b) {
+    std::cout << "test.Box not registered" << std::endl;
+    return;
+  }
+  
+  double t0, t1;
+  
+  // Box::set has two named arguments with default values
+  lwc::Integer pos[2] = {10, 10};
+  
+  lwc::KeywordArgs kwargs;
+  kwargs.set("scale", 2.0);
+  
+  std::cout << "=== Keyword arguments by name vs call site (test.Box.set)" << std::endl;
+  
+  // Box::set traces its calls, silence it while timing
+  std::streambuf *out = std::cout.rdbuf(0);
+  
+  t0 = Now();
+  for (size_t i=0; i<count; ++i) {
+    b->call("set", pos, kwargs);
+  }
+  t1 = Now();
+  std::cout.rdbuf(out);
+  std::cout.clear();
+  Report("by name  ", count, t1-t0);
+  
+  lwc::CallSite site(b->getMethodHandle("set"), 1, kwargs);
+  
+  out = std::cout.rdbuf(0);
+  t0 = Now();
+  for (size_t i=0; i<count; ++i) {
+    b->call(site, pos, kwargs);
+  }
+  t1 = Now();
+  std::cout.rdbuf(out);
+  std::cout.clear();
+  Report("call site", count, t1-t0);
+  
+  reg->destroy(b);
+}
+
+// Time a loop of single calls against one callBatch over the same parameter sets
+static void BenchBatchParams(lwc::Object *o, const char *method, std::vector<lwc::MethodParams*> &params) {
+  size_t count = params.size();
+  double t0, t1;
+  
+  t0 = Now();
+  for (size_t i=0; i<count; ++i) {
+    o->call(method, *(params[i]));
+  }
+  t1 = Now();
+  Report("single calls", count, t1-t0);
+  
+  t0 = Now();
+  o->callBatch(method, &(params[0]), count);
+  t1 = Now();
+  Report("batch       ", count, t1-t0);
+  
+  for (size_t i=0; i<count; ++i) {
+    delete params[i];
+  }
+  params.clear();
+}
+
+static void BenchBatch(lwc::Registry *reg, size_t count) {
+  std::vector<lwc::MethodParams*> params;
+  
+  lwc::Object *b = reg->create("test.Box");
+  if (!b) {
+    std::cout << "test.Box not registered" << std::endl;
+    return;
+  }
+  
+  std::cout << "=== Single calls vs batch (test.Box.setX)" << std::endl;
+  
+  const lwc::Method &setX = b->getMethod("setX");
+  for (size_t i=0; i<count; ++i) {
+    params.push_back(new lwc::MethodParams(setX));
+    params.back()->set(0, Integer(i));
+  }
+  BenchBatchParams(b, "setX", params);
+  
+  // script components: fewer calls, the interpreter dominates
+  count = count / 10;
+  
+  if (reg->hasType("pytest.ObjectList")) {
+    lwc::Object *ol = reg->create("pytest.ObjectList");
+    
+    std::cout << "=== Single calls vs batch (pytest.ObjectList.at)" << std::endl;
+    
+    ol->call("push", b);
+    
+    std::vector<lwc::Object*> results(count);
+    
+    const lwc::Method &at = ol->getMethod("at");
+    for (size_t i=0; i<count; ++i) {
+      params.push_back(new lwc::MethodParams(at));
+      params.back()->set(0, Integer(0));
+      params.back()->set(1, &(results[i]));
+    }
+    BenchBatchParams(ol, "at", params);
+    
+    reg->destroy(ol);
+  }
+  
+  if (reg->hasType("luatest.Dict")) {
+    lwc::Object *d = reg->create("luatest.Dict");
+    
+    std::cout << "=== Single calls vs batch (luatest.Dict.set)" << std::endl;
+    
+    static const char *keys[] = {"a", "b", "c", "d", "e", "f", "g", "h"};
+    
+    const lwc::Method &set = d->getMethod("set");
+    for (size_t i=0; i<count; ++i) {
+      params.push_back(new lwc::MethodParams(set));
+      params.back()->set(0, keys[i % 8]);
+      params.back()->set(1, keys[(i + 1) % 8]);
+    }
+    BenchBatchParams(d, "set", params);
+    
+    reg->destroy(d);
+  }
+  
+  reg->destroy(b);
+}
+
+static void BenchBroadcast(lwc::Registry *reg, size_t count) {
+  size_t nobjs = count / 10;
+  size_t nrounds = 10;
+  double t0, t1;
+  
+  std::vector<lwc::Object*> boxes;
+  for (size_t i=0; i<nobjs; ++i) {
+    boxes.push_back(reg->create("test.Box"));
+  }
+  
+  std::cout << "=== Loop vs broadcast (test.Box.setX, " << nobjs << " objects, "
+            << reg->getExecutor()->numWorkers() << " worker(s))" << std::endl;
+  
+  lwc::MethodHandle setX = reg->getMethodHandle("test.Box", "setX");
+  lwc::MethodParams params(setX.getMethod());
+  params.set(0, Integer(3));
+  
+  t0 = Now();
+  for (size_t r=0; r<nrounds; ++r) {
+    for (size_t i=0; i<nobjs; ++i) {
+      boxes[i]->call(setX, Integer(r));
+    }
+  }
+  t1 = Now();
+  Report("loop     ", nrounds*nobjs, t1-t0);
+  
+  t0 = Now();
+  for (size_t r=0; r<nrounds; ++r) {
+    reg->broadcast(&(boxes[0]), nobjs, setX, params);
+  }
+  t1 = Now();
+  Report("broadcast", nrounds*nobjs, t1-t0);
+  
+  for (size_t i=0; i<nobjs; ++i) {
+    reg->destroy(boxes[i]);
+  }
+}
+
+static void BenchProperties(lwc::Registry *reg, size_t count) {
+  lwc::Object *b = reg->create("test.Box");
+  lwc::Object *d = reg->create("test.DoubleBox");
+  
+  Integer val = 0;
+  double t0, t1;
+  
+  std::cout << "=== Methods vs properties (test.Box x, test.DoubleBox width)" << std::endl;
+  
+  lwc::MethodHandle setX = b->getMethodHandle("setX");
+  lwc::MethodHandle getX = b->getMethodHandle("getX");
+  
+  t0 = Now();
+  for (size_t i=0; i<count; ++i) {
+    b->call(setX, Integer(i));
+    b->call(getX, &val);
+  }
+  t1 = Now();
+  Report("methods  ", 2*count, t1-t0);
+  
+  const lwc::Property *x = b->findProperty("x");
+  const lwc::Property *w = d->findProperty("width");
+  lwc::ArgumentValue v;
+  
+  t0 = Now();
+  for (size_t i=0; i<count; ++i) {
+    v.integer = Integer(i);
+    x->set(b, v);
+    x->get(b, v);
+  }
+  t1 = Now();
+  Report("field    ", 2*count, t1-t0);
+  
+  t0 = Now();
+  for (size_t i=0; i<count; ++i) {
+    v.integer = Integer(i);
+    w->set(d, v);
+    w->get(d, v);
+  }
+  t1 = Now();
+  Report("accessors", 2*count, t1-t0);
+  
+  t0 = Now();
+  for (size_t i=0; i<count; ++i) {
+    b->setProperty("x", Integer(i));
+    val = b->getProperty<Integer>("x");
+  }
+  t1 = Now();
+  Report("by name  ", 2*count, t1-t0);
+  
+  reg->destroy(b);
+  reg->destroy(d);
+}
+
+static void BenchInterface(lwc::Registry *reg, size_t count) {
+  lwc::Object *b = reg->create("test.Box");
+  
+  Integer val = 0;
+  double t0, t1;
+  
+  std::cout << "=== Methods vs native interface (test.Box setX/getX)" << std::endl;
+  
+  lwc::MethodHandle setX = b->getMethodHandle("setX");
+  lwc::MethodHandle getX = b->getMethodHandle("getX");
+  
+  t0 = Now();
+  for (size_t i=0; i<count; ++i) {
+    b->call(setX, Integer(i));
+    b->call(getX, &val);
+  }
+  t1 = Now();
+  Report("methods  ", 2*count, t1-t0);
+  
+  IBox *ib = b->queryInterface<IBox>();
+  
+  t0 = Now();
+  for (size_t i=0; i<count; ++i) {
+    ib->x(Integer(i));
+    val = ib->x();
+  }
+  t1 = Now();
+  Report("interface", 2*count, t1-t0);
+  
+  reg->destroy(b);
+}
+
+static void BenchReturn(lwc::Registry *reg, size_t count) {
+  lwc::Object *b = reg->create("test.Box");
+  
+  Integer val = 0;
+  double t0, t1;
+  
+  std::cout << "=== Return value (test.Box getX)" << std::endl;
+  
+  lwc::MethodHandle getX = b->getMethodHandle("getX");
+  
+  t0 = Now();
+  for (size_t i=0; i<count; ++i) {
+    b->call(getX, &val);
+  }
+  t1 = Now();
+  Report("pointer  ", count, t1-t0);
+  
+  // parameters built once, the value is read back from the return slot
+  lwc::MethodParams params(getX.getMethod());
+  
+  t0 = Now();
+  for (size_t i=0; i<count; ++i) {
+    b->call(getX, params);
+    val = params.getReturn<Integer>();
+  }
+  t1 = Now();
+  Report("slot     ", count, t1-t0);
+  
+  reg->destroy(b);
+}
+
+static void BenchAutoBinding(lwc::Registry *reg, size_t count) {
+  lwc::Object *b = reg->create("test.Box");
+  
+  double t0, t1;
+  
+  std::cout << "=== Auto binding (test.Box, parameters built once)" << std::endl;
+  
+  lwc::MethodHandle setX = b->getMethodHandle("setX");
+  lwc::MethodParams setXParams(setX.getMethod());
+  setXParams.set(0, Integer(1));
+  
+  t0 = Now();
+  for (size_t i=0; i<count; ++i) {
+    b->call(setX, setXParams);
+  }
+  t1 = Now();
+  Report("setX (MethodParams)", count, t1-t0);
+  
+  lwc::MethodHandle move = b->getMethodHandle("move");
+  lwc::MethodParams moveParams(move.getMethod());
+  moveParams.set(0, Integer(1));
+  moveParams.set(1, Integer(1));
+  
+  t0 = Now();
+  for (size_t i=0; i<count; ++i) {
+    b->call(move, moveParams);
+  }
+  t1 = Now();
+  Report("move (auto)        ", count, t1-t0);
+  
+  reg->destroy(b);
+}
+
+static void BenchInterceptors(lwc::Registry *reg, size_t count) {
+  lwc::Object *b = reg->create("test.Box");
+  
+  lwc::Interceptor nop;
+  double t0, t1;
+  
+  std::cout << "=== Interceptors (test.Box setX)" << std::endl;
+  
+  lwc::MethodHandle setX = b->getMethodHandle("setX");
+  
+  t0 = Now();
+  for (size_t i=0; i<count; ++i) {
+    b->call(setX, Integer(i));
+  }
+  t1 = Now();
+  Report("none installed ", count, t1-t0);
+  
+  reg->addInterceptor(&nop, "test.DoubleBox");
+  
+  t0 = Now();
+  for (size_t i=0; i<count; ++i) {
+    b->call(setX, Integer(i));
+  }
+  t1 = Now();
+  Report("other type     ", count, t1-t0);
+  
+  reg->addInterceptor(&nop, "test.Box");
+  
+  t0 = Now();
+  for (size_t i=0; i<count; ++i) {
+    b->call(setX, Integer(i));
+  }
+  t1 = Now();
+  Report("no-op          ", count, t1-t0);
+  
+  reg->removeInterceptor(&nop);
+  
+  reg->destroy(b);
+}
+
+static void BenchCApi(lwc::Registry *reg, size_t count) {
+  lwc::Object *b = reg->create("test.Box");
+  
+  double t0, t1;
+  
+  std::cout << "=== C interface (test.Box setX, getX)" << std::endl;
+  
+  lwc::MethodHandle setX = b->getMethodHandle("setX");
+  
+  t0 = Now();
+  for (size_t i=0; i<count; ++i) {
+    b->tryCall(setX, Integer(i));
+  }
+  t1 = Now();
+  Report("setX (tryCall) ", count, t1-t0);
+  
+  lwc_registry *creg = reinterpret_cast<lwc_registry*>(reg);
+  lwc_object *cb = reinterpret_cast<lwc_object*>(b);
+  lwc_method *csetX = lwc_method_lookup(creg, "test.Box", "setX");
+  lwc_method *cgetX = lwc_method_lookup(creg, "test.Box", "getX");
+  lwc_value args[1];
+  
+  t0 = Now();
+  for (size_t i=0; i<count; ++i) {
+    args[0].integer = Integer(i);
+    lwc_call(cb, csetX, args, 1);
+  }
+  t1 = Now();
+  Report("setX (lwc_call)", count, t1-t0);
+  
+  t0 = Now();
+  for (size_t i=0; i<count; ++i) {
+    lwc_call(cb, cgetX, args, 1);
+  }
+  t1 = Now();
+  Report("getX (lwc_call)", count, t1-t0);
+  
+  lwc_method_release(csetX);
+  lwc_method_release(cgetX);
+  
+  reg->destroy(b);
+}
+
+static void BenchAsync(lwc::Registry *reg, size_t count) {
+  const size_t n = 16;
+  
+  std::vector<lwc::Object*> boxes(n);
+  std::vector<lwc::Future*> futures(n);
+  Integer total = 0;
+  double t0, t1;
+  
+  std::cout << "=== Asynchronous calls (" << n << " test.Box sample, "
+            << reg->getExecutor()->numWorkers() << " workers)" << std::endl;
+  
+  for (size_t i=0; i<n; ++i) {
+    boxes[i] = reg->create("test.Box");
+    boxes[i]->call("setWidth", 512);
+    boxes[i]->call("setHeight", 512);
+  }
+  
+  lwc::MethodHandle sample = boxes[0]->getMethodHandle("sample");
+  
+  t0 = Now();
+  for (size_t i=0; i<n; ++i) {
+    Integer hits = 0;
+    boxes[i]->call(sample, Integer(count), &hits);
+    total += hits;
+  }
+  t1 = Now();
+  Report("call     ", n, t1-t0);
+  
+  t0 = Now();
+  for (size_t i=0; i<n; ++i) {
+    futures[i] = boxes[i]->callAsync(sample, Integer(count));
+  }
+  for (size_t i=0; i<n; ++i) {
+    total -= futures[i]->getReturn<Integer>();
+    delete futures[i];
+  }
+  t1 = Now();
+  Report("callAsync", n, t1-t0);
+  
+  if (total != 0) {
+    std::cout << "*** Results differ" << std::endl;
+  }
+  
+  for (size_t i=0; i<n; ++i) {
+    reg->destroy(boxes[i]);
+  }
+}
+
+static void BenchActors(lwc::Registry *reg, size_t count) {
+  lwc::Object *b = reg->create("test.Box");
+  
+  lwc::MailboxStats stats;
+  Integer x = 0;
+  double t0, t1;
+  
+  // cross thread calls are much slower, keep the run short
+  count = (count >= 10 ? count / 10 : 1);
+  
+  std::cout << "=== Actors (test.Box setX)" << std::endl;
+  
+  lwc::MethodHandle setX = b->getMethodHandle("setX");
+  lwc::MethodParams params(setX.getMethod());
+  params.set(0, Integer(1));
+  
+  t0 = Now();
+  for (size_t i=0; i<count; ++i) {
+    b->call(setX, params);
+  }
+  t1 = Now();
+  Report("direct        ", count, t1-t0);
+  
+  lwc::Mailbox mailbox(1024);
+  b->setMailbox(&mailbox);
+  
+  t0 = Now();
+  for (size_t i=0; i<count; ++i) {
+    b->call(setX, params);
+  }
+  t1 = Now();
+  Report("send (wait)   ", count, t1-t0);
+  
+  t0 = Now();
+  for (size_t i=0; i<count; ++i) {
+    b->post(setX, params);
+  }
+  // queued after the posted calls
+  b->call("getX", &x);
+  t1 = Now();
+  Report("post (no wait)", count, t1-t0);
+  
+  mailbox.getStats(stats);
+  std::cout << "max depth " << stats.maxDepth << ", stalls " << stats.stalls << std::endl;
+  
+  b->setMailbox(0);
+  
+  reg->destroy(b);
+}
+
+// Replay cost of a recorded setter/getter sequence against the same direct calls
+static void BenchCommandBuffer(lwc::Registry *reg, size_t count) {
+  lwc::Object *b = reg->create("test.Box");
+  
+  lwc::CommandBuffer buffer;
+  Integer w = 0, h = 0;
+  double t0, t1;
+  
+  std::cout << "=== Command buffer (test.Box setWidth, setHeight, move, getSize)" << std::endl;
+  
+  count /= 4;
+  
+  t0 = Now();
+  for (size_t i=0; i<count; ++i) {
+    b->call("setWidth", Integer(2));
+    b->call("setHeight", Integer(3));
+    b->call("move", Integer(4), Integer(5));
+    b->call("getSize", &w, &h);
+  }
+  t1 = Now();
+  Report("call  ", 4*count, t1-t0);
+  
+  buffer.setInput(buffer.record(b, "setWidth"), 0, Integer(2));
+  buffer.setInput(buffer.record(b, "setHeight"), 0, Integer(3));
+  size_t move = buffer.record(b, "move");
+  buffer.setInput(move, 0, Integer(4));
+  buffer.setInput(move, 1, Integer(5));
+  size_t getSize = buffer.record(b, "getSize");
+  
+  t0 = Now();
+  for (size_t i=0; i<count; ++i) {
+    buffer.submit();
+    w = buffer.get<Integer>(getSize, 0);
+  }
+  t1 = Now();
+  Report("submit", 4*count, t1-t0);
+  
+  reg->destroy(b);
+}
+
+static void BenchSignals(lwc::Registry *reg, size_t count) {
+  lwc::Object *b = reg->create("test.Box");
+  lwc::Object *l = reg->create("test.Box");
+  
+  lwc::SignalQueue queue(1024);
+  lwc::SignalStats stats;
+  double t0, t1;
+  
+  std::cout << "=== Signals (test.Box resized -> test.Box move)" << std::endl;
+  
+  t0 = Now();
+  for (size_t i=0; i<count; ++i) {
+    b->emit("resized", Integer(1), Integer(2));
+  }
+  t1 = Now();
+  Report("no listener", count, t1-t0);
+  
+  b->connect("resized", l, "move");
+  t0 = Now();
+  for (size_t i=0; i<count; ++i) {
+    b->emit("resized", Integer(1), Integer(2));
+  }
+  t1 = Now();
+  Report("direct     ", count, t1-t0);
+  b->disconnectAll();
+  
+  // emit batches of 512 events then drain them
+  b->connect("resized", l, "move", &queue);
+  t0 = Now();
+  for (size_t i=0; i<count; ++i) {
+    b->emit("resized", Integer(1), Integer(2));
+    if ((i & 511) == 511) {
+      queue.process();
+    }
+  }
+  queue.process();
+  t1 = Now();
+  Report("queued     ", count, t1-t0);
+  b->disconnectAll();
+  
+  queue.getStats(stats);
+  std::cout << "queued " << stats.queued << ", dropped " << stats.dropped << ", average latency "
+            << (stats.delivered ? 1.0e6 * stats.totalLatency / double(stats.delivered) : 0.0) << " us, max "
+            << (1.0e6 * stats.maxLatency) << " us" << std::endl;
+  
+  reg->destroy(l);
+  reg->destroy(b);
+}
+
+static void BenchPools(lwc::Registry *reg, size_t count) {
+  // short-lived objects created and destroyed in groups of 16
+  lwc::Object *objects[16];
+  size_t n = count / 16;
+  double t0, t1;
+  
+  std::cout << "=== Pools (test.Box create/destroy)" << std::endl;
+  
+  t0 = Now();
+  for (size_t i=0; i<n; ++i) {
+    for (size_t j=0; j<16; ++j) {
+      objects[j] = reg->create("test.Box");
+    }
+    for (size_t j=0; j<16; ++j) {
+      reg->destroy(objects[j]);
+    }
+  }
+  t1 = Now();
+  Report("allocated", n*16, t1-t0);
+  
+  reg->setPool("test.Box", 16, 16);
+  t0 = Now();
+  for (size_t i=0; i<n; ++i) {
+    for (size_t j=0; j<16; ++j) {
+      objects[j] = reg->create("test.Box");
+    }
+    for (size_t j=0; j<16; ++j) {
+      reg->destroy(objects[j]);
+    }
+  }
+  t1 = Now();
+  Report("pooled   ", n*16, t1-t0);
+  
+  lwc::PoolStats stats;
+  reg->getPoolStats("test.Box", stats);
+  std::cout << "reused " << stats.reused << ", allocated " << stats.allocated << ", discarded " << stats.discarded << std::endl;
+  reg->setPool("test.Box", 0);
+}
+
+int main(int argc, char **argv) {
+  
+  size_t count = 1000000;
+  
+  if (argc > 1) {
+    count = (size_t) atol(argv[1]);
+  }
+  
+  lwc::Registry *reg = lwc::Registry::Initialize();
+  
+  reg->addLoaderPath("./components/loaders");
+  reg->addModulePath("./components/modules");
+  
+  // thread pool size (parallel and asynchronous calls)
+  if (argc > 2) {
+    reg->setNumWorkers((size_t) atol(argv[2]));
+  }
+  
+  try {
+    BenchHandles(reg, count);
+    BenchInherited(reg, count);
+    BenchCallSite(reg, count);
+    BenchBatch(reg, count);
+    BenchBroadcast(reg, count);
+    BenchProperties(reg, count);
+    BenchInterface(reg, count);
+    BenchReturn(reg, count);
+    BenchAutoBinding(reg, count);
+    BenchInterceptors(reg, count);
+    BenchCApi(reg, count);
+    BenchAsync(reg, count);
+    BenchActors(reg, count);
+    BenchCommandBuffer(reg, count);
+    BenchSignals(reg, count);
+    BenchPools(reg, count);
+  } catch (std::exception &e) {
+    std::cout << "*** Caught exception: " << e.what() << std::endl;
+  }
+  
+  lwc::Registry::DeInitialize();
+  
+  return 0;
+}
@@ -0,0 +1,100 @@
+-- Copyright (C) 2009, 2010  Gaetan Guidet
+-- 
+-- This file is part of lwc.
+-- 
+-- lwc is free software; you can redistribute it and/or modify it
+-- under the terms of the GNU Lesser General Public License as published by
+-- the Free Software Foundation; either version 2.1 of the License, or (at
+-- your option) any later version.
+-- 
+-- lwc is distributed in the hope that it will be useful, but
+-- WITHOUT ANY WARRANTY; without even the implied warranty of
+-- MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+-- Lesser General Public License for more details.
+-- 
+-- You should have received a copy of the GNU Lesser General Public
+-- License along with this library; if not, write to the Free Software
+-- Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+-- USA.
+
+-- Compare calls through the llwc module with calls through the flat C
+-- interface (lwc/capi.h) using the LuaJIT ffi library
+
+require "llwc"
+
+local ffi = require "ffi"
+
+-- declarations from lwc/capi.h (lwc_integer is long on 64 bit platforms)
+ffi.cdef[[
+typedef union {
+  void *ptr;
+  double real;
+  long integer;
+  unsigned char boolean;
+} lwc_value;
+typedef struct lwc_registry lwc_registry;
+typedef struct lwc_object lwc_object;
+typedef struct lwc_method lwc_method;
+lwc_registry* lwc_registry_create(void);
+lwc_object* lwc_object_create(lwc_registry *reg, const char *type);
+void lwc_object_destroy(lwc_registry *reg, lwc_object *obj);
+lwc_method* lwc_method_lookup(lwc_registry *reg, const char *type, const char *name);
+void lwc_method_release(lwc_method *method);
+int lwc_call(lwc_object *obj, const lwc_method *method, lwc_value *args, size_t nargs);
+]]
+
+local lwc = ffi.load("lwc")
+
+local count = tonumber(arg and arg[1]) or 1000000
+
+local function report(what, t0, t1)
+  print(string.format("%s: %d calls in %fs (%f ns/call)", what, count, t1-t0, (t1-t0)*1e9/count))
+end
+
+-- llwc initializes the registry, lwc_registry_create returns the same instance
+local reg = llwc.Initialize()
+reg:addLoaderPath("./components/loaders")
+reg:addModulePath("./components/modules")
+
+print("=== test.Box setX, getX")
+
+local b = reg:create("test.Box")
+
+local t0 = os.clock()
+for i = 1, count do
+  b:setX(i)
+end
+report("setX (llwc)   ", t0, os.clock())
+
+t0 = os.clock()
+for i = 1, count do
+  b:getX()
+end
+report("getX (llwc)   ", t0, os.clock())
+
+reg:destroy(b)
+
+local creg = lwc.lwc_registry_create()
+local cb = lwc.lwc_object_create(creg, "test.Box")
+local setX = lwc.lwc_method_lookup(creg, "test.Box", "setX")
+local getX = lwc.lwc_method_lookup(creg, "test.Box", "getX")
+local args = ffi.new("lwc_value[1]")
+
+t0 = os.clock()
+for i = 1, count do
+  args[0].integer = i
+  lwc.lwc_call(cb, setX, args, 1)
+end
+report("setX (lwc_call)", t0, os.clock())
+
+t0 = os.clock()
+for i = 1, count do
+  lwc.lwc_call(cb, getX, args, 1)
+end
+report("getX (lwc_call)", t0, os.clock())
+
+lwc.lwc_method_release(setX)
+lwc.lwc_method_release(getX)
+lwc.lwc_object_destroy(creg, cb)
+
+llwc.DeInitialize()
@@ -0,0 +1,122 @@
+/*
+
+Copyright (C) 2009, 2010  Gaetan Guidet
+
+This file is part of lwc.
+
+lwc is free software; you can redistribute it and/or modify it
+under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 2.1 of the License, or (at
+your option) any later version.
+
+lwc is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+USA.
+
+*/
+
+/* Plain C client of the flat call interface (see lwc/capi.h) */
+
+#include <lwc/capi.h>
+#include <stdio.h>
+
+static lwc_method* Lookup(lwc_registry *reg, const char *type, const char *name) {
+  char msg[256];
+  lwc_method *m = lwc_method_lookup(reg, type, name);
+  if (!m) {
+    lwc_last_error(msg, sizeof(msg));
+    printf("Lookup %s.%s failed: %s\n", type, name, msg);
+  }
+  return m;
+}
+
+static void Report(const char *what, int code) {
+  char msg[256];
+  if (code != 0) {
+    lwc_last_error(msg, sizeof(msg));
+    printf("%s: error %d: %s\n", what, code, msg);
+  } else {
+    printf("%s: ok\n", what);
+  }
+}
+
+int main(int argc, char **argv) {
+  lwc_registry *reg;
+  lwc_object *box;
+  lwc_method *setX, *getX, *move, *contains, *toBox;
+  lwc_value args[3];
+  unsigned char inside;
+  size_t i;
+  
+  (void) argc;
+  (void) argv;
+  
+  reg = lwc_registry_create();
+  lwc_registry_add_loader_path(reg, "./components/loaders");
+  lwc_registry_add_module_path(reg, "./components/modules");
+  
+  printf("Has test.Box: %d\n", lwc_registry_has_type(reg, "test.Box"));
+  printf("Has test.Nothing: %d\n", lwc_registry_has_type(reg, "test.Nothing"));
+  
+  box = lwc_object_create(reg, "test.Box");
+  printf("Object type: %s\n", lwc_object_type(box));
+  
+  setX = Lookup(reg, "test.Box", "setX");
+  getX = Lookup(reg, "test.Box", "getX");
+  move = Lookup(reg, "test.Box", "move");
+  contains = Lookup(reg, "test.Box", "contains");
+  toBox = Lookup(reg, "test.DoubleBox", "toBox");
+  Lookup(reg, "test.Box", "nothing");
+  Lookup(reg, "test.Nothing", "setX");
+  
+  printf("contains:");
+  for (i=0; i<lwc_method_num_args(contains); ++i) {
+    printf(" (dir %d, type %d)", lwc_method_arg_dir(contains, i), lwc_method_arg_type(contains, i));
+  }
+  printf("\n");
+  
+  args[0].integer = 10;
+  Report("setX(10)", lwc_call(box, setX, args, 1));
+  
+  args[0].integer = 0;
+  Report("getX()", lwc_call(box, getX, args, 1));
+  printf("  x = %ld\n", (long) args[0].integer);
+  
+  args[0].integer = 5;
+  args[1].integer = 5;
+  Report("move(5, 5)", lwc_call(box, move, args, 2));
+  
+  Report("getX()", lwc_call(box, getX, args, 1));
+  printf("  x = %ld\n", (long) args[0].integer);
+  
+  /* out arguments are passed as pointers */
+  args[0].integer = 15;
+  args[1].integer = 5;
+  args[2].ptr = &inside;
+  Report("contains(15, 5)", lwc_call(box, contains, args, 3));
+  printf("  inside = %d\n", (int) inside);
+  
+  /* errors */
+  Report("setX()", lwc_call(box, setX, args, 0));
+  Report("toBox() on test.Box", lwc_call(box, toBox, args, 1));
+  Report("null method", lwc_call(box, 0, args, 0));
+  args[2].ptr = 0;
+  Report("contains with null out", lwc_call(box, contains, args, 3));
+  
+  lwc_method_release(setX);
+  lwc_method_release(getX);
+  lwc_method_release(move);
+  lwc_method_release(contains);
+  lwc_method_release(toBox);
+  
+  lwc_object_destroy(reg, box);
+  lwc_registry_destroy(reg);
+  
+  return 0;
+}
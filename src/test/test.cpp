@@ -23,6 +23,29 @@ USA.
 
 #include <lwc/object.h>
 #include <lwc/registry.h>
+#include <lwc/future.h>
+#include <lwc/actor.h>
+#include <lwc/cmdbuffer.h>
+#include <lwc/signal.h>
+#include "../modules/box.h"
+#include <cstdlib>
+#include <new>
+
+// count heap allocations (see "Allocations" test below)
+static size_t gAllocations = 0;
+
+void* operator new(size_t sz) throw(std::bad_alloc) {
+  ++gAllocations;
+  void *p = malloc(sz > 0 ? sz : 1);
+  if (!p) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void operator delete(void *p) throw() {
+  free(p);
+}
 
 using lwc::Integer;
 
@@ -132,6 +155,57 @@ void printTypeInfo(T val)
 
 // ---
 
+class CallLogger : public lwc::Interceptor {
+  public:
+    
+    virtual bool before(lwc::Object *, const char *name, lwc::MethodParams &, lwc::Status &) {
+      std::cout << "  before " << name << std::endl;
+      return true;
+    }
+    
+    virtual void after(lwc::Object *, const char *name, lwc::MethodParams &, lwc::Status &status) {
+      std::cout << "  after " << name << (status.succeeded() ? "" : " (failed)") << std::endl;
+    }
+};
+
+class NegativeSizeGuard : public lwc::Interceptor {
+  public:
+    
+    virtual bool before(lwc::Object *, const char *, lwc::MethodParams &params, lwc::Status &) {
+      return (params.get<lwc::Integer>(0) >= 0);
+    }
+};
+
+class ThrowingInterceptor : public lwc::Interceptor {
+  public:
+    
+    virtual void after(lwc::Object *, const char *, lwc::MethodParams &, lwc::Status &) {
+      throw std::runtime_error("after hook failed");
+    }
+};
+
+// Calls a box from a second thread (see "Actors" test below)
+class BoxCaller {
+  public:
+    
+    BoxCaller(lwc::Object *box)
+      : mBox(box), mWidth(0), mDone(0) {
+    }
+    
+    int run(void*) {
+      mBox->call("setWidth", 11);
+      mBox->call("getWidth", &mWidth);
+      lwc::atomic::Store(&mDone, 1);
+      return 0;
+    }
+    
+    lwc::Object *mBox;
+    lwc::Integer mWidth;
+    volatile long mDone;
+};
+
+// ---
+
 int main(int, char**) {
   
   /*
@@ -173,6 +247,25 @@ int main(int, char**) {
     std::cout << names[i] << std::endl;
   }
   
+  std::cout << "=== Inherited lookups" << std::endl;
+  {
+    lwc::MethodsTable *base = new lwc::MethodsTable();
+    lwc::MethodsTable derived(base);
+    lwc::Method m;
+    m.setDescription("added after the derived table");
+    base->addMethod("late", m);
+    std::cout << "derived sees late: " << (derived.findMethod("late") != 0) << std::endl;
+    base->addProperty("size", *(reg->getMethods("test.Box")->findProperty("x")));
+    try {
+      derived.addMethod("size", m);
+      std::cout << "method clashing with an inherited property added" << std::endl;
+    } catch (std::exception &e) {
+      std::cout << e.what() << std::endl;
+    }
+    delete base;
+    std::cout << "after base deletion: " << (derived.findMethod("late") != 0) << ", " << derived.numMethods() << " method(s)" << std::endl;
+  }
+  
   lwc::Object *c = 0;
   Integer val = 0;
   
@@ -211,6 +304,11 @@ int main(int, char**) {
     kwargs.set("scale", 3);
     b->call("set", pos, kwargs);
     
+    // keyword slots and defaults resolved once for this arguments shape
+    lwc::CallSite setSite(b->getMethodHandle("set"), 1, kwargs);
+    kwargs.set("scale", 4);
+    b->call(setSite, pos, kwargs);
+    
     b->call("setWidth", 400);
     b->call("setHeight", 400);
     
@@ -223,6 +321,22 @@ int main(int, char**) {
     b->call("getHeight", &val);
     std::cout << "getHeight = " << val << std::endl;
     
+    // several parameter sets in a single dispatch (last setWidth wins)
+    lwc::MethodHandle setWidth = b->getMethodHandle("setWidth");
+    lwc::MethodParams w0(setWidth.getMethod()), w1(setWidth.getMethod());
+    w0.set(0, lwc::Integer(100));
+    w1.set(0, lwc::Integer(400));
+    lwc::MethodParams *setBatch[2] = {&w0, &w1};
+    b->callBatch(setWidth, setBatch, 2);
+    
+    lwc::Integer widths[2] = {0, 0};
+    lwc::MethodParams g0(b->getMethod("getWidth")), g1(b->getMethod("getWidth"));
+    g0.set(0, &widths[0]);
+    g1.set(0, &widths[1]);
+    lwc::MethodParams *getBatch[2] = {&g0, &g1};
+    b->callBatch("getWidth", getBatch, 2);
+    std::cout << "getWidth (batch) = " << widths[0] << ", " << widths[1] << std::endl;
+    
     
     val = 1;
     
@@ -249,6 +363,685 @@ int main(int, char**) {
   if (c) reg->destroy(c);
   if (b) reg->destroy(b);
   
+  std::cout << "=== Broadcast" << std::endl;
+  {
+    std::vector<lwc::Object*> boxes;
+    for (size_t i=0; i<100; ++i) {
+      boxes.push_back(reg->create("test.Box"));
+    }
+    
+    try {
+      lwc::MethodHandle setX = reg->getMethodHandle("test.Box", "setX");
+      lwc::MethodParams params(setX.getMethod());
+      params.set(0, lwc::Integer(7));
+      reg->broadcast(&boxes[0], boxes.size(), setX, params);
+      
+      size_t count = 0;
+      for (size_t i=0; i<boxes.size(); ++i) {
+        boxes[i]->call("getX", &val);
+        if (val == 7) {
+          ++count;
+        }
+      }
+      std::cout << "setX on " << count << "/" << boxes.size() << " boxes" << std::endl;
+      
+      // only input arguments can be broadcast
+      lwc::MethodParams outParams(reg->getMethodHandle("test.Box", "getX").getMethod());
+      outParams.set(0, &val);
+      reg->broadcast(&boxes[0], boxes.size(), "getX", outParams);
+      
+    } catch (std::exception &e) {
+      std::cout << "*** Caught exception: " << e.what() << std::endl;
+    }
+    
+    for (size_t i=0; i<boxes.size(); ++i) {
+      reg->destroy(boxes[i]);
+    }
+  }
+  
+  std::cout << "=== Properties" << std::endl;
+  {
+    lwc::Object *box = reg->create("test.Box");
+    lwc::Object *dbox = reg->create("test.DoubleBox");
+    
+    try {
+      box->setProperty("x", lwc::Integer(12));
+      box->call("getX", &val);
+      std::cout << "test.Box x = " << box->getProperty<lwc::Integer>("x") << ", getX = " << val << std::endl;
+      
+      dbox->setProperty("width", lwc::Integer(12));
+      dbox->call("getWidth", &val);
+      std::cout << "test.DoubleBox width = " << dbox->getProperty<lwc::Integer>("width") << ", getWidth = " << val << std::endl;
+      
+      box->getProperty<lwc::Real>("x");
+      
+    } catch (std::exception &e) {
+      std::cout << "*** Caught exception: " << e.what() << std::endl;
+    }
+    
+    reg->destroy(box);
+    reg->destroy(dbox);
+  }
+  
+  std::cout << "=== Interfaces" << std::endl;
+  {
+    lwc::Object *box = reg->create("test.Box");
+    lwc::Object *dbox = reg->create("test.DoubleBox");
+    
+    try {
+      IBox *ib = box->queryInterface<IBox>();
+      ib->x(5);
+      box->call("getX", &val);
+      std::cout << "test.Box IBox x = " << ib->x() << ", getX = " << val << std::endl;
+      
+      IBox *idb = dbox->queryInterface<IBox>();
+      idb->width(5);
+      dbox->call("getWidth", &val);
+      std::cout << "test.DoubleBox IBox width = " << idb->width() << ", getWidth = " << val << std::endl;
+      
+      std::cout << "test.Box test.IUnknown: " << (box->queryInterface("test.IUnknown") ? "found" : "not found") << std::endl;
+      
+    } catch (std::exception &e) {
+      std::cout << "*** Caught exception: " << e.what() << std::endl;
+    }
+    
+    reg->destroy(box);
+    reg->destroy(dbox);
+  }
+  
+  std::cout << "=== Interface bindings" << std::endl;
+  {
+    lwc::MethodDecl shapeDecl[] = {
+      {"getX", 1,      {{lwc::AD_RETURN, lwc::AT_INT, -1, LWC_NODEF, NULL}}, 0, "Get shape origin x coord"},
+      {"getY", 1,      {{lwc::AD_RETURN, lwc::AT_INT, -1, LWC_NODEF, NULL}}, 0, "Get shape origin y coord"},
+      {"getWidth", 1,  {{lwc::AD_RETURN, lwc::AT_INT, -1, LWC_NODEF, NULL}}, 0, "Get shape width"},
+      {"getHeight", 1, {{lwc::AD_RETURN, lwc::AT_INT, -1, LWC_NODEF, NULL}}, 0, "Get shape height"}
+    };
+    lwc::MethodDecl scalableDecl[] = {
+      {"setWidth", 1,  {{lwc::AD_IN,  lwc::AT_REAL, -1, LWC_NODEF, NULL}}, 0, "Set width"}
+    };
+    
+    try {
+      reg->addInterface(lwc::Interface("test.Shape", shapeDecl, LWC_NUMMETHODS(shapeDecl)));
+      reg->addInterface(lwc::Interface("test.Scalable", scalableDecl, LWC_NUMMETHODS(scalableDecl)));
+      
+      std::cout << reg->getInterface("test.Shape")->toString();
+      
+      const char *types[] = {"test.Box", "test.DoubleBox"};
+      const char *ifaces[] = {"test.Shape", "test.Scalable"};
+      for (size_t i=0; i<2; ++i) {
+        for (size_t j=0; j<2; ++j) {
+          const lwc::InterfaceBinding *binding = reg->getBinding(types[i], ifaces[j]);
+          std::cout << types[i] << " implements " << ifaces[j] << ": " << (binding->isValid() ? "yes" : "no");
+          if (!binding->isValid()) {
+            std::cout << " (" << binding->getStatus().getMessage() << ")";
+          }
+          std::cout << std::endl;
+        }
+      }
+      
+      lwc::Object *dbox = reg->create("test.DoubleBox");
+      const lwc::InterfaceBinding &shape = *(reg->getBinding("test.DoubleBox", "test.Shape"));
+      
+      dbox->call("setWidth", 21);
+      if (shape.accepts(dbox)) {
+        // slot 2 is getWidth
+        dbox->call(shape[2], &val);
+        std::cout << "test.Shape slot 2 (" << shape[2].getName() << ") = " << val << std::endl;
+      }
+      reg->destroy(dbox);
+      
+    } catch (std::exception &e) {
+      std::cout << "*** Caught exception: " << e.what() << std::endl;
+    }
+  }
+  
+  std::cout << "=== Allocations" << std::endl;
+  {
+    lwc::Object *box = reg->create("test.Box");
+    
+    try {
+      lwc::MethodHandle sum = box->getMethodHandle("sum");
+      lwc::Integer total = 0;
+      
+      // first call may populate lazily built tables
+      box->call(sum, 1, 2, 3, 4, 5, 6, 7, 8, 9, &total);
+      
+      size_t count = gAllocations;
+      box->call(sum, 1, 2, 3, 4, 5, 6, 7, 8, 9, &total);
+      count = gAllocations - count;
+      
+      std::cout << "sum = " << total << ", heap allocations during 10 arguments call: " << count << std::endl;
+      
+    } catch (std::exception &e) {
+      std::cout << "*** Caught exception: " << e.what() << std::endl;
+    }
+    
+    reg->destroy(box);
+  }
+  
+  std::cout << "=== Memoized results" << std::endl;
+  {
+    lwc::Object *box = reg->create("test.Box");
+    
+    try {
+      bool inside = false;
+      unsigned long hits = 0, misses = 0;
+      
+      std::cout << "contains is memoized: " << box->getMethods()->findMethod("contains")->isMemoized() << std::endl;
+      
+      box->call("setWidth", 10);
+      box->call("setHeight", 10);
+      box->call("contains", 5, 5, &inside);
+      std::cout << "contains(5, 5) = " << inside << std::endl;
+      box->call("contains", 5, 5, &inside);
+      std::cout << "contains(5, 5) = " << inside << std::endl;
+      box->call("contains", 20, 5, &inside);
+      std::cout << "contains(20, 5) = " << inside << std::endl;
+      box->getResultStats(hits, misses);
+      std::cout << "hits = " << hits << ", misses = " << misses << ", evaluations = " << box->getProperty<lwc::Integer>("containsCalls") << std::endl;
+      
+      // field property writes invalidate cached results
+      box->setProperty<lwc::Integer>("width", 30);
+      box->call("contains", 20, 5, &inside);
+      std::cout << "contains(20, 5) after width = 30: " << inside << std::endl;
+      box->getResultStats(hits, misses);
+      std::cout << "hits = " << hits << ", misses = " << misses << ", evaluations = " << box->getProperty<lwc::Integer>("containsCalls") << std::endl;
+      
+    } catch (std::exception &e) {
+      std::cout << "*** Caught exception: " << e.what() << std::endl;
+    }
+    
+    reg->destroy(box);
+  }
+  
+  std::cout << "=== Return values" << std::endl;
+  {
+    lwc::Object *box = reg->create("test.Box");
+    
+    try {
+      box->call("setX", 7);
+      
+      lwc::MethodHandle getX = box->getMethodHandle("getX");
+      lwc::MethodParams params(getX.getMethod());
+      box->call(getX, params);
+      std::cout << "getX (return slot) = " << params.getReturn<lwc::Integer>() << std::endl;
+      
+      lwc::Integer x = 0;
+      box->call(getX, &x);
+      std::cout << "getX (pointer) = " << x << std::endl;
+      
+      // status context outlives the call arguments
+      lwc::Status status;
+      {
+        std::string name("getZ");
+        status = box->tryCall(name.c_str());
+      }
+      std::cout << status.getMessage() << std::endl;
+      {
+        lwc::KeywordArgs kwargs;
+        kwargs.set(std::string("scalex").c_str(), 1.0);
+        lwc::Integer pos[2] = {1, 1};
+        status = box->tryCall("set", pos, kwargs);
+      }
+      std::cout << status.getMessage() << std::endl;
+      lwc::MethodHandle invalid;
+      status = box->tryCall(invalid, params);
+      std::cout << status.getMessage() << std::endl;
+      
+      // pointer set on parameters: written back by every call path, dropped
+      // when the parameters are reset
+      x = -1;
+      params.set(0, &x);
+      box->call("getX", params);
+      std::cout << "getX (params pointer) = " << x << std::endl;
+      params.setDefaults();
+      box->call("setX", 8);
+      box->call("getX", params);
+      std::cout << "getX (after reset) = " << x << ", " << params.getReturn<lwc::Integer>() << std::endl;
+      
+      lwc::Method m;
+      m.addArg(lwc::Argument(lwc::AD_RETURN, lwc::AT_INT));
+      m.addArg(lwc::Argument(lwc::AD_IN, lwc::AT_INT));
+      m.validateArgs();
+      
+    } catch (std::exception &e) {
+      std::cout << "*** Caught exception: " << e.what() << std::endl;
+    }
+    
+    reg->destroy(box);
+  }
+  
+  std::cout << "=== Auto bound methods" << std::endl;
+  {
+    lwc::Object *box = reg->create("test.Box");
+    
+    try {
+      lwc::Integer x = 0, y = 0, w = 0, h = 0, amount = 1;
+      
+      box->call("setWidth", 2);
+      box->call("setHeight", 3);
+      box->call("move", 4, 5);
+      box->call("getX", &x);
+      box->call("getY", &y);
+      std::cout << "move(4, 5): x = " << x << ", y = " << y << std::endl;
+      
+      lwc::MethodHandle area = box->getMethodHandle("area");
+      lwc::MethodParams params(area.getMethod());
+      box->call(area, params);
+      std::cout << "area = " << params.getReturn<lwc::Integer>() << std::endl;
+      
+      box->call("getSize", &w, &h);
+      std::cout << "size = " << w << "x" << h << std::endl;
+      
+      box->call("grow", &amount);
+      std::cout << "grow(1): area = " << amount << std::endl;
+      
+      // arguments are checked against the generated signature
+      box->call("move", 1.5, "a");
+      
+    } catch (std::exception &e) {
+      std::cout << "*** Caught exception: " << e.what() << std::endl;
+    }
+    
+    reg->destroy(box);
+  }
+  
+  std::cout << "=== Signatures" << std::endl;
+  {
+    const lwc::MethodsTable *methods = reg->getMethods("test.Box");
+    const char *names[] = {"setX", "getX", "move", "getSize", "contains", "set"};
+    for (size_t i=0; i<sizeof(names)/sizeof(const char*); ++i) {
+      std::cout << names[i] << ": " << methods->findMethod(names[i])->signature() << std::endl;
+    }
+  }
+  
+  std::cout << "=== Interceptors" << std::endl;
+  {
+    lwc::Object *box = reg->create("test.Box");
+    
+    CallLogger logger;
+    NegativeSizeGuard guard;
+    
+    try {
+      lwc::Integer x = 0;
+      
+      std::cout << "active: " << lwc::InterceptorChain::Active() << std::endl;
+      
+      reg->addInterceptor(&logger, "test.Box");
+      reg->addInterceptor(&guard, "test.Box", "setWidth");
+      std::cout << "active: " << lwc::InterceptorChain::Active() << std::endl;
+      
+      box->call("setX", 3);
+      box->call("getX", &x);
+      std::cout << "x = " << x << std::endl;
+      
+      lwc::Status status = box->tryCall("setWidth", -1);
+      std::cout << "setWidth(-1): " << status.getMessage() << std::endl;
+      box->call("setWidth", -1);
+      
+    } catch (std::exception &e) {
+      std::cout << "*** Caught exception: " << e.what() << std::endl;
+    }
+    
+    // interceptor exceptions are reported as call failures
+    ThrowingInterceptor thrower;
+    reg->addInterceptor(&thrower, "test.Box", "setY");
+    lwc::Status thrown = box->tryCall("setY", 1);
+    std::cout << "setY: " << thrown.getMessage() << std::endl;
+    reg->removeInterceptor(&thrower);
+    
+    // other types are not intercepted
+    lwc::Object *dbox = reg->create("test.DoubleBox");
+    dbox->call("setX", 1.0);
+    reg->destroy(dbox);
+    
+    reg->removeInterceptor(&logger);
+    reg->removeInterceptor(&guard);
+    std::cout << "active: " << lwc::InterceptorChain::Active() << std::endl;
+    
+    reg->destroy(box);
+  }
+  
+  std::cout << "=== Asynchronous calls" << std::endl;
+  {
+    lwc::Object *box0 = reg->create("test.Box");
+    lwc::Object *box1 = reg->create("test.Box");
+    
+    NegativeSizeGuard guard;
+    
+    try {
+      box0->call("setWidth", 512);
+      box0->call("setHeight", 512);
+      box1->call("setWidth", 2);
+      box1->call("setHeight", 3);
+      
+      // independent calls overlap, outputs are owned by the futures
+      lwc::Future *sample = box0->callAsync("sample", 10000);
+      lwc::Future *size = box1->callAsync("getSize");
+      lwc::Future *grow = box1->callAsync(box1->getMethodHandle("grow"), 1);
+      
+      std::cout << "sample(10000) = " << sample->getReturn<lwc::Integer>() << std::endl;
+      std::cout << "size = " << size->get<lwc::Integer>(0) << "x" << size->get<lwc::Integer>(1) << std::endl;
+      grow->wait();
+      std::cout << "grow(1): ready = " << grow->ready() << ", area = " << grow->get<lwc::Integer>(0) << std::endl;
+      
+      delete sample;
+      delete size;
+      delete grow;
+      
+      // input strings are copied by callAsync
+      char *text = new char[6];
+      strcpy(text, "hello");
+      lwc::Future *measure = box0->callAsync("measure", text);
+      memset(text, 0, 6);
+      delete[] text;
+      lwc::Future *measure2 = box1->callAsync("measure", std::string("temporary"));
+      measure->wait();
+      measure2->wait();
+      std::cout << "measure: " << measure->getReturn<lwc::Integer>() << ", " << measure2->getReturn<lwc::Integer>() << std::endl;
+      delete measure;
+      delete measure2;
+      
+      // the pool can be resized once no call is pending
+      size_t nworkers = reg->getNumWorkers();
+      std::cout << "setNumWorkers: " << reg->setNumWorkers(nworkers + 2) << std::endl;
+      reg->setNumWorkers(nworkers);
+      
+      // failures are reported by the future
+      reg->addInterceptor(&guard, "test.Box", "setWidth");
+      lwc::Future *setWidth = box0->callAsync("setWidth", -1);
+      std::cout << "setWidth(-1): " << setWidth->getStatus().getMessage() << std::endl;
+      delete setWidth;
+      reg->removeInterceptor(&guard);
+      
+      // invalid calls throw
+      box0->callAsync("move", 1, 2, 3);
+      
+    } catch (std::exception &e) {
+      std::cout << "*** Caught exception: " << e.what() << std::endl;
+    }
+    
+    try {
+      box0->callAsync("set", 1);
+    } catch (std::exception &e) {
+      std::cout << "*** Caught exception: " << e.what() << std::endl;
+    }
+    
+    reg->destroy(box0);
+    reg->destroy(box1);
+  }
+  
+  std::cout << "=== Actors" << std::endl;
+  {
+    lwc::Object *box = reg->create("test.Box");
+    
+    NegativeSizeGuard guard;
+    lwc::MailboxStats stats;
+    
+    try {
+      lwc::Integer x = 0, y = 0;
+      
+      // the mailbox thread runs all the calls
+      lwc::Mailbox mailbox(4);
+      box->setMailbox(&mailbox);
+      
+      box->call("setX", 7);
+      box->call("getX", &x);
+      std::cout << "x = " << x << std::endl;
+      
+      lwc::MethodHandle setY = box->getMethodHandle("setY");
+      lwc::MethodParams params(setY.getMethod());
+      for (lwc::Integer i=0; i<10; ++i) {
+        params.set(0, i);
+        box->post(setY, params);
+      }
+      box->call("getY", &y);
+      std::cout << "y = " << y << std::endl;
+      
+      // so are the property accesses, creations and destructions
+      box->setProperty("x", lwc::Integer(9));
+      std::cout << "x property = " << box->getProperty<lwc::Integer>("x") << std::endl;
+      
+      reg->setLoaderMailbox(box->getLoaderName(), &mailbox);
+      lwc::Object *other = reg->create("test.Box");
+      std::cout << "created with mailbox: " << (other->getMailbox() == &mailbox) << std::endl;
+      reg->destroy(other);
+      reg->setLoaderMailbox(box->getLoaderName(), 0);
+      
+      reg->addInterceptor(&guard, "test.Box", "setWidth");
+      lwc::MethodHandle setWidth = box->getMethodHandle("setWidth");
+      lwc::MethodParams wparams(setWidth.getMethod());
+      wparams.set(0, lwc::Integer(-1));
+      box->post(setWidth, wparams);
+      lwc::Status status = box->tryCall("setWidth", -1);
+      std::cout << "setWidth(-1): " << status.getMessage() << std::endl;
+      reg->removeInterceptor(&guard);
+      
+      mailbox.getStats(stats);
+      std::cout << "sent " << stats.sent << ", posted " << stats.posted << ", processed " << stats.processed
+                << ", failed " << stats.failed << ", depth " << stats.depth << std::endl;
+      
+      // outputs cannot be posted
+      lwc::MethodHandle getX = box->getMethodHandle("getX");
+      lwc::MethodParams xparams(getX.getMethod());
+      box->post(getX, xparams);
+      
+    } catch (std::exception &e) {
+      std::cout << "*** Caught exception: " << e.what() << std::endl;
+    }
+    
+    try {
+      // owned by this thread: calls from other threads wait for process
+      lwc::Mailbox mailbox(0, false);
+      box->setMailbox(&mailbox);
+      
+      BoxCaller caller(box);
+      gcore::Thread thread(&caller, &BoxCaller::run, 0);
+      
+      size_t processed = 0;
+      while (lwc::atomic::Load(&(caller.mDone)) == 0) {
+        processed += mailbox.process();
+      }
+      thread.wait();
+      
+      std::cout << "width = " << caller.mWidth << " (" << processed << " calls processed)" << std::endl;
+      
+    } catch (std::exception &e) {
+      std::cout << "*** Caught exception: " << e.what() << std::endl;
+    }
+    
+    box->setMailbox(0);
+    reg->destroy(box);
+  }
+  
+  std::cout << "=== Command buffers" << std::endl;
+  {
+    lwc::Object *box = reg->create("test.Box");
+    
+    try {
+      lwc::CommandBuffer buffer;
+      
+      size_t setWidth = buffer.record(box, "setWidth");
+      buffer.setInput(setWidth, 0, 2);
+      buffer.setInput(buffer.record(box, "setHeight"), 0, 3);
+      size_t getSize = buffer.record(box, "getSize");
+      size_t area = buffer.record(box, "area");
+      size_t grow = buffer.record(box, box->getMethodHandle("grow"));
+      buffer.setInput(grow, 0, 1);
+      
+      buffer.submit();
+      std::cout << "size = " << buffer.get<lwc::Integer>(getSize, 0) << "x" << buffer.get<lwc::Integer>(getSize, 1)
+                << ", area = " << buffer.getReturn<lwc::Integer>(area)
+                << ", grow(1) = " << buffer.get<lwc::Integer>(grow, 0) << std::endl;
+      
+      // submit again with updated inputs
+      buffer.setInput(setWidth, 0, 5);
+      buffer.setInput(grow, 0, 0);
+      buffer.submit();
+      std::cout << "size = " << buffer.get<lwc::Integer>(getSize, 0) << "x" << buffer.get<lwc::Integer>(getSize, 1)
+                << ", area = " << buffer.getReturn<lwc::Integer>(area) << " (" << buffer.numCompleted() << " commands)" << std::endl;
+      
+      // nothing is called when an input is missing
+      buffer.record(box, "setX");
+      lwc::Status status = buffer.trySubmit();
+      std::cout << "command " << buffer.failedCommand() << ": " << status.getMessage()
+                << " (" << buffer.numCompleted() << " commands)" << std::endl;
+      
+      buffer.clear();
+      buffer.record(box, "set");
+      
+    } catch (std::exception &e) {
+      std::cout << "*** Caught exception: " << e.what() << std::endl;
+    }
+    
+    reg->destroy(box);
+  }
+  
+  std::cout << "=== Signals" << std::endl;
+  {
+    lwc::Object *box = reg->create("test.Box");
+    lwc::Object *follower = reg->create("test.Box");
+    lwc::Object *listener = reg->create("test.DoubleBox");
+    lwc::Object *ol = (reg->hasType("pytest.ObjectList") ? reg->create("pytest.ObjectList") : 0);
+    
+    try {
+      std::vector<std::string> names;
+      listener->getMethods()->availableSignals(names);
+      std::cout << "test.DoubleBox signals: " << names.size() << " (" << names[0] << ")" << std::endl;
+      
+      // synchronous: follower moves by the new dimensions
+      box->connect("resized", follower, "move");
+      box->call("setWidth", 3);
+      std::cout << "follower at " << follower->getProperty<lwc::Integer>("x") << ", " << follower->getProperty<lwc::Integer>("y") << std::endl;
+      
+      // queued: delivered when the queue is processed, overflow is dropped
+      lwc::SignalQueue queue(4);
+      box->connect("resized", listener, "move", &queue);
+      for (lwc::Integer i=1; i<=6; ++i) {
+        box->call("setHeight", i);
+      }
+      std::cout << "listener at " << listener->getProperty<lwc::Integer>("x") << ", " << listener->getProperty<lwc::Integer>("y")
+                << " (" << queue.depth() << " queued)" << std::endl;
+      size_t n = queue.process();
+      lwc::SignalStats stats;
+      queue.getStats(stats);
+      std::cout << "processed " << n << ": listener at " << listener->getProperty<lwc::Integer>("x") << ", " << listener->getProperty<lwc::Integer>("y")
+                << " (queued " << stats.queued << ", dropped " << stats.dropped << ", delivered " << stats.delivered
+                << ", failed " << stats.failed << ", depth " << stats.depth << ")" << std::endl;
+      
+      // script listener
+      if (ol) {
+        box->connect("resized", ol, "onResized");
+      }
+      box->emit("resized", 10, 20);
+      
+      std::cout << "disconnected " << box->disconnect("resized", follower) << ", "
+                << box->numConnections("resized") << " connection(s) left" << std::endl;
+      
+      lwc::Status status = box->emit("moved", 1, 2);
+      std::cout << status.getMessage() << std::endl;
+      status = box->emit("resized", 1);
+      std::cout << status.getMessage() << std::endl;
+      
+      try {
+        box->connect("resized", follower, "setX");
+      } catch (std::exception &e) {
+        std::cout << e.what() << std::endl;
+      }
+      
+      box->disconnectAll();
+      box->call("setWidth", 1);
+      std::cout << "follower at " << follower->getProperty<lwc::Integer>("x") << ", " << follower->getProperty<lwc::Integer>("y")
+                << " (" << queue.depth() << " queued)" << std::endl;
+      
+      // destroying a queue or a listener removes its connections
+      {
+        lwc::SignalQueue tmp;
+        box->connect("resized", follower, "move", &tmp);
+      }
+      lwc::Object *temp = reg->create("test.Box");
+      box->connect("resized", temp, "move");
+      std::cout << "incoming " << temp->numIncomingConnections() << ", ";
+      reg->destroy(temp);
+      std::cout << box->numConnections("resized") << " connection(s) left" << std::endl;
+      
+    } catch (std::exception &e) {
+      std::cout << "*** Caught exception: " << e.what() << std::endl;
+    }
+    
+    if (ol) {
+      reg->destroy(ol);
+    }
+    reg->destroy(listener);
+    reg->destroy(follower);
+    reg->destroy(box);
+  }
+  
+  std::cout << "=== Pools" << std::endl;
+  {
+    lwc::PoolStats stats;
+    std::cout << "test.Box pool: " << reg->setPool("test.Box", 2, 1) << std::endl;
+    
+    try {
+      lwc::Object *box = reg->create("test.Box");
+      lwc::Object *other = reg->create("test.Box");
+      box->call("setWidth", 5);
+      box->setProperty<lwc::Integer>("x", 3);
+      box->connect("resized", other, "move");
+      lwc::Object *prev = box;
+      reg->destroy(box);
+      
+      // recycled instances are reset
+      box = reg->create("test.Box");
+      std::cout << "reused " << (box == prev) << ": x=" << box->getProperty<lwc::Integer>("x")
+                << ", width=" << box->getProperty<lwc::Integer>("width")
+                << ", " << box->numConnections() << " connection(s)" << std::endl;
+      
+      // at most 2 kept, listeners of a connection are not pooled
+      lwc::Object *third = reg->create("test.Box");
+      third->connect("resized", other, "move");
+      reg->destroy(box);
+      reg->getPoolStats("test.Box", stats);
+      unsigned long discarded = stats.discarded;
+      reg->destroy(other);
+      reg->getPoolStats("test.Box", stats);
+      std::cout << "listener discarded: " << (stats.discarded - discarded) << ", " << third->numConnections() << " connection(s) left" << std::endl;
+      reg->destroy(third);
+      reg->getPoolStats("test.Box", stats);
+      std::cout << "size " << stats.size << "/" << stats.maxSize << ", reused " << stats.reused << ", allocated " << stats.allocated
+                << ", recycled " << stats.recycled << ", discarded " << stats.discarded << std::endl;
+      
+      if (reg->hasType("pytest.ObjectList")) {
+        std::cout << "pytest.ObjectList pool: " << reg->setPool("pytest.ObjectList", 4, 2) << std::endl;
+        lwc::Object *ol = reg->create("pytest.ObjectList");
+        lwc::Object *item = reg->create("test.Box");
+        ol->call("push", item);
+        reg->destroy(ol);
+        ol = reg->create("pytest.ObjectList");
+        lwc::Integer sz = 0;
+        ol->call("size", &sz);
+        std::cout << "recycled list size: " << sz << std::endl;
+        reg->destroy(ol);
+        reg->destroy(item);
+        reg->getPoolStats("pytest.ObjectList", stats);
+        std::cout << "size " << stats.size << "/" << stats.maxSize << ", reused " << stats.reused << ", allocated " << stats.allocated
+                  << ", recycled " << stats.recycled << ", discarded " << stats.discarded << std::endl;
+      }
+      
+    } catch (std::exception &e) {
+      std::cout << "*** Caught exception: " << e.what() << std::endl;
+    }
+    
+    // idle instances are kept when a pool is resized
+    reg->setPool("test.Box", 4, 3);
+    reg->getPoolStats("test.Box", stats);
+    std::cout << "resized: size " << stats.size << "/" << stats.maxSize << ", recycled " << stats.recycled << std::endl;
+    
+    std::cout << "unknown type pool: " << reg->setPool("test.Unknown", 4) << std::endl;
+    std::cout << "test.Box pool removed: " << reg->setPool("test.Box", 0) << ", " << reg->getPoolStats("test.Box", stats) << std::endl;
+  }
+  
   if (reg->hasType("pytest.ObjectList")) {
     lwc::Object *ol = reg->create("pytest.ObjectList");
     
@@ -284,6 +1077,8 @@ int main(int, char**) {
       std::cout << "*** FAILED: " << e.what() << std::endl;
     }
     
+    std::cout << "pytest.ObjectList IBox: " << (ol->queryInterface<IBox>() ? "found" : "not found") << std::endl;
+    
     reg->destroy(ol);
   }
   
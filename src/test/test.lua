@@ -83,6 +83,65 @@ else
 	reg:destroy(obj)
 end
 
+print("=== Properties")
+box = reg:create("test.Box")
+box.x = 10
+box.width = 30
+print("  " .. box.x .. ", " .. box:getX() .. ", " .. box.width)
+reg:destroy(box)
+
+print("=== Broadcast")
+boxes = {}
+for i = 1, 10 do
+	boxes[i] = reg:create("test.Box")
+end
+reg:broadcast(boxes, "setX", 3)
+reg:broadcast(boxes, "setY", 4)
+print("  " .. boxes[1]:getX() .. ", " .. boxes[10]:getY())
+for idx,box in ipairs(boxes) do
+	reg:destroy(box)
+end
+
+print("=== Command buffer")
+box = reg:create("test.Box")
+cb = llwc.CommandBuffer.new()
+cb:record(box, "setWidth", 2)
+cb:extend({{box, "setHeight", 3}, {box, "move", 4, 5}, {box, "getSize"}, {box, "area"}})
+results = cb:submit()
+w, h = unpack(results[4])
+print("  " .. w .. "x" .. h .. ", " .. results[5][1] .. " (" .. cb:size() .. " commands)")
+cb:clear()
+reg:destroy(box)
+
+print("=== Signals")
+box = reg:create("test.Box")
+other = reg:create("test.Box")
+q = llwc.SignalQueue.new(2)
+box:connect("resized", other, "move", q)
+box:setWidth(3)
+box:emit("resized", 4, 5)
+box:emit("resized", 6, 7)
+print("  " .. q:depth() .. " queued, " .. q:process() .. " processed")
+stats = q:getStats()
+print("  queued " .. stats.queued .. ", dropped " .. stats.dropped .. ", delivered " .. stats.delivered)
+print("  other at " .. other:getX() .. ", " .. other:getY())
+print("  " .. box:disconnect("resized", other) .. " disconnected")
+reg:destroy(box)
+reg:destroy(other)
+
+print("=== Pools")
+print("  test.Box pool: " .. tostring(reg:setPool("test.Box", 4, 1)))
+print("  luatest.Dict pool: " .. tostring(reg:setPool("luatest.Dict", 2)))
+d = reg:create("luatest.Dict")
+d:set("key", "value")
+reg:destroy(d)
+d = reg:create("luatest.Dict")
+print("  recycled dict size: " .. d:size())
+reg:destroy(d)
+stats = reg:getPoolStats("luatest.Dict")
+print("  size " .. stats.size .. "/" .. stats.maxSize .. ", reused " .. stats.reused .. ", allocated " .. stats.allocated)
+print("  " .. tostring(reg:setPool("test.Box", 0)) .. ", " .. tostring(reg:getPoolStats("test.Box")))
+
 
 llwc.DeInitialize()
 
@@ -122,6 +122,141 @@ if obj:
 
    reg.destroy(obj)
 
+print("### properties")
+box = reg.create("test.Box")
+box.x = 10
+box.width = 30
+print("%s, %s, %s" % (box.x, box.getX(), box.width))
+try:
+   box.x = 1.5
+except Exception, e:
+   print("*** FAILED: %s" % e)
+print("### memoized results")
+print("%s, %s" % (box.contains(12, 0), box.contains(12, 0)))
+box.width = 1
+print(box.contains(12, 0))
+print(box.getResultStats())
+reg.destroy(box)
+
+print("### auto bound methods")
+box = reg.create("test.Box")
+box.setWidth(2)
+box.setHeight(3)
+box.move(4, 5)
+print("%s, %s, %s" % (box.getX(), box.getY(), box.area()))
+print(box.getSize())
+reg.destroy(box)
+
+print("### signature stubs")
+box = reg.create("test.Box")
+box.setX(4)
+box.move(1, 2)
+print("%s, %s" % (box.getX(), box.getY()))
+reg.destroy(box)
+
+print("### broadcast")
+boxes = [reg.create("test.Box") for i in xrange(10)]
+reg.broadcast(boxes, "setX", 3)
+reg.broadcast(boxes, "setY", 4)
+print(", ".join(["%s:%s" % (b.getX(), b.getY()) for b in boxes]))
+try:
+   reg.broadcast(boxes, "getX")
+except Exception, e:
+   print("*** FAILED: %s" % e)
+for b in boxes:
+   reg.destroy(b)
+
+print("### command buffer")
+box = reg.create("test.Box")
+cb = lwcpy.CommandBuffer()
+cb.record(box, "setWidth", 2)
+cb.extend([(box, "setHeight", 3), (box, "move", 4, 5), (box, "getSize",), (box, "area",), (box, "grow", 1)])
+print(cb.submit())
+print(cb.submit())
+try:
+   cb.record(box, "setX", "a")
+except Exception, e:
+   print("*** FAILED: %s" % e)
+cb.record(box, "setY")
+try:
+   cb.submit()
+except Exception, e:
+   print("*** FAILED: %s" % e)
+print(cb.size())
+cb.clear()
+reg.destroy(box)
+lst = reg.create("pytest.ObjectList")
+if lst:
+   indent = "=> "
+   cb.record(lst, "printInt", 10, indent)
+   indent = None
+   cb.submit()
+   reg.destroy(lst)
+
+print("### signals")
+box = reg.create("test.Box")
+other = reg.create("test.Box")
+lst = reg.create("pytest.ObjectList")
+print(box.availableSignals())
+if lst:
+   box.connect("resized", lst, "onResized")
+   box.setWidth(4)
+q = lwcpy.SignalQueue(2)
+box.connect("resized", other, "move", q)
+box.setHeight(5)
+box.emit("resized", 7, 8)
+box.emit("resized", 9, 9)
+print(q.depth())
+print(q.process())
+s = q.getStats()
+print((s["queued"], s["dropped"], s["delivered"], s["failed"], s["depth"]))
+print((other.x, other.y))
+# the temporary queue removes its connection when collected
+box.connect("resized", other, "move", lwcpy.SignalQueue())
+box.emit("resized", 1, 1)
+print((other.x, other.y))
+try:
+   box.emit("resized", "a", 1)
+except Exception, e:
+   print("*** FAILED: %s" % e)
+if lst:
+   lst.connect("sizeChanged", other, "setX")
+   lst.push(box)
+   lst.push(other)
+   print(other.x)
+   try:
+      lst.connect("sizeChanged", box, "move")
+   except Exception, e:
+      print("*** FAILED: %s" % e)
+   print(box.disconnect("resized", lst))
+   reg.destroy(lst)
+reg.destroy(box)
+reg.destroy(other)
+
+print("### pools")
+print(reg.setPool("test.Box", 4, 2))
+print(reg.setPool("pytest.ObjectList", 2))
+box = reg.create("test.Box")
+box.x = 5
+reg.destroy(box)
+box = reg.create("test.Box")
+print(box.x)
+lst = reg.create("pytest.ObjectList")
+if lst:
+   lst.push(box)
+   reg.destroy(lst)
+   lst = reg.create("pytest.ObjectList")
+   print(lst.size())
+   reg.destroy(lst)
+s = reg.getPoolStats("pytest.ObjectList")
+if s:
+   print((s["size"], s["maxSize"], s["reused"], s["allocated"], s["recycled"], s["discarded"]))
+reg.destroy(box)
+s = reg.getPoolStats("test.Box")
+print((s["size"], s["maxSize"], s["reused"], s["allocated"], s["recycled"], s["discarded"]))
+print(reg.setPool("test.Box", 0))
+print(reg.getPoolStats("test.Box"))
+
 print("### test lua object")
 obj = reg.create("luatest.Dict")
 if obj:
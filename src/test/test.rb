@@ -59,6 +59,20 @@ if not obj.nil? then
   reg.destroy(obj)
 end
 
+puts "Properties"
+box = reg.create("test.Box")
+box.x = 10
+box.width = 30
+puts "=> (#{box.x}, #{box.getX()}, #{box.width})"
+reg.destroy(box)
+
+puts "Broadcast"
+boxes = (1..10).map { reg.create("test.Box") }
+reg.broadcast(boxes, "setX", 3)
+reg.broadcast(boxes, "setY", 4)
+puts "=> (#{boxes[0].getX()}, #{boxes[9].getY()})"
+boxes.each { |box| reg.destroy(box) }
+
 RLWC.DeInitialize()
 
 